@@ -0,0 +1,36 @@
+/**
+ * @file AllocCounter.cpp
+ * @brief The replaced global operator new and delete of the benchmarks.
+ * They are kept out of the benchmarks, so that the compiler does not inline std::free() into the deallocations of the standard containers
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "AllocCounter.h"
+#include <cstdlib>
+#include <new>
+
+/// @brief the number of heap allocations so far
+static std::size_t allocCount = 0;
+
+std::size_t numAllocs() { return allocCount; }
+
+void * operator new(std::size_t size)
+{
+    ++allocCount;
+    if (void *ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void * operator new[](std::size_t size) { return ::operator new(size); }
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr) noexcept { std::free(ptr); }
+
+void operator delete[](void *ptr, std::size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,17 @@
+/**
+ * @file AllocCounter.h
+ * @brief Count the heap allocations of the benchmarks by replacing the global operator new and delete
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_BENCH_ALLOC_COUNTER_H_
+#define MAGICAL_FLOW_BENCH_ALLOC_COUNTER_H_
+
+#include <cstddef>
+
+/// @brief get the number of heap allocations so far
+/// @return the number of calls to the replaced operator new and new[]
+std::size_t numAllocs();
+
+#endif //MAGICAL_FLOW_BENCH_ALLOC_COUNTER_H_
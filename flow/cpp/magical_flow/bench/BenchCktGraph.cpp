@@ -0,0 +1,231 @@
+/**
+ * @file BenchCktGraph.cpp
+ * @brief Benchmark building, copying and the placement-update and flag-scan loops over CktGraph, and flattening and checkpointing a DesignDB
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <limits>
+#include <string>
+#include "db/DesignDB.h"
+#include "AllocCounter.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace bench
+{
+    /// @brief the node layout before the hot/cold split, as the reference
+    struct LegacyNode
+    {
+        IndexType graphIdx = INDEX_TYPE_MAX;
+        std::vector<IndexType> pinIdxArray;
+        XY<LocType> offset = XY<LocType>(0, 0);
+        OriType orient = OriType::N;
+        bool implPhy = false;
+        bool flipVertFlag = false;
+        ImplType implType = ImplType::UNSET;
+        SymbolId refNameId = EMPTY_SYMBOL;
+        SymbolId nameId = EMPTY_SYMBOL;
+    };
+
+    /// @brief the net layout before the hot/cold split, as the reference
+    struct LegacyNet
+    {
+        std::vector<IndexType> pinIdxArray;
+        std::vector<IndexType> subIdxArray;
+        SymbolId nameId = EMPTY_SYMBOL;
+        IndexType ioPos = INDEX_TYPE_MAX;
+        bool isVdd = false;
+        bool isVss = false;
+        bool isDigital = false;
+        bool isAnalog = false;
+        std::vector<IoPinConfigure> ioInterfaces = std::vector<IoPinConfigure>(1);
+    };
+
+    /// @brief run a loop several times and print the best time
+    /// @param first: the name of the loop
+    /// @param second: the loop
+    template<typename LoopType>
+    inline void time(const std::string &name, LoopType loop)
+    {
+        double best = std::numeric_limits<double>::max();
+        for (IndexType round = 0; round < 10; ++round)
+        {
+            auto start = std::chrono::steady_clock::now();
+            loop();
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            best = std::min(best, elapsed.count());
+        }
+        std::cout << name << ": " << best << " ms" << std::endl;
+    }
+} // End of the bench namespace
+
+PROJECT_NAMESPACE_END
+
+int main(int argc, char **argv)
+{
+    using namespace PROJECT_NAMESPACE;
+    const IndexType num = argc > 1 ? static_cast<IndexType>(std::stoul(argv[1])) : 1000000;
+    CktGraph ckt;
+    std::vector<bench::LegacyNode> legacyNodes(num);
+    std::vector<bench::LegacyNet> legacyNets(num);
+    for (IndexType idx = 0; idx < num; ++idx)
+    {
+        ckt.allocateNode();
+        IndexType netIdx = ckt.allocateNet();
+        if (idx % 7 == 0)
+        {
+            ckt.net(netIdx).markVddFlag();
+            legacyNets[idx].isVdd = true;
+        }
+    }
+    std::cout << "nodes/nets: " << num << std::endl;
+    std::cout << "sizeof legacy node/net: " << sizeof(bench::LegacyNode) << "/" << sizeof(bench::LegacyNet) << " bytes" << std::endl;
+
+    // Placement update: shift every node and read back the flip flag
+    LocType sum = 0;
+    bench::time("placement update, legacy objects", [&]()
+    {
+        for (auto &node : legacyNodes)
+        {
+            node.offset.setXY(node.offset.x() + 1, node.offset.y() + 2);
+            sum += node.flipVertFlag ? 0 : node.offset.x();
+        }
+    });
+    bench::time("placement update, CktNode views", [&]()
+    {
+        for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx)
+        {
+            CktNode node = ckt.node(nodeIdx);
+            node.setOffset(node.offset().x() + 1, node.offset().y() + 2);
+            sum += node.flipVertFlag() ? 0 : node.offset().x();
+        }
+    });
+    bench::time("placement update, hot arrays", [&]()
+    {
+        auto offsets = ckt.nodeOffsets();
+        auto flips = ckt.nodeFlipVertFlags();
+        for (IndexType nodeIdx = 0; nodeIdx < offsets.size(); ++nodeIdx)
+        {
+            offsets[nodeIdx].setXY(offsets[nodeIdx].x() + 1, offsets[nodeIdx].y() + 2);
+            sum += flips[nodeIdx] ? 0 : offsets[nodeIdx].x();
+        }
+    });
+
+    // Flag scan: count the power nets
+    IndexType count = 0;
+    bench::time("flag scan, legacy objects", [&]()
+    {
+        for (const auto &net : legacyNets)
+        {
+            count += (net.isVdd or net.isVss) ? 1 : 0;
+        }
+    });
+    bench::time("flag scan, Net views", [&]()
+    {
+        for (IndexType netIdx = 0; netIdx < ckt.numNets(); ++netIdx)
+        {
+            count += ckt.net(netIdx).isPower() ? 1 : 0;
+        }
+    });
+    bench::time("flag scan, hot arrays", [&]()
+    {
+        const Byte power = static_cast<Byte>(NetFlag::VDD) | static_cast<Byte>(NetFlag::VSS);
+        for (Byte flags : ckt.netFlags())
+        {
+            count += (flags & power) ? 1 : 0;
+        }
+    });
+    // Build: 4-pin devices on a shared pool of nets, then copy the graph as _ckts does when it grows
+    const IndexType numDevices = num / 4;
+    std::size_t allocsBefore = numAllocs();
+    CktGraph devices;
+    for (IndexType idx = 0; idx < numDevices; ++idx)
+    {
+        devices.allocateNet();
+    }
+    for (IndexType idx = 0; idx < numDevices; ++idx)
+    {
+        IndexType nodeIdx = devices.allocateNode();
+        for (IndexType nth = 0; nth < 4; ++nth)
+        {
+            IndexType pinIdx = devices.allocatePin();
+            IndexType netIdx = (idx + nth * 7) % numDevices;
+            devices.pin(pinIdx).setNodeIdx(nodeIdx);
+            devices.pin(pinIdx).setNetIdx(netIdx);
+            devices.pin(pinIdx).addLayoutRectIdx(pinIdx);
+            devices.node(nodeIdx).appendPinIdx(pinIdx);
+            devices.net(netIdx).appendPinIdx(pinIdx);
+        }
+    }
+    std::cout << "build " << numDevices << " devices: " << numAllocs() - allocsBefore << " allocations" << std::endl;
+    allocsBefore = numAllocs();
+    bench::time("copy the device graph", [&]()
+    {
+        CktGraph copy(devices);
+        count += copy.numPins();
+    });
+    std::cout << "copy: " << (numAllocs() - allocsBefore) / 10 << " allocations" << std::endl;
+
+    // Flatten: a top of num / 1000 instances of a cell of 1000 4-pin devices, the first 100 nets of the cell are ports
+    DesignDB db;
+    IndexType devIdx = db.allocateCkt();
+    db.subCkt(devIdx).build(std::vector<IndexType>{ INDEX_TYPE_MAX }, std::vector<IndexType>(4, 0),
+                            std::vector<IndexType>{ 0, 1, 2, 3 }, Span<const IntType>(), std::vector<IntType>(4, 0));
+    db.subCkt(devIdx).setImplType(ImplType::PCELL_Nch);
+    const IndexType cellSize = 1000;
+    const IndexType numPorts = 100;
+    IndexType cellIdx = db.allocateCkt();
+    std::vector<IndexType> pinNodeIdx;
+    std::vector<IndexType> pinNetIdx;
+    for (IndexType idx = 0; idx < cellSize * 4; ++idx)
+    {
+        pinNodeIdx.emplace_back(idx / 4);
+        pinNetIdx.emplace_back((idx / 4 + (idx % 4) * 7) % cellSize);
+    }
+    db.subCkt(cellIdx).build(std::vector<IndexType>(cellSize, devIdx), pinNodeIdx, pinNetIdx, Span<const IntType>(), std::vector<IntType>(cellSize, 0));
+    const IndexType numCells = std::max(num / cellSize, 1u);
+    pinNodeIdx.clear();
+    pinNetIdx.clear();
+    for (IndexType idx = 0; idx < numCells * numPorts; ++idx)
+    {
+        pinNodeIdx.emplace_back(idx / numPorts);
+        pinNetIdx.emplace_back((idx / numPorts) * numPorts / 2 + idx % numPorts);
+    }
+    IndexType topIdx = db.allocateCkt();
+    CktGraph &top = db.subCkt(topIdx);
+    top.build(std::vector<IndexType>(numCells, cellIdx), pinNodeIdx, pinNetIdx, Span<const IntType>(),
+              std::vector<IntType>(pinNetIdx.back() + 1, 0));
+    for (IndexType pinIdx = 0; pinIdx < top.numPins(); ++pinIdx)
+    {
+        top.pin(pinIdx).setIntNetIdx(pinIdx % numPorts);
+    }
+    db.findRootCkt();
+    bench::time("flatten " + std::to_string(numCells * cellSize) + " devices", [&]()
+    {
+        FlatDesign flat = db.flatten();
+        count += flat.numNets();
+    });
+
+    // Checkpoint the same design and restore it. The layouts are left in the file
+    const std::string checkpoint = "bench_design.ckpt";
+    bench::time("save checkpoint", [&]()
+    {
+        count += db.save(checkpoint);
+    });
+    bench::time("load checkpoint", [&]()
+    {
+        DesignDB loaded;
+        count += loaded.load(checkpoint);
+        count += loaded.numCkts();
+    });
+    std::remove(checkpoint.c_str());
+
+    // Keep the loops from being optimized away
+    std::cout << "checksum: " << sum << " " << count << std::endl;
+    return 0;
+}
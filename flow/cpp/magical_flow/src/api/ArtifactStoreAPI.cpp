@@ -0,0 +1,33 @@
+/**
+ * @file ArtifactStoreAPI.cpp
+ * @brief The Python interface for ArtifactStore
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include "db/ArtifactStore.h"
+
+namespace py = pybind11;
+
+void initArtifactStoreAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::ArtifactStore>(m, "ArtifactStore")
+        .def(py::init<const std::string &>())
+        .def("commit", py::overload_cast<const std::string &, const std::string &>(&PROJECT_NAMESPACE::ArtifactStore::commit),
+                "Take a result file of a circuit into the store and replace it by a link to the stored object")
+        .def("commitAs", py::overload_cast<const std::string &, const std::string &, const std::string &>(&PROJECT_NAMESPACE::ArtifactStore::commit),
+                "Take a file written aside into the store and link it to the result file")
+        .def("put", [](PROJECT_NAMESPACE::ArtifactStore &store, const std::string &ckt, py::bytes data, const std::string &filename)
+                { return store.put(ckt, data, filename); },
+                "Write the contents of a result file through the store")
+        .def("release", &PROJECT_NAMESPACE::ArtifactStore::release, "Remove a result file before a tool rewrites it")
+        .def("checkout", &PROJECT_NAMESPACE::ArtifactStore::checkout, "Link the last stored file of a circuit and stage to a result file")
+        .def("contains", &PROJECT_NAMESPACE::ArtifactStore::contains, "Whether a file of a circuit and stage is stored")
+        .def("objectFile", &PROJECT_NAMESPACE::ArtifactStore::objectFile, "Get the stored object of a circuit and stage")
+        .def_static("stageOf", &PROJECT_NAMESPACE::ArtifactStore::stageOf, "Get the stage of a result file of a circuit")
+        .def("numArtifacts", &PROJECT_NAMESPACE::ArtifactStore::numArtifacts)
+        .def("numStored", &PROJECT_NAMESPACE::ArtifactStore::numStored)
+        .def("numDeduped", &PROJECT_NAMESPACE::ArtifactStore::numDeduped)
+        .def("bytesDeduped", &PROJECT_NAMESPACE::ArtifactStore::bytesDeduped);
+}
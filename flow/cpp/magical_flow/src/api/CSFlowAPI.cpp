@@ -7,6 +7,7 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include "csflow/CSFlow.h"
 
 namespace py = pybind11;
@@ -19,6 +20,46 @@ void initCSFlowAPI(py::module &m) {
     .def("numCurrentPaths", &PROJECT_NAMESPACE::CSFlow::numCurrentPaths)
     .def("currentPinPath", &PROJECT_NAMESPACE::CSFlow::currentPinPath)
     .def("currentCellPath", &PROJECT_NAMESPACE::CSFlow::currentCellPath)
+    .def("currentPinPathIds", &PROJECT_NAMESPACE::CSFlow::currentPinPathIds)
+    .def("currentCellPathIds", &PROJECT_NAMESPACE::CSFlow::currentCellPathIds)
     .def("currentPinPaths", &PROJECT_NAMESPACE::CSFlow::currentPinPaths)
-    .def("currentCellPaths", &PROJECT_NAMESPACE::CSFlow::currentCellPaths);
+    .def("currentCellPaths", &PROJECT_NAMESPACE::CSFlow::currentCellPaths)
+    .def("currentPathStart", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto start = csflow.currentPathStart(); return py::array_t<PROJECT_NAMESPACE::IndexType>(start.size(), start.data()); },
+            "Get the offsets of the current paths as an array. Path i is [start[i], start[i + 1]) in the pin and node arrays")
+    .def("currentPathPinIdx", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto pins = csflow.currentPathPinIdx(); return py::array_t<PROJECT_NAMESPACE::IndexType>(pins.size(), pins.data()); },
+            "Get the pins of all the current paths as an array")
+    .def("currentPathNodeIdx", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto nodes = csflow.currentPathNodeIdx(); return py::array_t<PROJECT_NAMESPACE::IndexType>(nodes.size(), nodes.data()); },
+            "Get the nodes of all the current paths as an array")
+    .def("currentPathPins", [](const PROJECT_NAMESPACE::CSFlow &csflow, PROJECT_NAMESPACE::IndexType i)
+            { auto pins = csflow.currentPathPins(i); return std::vector<PROJECT_NAMESPACE::IndexType>(pins.begin(), pins.end()); },
+            "Get the pins of a current path")
+    .def("currentPathNodes", [](const PROJECT_NAMESPACE::CSFlow &csflow, PROJECT_NAMESPACE::IndexType i)
+            { auto nodes = csflow.currentPathNodes(i); return std::vector<PROJECT_NAMESPACE::IndexType>(nodes.begin(), nodes.end()); },
+            "Get the nodes of a current path")
+    .def("numSignalPaths", &PROJECT_NAMESPACE::CSFlow::numSignalPaths)
+    .def("signalPinPath", &PROJECT_NAMESPACE::CSFlow::signalPinPath)
+    .def("signalCellPath", &PROJECT_NAMESPACE::CSFlow::signalCellPath)
+    .def("signalPinPathIds", &PROJECT_NAMESPACE::CSFlow::signalPinPathIds)
+    .def("signalCellPathIds", &PROJECT_NAMESPACE::CSFlow::signalCellPathIds)
+    .def("signalPinPaths", &PROJECT_NAMESPACE::CSFlow::signalPinPaths)
+    .def("signalCellPaths", &PROJECT_NAMESPACE::CSFlow::signalCellPaths)
+    .def("signalNetLevel", &PROJECT_NAMESPACE::CSFlow::signalNetLevel, "Get the number of devices from an input to a net. INDEX_TYPE_MAX if unreached")
+    .def("signalPathStart", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto start = csflow.signalPathStart(); return py::array_t<PROJECT_NAMESPACE::IndexType>(start.size(), start.data()); },
+            "Get the offsets of the signal paths as an array. Path i is [start[i], start[i + 1]) in the pin and node arrays")
+    .def("signalPathPinIdx", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto pins = csflow.signalPathPinIdx(); return py::array_t<PROJECT_NAMESPACE::IndexType>(pins.size(), pins.data()); },
+            "Get the pins of all the signal paths as an array")
+    .def("signalPathNodeIdx", [](const PROJECT_NAMESPACE::CSFlow &csflow)
+            { auto nodes = csflow.signalPathNodeIdx(); return py::array_t<PROJECT_NAMESPACE::IndexType>(nodes.size(), nodes.data()); },
+            "Get the nodes of all the signal paths as an array")
+    .def("signalPathPins", [](const PROJECT_NAMESPACE::CSFlow &csflow, PROJECT_NAMESPACE::IndexType i)
+            { auto pins = csflow.signalPathPins(i); return std::vector<PROJECT_NAMESPACE::IndexType>(pins.begin(), pins.end()); },
+            "Get the pins of a signal path")
+    .def("signalPathNodes", [](const PROJECT_NAMESPACE::CSFlow &csflow, PROJECT_NAMESPACE::IndexType i)
+            { auto nodes = csflow.signalPathNodes(i); return std::vector<PROJECT_NAMESPACE::IndexType>(nodes.begin(), nodes.end()); },
+            "Get the nodes of a signal path");
 }
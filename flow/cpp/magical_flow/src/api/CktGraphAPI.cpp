@@ -7,18 +7,39 @@
 
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/numpy.h>
 #include "db/CktGraph.h"
+#include "db/CktGraphAlgo.h"
 
 namespace py = pybind11;
 
+/// @brief a contiguous array from Python. Lists and arrays of other dtypes are converted on the way in
+template<typename T>
+using PyArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/// @brief view a Python array as a span
+/// @param the array
+/// @return the span over the array data
+template<typename T>
+PROJECT_NAMESPACE::Span<const T> toSpan(const PyArray<T> &arr)
+{
+    return PROJECT_NAMESPACE::Span<const T>(arr.data(), static_cast<PROJECT_NAMESPACE::IndexType>(arr.size()));
+}
+
 void initCktGraphAPI(py::module &m)
 {
+    py::class_<PROJECT_NAMESPACE::CktEdit>(m , "CktEdit")
+        .def_readonly("type", &PROJECT_NAMESPACE::CktEdit::type)
+        .def_readonly("idx", &PROJECT_NAMESPACE::CktEdit::idx)
+        .def_readonly("fromIdx", &PROJECT_NAMESPACE::CktEdit::from)
+        .def_readonly("toIdx", &PROJECT_NAMESPACE::CktEdit::to);
+
     py::class_<PROJECT_NAMESPACE::CktGraph>(m , "CktGraph")
         .def(py::init<>())
         .def("setTechDB", &PROJECT_NAMESPACE::CktGraph::setTechDB)
         .def("allocateNode", &PROJECT_NAMESPACE::CktGraph::allocateNode)
         .def("numNodes", &PROJECT_NAMESPACE::CktGraph::numNodes)
-        .def("node", &PROJECT_NAMESPACE::CktGraph::node, py::return_value_policy::reference)
+        .def("node", &PROJECT_NAMESPACE::CktGraph::node, py::keep_alive<0, 1>())
         .def("allocatePin", &PROJECT_NAMESPACE::CktGraph::allocatePin)
         .def("resizeNodes", &PROJECT_NAMESPACE::CktGraph::resizeNodeArray, "Resize the node vector in this circuit")
         .def("numPins", &PROJECT_NAMESPACE::CktGraph::numPins)
@@ -31,15 +52,69 @@ void initCktGraphAPI(py::module &m)
         .def("numNets", &PROJECT_NAMESPACE::CktGraph::numNets)
         .def("numPsubs", &PROJECT_NAMESPACE::CktGraph::numPsubs)
         .def("numNwells", &PROJECT_NAMESPACE::CktGraph::numNwells)
-        .def("net", &PROJECT_NAMESPACE::CktGraph::net, py::return_value_policy::reference)
-        .def("psub", &PROJECT_NAMESPACE::CktGraph::psub, py::return_value_policy::reference)
-        .def("nwell", &PROJECT_NAMESPACE::CktGraph::nwell, py::return_value_policy::reference)
+        .def("net", &PROJECT_NAMESPACE::CktGraph::net, py::keep_alive<0, 1>())
+        .def("psub", &PROJECT_NAMESPACE::CktGraph::psub, py::keep_alive<0, 1>())
+        .def("nwell", &PROJECT_NAMESPACE::CktGraph::nwell, py::keep_alive<0, 1>())
+        .def("build", [](PROJECT_NAMESPACE::CktGraph &ckt, PyArray<PROJECT_NAMESPACE::IndexType> nodeGraphIdx,
+                    PyArray<PROJECT_NAMESPACE::IndexType> pinNodeIdx, PyArray<PROJECT_NAMESPACE::IndexType> pinNetIdx,
+                    PyArray<PROJECT_NAMESPACE::IntType> pinTypes, PyArray<PROJECT_NAMESPACE::IntType> netFlags)
+                { ckt.build(toSpan(nodeGraphIdx), toSpan(pinNodeIdx), toSpan(pinNetIdx), toSpan(pinTypes), toSpan(netFlags)); },
+                "Build the nodes, pins and nets from flat arrays in one call",
+                py::arg("nodeGraphIdx"), py::arg("pinNodeIdx"), py::arg("pinNetIdx"), py::arg("pinTypes"), py::arg("netFlags"))
+        .def("setNodeNames", &PROJECT_NAMESPACE::CktGraph::setNodeNames, "Set the names of all the nodes",
+                py::arg("names"), py::arg("refNames") = std::vector<std::string>())
+        .def("setNetNames", &PROJECT_NAMESPACE::CktGraph::setNetNames, "Set the names of all the nets")
+        .def("findNode", &PROJECT_NAMESPACE::CktGraph::findNode, "Find a node by name. INDEX_TYPE_MAX if not found")
+        .def("findNet", &PROJECT_NAMESPACE::CktGraph::findNet, "Find a net by name. INDEX_TYPE_MAX if not found")
+        .def("finalize", &PROJECT_NAMESPACE::CktGraph::finalize, "Pack the connectivity into contiguous arrays")
+        .def("isFinalized", &PROJECT_NAMESPACE::CktGraph::isFinalized)
+        .def("netPins", [](const PROJECT_NAMESPACE::CktGraph &ckt, PROJECT_NAMESPACE::IndexType netIdx)
+                { auto pins = ckt.netPins(netIdx); return std::vector<PROJECT_NAMESPACE::IndexType>(pins.begin(), pins.end()); }, "Get the pins of a net")
+        .def("netSubs", [](const PROJECT_NAMESPACE::CktGraph &ckt, PROJECT_NAMESPACE::IndexType netIdx)
+                { auto pins = ckt.netSubs(netIdx); return std::vector<PROJECT_NAMESPACE::IndexType>(pins.begin(), pins.end()); }, "Get the substrate pins of a net")
+        .def("nodePins", [](const PROJECT_NAMESPACE::CktGraph &ckt, PROJECT_NAMESPACE::IndexType nodeIdx)
+                { auto pins = ckt.nodePins(nodeIdx); return std::vector<PROJECT_NAMESPACE::IndexType>(pins.begin(), pins.end()); }, "Get the pins of a node")
+        .def("netFlags", [](const PROJECT_NAMESPACE::CktGraph &ckt)
+                { auto flags = ckt.netFlags(); return py::array_t<PROJECT_NAMESPACE::Byte>(flags.size(), flags.data()); },
+                "Get the NetFlag bits of all the nets as an array")
+        .def("netsWithFlags", [](const PROJECT_NAMESPACE::CktGraph &ckt, PROJECT_NAMESPACE::IntType required, PROJECT_NAMESPACE::IntType excluded)
+                {
+                    auto nets = ckt.netsWithFlags(static_cast<PROJECT_NAMESPACE::Byte>(required), static_cast<PROJECT_NAMESPACE::Byte>(excluded));
+                    return py::array_t<PROJECT_NAMESPACE::IndexType>(nets.size(), nets.data());
+                },
+                "Get the indices of the nets with all the required NetFlag bits and none of the excluded ones as an array",
+                py::arg("required"), py::arg("excluded") = 0)
+        .def("pinNet", &PROJECT_NAMESPACE::CktGraph::pinNet)
+        .def("pinNode", &PROJECT_NAMESPACE::CktGraph::pinNode)
+        .def("addNode", &PROJECT_NAMESPACE::CktGraph::addNode, "Add a node and connect its pins. Journaled",
+                py::arg("name"), py::arg("graphIdx"), py::arg("pinNets"))
+        .def("removeNode", &PROJECT_NAMESPACE::CktGraph::removeNode, "Remove a node and its pins. The last node and the last pins take their indices. Journaled")
+        .def("reconnectPin", &PROJECT_NAMESPACE::CktGraph::reconnectPin, "Connect a pin to another net. Journaled")
+        .def("markPropEdited", &PROJECT_NAMESPACE::CktGraph::markPropEdited, "Record that the device property was changed")
+        .def("journal", &PROJECT_NAMESPACE::CktGraph::journal, "Get the edits since the journal was cleared")
+        .def("clearJournal", &PROJECT_NAMESPACE::CktGraph::clearJournal)
         .def_property("name", &PROJECT_NAMESPACE::CktGraph::name, &PROJECT_NAMESPACE::CktGraph::setName)
+        .def_property_readonly("nameId", &PROJECT_NAMESPACE::CktGraph::nameId)
         .def("layout", &PROJECT_NAMESPACE::CktGraph::layout, py::return_value_policy::reference)
+        .def("isLayoutLoaded", &PROJECT_NAMESPACE::CktGraph::isLayoutLoaded, "Whether the layout is read from the checkpoint")
+        .def("shareLayout", &PROJECT_NAMESPACE::CktGraph::shareLayout, "Share the layout of another circuit, optionally mirrored")
+        .def("isLayoutShared", &PROJECT_NAMESPACE::CktGraph::isLayoutShared, "Whether the layout is shared with other circuits")
+        .def("layoutBoundary", &PROJECT_NAMESPACE::CktGraph::layoutBoundary, "Get the boundary of the layout without copying a shared one")
+        .def("insertLayoutInto", &PROJECT_NAMESPACE::CktGraph::insertLayoutInto, "Insert the layout into another one without copying a shared one")
         .def("parseGDS", &PROJECT_NAMESPACE::CktGraph::parseGDS, py::return_value_policy::reference)
         .def_property("implType", &PROJECT_NAMESPACE::CktGraph::implType, &PROJECT_NAMESPACE::CktGraph::setImplType) 
         .def_property("implIdx", &PROJECT_NAMESPACE::CktGraph::implIdx, &PROJECT_NAMESPACE::CktGraph::setImplIdx)
         .def_property("isImpl", &PROJECT_NAMESPACE::CktGraph::isImpl, &PROJECT_NAMESPACE::CktGraph::setIsImpl)
+        .def("beginImpl", &PROJECT_NAMESPACE::CktGraph::beginImpl, "Record the nodes and pins before the implementation adds its own")
+        .def("isImplInProgress", &PROJECT_NAMESPACE::CktGraph::isImplInProgress, "Whether the implementation began and is not finished")
+        .def("rollbackImpl", &PROJECT_NAMESPACE::CktGraph::rollbackImpl, "Drop an implementation in progress with the nodes and pins it added")
         .def("GdsData", &::MAGICAL_FLOW::CktGraph::gdsData, py::return_value_policy::reference)
         .def("gdsData", &::MAGICAL_FLOW::CktGraph::gdsData, py::return_value_policy::reference);
+
+    // Vertices [0, numNodes) are the nodes and numNodes + netIdx are the nets
+    m.def("connectedComponents", [](PROJECT_NAMESPACE::CktGraph &ckt)
+            { std::vector<PROJECT_NAMESPACE::IndexType> component; PROJECT_NAMESPACE::CktGraphAlgo::connectedComponents(ckt, component); return component; },
+            "Get the connected component of each vertex of the device/net graph");
+    m.def("bfsDistances", &PROJECT_NAMESPACE::CktGraphAlgo::bfsDistances, "Get the BFS distance from a vertex to every vertex of the device/net graph. INDEX_TYPE_MAX if unreachable");
+    m.def("eccentricity", &PROJECT_NAMESPACE::CktGraphAlgo::eccentricity, "Get the eccentricity of a vertex of the device/net graph within its component");
 }
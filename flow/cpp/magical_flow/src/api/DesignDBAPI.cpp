@@ -8,6 +8,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/stl_bind.h>
+#include <pybind11/numpy.h>
 #include "db/DesignDB.h"
 
 namespace py = pybind11;
@@ -16,15 +17,76 @@ PYBIND11_MAKE_OPAQUE(std::vector<std::string>);
 
 void initDesignDBAPI(py::module &m)
 {
+    py::class_<PROJECT_NAMESPACE::SymbolTable>(m , "SymbolTable")
+        .def("size", &PROJECT_NAMESPACE::SymbolTable::size, "Get the number of symbols")
+        .def("str", &PROJECT_NAMESPACE::SymbolTable::str, "Get the string of a symbol id")
+        .def("find", [](const PROJECT_NAMESPACE::SymbolTable &table, const std::string &name) { return table.find(name); }, "Find the symbol id of a name. INDEX_TYPE_MAX if not found")
+        .def("intern", [](PROJECT_NAMESPACE::SymbolTable &table, const std::string &name) { return table.intern(name); }, "Intern a name and get the symbol id");
+
+    py::class_<PROJECT_NAMESPACE::FlatDesign>(m , "FlatDesign")
+        .def("numPaths", &PROJECT_NAMESPACE::FlatDesign::numPaths)
+        .def("pathParent", &PROJECT_NAMESPACE::FlatDesign::pathParent, "Get the parent instance path. INDEX_TYPE_MAX for the root")
+        .def("pathNode", &PROJECT_NAMESPACE::FlatDesign::pathNode, "Get the node of an instance path in the circuit of its parent")
+        .def("pathCkt", &PROJECT_NAMESPACE::FlatDesign::pathCkt, "Get the circuit instantiated at an instance path")
+        .def("pathName", &PROJECT_NAMESPACE::FlatDesign::pathName, "Get the hierarchical instance name of a path",
+                py::arg("pathId"), py::arg("separator") = "/")
+        .def("numDevices", &PROJECT_NAMESPACE::FlatDesign::numDevices)
+        .def("deviceMaster", &PROJECT_NAMESPACE::FlatDesign::deviceMaster, "Get the device circuit of a device")
+        .def("devicePath", &PROJECT_NAMESPACE::FlatDesign::devicePath, "Get the instance path of a device")
+        .def("deviceNets", [](const PROJECT_NAMESPACE::FlatDesign &flat, PROJECT_NAMESPACE::IndexType devIdx)
+                { auto nets = flat.deviceNets(devIdx); return std::vector<PROJECT_NAMESPACE::IndexType>(nets.begin(), nets.end()); },
+                "Get the flat nets of the pins of a device")
+        .def("deviceMasters", [](const PROJECT_NAMESPACE::FlatDesign &flat)
+                { auto masters = flat.deviceMasters(); return py::array_t<PROJECT_NAMESPACE::IndexType>(masters.size(), masters.data()); },
+                "Get the device circuits of all the devices as an array")
+        .def("devicePaths", [](const PROJECT_NAMESPACE::FlatDesign &flat)
+                { auto paths = flat.devicePaths(); return py::array_t<PROJECT_NAMESPACE::IndexType>(paths.size(), paths.data()); },
+                "Get the instance paths of all the devices as an array")
+        .def("numNets", &PROJECT_NAMESPACE::FlatDesign::numNets)
+        .def("netPath", &PROJECT_NAMESPACE::FlatDesign::netPath, "Get the instance path of the highest net of a flat net")
+        .def("netIdx", &PROJECT_NAMESPACE::FlatDesign::netIdx, "Get the highest net of a flat net in the circuit at its path")
+        .def("flatNet", &PROJECT_NAMESPACE::FlatDesign::flatNet, "Get the flat net of a net of a circuit instance");
+
     py::class_<PROJECT_NAMESPACE::DesignDB>(m , "DesignDB")
         .def(py::init<>())
         .def("numCkts", &PROJECT_NAMESPACE::DesignDB::numCkts)
         .def("subCkt", &PROJECT_NAMESPACE::DesignDB::subCkt, py::return_value_policy::reference)
         .def("resizeSubCkts", &PROJECT_NAMESPACE::DesignDB::resizeSubCkts, "resize the sub circuits")
+        .def("findCkt", &PROJECT_NAMESPACE::DesignDB::findCkt, "Find a circuit by name. INDEX_TYPE_MAX if not found")
         .def("rootCktIdx", &PROJECT_NAMESPACE::DesignDB::rootCktIdx)
         .def("allocateCkt", &PROJECT_NAMESPACE::DesignDB::allocateCkt)
-        .def("findRootCkt", &PROJECT_NAMESPACE::DesignDB::findRootCkt)
+        .def("copyCkt", &PROJECT_NAMESPACE::DesignDB::copyCkt, py::arg("cktIdx"), py::arg("name"), "Append a copy of a circuit under another name. Return the index of the copy")
+        .def("flippedCopyOf", &PROJECT_NAMESPACE::DesignDB::flippedCopyOf, py::arg("cktIdx"), py::arg("name"), "Get the flipped copy of a circuit, or append one under the name the first time. Return the index of the copy")
+        .def("flippedCopy", &PROJECT_NAMESPACE::DesignDB::flippedCopy, "Get the flipped copy of a circuit. INDEX_TYPE_MAX if none")
+        .def("flippedOriginal", &PROJECT_NAMESPACE::DesignDB::flippedOriginal, "Get the circuit a flipped copy is of. INDEX_TYPE_MAX if the circuit is not a flipped copy")
+        .def("findRootCkt", &PROJECT_NAMESPACE::DesignDB::findRootCkt, "Levelize the hierarchy and find its roots. False if the hierarchy has a cycle")
+        .def("rootCkts", &PROJECT_NAMESPACE::DesignDB::rootCkts, "Get the circuits that are not instantiated")
+        .def("numLevels", &PROJECT_NAMESPACE::DesignDB::numLevels, "Get the number of levels of the hierarchy")
+        .def("cktLevel", &PROJECT_NAMESPACE::DesignDB::cktLevel, "Get the level of a circuit. 0 for the circuits without sub circuits")
+        .def("levelCkts", [](const PROJECT_NAMESPACE::DesignDB &db, PROJECT_NAMESPACE::IndexType level)
+                { auto ckts = db.levelCkts(level); return std::vector<PROJECT_NAMESPACE::IndexType>(ckts.begin(), ckts.end()); },
+                "Get the circuits at a level. They do not depend on each other")
+        .def("topoOrder", &PROJECT_NAMESPACE::DesignDB::topoOrder, "Get all the circuits, every circuit before its sub circuits")
+        .def("subtreeCkts", &PROJECT_NAMESPACE::DesignDB::subtreeCkts, "Get a circuit and the circuits under it bottom-up by level")
+        .def("finalize", &PROJECT_NAMESPACE::DesignDB::finalize, "Pack the connectivity of all the circuits")
+        .def("flatten", &PROJECT_NAMESPACE::DesignDB::flatten, "Expand the hierarchy under the root circuit down to the devices")
+        .def("computeStructHashes", &PROJECT_NAMESPACE::DesignDB::computeStructHashes, "Recompute the structural hashes of all the circuits")
+        .def("structHash", &PROJECT_NAMESPACE::DesignDB::structHash, "Get the structural hash of a circuit")
+        .def("structEquivClasses", &PROJECT_NAMESPACE::DesignDB::structEquivClasses, "Get the first structurally identical circuit of each circuit")
+        .def("dedupDevices", &PROJECT_NAMESPACE::DesignDB::dedupDevices, "Merge the identical device circuits. Return the number of unique devices. The circuits after the first merged one are renumbered, and the circuit, node and net objects taken before are invalid")
+        .def("shareIdenticalLayouts", &PROJECT_NAMESPACE::DesignDB::shareIdenticalLayouts, "Share one copy of the identical or mirrored layouts. Return the number of unique layouts")
+        .def("shareIdenticalLayout", &PROJECT_NAMESPACE::DesignDB::shareIdenticalLayout, "Share the layout of an earlier circuit passed here with an identical or mirrored layout, or offer its own. Return whether it is shared")
+        .def("propagateEdits", &PROJECT_NAMESPACE::DesignDB::propagateEdits, "Mark the edited circuits and their ancestors dirty. Return the number of dirty circuits")
+        .def("isDirty", &PROJECT_NAMESPACE::DesignDB::isDirty, "Whether a circuit or one of its descendants was edited")
+        .def("dirtyCkts", &PROJECT_NAMESPACE::DesignDB::dirtyCkts, "Get the dirty circuits")
+        .def("updateDirty", &PROJECT_NAMESPACE::DesignDB::updateDirty, "Refresh the packed connectivity and structural hashes of the dirty circuits")
+        .def("memoryReport", &PROJECT_NAMESPACE::DesignDB::memoryReport, py::arg("topN") = 10,
+             "Count the bytes held by the circuits, layouts, names and device properties")
+        .def("save", &PROJECT_NAMESPACE::DesignDB::save, "Save the design to a binary checkpoint")
+        .def("load", &PROJECT_NAMESPACE::DesignDB::load, py::arg("filename"), py::arg("lazyLayouts") = true,
+             "Replace the design by a binary checkpoint. The circuits fetched before are invalidated")
         .def_readwrite("power", &PROJECT_NAMESPACE::DesignDB::power)
         .def_readwrite("ground", &PROJECT_NAMESPACE::DesignDB::power)
+        .def("symbolTable", &PROJECT_NAMESPACE::DesignDB::symbolTable, py::return_value_policy::reference, "Get the symbol table of the names")
         .def("phyPropDB", &PROJECT_NAMESPACE::DesignDB::phyPropDB, py::return_value_policy::reference, "Get physical property DB");
 }
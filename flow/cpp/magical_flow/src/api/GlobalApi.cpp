@@ -12,6 +12,8 @@ namespace py = pybind11;
 
 void initGlobalAPI(py::module &m)
 {
+    m.attr("INDEX_TYPE_MAX") = PROJECT_NAMESPACE::INDEX_TYPE_MAX;
+
     // See https://stackoverflow.com/questions/47893832/pybind11-global-level-enum
     py::enum_<PROJECT_NAMESPACE::OriType>(m, "OriType")
         .value("OriTypeN", PROJECT_NAMESPACE::OriType::N)
@@ -38,6 +40,21 @@ void initGlobalAPI(py::module &m)
         .value("PSUB", PROJECT_NAMESPACE::PinType::PSUB)
         .value("NWELL", PROJECT_NAMESPACE::PinType::NWELL)
         .export_values();
+
+    py::enum_<PROJECT_NAMESPACE::NetFlag>(m, "NetFlag", py::arithmetic())
+        .value("VDD", PROJECT_NAMESPACE::NetFlag::VDD)
+        .value("VSS", PROJECT_NAMESPACE::NetFlag::VSS)
+        .value("DIGITAL", PROJECT_NAMESPACE::NetFlag::DIGITAL)
+        .value("ANALOG", PROJECT_NAMESPACE::NetFlag::ANALOG)
+        .value("IO", PROJECT_NAMESPACE::NetFlag::IO)
+        .export_values();
+
+    py::enum_<PROJECT_NAMESPACE::CktEditType>(m, "CktEditType")
+        .value("ADD_NODE", PROJECT_NAMESPACE::CktEditType::ADD_NODE)
+        .value("REMOVE_NODE", PROJECT_NAMESPACE::CktEditType::REMOVE_NODE)
+        .value("RECONNECT_PIN", PROJECT_NAMESPACE::CktEditType::RECONNECT_PIN)
+        .value("EDIT_PROP", PROJECT_NAMESPACE::CktEditType::EDIT_PROP)
+        .export_values();
  
     m.def("orientConv", &PROJECT_NAMESPACE::MfUtil::orientConv, "convert coordinates under different offset and orientation",
             py::arg_v("coord", PROJECT_NAMESPACE::XY<PROJECT_NAMESPACE::LocType>(0,0), "XYLoc(0, 0)"), 
@@ -20,7 +20,7 @@ void initGraphComponentsAPI(py::module &m)
         .def("setBBox", &PROJECT_NAMESPACE::GdsData::setBBox);
 
     py::class_<PROJECT_NAMESPACE::CktNode>(m , "CktNode")
-        .def(py::init<>())
+        .def_property_readonly("idx", &PROJECT_NAMESPACE::CktNode::idx)
         .def_property("graphIdx", &PROJECT_NAMESPACE::CktNode::subgraphIdx, &PROJECT_NAMESPACE::CktNode::setSubgraphIdx)
         .def("appendPinIdx", &PROJECT_NAMESPACE::CktNode::appendPinIdx)
         .def("numPins", &PROJECT_NAMESPACE::CktNode::numPins)
@@ -28,21 +28,24 @@ void initGraphComponentsAPI(py::module &m)
         .def_property("isImpl", &PROJECT_NAMESPACE::CktNode::isImpl, &PROJECT_NAMESPACE::CktNode::setIsImpl)
         .def_property("flipVertFlag", &PROJECT_NAMESPACE::CktNode::flipVertFlag, &PROJECT_NAMESPACE::CktNode::setFlipVertFlag)
         .def("isLeaf", &PROJECT_NAMESPACE::CktNode::isLeaf)
-        .def("offset", &PROJECT_NAMESPACE::CktNode::offset, py::return_value_policy::reference)
+        .def("offset", py::overload_cast<>(&PROJECT_NAMESPACE::CktNode::offset), py::return_value_policy::reference)
         .def("setOffset", &PROJECT_NAMESPACE::CktNode::setOffset)
         .def_property("implType", &PROJECT_NAMESPACE::CktNode::implType, &PROJECT_NAMESPACE::CktNode::setImplType)
         .def_property("refName", &PROJECT_NAMESPACE::CktNode::refName, &PROJECT_NAMESPACE::CktNode::setRefName)
         .def_property("name", &PROJECT_NAMESPACE::CktNode::name, &PROJECT_NAMESPACE::CktNode::setName)
+        .def_property_readonly("nameId", &PROJECT_NAMESPACE::CktNode::nameId)
+        .def_property_readonly("refNameId", &PROJECT_NAMESPACE::CktNode::refNameId)
         .def("setOrient", &PROJECT_NAMESPACE::CktNode::setOrient)
-        .def("orient", &PROJECT_NAMESPACE::CktNode::orient, py::return_value_policy::reference);
+        .def("orient", py::overload_cast<>(&PROJECT_NAMESPACE::CktNode::orient), py::return_value_policy::reference);
 
     py::class_<PROJECT_NAMESPACE::Net>(m, "Net")
-        .def(py::init<>())
+        .def_property_readonly("idx", &PROJECT_NAMESPACE::Net::idx)
         .def("appendPinIdx", &PROJECT_NAMESPACE::Net::appendPinIdx)
         .def("appendSubIdx", &PROJECT_NAMESPACE::Net::appendSubIdx)
         .def("numPins", &PROJECT_NAMESPACE::Net::numPins)
         .def("numSubs", &PROJECT_NAMESPACE::Net::numSubs)
         .def_property("name", &PROJECT_NAMESPACE::Net::name, &PROJECT_NAMESPACE::Net::setName)
+        .def_property_readonly("nameId", &PROJECT_NAMESPACE::Net::nameId)
         .def_property("ioPos", &PROJECT_NAMESPACE::Net::ioPos, &PROJECT_NAMESPACE::Net::setIoPos)
         .def("isIo", &PROJECT_NAMESPACE::Net::isIo)
         .def("isSub", &PROJECT_NAMESPACE::Net::isSub)
@@ -0,0 +1,31 @@
+/**
+ * @file ImplCacheAPI.cpp
+ * @brief The Python interface for ImplCache
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "db/DesignDB.h"
+#include "db/ImplCache.h"
+
+namespace py = pybind11;
+
+void initImplCacheAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::ImplCache>(m, "ImplCache")
+        .def(py::init<PROJECT_NAMESPACE::DesignDB &, const std::string &>(), py::keep_alive<1, 2>())
+        .def("computeFingerprint", &PROJECT_NAMESPACE::ImplCache::computeFingerprint,
+                "Fingerprint a circuit from its netlist, a salt of the other inputs and the fingerprints of its sub circuits")
+        .def("hasFingerprint", &PROJECT_NAMESPACE::ImplCache::hasFingerprint)
+        .def("fingerprint", &PROJECT_NAMESPACE::ImplCache::fingerprint)
+        .def("entryFile", &PROJECT_NAMESPACE::ImplCache::entryFile, "Get the file of the entry of a circuit")
+        .def("contains", &PROJECT_NAMESPACE::ImplCache::contains, "Whether the cache has the entry of a circuit")
+        .def("restore", &PROJECT_NAMESPACE::ImplCache::restore, py::arg("cktIdx"), py::arg("resultDir") = "",
+                "Restore the implementation of a circuit and write its result files into resultDir. False if the cache misses")
+        .def("store", &PROJECT_NAMESPACE::ImplCache::store, py::arg("cktIdx"), py::arg("resultDir") = "", py::arg("files") = std::vector<std::string>(),
+                "Store the implementation of a circuit and its result files, named relative to resultDir")
+        .def("numHits", &PROJECT_NAMESPACE::ImplCache::numHits)
+        .def("numMisses", &PROJECT_NAMESPACE::ImplCache::numMisses);
+}
@@ -0,0 +1,52 @@
+/**
+ * @file ImplSchedulerAPI.cpp
+ * @brief The Python interface for ImplScheduler
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/functional.h>
+#include "db/DesignDB.h"
+#include "db/ImplScheduler.h"
+
+namespace py = pybind11;
+
+void initImplSchedulerAPI(py::module &m)
+{
+    py::enum_<PROJECT_NAMESPACE::ImplTaskState>(m, "ImplTaskState")
+        .value("WAITING", PROJECT_NAMESPACE::ImplTaskState::WAITING)
+        .value("READY", PROJECT_NAMESPACE::ImplTaskState::READY)
+        .value("RUNNING", PROJECT_NAMESPACE::ImplTaskState::RUNNING)
+        .value("DONE", PROJECT_NAMESPACE::ImplTaskState::DONE)
+        .value("FAILED", PROJECT_NAMESPACE::ImplTaskState::FAILED);
+
+    py::class_<PROJECT_NAMESPACE::ImplScheduler>(m, "ImplScheduler")
+        .def(py::init<PROJECT_NAMESPACE::DesignDB &>(), py::keep_alive<1, 2>())
+        .def("addStage", [](PROJECT_NAMESPACE::ImplScheduler &scheduler, const std::string &name, py::function callback, bool barrier)
+                {
+                    // The workers run without the GIL. Take it only for the Python callback. None counts as success
+                    auto wrapped = [callback](PROJECT_NAMESPACE::IndexType cktIdx)
+                    {
+                        py::gil_scoped_acquire gil;
+                        py::object result = callback(cktIdx);
+                        return result.is_none() || result.cast<bool>();
+                    };
+                    return scheduler.addStage(name, wrapped, barrier);
+                },
+                py::arg("name"), py::arg("callback"), py::arg("barrier") = false,
+                "Append a stage. callback(cktIdx) implements the stage of a circuit and returns False on failure")
+        .def("build", &PROJECT_NAMESPACE::ImplScheduler::build, "Set the circuits to implement")
+        .def("run", &PROJECT_NAMESPACE::ImplScheduler::run, py::arg("numThreads") = 0, py::call_guard<py::gil_scoped_release>(),
+                "Run all the tasks on a worker pool, children before parents. Return whether all are done")
+        .def("numStages", &PROJECT_NAMESPACE::ImplScheduler::numStages)
+        .def("stageName", &PROJECT_NAMESPACE::ImplScheduler::stageName)
+        .def("ckts", &PROJECT_NAMESPACE::ImplScheduler::ckts, "Get the scheduled circuits")
+        .def("taskState", &PROJECT_NAMESPACE::ImplScheduler::taskState, "Get the state of a stage of a circuit")
+        .def("numTasks", &PROJECT_NAMESPACE::ImplScheduler::numTasks, "Get the number of tasks in a state")
+        .def("runningTasks", &PROJECT_NAMESPACE::ImplScheduler::runningTasks, "Get the (circuit, stage) of the running tasks")
+        .def("taskRuntime", &PROJECT_NAMESPACE::ImplScheduler::taskRuntime, "Get the wall time of a task in seconds")
+        .def("criticalPathRuntime", &PROJECT_NAMESPACE::ImplScheduler::criticalPathRuntime,
+                "Get the runtime of the longest chain of dependent tasks in the last run");
+}
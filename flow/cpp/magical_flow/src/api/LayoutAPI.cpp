@@ -34,13 +34,16 @@ void initLayoutAPI(py::module &m)
         .def(py::init())
         .def("init", &PROJECT_NAMESPACE::Layout::init)
         .def("clear", &PROJECT_NAMESPACE::Layout::clear)
-        .def("text", &PROJECT_NAMESPACE::Layout::text, py::return_value_policy::reference)
+        .def("text", py::overload_cast<PROJECT_NAMESPACE::IndexType, PROJECT_NAMESPACE::IndexType>(&PROJECT_NAMESPACE::Layout::text), py::return_value_policy::reference)
         .def("numLayers", &PROJECT_NAMESPACE::Layout::numLayers, py::return_value_policy::reference)
         .def("numRects", &PROJECT_NAMESPACE::Layout::numRects, py::return_value_policy::reference)
         .def("boundary", &PROJECT_NAMESPACE::Layout::boundary, py::return_value_policy::reference)
         .def("setBoundary", &PROJECT_NAMESPACE::Layout::setBoundary, py::return_value_policy::reference)
-        .def("rect", &PROJECT_NAMESPACE::Layout::rect, py::return_value_policy::reference)
+        .def("rect", py::overload_cast<PROJECT_NAMESPACE::IndexType, PROJECT_NAMESPACE::IndexType>(&PROJECT_NAMESPACE::Layout::rect), py::return_value_policy::reference)
         .def("insertLayout", &PROJECT_NAMESPACE::Layout::insertLayout)
+        .def("flipVert", &PROJECT_NAMESPACE::Layout::flipVert, "Mirror the layout about the vertical center line of the boundary")
+        .def("hash", &PROJECT_NAMESPACE::Layout::hash, py::arg("flipVertFlag") = false, "Hash the layout, or its mirror")
+        .def("equals", &PROJECT_NAMESPACE::Layout::equals, py::arg("other"), py::arg("flipVertFlag") = false, "Whether the layout equals another one, or its mirror")
         .def("setRectDatatype", &PROJECT_NAMESPACE::Layout::setRectDatatype)
         .def("insertText", py::overload_cast<PROJECT_NAMESPACE::IndexType, const PROJECT_NAMESPACE::TextLayout &>(&PROJECT_NAMESPACE::Layout::insertText), "Insert a text object in the layout")
         .def("insertText", py::overload_cast<PROJECT_NAMESPACE::IndexType, const std::string &, const PROJECT_NAMESPACE::XY<PROJECT_NAMESPACE::LocType> &>
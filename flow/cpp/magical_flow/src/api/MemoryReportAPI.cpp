@@ -0,0 +1,42 @@
+/**
+ * @file MemoryReportAPI.cpp
+ * @brief The Python interface for MemoryReport
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include "db/DesignDB.h"
+
+namespace py = pybind11;
+
+void initMemoryReportAPI(py::module &m)
+{
+    py::class_<PROJECT_NAMESPACE::CktMemory>(m, "CktMemory")
+        .def_readonly("cktIdx", &PROJECT_NAMESPACE::CktMemory::cktIdx)
+        .def_property_readonly("name", [](const PROJECT_NAMESPACE::CktMemory &usage) { return PROJECT_NAMESPACE::SymbolTable::global().str(usage.nameId); })
+        .def_readonly("graph", &PROJECT_NAMESPACE::CktMemory::graph, "The CktGraph object itself")
+        .def_readonly("nodes", &PROJECT_NAMESPACE::CktMemory::nodes)
+        .def_readonly("pins", &PROJECT_NAMESPACE::CktMemory::pins)
+        .def_readonly("nets", &PROJECT_NAMESPACE::CktMemory::nets)
+        .def_readonly("connectivity", &PROJECT_NAMESPACE::CktMemory::connectivity, "The packed connectivity, name indexes and journal")
+        .def_readonly("layout", &PROJECT_NAMESPACE::CktMemory::layout, "The layout. A shared layout is counted for the first circuit sharing it")
+        .def_readonly("strings", &PROJECT_NAMESPACE::CktMemory::strings)
+        .def_readonly("tech", &PROJECT_NAMESPACE::CktMemory::tech, "The copy of the TechDB")
+        .def("total", &PROJECT_NAMESPACE::CktMemory::total);
+
+    py::class_<PROJECT_NAMESPACE::MemoryReport>(m, "MemoryReport")
+        .def_readonly("ckts", &PROJECT_NAMESPACE::MemoryReport::ckts, "The bytes of each circuit, by circuit index")
+        .def_readonly("layoutLayers", &PROJECT_NAMESPACE::MemoryReport::layoutLayers, "The bytes of each layer in all the layouts")
+        .def_readonly("layoutTables", &PROJECT_NAMESPACE::MemoryReport::layoutTables)
+        .def_readonly("processSymbols", &PROJECT_NAMESPACE::MemoryReport::processSymbols, "The process-wide symbol table of the names, shared by every design and not in total()")
+        .def_readonly("phyProps", &PROJECT_NAMESPACE::MemoryReport::phyProps)
+        .def_readonly("design", &PROJECT_NAMESPACE::MemoryReport::design)
+        .def_readonly("numSharedLayouts", &PROJECT_NAMESPACE::MemoryReport::numSharedLayouts)
+        .def_readonly("numUnloadedLayouts", &PROJECT_NAMESPACE::MemoryReport::numUnloadedLayouts)
+        .def_readonly("heaviest", &PROJECT_NAMESPACE::MemoryReport::heaviest, "The heaviest circuits, heaviest first")
+        .def("cktTotal", &PROJECT_NAMESPACE::MemoryReport::cktTotal)
+        .def("total", &PROJECT_NAMESPACE::MemoryReport::total)
+        .def("log", &PROJECT_NAMESPACE::MemoryReport::log, "Write the report to the log");
+}
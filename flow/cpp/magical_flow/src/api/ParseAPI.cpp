@@ -15,4 +15,5 @@ namespace py = pybind11;
 void initParseAPI(py::module &m)
 {
     m.def("parseSimpleTechFile", &PROJECT_NAMESPACE::PARSE::parseSimpleTechFile, "Parse simple tech file");
+    m.def("parseLefFile", &PROJECT_NAMESPACE::PARSE::parseLefFile, "Parse the layers, vias and macros in a LEF file");
 }
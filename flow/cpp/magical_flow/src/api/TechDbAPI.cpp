@@ -17,11 +17,60 @@ void initTechDbAPI(py::module &m)
         .def(py::init())
         .def_property("dbu", &PROJECT_NAMESPACE::TechUnit::dbu, &PROJECT_NAMESPACE::TechUnit::setDbu);
 
+    py::class_<PROJECT_NAMESPACE::LefShape>(m, "LefShape")
+        .def(py::init<>())
+        .def_readonly("dbLayer", &PROJECT_NAMESPACE::LefShape::dbLayer)
+        .def_readonly("rect", &PROJECT_NAMESPACE::LefShape::rect);
+
+    py::class_<PROJECT_NAMESPACE::LefLayer>(m, "LefLayer")
+        .def(py::init<>())
+        .def_readonly("name", &PROJECT_NAMESPACE::LefLayer::name)
+        .def_readonly("type", &PROJECT_NAMESPACE::LefLayer::type)
+        .def_readonly("direction", &PROJECT_NAMESPACE::LefLayer::direction)
+        .def_readonly("pitch", &PROJECT_NAMESPACE::LefLayer::pitch)
+        .def_readonly("width", &PROJECT_NAMESPACE::LefLayer::width)
+        .def_readonly("spacing", &PROJECT_NAMESPACE::LefLayer::spacing)
+        .def_readonly("area", &PROJECT_NAMESPACE::LefLayer::area)
+        .def_readonly("dbLayer", &PROJECT_NAMESPACE::LefLayer::dbLayer);
+
+    py::class_<PROJECT_NAMESPACE::LefVia>(m, "LefVia")
+        .def(py::init<>())
+        .def_readonly("name", &PROJECT_NAMESPACE::LefVia::name)
+        .def_readonly("isDefault", &PROJECT_NAMESPACE::LefVia::isDefault)
+        .def_readonly("shapes", &PROJECT_NAMESPACE::LefVia::shapes);
+
+    py::class_<PROJECT_NAMESPACE::LefPin>(m, "LefPin")
+        .def(py::init<>())
+        .def_readonly("name", &PROJECT_NAMESPACE::LefPin::name)
+        .def_readonly("direction", &PROJECT_NAMESPACE::LefPin::direction)
+        .def_readonly("use", &PROJECT_NAMESPACE::LefPin::use)
+        .def_readonly("shapes", &PROJECT_NAMESPACE::LefPin::shapes);
+
+    py::class_<PROJECT_NAMESPACE::LefMacro>(m, "LefMacro")
+        .def(py::init<>())
+        .def_readonly("name", &PROJECT_NAMESPACE::LefMacro::name)
+        .def_readonly("macroClass", &PROJECT_NAMESPACE::LefMacro::macroClass)
+        .def_readonly("origin", &PROJECT_NAMESPACE::LefMacro::origin)
+        .def_readonly("width", &PROJECT_NAMESPACE::LefMacro::width)
+        .def_readonly("height", &PROJECT_NAMESPACE::LefMacro::height)
+        .def_readonly("pins", &PROJECT_NAMESPACE::LefMacro::pins)
+        .def_readonly("obs", &PROJECT_NAMESPACE::LefMacro::obs);
+
     py::class_<PROJECT_NAMESPACE::TechDB>(m, "TechDB")
         .def(py::init())
         .def("units", &PROJECT_NAMESPACE::TechDB::units, py::return_value_policy::reference, "Get units for techDB")
         .def("numLayers", &PROJECT_NAMESPACE::TechDB::numLayers, "Get the number of layers")
         .def("dbLayerToPdk", &PROJECT_NAMESPACE::TechDB::dbLayerToPdk, "Convert db layer index to pdk layer ID")
-        .def("pdkLayerToDb", &PROJECT_NAMESPACE::TechDB::pdkLayerToDb, "Convert PDK layer ID to db layer index")
-        .def("layerNameToIdx", &PROJECT_NAMESPACE::TechDB::layerNameToIdx, "Convert layer name to db layer index");
+        .def("dbLayerToPdkDatatype", &PROJECT_NAMESPACE::TechDB::dbLayerToPdkDatatype, "Convert the datatype of a shape on a db layer to PDK datatype")
+        .def("pdkLayerToDb", py::overload_cast<PROJECT_NAMESPACE::IndexType>(&PROJECT_NAMESPACE::TechDB::pdkLayerToDb, py::const_), "Convert PDK layer ID to db layer index")
+        .def("pdkLayerToDb", py::overload_cast<PROJECT_NAMESPACE::IndexType, PROJECT_NAMESPACE::IndexType>(&PROJECT_NAMESPACE::TechDB::pdkLayerToDb, py::const_), "Convert PDK (layer, datatype) to db layer index")
+        .def("pdkDatatypeToDb", &PROJECT_NAMESPACE::TechDB::pdkDatatypeToDb, "Convert PDK datatype on a db layer to the datatype stored in layout")
+        .def("layerNameToIdx", &PROJECT_NAMESPACE::TechDB::layerNameToIdx, "Convert layer name to db layer index")
+        .def("findLayer", &PROJECT_NAMESPACE::TechDB::findLayer, "Find the db layer index of a layer name. INDEX_TYPE_MAX if not found")
+        .def("numLefLayers", &PROJECT_NAMESPACE::TechDB::numLefLayers, "Get the number of LEF layers")
+        .def("numLefVias", &PROJECT_NAMESPACE::TechDB::numLefVias, "Get the number of LEF vias")
+        .def("numLefMacros", &PROJECT_NAMESPACE::TechDB::numLefMacros, "Get the number of LEF macros")
+        .def("lefLayer", &PROJECT_NAMESPACE::TechDB::lefLayer, py::return_value_policy::reference, "Get a LEF layer")
+        .def("lefVia", &PROJECT_NAMESPACE::TechDB::lefVia, py::return_value_policy::reference, "Get a LEF via")
+        .def("lefMacro", &PROJECT_NAMESPACE::TechDB::lefMacro, py::return_value_policy::reference, "Get a LEF macro");
 }
@@ -8,6 +8,7 @@
 
 #include <pybind11/pybind11.h>
 #include "util/XY.h"
+#include "util/Hash.h"
 #include "global/global.h"
 
 namespace py = pybind11;
@@ -32,4 +33,8 @@ void initUtilAPI(py::module &m)
         .def_property("yHi", &PROJECT_NAMESPACE::Box<PROJECT_NAMESPACE::LocType>::yHi, &PROJECT_NAMESPACE::Box<PROJECT_NAMESPACE::LocType>::setYHi)
         .def("xLen", &PROJECT_NAMESPACE::Box<PROJECT_NAMESPACE::LocType>::xLen)
         .def("yLen", &PROJECT_NAMESPACE::Box<PROJECT_NAMESPACE::LocType>::yLen);
+
+    m.def("hashString", &PROJECT_NAMESPACE::HashUtil::hashString, "Hash a string. The same across runs");
+    m.def("hashFile", &PROJECT_NAMESPACE::HashUtil::hashFile, "Hash the contents of a file. 0 if it cannot be read");
+    m.def("combineHash", &PROJECT_NAMESPACE::HashUtil::combine, "Combine a value into a running hash");
 }
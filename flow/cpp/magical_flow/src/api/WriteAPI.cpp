@@ -14,5 +14,8 @@ namespace py = pybind11;
 
 void initWriterAPI(py::module &m)
 {
-    m.def("writeGdsLayout", &PROJECT_NAMESPACE::WRITER::writeGdsLayout, "write the layout for circuit to GDSII");
+    m.def("writeGdsLayout", py::overload_cast<PROJECT_NAMESPACE::IndexType, const std::string &, PROJECT_NAMESPACE::DesignDB &, PROJECT_NAMESPACE::TechDB &>(&PROJECT_NAMESPACE::WRITER::writeGdsLayout),
+            "write the layout for circuit to GDSII");
+    m.def("writeGdsLayout", py::overload_cast<PROJECT_NAMESPACE::IndexType, const std::string &, PROJECT_NAMESPACE::DesignDB &, PROJECT_NAMESPACE::TechDB &, PROJECT_NAMESPACE::ArtifactStore &>(&PROJECT_NAMESPACE::WRITER::writeGdsLayout),
+            "write the layout for circuit to GDSII through an artifact store");
 }
@@ -22,6 +22,10 @@ void initParseAPI(py::module &);
 void initWriterAPI(py::module &);
 void initTechDbAPI(py::module &);
 void initCSFlowAPI(py::module &);
+void initImplSchedulerAPI(py::module &);
+void initImplCacheAPI(py::module &);
+void initArtifactStoreAPI(py::module &);
+void initMemoryReportAPI(py::module &);
 
 PYBIND11_MAKE_OPAQUE(std::vector<PROJECT_NAMESPACE::IndexType>);
 
@@ -38,4 +42,8 @@ PYBIND11_MODULE(magicalFlow, m)
     initWriterAPI(m);
     initTechDbAPI(m);
     initCSFlowAPI(m);
+    initImplSchedulerAPI(m);
+    initImplCacheAPI(m);
+    initArtifactStoreAPI(m);
+    initMemoryReportAPI(m);
 }
@@ -5,6 +5,8 @@
  * @date 03/30/2020
  */
 
+#include <algorithm>
+#include <array>
 #include <queue>
 #include <set>
 
@@ -12,132 +14,499 @@
 
 PROJECT_NAMESPACE_BEGIN
 
+namespace {
+  /// @brief whether a pin is the drain (0) or the source (2) terminal of its node
+  inline bool isTerminal(const CktGraph& ckt, const IndexType pinIdx, const IndexType terminal) {
+    const Span<const IndexType> nodePins = ckt.nodePins(ckt.pinNode(pinIdx));
+    return nodePins.size() > terminal and nodePins[terminal] == pinIdx;
+  }
+}
+
 void CSFlow::computeCurrentFlow(CktGraph& ckt) {
-  for (IndexType i = 0; i < ckt.numPins(); ++i) {
-    Pin& pin1 = ckt.pin(i);
-    Net& net1 = ckt.net(pin1.netIdx());
-    CktNode& node1 = ckt.node(pin1.nodeIdx());
-
-    ImplType implType1 = getCktNodeImplType(node1);
-    
-    if (implType1 == ImplType::PCELL_Pch
-        and i == node1.pinIdx(2)
-        and net1.isVdd()) {
-      for (IndexType j = 0; j < ckt.numPins(); ++j) {
-        Pin& pin2 = ckt.pin(j);
-        Net& net2 = ckt.net(pin2.netIdx());
-        CktNode& node2 = ckt.node(pin2.nodeIdx());
-        ImplType implType2 = getCktNodeImplType(node2);
-        if (implType2 == ImplType::PCELL_Nch
-            and j == node2.pinIdx(2)
-            and net2.isVss()) {
-          std::vector<std::string> pinNames;
-          std::vector<std::string> cellNames;
-          std::vector<unsigned char> visited(ckt.numPins(), 0);
-          currentDFS(ckt, i, j, visited, pinNames, cellNames);
-        }
+  if (!ckt.isFinalized()) {
+    ckt.finalize();
+  }
+  _currentCkt = &ckt;
+  _currentPathStart.assign(1, 0);
+  _currentPathPin.clear();
+  _currentPathNode.clear();
+  const IndexType numPins = ckt.numPins();
+  std::vector<ImplType> nodeImpl;
+  nodeImpl.reserve(ckt.numNodes());
+  for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx) {
+    nodeImpl.emplace_back(getCktNodeImplType(ckt.node(nodeIdx)));
+  }
+  buildCurrentArcs(ckt, nodeImpl);
+
+  // Sources: the PMOS sources on VDD. Sinks: the NMOS sources on VSS, ranked by pin index
+  std::vector<IndexType> sources, sinks;
+  std::vector<IndexType> sinkRank(numPins, INDEX_TYPE_MAX);
+  for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx) {
+    const IndexType netIdx = ckt.pinNet(pinIdx);
+    if (netIdx == INDEX_TYPE_MAX or !isTerminal(ckt, pinIdx, 2)) {
+      continue;
+    }
+    const ImplType implType = nodeImpl[ckt.pinNode(pinIdx)];
+    if (implType == ImplType::PCELL_Pch and ckt.net(netIdx).isVdd()) {
+      sources.emplace_back(pinIdx);
+    }
+    else if (implType == ImplType::PCELL_Nch and ckt.net(netIdx).isVss()) {
+      sinkRank[pinIdx] = sinks.size();
+      sinks.emplace_back(pinIdx);
+    }
+  }
+  // The pins no sink is reachable from only lead to dead ends
+  std::vector<unsigned char> reachable;
+  markSinkReachable(sinks, reachable);
+
+  // One DFS over the simple paths from the sources, as if from a virtual source feeding them all.
+  // Every sink reached closes a path. The sinks have no arcs, so the paths end there
+  std::vector<unsigned char> visited(numPins, 0);
+  std::vector<IndexType> pinPath; // the pins on the path
+  std::vector<IndexType> arcCursor; // arcCursor[k] = the next arc to follow from pinPath[k]
+  std::vector<std::pair<IndexType, IndexType>> found; // (sink rank, path index) of the paths from one source
+  std::vector<IndexType> sortedPin, sortedNode, sortedLength; // the paths of one source reordered
+  for (IndexType srcIdx : sources) {
+    if (!reachable[srcIdx]) {
+      continue;
+    }
+    const IndexType firstPath = numCurrentPaths();
+    found.clear();
+    visited[srcIdx] = 1;
+    pinPath.assign(1, srcIdx);
+    arcCursor.assign(1, _arcStart[srcIdx]);
+    while (!pinPath.empty()) {
+      const IndexType pinIdx = pinPath.back();
+      if (arcCursor.back() == _arcStart[pinIdx + 1]) {
+        visited[pinIdx] = 0;
+        pinPath.pop_back();
+        arcCursor.pop_back();
+        continue;
+      }
+      const IndexType nextIdx = _arcPin[arcCursor.back()++];
+      if (visited[nextIdx] or !reachable[nextIdx]) {
+        continue;
+      }
+      pinPath.emplace_back(nextIdx);
+      if (sinkRank[nextIdx] != INDEX_TYPE_MAX) {
+        found.emplace_back(sinkRank[nextIdx], numCurrentPaths());
+        appendCurrentPath(ckt, pinPath);
+        pinPath.pop_back();
+        continue;
       }
+      visited[nextIdx] = 1;
+      arcCursor.emplace_back(_arcStart[nextIdx]);
+    }
+    // Keep the paths of a source ordered by sink, and in DFS order for each sink, as the pairwise search did
+    auto byRank = [](const std::pair<IndexType, IndexType>& lhs, const std::pair<IndexType, IndexType>& rhs) {
+      return lhs.first < rhs.first;
+    };
+    if (std::is_sorted(found.begin(), found.end(), byRank)) {
+      continue;
+    }
+    std::stable_sort(found.begin(), found.end(), byRank);
+    const IndexType firstPin = _currentPathStart[firstPath];
+    sortedPin.clear();
+    sortedNode.clear();
+    sortedLength.clear();
+    for (const auto& pathRank : found) {
+      const IndexType begin = _currentPathStart[pathRank.second];
+      const IndexType end = _currentPathStart[pathRank.second + 1];
+      sortedPin.insert(sortedPin.end(), _currentPathPin.begin() + begin, _currentPathPin.begin() + end);
+      sortedNode.insert(sortedNode.end(), _currentPathNode.begin() + begin, _currentPathNode.begin() + end);
+      sortedLength.emplace_back(end - begin);
+    }
+    for (IndexType pathIdx = firstPath; pathIdx < numCurrentPaths(); ++pathIdx) {
+      _currentPathStart[pathIdx + 1] = _currentPathStart[pathIdx] + sortedLength[pathIdx - firstPath];
     }
+    std::copy(sortedPin.begin(), sortedPin.end(), _currentPathPin.begin() + firstPin);
+    std::copy(sortedNode.begin(), sortedNode.end(), _currentPathNode.begin() + firstPin);
   }
-  //for (auto& vec : _currentCellPaths) {
-    //for (auto pinIdx : vec) {
-      //std::cerr << pinIdx << " ";
-    //}
-    //std::cerr << std::endl;
-  //}
 }
 
-void CSFlow::currentDFS(CktGraph& ckt, const IndexType sPinIdx, const IndexType tPinIdx, std::vector<unsigned char>& visited, std::vector<std::string>& pinNames, std::vector<std::string>& cellNames) {
-  Pin& pin = ckt.pin(sPinIdx);
-  Net& net = ckt.net(pin.netIdx());
-  CktNode& node = ckt.node(pin.nodeIdx());
+void CSFlow::buildCurrentArcs(CktGraph& ckt, const std::vector<ImplType>& nodeImpl) {
+  const IndexType numPins = ckt.numPins();
+  _arcStart.assign(1, 0);
+  _arcStart.reserve(numPins + 1);
+  _arcPin.clear();
+  for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx) {
+    const Span<const IndexType> nodePins = ckt.nodePins(ckt.pinNode(pinIdx));
+    const IndexType netIdx = ckt.pinNet(pinIdx);
+    const ImplType implType = nodeImpl[ckt.pinNode(pinIdx)];
+    if (nodePins.size() > 2 and netIdx != INDEX_TYPE_MAX) {
+      switch (implType) {
+        case ImplType::PCELL_Pch:
+        {
+          // source -> drain
+          if (pinIdx == nodePins[2]) {
+            _arcPin.emplace_back(nodePins[0]);
+          }
+          // drain -> PMOS sources and NMOS drains on the net
+          else if (pinIdx == nodePins[0]) {
+            for (IndexType adjPinIdx : ckt.netPins(netIdx)) {
+              const ImplType adjImpl = nodeImpl[ckt.pinNode(adjPinIdx)];
+              if ((adjImpl == ImplType::PCELL_Pch and isTerminal(ckt, adjPinIdx, 2))
+                  or (adjImpl == ImplType::PCELL_Nch and isTerminal(ckt, adjPinIdx, 0))) {
+                _arcPin.emplace_back(adjPinIdx);
+              }
+            }
+          }
+          // gate or body
+          break;
+        }
+        case ImplType::PCELL_Nch:
+        {
+          // drain -> source
+          if (pinIdx == nodePins[0]) {
+            _arcPin.emplace_back(nodePins[2]);
+          }
+          // source -> NMOS drains on the net, unless it is VSS
+          else if (pinIdx == nodePins[2] and !ckt.net(netIdx).isVss()) {
+            for (IndexType adjPinIdx : ckt.netPins(netIdx)) {
+              if (nodeImpl[ckt.pinNode(adjPinIdx)] == ImplType::PCELL_Nch and isTerminal(ckt, adjPinIdx, 0)) {
+                _arcPin.emplace_back(adjPinIdx);
+              }
+            }
+          }
+          // gate or body
+          break;
+        }
+        default:
+          break;
+      }
+    }
+    _arcStart.emplace_back(_arcPin.size());
+  }
+}
 
-  const auto &pinName = _db.subCkt(node.subgraphIdx()).net(pin.intNetIdx()).name();
-  
-  visited[sPinIdx] = 1;
-  pinNames.emplace_back(pinName);
-  cellNames.emplace_back(node.name());
+void CSFlow::markSinkReachable(const std::vector<IndexType>& sinks, std::vector<unsigned char>& reachable) const {
+  // Reverse the arcs and search back from the sinks
+  const IndexType numPins = _arcStart.size() - 1;
+  std::vector<IndexType> revStart(numPins + 1, 0);
+  for (IndexType pinIdx : _arcPin) {
+    ++revStart[pinIdx + 1];
+  }
+  for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx) {
+    revStart[pinIdx + 1] += revStart[pinIdx];
+  }
+  std::vector<IndexType> revPin(_arcPin.size());
+  std::vector<IndexType> fill(revStart.begin(), revStart.end() - 1);
+  for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx) {
+    for (IndexType arc = _arcStart[pinIdx]; arc < _arcStart[pinIdx + 1]; ++arc) {
+      revPin[fill[_arcPin[arc]]++] = pinIdx;
+    }
+  }
+  reachable.assign(numPins, 0);
+  std::vector<IndexType> queue(sinks.begin(), sinks.end());
+  for (IndexType sinkIdx : sinks) {
+    reachable[sinkIdx] = 1;
+  }
+  for (IndexType head = 0; head < queue.size(); ++head) {
+    const IndexType pinIdx = queue[head];
+    for (IndexType arc = revStart[pinIdx]; arc < revStart[pinIdx + 1]; ++arc) {
+      if (!reachable[revPin[arc]]) {
+        reachable[revPin[arc]] = 1;
+        queue.emplace_back(revPin[arc]);
+      }
+    }
+  }
+}
 
-  if (sPinIdx == tPinIdx) {
-    _currentPinPaths.emplace_back(pinNames);
-    _currentCellPaths.emplace_back(cellNames);
-    visited[sPinIdx] = 0;
-    pinNames.pop_back();
-    cellNames.pop_back();
-    return;
+void CSFlow::appendCurrentPath(const CktGraph& ckt, const std::vector<IndexType>& pinPath) {
+  for (IndexType pinIdx : pinPath) {
+    _currentPathPin.emplace_back(pinIdx);
+    _currentPathNode.emplace_back(ckt.pinNode(pinIdx));
   }
+  _currentPathStart.emplace_back(_currentPathPin.size());
+}
 
+void CSFlow::computeSignalFlow(CktGraph& ckt) {
+  if (!ckt.isFinalized()) {
+    ckt.finalize();
+  }
+  _signalCkt = &ckt;
+  _signalPathStart.assign(1, 0);
+  _signalPathPin.clear();
+  _signalPathNode.clear();
+  const IndexType numNets = ckt.numNets();
+  std::vector<ImplType> nodeImpl;
+  nodeImpl.reserve(ckt.numNodes());
+  for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx) {
+    nodeImpl.emplace_back(getCktNodeImplType(ckt.node(nodeIdx)));
+  }
+  std::vector<unsigned char> isOutput;
+  buildSignalArcs(ckt, nodeImpl, isOutput);
 
-  std::vector<IndexType> adjPins;
- 
-  ImplType implType = getCktNodeImplType(node);
+  // Fold the feedback loops into components. Tarjan numbers them in reverse topological order
+  std::vector<IndexType> comp;
+  const IndexType numComps = condenseSignalArcs(comp);
+  std::vector<IndexType> compStart(numComps + 1, 0);
+  for (IndexType netIdx = 0; netIdx < numNets; ++netIdx) {
+    ++compStart[comp[netIdx] + 1];
+  }
+  for (IndexType compIdx = 0; compIdx < numComps; ++compIdx) {
+    compStart[compIdx + 1] += compStart[compIdx];
+  }
+  std::vector<IndexType> compNet(numNets);
+  std::vector<IndexType> fill(compStart.begin(), compStart.end() - 1);
+  for (IndexType netIdx = 0; netIdx < numNets; ++netIdx) {
+    compNet[fill[comp[netIdx]]++] = netIdx;
+  }
 
-  switch (implType) {
-    case ImplType::PCELL_Pch:
-    {
-        
-      // source -> drain
-      if (sPinIdx == node.pinIdx(2)) {
-        if (!visited[node.pinIdx(0)])
-          adjPins.emplace_back(node.pinIdx(0));
+  // Levelize from the inputs: the IO nets that are not power and no MOS drains onto.
+  // A component takes the deepest level it is entered at, and spreads it inside breadth-first
+  _signalNetLevel.assign(numNets, INDEX_TYPE_MAX);
+  std::vector<IndexType> predArc(numNets, INDEX_TYPE_MAX); // the arc a net is reached by
+  for (IndexType netIdx = 0; netIdx < numNets; ++netIdx) {
+    const Net net = ckt.net(netIdx);
+    if (net.isIo() and !net.isPower() and !isOutput[netIdx]) {
+      _signalNetLevel[netIdx] = 0;
+    }
+  }
+  std::vector<IndexType> queue;
+  for (IndexType compIdx = numComps; compIdx-- > 0; ) {
+    queue.clear();
+    for (IndexType idx = compStart[compIdx]; idx < compStart[compIdx + 1]; ++idx) {
+      if (_signalNetLevel[compNet[idx]] != INDEX_TYPE_MAX) {
+        queue.emplace_back(compNet[idx]);
       }
-      // drain -> other
-      else if (sPinIdx == node.pinIdx(0)) {
-        for (IndexType pinIdx : net.pinIdxArray()) {
-          if (!visited[pinIdx]) {
-            CktNode& adjNode = ckt.node(ckt.pin(pinIdx).nodeIdx());
-            ImplType adjNodeImpl = getCktNodeImplType(adjNode);
-            if ((adjNodeImpl == ImplType::PCELL_Pch and pinIdx == adjNode.pinIdx(2))
-                or (adjNodeImpl == ImplType::PCELL_Nch and pinIdx == adjNode.pinIdx(0)))
-              adjPins.emplace_back(pinIdx);
-          }
-        }  
+    }
+    for (IndexType head = 0; head < queue.size(); ++head) {
+      const IndexType netIdx = queue[head];
+      for (IndexType arc = _sigArcStart[netIdx]; arc < _sigArcStart[netIdx + 1]; ++arc) {
+        const IndexType nextIdx = _sigArcNet[arc];
+        if (comp[nextIdx] == compIdx and _signalNetLevel[nextIdx] == INDEX_TYPE_MAX) {
+          _signalNetLevel[nextIdx] = _signalNetLevel[netIdx] + 1;
+          predArc[nextIdx] = arc;
+          queue.emplace_back(nextIdx);
+        }
+      }
+    }
+    // The arcs leaving the component enter the later ones. The inputs stay at level 0
+    for (IndexType netIdx : queue) {
+      for (IndexType arc = _sigArcStart[netIdx]; arc < _sigArcStart[netIdx + 1]; ++arc) {
+        const IndexType nextIdx = _sigArcNet[arc];
+        const IndexType nextLevel = _signalNetLevel[nextIdx];
+        if (comp[nextIdx] != compIdx
+            and (nextLevel == INDEX_TYPE_MAX or (nextLevel != 0 and _signalNetLevel[netIdx] + 1 > nextLevel))) {
+          _signalNetLevel[nextIdx] = _signalNetLevel[netIdx] + 1;
+          predArc[nextIdx] = arc;
+        }
       }
-      // gate or body
-      else {
+    }
+  }
+
+  // One path per reached output, through its deepest chain of devices
+  for (IndexType netIdx = 0; netIdx < numNets; ++netIdx) {
+    if (isOutput[netIdx] and _signalNetLevel[netIdx] != INDEX_TYPE_MAX and _signalNetLevel[netIdx] > 0) {
+      appendSignalPath(ckt, predArc, netIdx);
+    }
+  }
+}
+
+void CSFlow::buildSignalArcs(CktGraph& ckt, const std::vector<ImplType>& nodeImpl, std::vector<unsigned char>& isOutput) {
+  const IndexType numNets = ckt.numNets();
+  isOutput.assign(numNets, 0);
+  auto isSignal = [&](const IndexType netIdx) {
+    return netIdx != INDEX_TYPE_MAX and !ckt.net(netIdx).isPower();
+  };
+  // (net, net, pin, pin) of the arcs, in node order
+  std::vector<std::array<IndexType, 4>> arcs;
+  for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx) {
+    const Span<const IndexType> nodePins = ckt.nodePins(nodeIdx);
+    switch (nodeImpl[nodeIdx]) {
+      case ImplType::PCELL_Nch:
+      case ImplType::PCELL_Pch:
+      {
+        // gate -> drain. Pins are (d, g, s, ...)
+        if (nodePins.size() < 3) {
+          break;
+        }
+        const IndexType drainNet = ckt.pinNet(nodePins[0]);
+        const IndexType gateNet = ckt.pinNet(nodePins[1]);
+        if (!isSignal(drainNet)) {
+          break;
+        }
+        if (ckt.net(drainNet).isIo()) {
+          isOutput[drainNet] = 1;
+        }
+        if (isSignal(gateNet) and gateNet != drainNet) {
+          arcs.push_back({ gateNet, drainNet, nodePins[1], nodePins[0] });
+        }
+        break;
       }
-      break;
-    }
-    case ImplType::PCELL_Nch:
-    {
-      // drain -> source
-      if (sPinIdx == node.pinIdx(0)) {
-        if (!visited[node.pinIdx(2)])
-          adjPins.emplace_back(node.pinIdx(2));
+      case ImplType::PCELL_Res:
+      case ImplType::PCELL_Cap:
+      {
+        // The signal passes both ways
+        if (nodePins.size() < 2) {
+          break;
+        }
+        const IndexType net0 = ckt.pinNet(nodePins[0]);
+        const IndexType net1 = ckt.pinNet(nodePins[1]);
+        if (isSignal(net0) and isSignal(net1) and net0 != net1) {
+          arcs.push_back({ net0, net1, nodePins[0], nodePins[1] });
+          arcs.push_back({ net1, net0, nodePins[1], nodePins[0] });
+        }
+        break;
       }
-      // source -> other
-      else if (sPinIdx == node.pinIdx(2)) {
-        for (IndexType pinIdx : net.pinIdxArray()) {
-          if (!net.isVss() and !visited[pinIdx]) {
-            CktNode& adjNode = ckt.node(ckt.pin(pinIdx).nodeIdx());
-            ImplType adjNodeImpl = getCktNodeImplType(adjNode);
-            if (adjNodeImpl == ImplType::PCELL_Nch and pinIdx == adjNode.pinIdx(0))
-              adjPins.emplace_back(pinIdx);
-          }
+      default:
+        // The sub circuits are opaque
+        break;
+    }
+  }
+  _sigArcStart.assign(numNets + 1, 0);
+  for (const auto& arc : arcs) {
+    ++_sigArcStart[arc[0] + 1];
+  }
+  for (IndexType netIdx = 0; netIdx < numNets; ++netIdx) {
+    _sigArcStart[netIdx + 1] += _sigArcStart[netIdx];
+  }
+  _sigArcNet.resize(arcs.size());
+  _sigArcFromPin.resize(arcs.size());
+  _sigArcToPin.resize(arcs.size());
+  std::vector<IndexType> fill(_sigArcStart.begin(), _sigArcStart.end() - 1);
+  for (const auto& arc : arcs) {
+    const IndexType arcIdx = fill[arc[0]]++;
+    _sigArcNet[arcIdx] = arc[1];
+    _sigArcFromPin[arcIdx] = arc[2];
+    _sigArcToPin[arcIdx] = arc[3];
+  }
+}
+
+IndexType CSFlow::condenseSignalArcs(std::vector<IndexType>& comp) const {
+  // Iterative Tarjan
+  const IndexType numNets = _sigArcStart.size() - 1;
+  std::vector<IndexType> order(numNets, INDEX_TYPE_MAX), low(numNets, 0);
+  std::vector<unsigned char> onStack(numNets, 0);
+  std::vector<IndexType> stack, callNet, callArc;
+  comp.assign(numNets, INDEX_TYPE_MAX);
+  IndexType numComps = 0;
+  IndexType counter = 0;
+  auto visit = [&](const IndexType netIdx) {
+    order[netIdx] = low[netIdx] = counter++;
+    stack.emplace_back(netIdx);
+    onStack[netIdx] = 1;
+    callNet.emplace_back(netIdx);
+    callArc.emplace_back(_sigArcStart[netIdx]);
+  };
+  for (IndexType rootIdx = 0; rootIdx < numNets; ++rootIdx) {
+    if (order[rootIdx] != INDEX_TYPE_MAX) {
+      continue;
+    }
+    visit(rootIdx);
+    while (!callNet.empty()) {
+      const IndexType netIdx = callNet.back();
+      if (callArc.back() < _sigArcStart[netIdx + 1]) {
+        const IndexType nextIdx = _sigArcNet[callArc.back()++];
+        if (order[nextIdx] == INDEX_TYPE_MAX) {
+          visit(nextIdx);
+        }
+        else if (onStack[nextIdx]) {
+          low[netIdx] = std::min(low[netIdx], order[nextIdx]);
         }
+        continue;
       }
-      // gate or body
-      else {
+      if (low[netIdx] == order[netIdx]) {
+        IndexType memberIdx;
+        do {
+          memberIdx = stack.back();
+          stack.pop_back();
+          onStack[memberIdx] = 0;
+          comp[memberIdx] = numComps;
+        } while (memberIdx != netIdx);
+        ++numComps;
+      }
+      callNet.pop_back();
+      callArc.pop_back();
+      if (!callNet.empty()) {
+        low[callNet.back()] = std::min(low[callNet.back()], low[netIdx]);
       }
-      break;
     }
-    default:
-      break;
   }
+  return numComps;
+}
 
+void CSFlow::appendSignalPath(const CktGraph& ckt, const std::vector<IndexType>& predArc, IndexType netIdx) {
+  // Walk back to the input, then write the arcs from the input on
+  const IndexType first = _signalPathPin.size();
+  while (predArc[netIdx] != INDEX_TYPE_MAX) {
+    const IndexType arc = predArc[netIdx];
+    _signalPathPin.emplace_back(_sigArcToPin[arc]);
+    _signalPathPin.emplace_back(_sigArcFromPin[arc]);
+    netIdx = ckt.pinNet(_sigArcFromPin[arc]);
+  }
+  std::reverse(_signalPathPin.begin() + first, _signalPathPin.end());
+  for (IndexType idx = first; idx < _signalPathPin.size(); ++idx) {
+    _signalPathNode.emplace_back(ckt.pinNode(_signalPathPin[idx]));
+  }
+  _signalPathStart.emplace_back(_signalPathPin.size());
+}
 
-  for (IndexType pinIdx : adjPins) {
-    assert(!visited[pinIdx]);
-    currentDFS(ckt, pinIdx, tPinIdx, visited, pinNames, cellNames);
+std::vector<SymbolId> CSFlow::pinNameIds(CktGraph* ckt, Span<const IndexType> pins) const {
+  // The net of the device a pin connects to inside the device, e.g. D, G or S
+  std::vector<SymbolId> ids;
+  ids.reserve(pins.size());
+  for (IndexType pinIdx : pins) {
+    const IndexType subgraphIdx = ckt->node(ckt->pinNode(pinIdx)).subgraphIdx();
+    ids.emplace_back(_db.subCkt(subgraphIdx).net(ckt->pin(pinIdx).intNetIdx()).nameId());
   }
+  return ids;
+}
 
-  visited[sPinIdx] = 0;
-  pinNames.pop_back();
-  cellNames.pop_back();
+std::vector<SymbolId> CSFlow::cellNameIds(CktGraph* ckt, Span<const IndexType> nodes) const {
+  std::vector<SymbolId> ids;
+  ids.reserve(nodes.size());
+  for (IndexType nodeIdx : nodes) {
+    ids.emplace_back(ckt->node(nodeIdx).nameId());
+  }
+  return ids;
 }
 
-void CSFlow::computeSignalFlow(CktGraph& ckt) {
-  
+std::vector<std::vector<std::string>> CSFlow::currentPinPaths() const {
+  std::vector<std::vector<std::string>> paths;
+  paths.reserve(numCurrentPaths());
+  for (IndexType i = 0; i < numCurrentPaths(); ++i) {
+    paths.emplace_back(currentPinPath(i));
+  }
+  return paths;
+}
+
+std::vector<std::vector<std::string>> CSFlow::currentCellPaths() const {
+  std::vector<std::vector<std::string>> paths;
+  paths.reserve(numCurrentPaths());
+  for (IndexType i = 0; i < numCurrentPaths(); ++i) {
+    paths.emplace_back(currentCellPath(i));
+  }
+  return paths;
+}
+
+std::vector<std::vector<std::string>> CSFlow::signalPinPaths() const {
+  std::vector<std::vector<std::string>> paths;
+  paths.reserve(numSignalPaths());
+  for (IndexType i = 0; i < numSignalPaths(); ++i) {
+    paths.emplace_back(signalPinPath(i));
+  }
+  return paths;
+}
+
+std::vector<std::vector<std::string>> CSFlow::signalCellPaths() const {
+  std::vector<std::vector<std::string>> paths;
+  paths.reserve(numSignalPaths());
+  for (IndexType i = 0; i < numSignalPaths(); ++i) {
+    paths.emplace_back(signalCellPath(i));
+  }
+  return paths;
+}
+
+std::vector<std::string> CSFlow::symbolNames(const std::vector<SymbolId>& ids) {
+  const SymbolTable& symbols = SymbolTable::global();
+  std::vector<std::string> names;
+  names.reserve(ids.size());
+  for (SymbolId id : ids) {
+    names.emplace_back(symbols.str(id));
+  }
+  return names;
 }
 
 ImplType CSFlow::getCktNodeImplType(const CktNode& node) {
@@ -21,21 +21,75 @@ class CSFlow {
   void computeSignalFlow(CktGraph& ckt);
 
   /* Get */
-  const IntType                                 numCurrentPaths()                   const { return _currentPinPaths.size(); }
-  const std::vector<std::string>&               currentPinPath(const IndexType i)   const { return _currentPinPaths.at(i); }
-  const std::vector<std::string>&               currentCellPath(const IndexType i)  const { return _currentCellPaths.at(i); }
-  const std::vector<std::vector<std::string>>&  currentPinPaths()                   const { return _currentPinPaths; }
-  const std::vector<std::vector<std::string>>&  currentCellPaths()                  const { return _currentCellPaths; }
+  // The paths are stored as pin and node indices of the last circuit computed. The names are looked up on request
+  IndexType                                     numCurrentPaths()                     const { return _currentPathStart.size() - 1; }
+  Span<const IndexType>                         currentPathPins(const IndexType i)    const { return pathSpan(_currentPathStart, _currentPathPin, i); }
+  Span<const IndexType>                         currentPathNodes(const IndexType i)   const { return pathSpan(_currentPathStart, _currentPathNode, i); }
+  Span<const IndexType>                         currentPathStart()                    const { return Span<const IndexType>(_currentPathStart); }
+  Span<const IndexType>                         currentPathPinIdx()                   const { return Span<const IndexType>(_currentPathPin); }
+  Span<const IndexType>                         currentPathNodeIdx()                  const { return Span<const IndexType>(_currentPathNode); }
+  std::vector<SymbolId>                         currentPinPathIds(const IndexType i)  const { return pinNameIds(_currentCkt, currentPathPins(i)); }
+  std::vector<SymbolId>                         currentCellPathIds(const IndexType i) const { return cellNameIds(_currentCkt, currentPathNodes(i)); }
+  std::vector<std::string>                      currentPinPath(const IndexType i)     const { return symbolNames(currentPinPathIds(i)); }
+  std::vector<std::string>                      currentCellPath(const IndexType i)    const { return symbolNames(currentCellPathIds(i)); }
+  std::vector<std::vector<std::string>>         currentPinPaths()                     const;
+  std::vector<std::vector<std::string>>         currentCellPaths()                    const;
+  // The signal paths have the same layout. Each device on a path adds its input pin and its output pin
+  IndexType                                     numSignalPaths()                      const { return _signalPathStart.size() - 1; }
+  Span<const IndexType>                         signalPathPins(const IndexType i)     const { return pathSpan(_signalPathStart, _signalPathPin, i); }
+  Span<const IndexType>                         signalPathNodes(const IndexType i)    const { return pathSpan(_signalPathStart, _signalPathNode, i); }
+  Span<const IndexType>                         signalPathStart()                     const { return Span<const IndexType>(_signalPathStart); }
+  Span<const IndexType>                         signalPathPinIdx()                    const { return Span<const IndexType>(_signalPathPin); }
+  Span<const IndexType>                         signalPathNodeIdx()                   const { return Span<const IndexType>(_signalPathNode); }
+  IndexType                                     signalNetLevel(const IndexType netIdx) const { return _signalNetLevel.at(netIdx); }
+  std::vector<SymbolId>                         signalPinPathIds(const IndexType i)   const { return pinNameIds(_signalCkt, signalPathPins(i)); }
+  std::vector<SymbolId>                         signalCellPathIds(const IndexType i)  const { return cellNameIds(_signalCkt, signalPathNodes(i)); }
+  std::vector<std::string>                      signalPinPath(const IndexType i)      const { return symbolNames(signalPinPathIds(i)); }
+  std::vector<std::string>                      signalCellPath(const IndexType i)     const { return symbolNames(signalCellPathIds(i)); }
+  std::vector<std::vector<std::string>>         signalPinPaths()                      const;
+  std::vector<std::vector<std::string>>         signalCellPaths()                     const;
 
  private:
 
   DesignDB& _db;
 
-  std::vector<std::vector<std::string>> _currentPinPaths; // pin's net names
-  std::vector<std::vector<std::string>> _currentCellPaths; // cell names
+  CktGraph* _currentCkt = nullptr; // the circuit of the current paths
+  std::vector<IndexType> _currentPathStart = { 0 }; // path i = [_currentPathStart[i], _currentPathStart[i + 1]) in the arrays below
+  std::vector<IndexType> _currentPathPin; // the pins on the paths
+  std::vector<IndexType> _currentPathNode; // the nodes of the pins
 
-  
-  void currentDFS(CktGraph& ckt, const IndexType sPinIdx, const IndexType tPinIdx, std::vector<unsigned char>& visited, std::vector<std::string>& pinNames, std::vector<std::string>& cellNames);
+  CktGraph* _signalCkt = nullptr; // the circuit of the signal paths
+  std::vector<IndexType> _signalPathStart = { 0 }; // path i = [_signalPathStart[i], _signalPathStart[i + 1]) in the arrays below
+  std::vector<IndexType> _signalPathPin; // the pins on the paths
+  std::vector<IndexType> _signalPathNode; // the nodes of the pins
+  std::vector<IndexType> _signalNetLevel; // the number of devices from an input to a net. INDEX_TYPE_MAX if unreached
+
+  /* Current flow graph of the last circuit, in CSR form over the pins */
+  std::vector<IndexType> _arcStart; // _arcPin[_arcStart[pinIdx] .. _arcStart[pinIdx + 1]) = the pins the current flows to from pinIdx
+  std::vector<IndexType> _arcPin;
+
+  /* Signal flow graph of the last circuit, in CSR form over the nets */
+  std::vector<IndexType> _sigArcStart; // arcs [_sigArcStart[netIdx], _sigArcStart[netIdx + 1]) leave netIdx
+  std::vector<IndexType> _sigArcNet; // the net an arc enters
+  std::vector<IndexType> _sigArcFromPin; // the device pin on the net the arc leaves
+  std::vector<IndexType> _sigArcToPin; // the device pin on the net the arc enters
+
+  void buildCurrentArcs(CktGraph& ckt, const std::vector<ImplType>& nodeImpl);
+  void markSinkReachable(const std::vector<IndexType>& sinks, std::vector<unsigned char>& reachable) const;
+  void appendCurrentPath(const CktGraph& ckt, const std::vector<IndexType>& pinPath);
+
+  void buildSignalArcs(CktGraph& ckt, const std::vector<ImplType>& nodeImpl, std::vector<unsigned char>& isOutput);
+  IndexType condenseSignalArcs(std::vector<IndexType>& comp) const;
+  void appendSignalPath(const CktGraph& ckt, const std::vector<IndexType>& predArc, IndexType netIdx);
+
+  static Span<const IndexType> pathSpan(const std::vector<IndexType>& start, const std::vector<IndexType>& arr, const IndexType i) {
+    return Span<const IndexType>(arr.data() + start.at(i), start.at(i + 1) - start.at(i));
+  }
+
+  std::vector<SymbolId> pinNameIds(CktGraph* ckt, Span<const IndexType> pins) const;
+  std::vector<SymbolId> cellNameIds(CktGraph* ckt, Span<const IndexType> nodes) const;
+
+  static std::vector<std::string> symbolNames(const std::vector<SymbolId>& ids);
 
   ImplType    getCktNodeImplType(const CktNode& node);
 
@@ -0,0 +1,256 @@
+/**
+ * @file ArtifactStore.cpp
+ * @brief A content-addressed store of the files written into the result directory
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/ArtifactStore.h"
+#include "util/Hash.h"
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /*
+     * The store:
+     *   objects/<first 2 hex digits>/<16 hex digits of the hash>-<size>   the contents of the files, read-only
+     *   index   one line per stored file: object, circuit and stage separated by tabs. Later lines override
+     */
+    /// @brief whether users edit the result files of a stage. Linking them would make them read-only, or let an edit change the shared object
+    bool isEditableStage(const std::string &stage)
+    {
+        return stage == ".sym" || stage == ".symnet" || stage == ".sigpath";
+    }
+
+    bool makeDir(const std::string &dir)
+    {
+        return ::mkdir(dir.c_str(), 0755) == 0 || errno == EEXIST;
+    }
+
+    bool readFile(const std::string &filename, std::string &data)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+}
+
+ArtifactStore::ArtifactStore(const std::string &root)
+    : _root(root), _numStored(0), _numDeduped(0), _bytesDeduped(0), _numTmpFiles(0)
+{
+    if (!_root.empty() && _root.back() != '/')
+    {
+        _root += '/';
+    }
+    if (!makeDir(_root) || !makeDir(_root + "objects"))
+    {
+        ERR("ArtifactStore::%s: cannot create the store %s \n", __FUNCTION__, _root.c_str());
+        return;
+    }
+    std::ifstream index(_root + "index");
+    std::string line;
+    while (std::getline(index, line))
+    {
+        // An interrupted append leaves a partial last line without the stage
+        std::size_t first = line.find('\t');
+        if (first == std::string::npos || line.find('\t', first + 1) == std::string::npos)
+        {
+            continue;
+        }
+        _index[line.substr(first + 1)] = line.substr(0, first);
+    }
+}
+
+std::string ArtifactStore::stageOf(const std::string &ckt, const std::string &filename)
+{
+    std::size_t slash = filename.find_last_of('/');
+    std::string base = slash == std::string::npos ? filename : filename.substr(slash + 1);
+    if (!ckt.empty() && base.compare(0, ckt.size(), ckt) == 0)
+    {
+        return base.substr(ckt.size());
+    }
+    return base;
+}
+
+bool ArtifactStore::commit(const std::string &ckt, const std::string &written, const std::string &filename)
+{
+    std::string data;
+    if (!readFile(written, data))
+    {
+        ERR("ArtifactStore::%s: cannot read file: %s \n", __FUNCTION__, written.c_str());
+        return false;
+    }
+    std::string stage = stageOf(ckt, filename);
+    std::string object = storeObject(data, written);
+    if (object.empty() || !linkObject(_root + object, filename, isEditableStage(stage)))
+    {
+        return false;
+    }
+    if (written != filename)
+    {
+        std::remove(written.c_str());
+    }
+    record(ckt, stage, object);
+    return true;
+}
+
+bool ArtifactStore::put(const std::string &ckt, const std::string &data, const std::string &filename)
+{
+    std::string stage = stageOf(ckt, filename);
+    std::string object = storeObject(data, "");
+    if (object.empty() || !linkObject(_root + object, filename, isEditableStage(stage)))
+    {
+        return false;
+    }
+    record(ckt, stage, object);
+    return true;
+}
+
+void ArtifactStore::release(const std::string &filename) const
+{
+    std::remove(filename.c_str());
+}
+
+std::string ArtifactStore::storeObject(const std::string &data, const std::string &written)
+{
+    char name[40];
+    HashType hash = HashUtil::mix(HashUtil::hashBytes(data.data(), data.size()));
+    std::snprintf(name, sizeof(name), "%016" PRIx64 "-%" PRIu64, static_cast<std::uint64_t>(hash), static_cast<std::uint64_t>(data.size()));
+    std::string dir = std::string("objects/") + std::string(name, 2);
+    std::string object = dir + "/" + name;
+    std::string stored;
+    if (readFile(_root + object, stored))
+    {
+        if (stored == data)
+        {
+            ++_numDeduped;
+            _bytesDeduped += data.size();
+            return object;
+        }
+        WRN("ArtifactStore::%s: hash collision or corrupted object %s. The file is not stored \n", __FUNCTION__, object.c_str());
+        return "";
+    }
+    if (!makeDir(_root + dir))
+    {
+        ERR("ArtifactStore::%s: cannot create directory %s \n", __FUNCTION__, (_root + dir).c_str());
+        return "";
+    }
+    // Link or write aside and rename, so that a concurrent flow never sees a partial object.
+    // The written file stays until commit() succeeds, so that a failure leaves it to the caller
+    std::string tmpName = tmpFile(_root + object);
+    if (written.empty() || ::link(written.c_str(), tmpName.c_str()) != 0)
+    {
+        std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        file.close();
+        if (file.fail())
+        {
+            ERR("ArtifactStore::%s: failed to write file: %s \n", __FUNCTION__, tmpName.c_str());
+            std::remove(tmpName.c_str());
+            return "";
+        }
+    }
+    ::chmod(tmpName.c_str(), 0444);
+    if (std::rename(tmpName.c_str(), (_root + object).c_str()) != 0)
+    {
+        ERR("ArtifactStore::%s: cannot create object %s \n", __FUNCTION__, object.c_str());
+        std::remove(tmpName.c_str());
+        return "";
+    }
+    ++_numStored;
+    return object;
+}
+
+bool ArtifactStore::linkObject(const std::string &object, const std::string &filename, bool copy) const
+{
+    // Link or copy aside and rename over the file, so that a failure leaves the file as it is
+    std::string tmpName = filename + ".link";
+    std::remove(tmpName.c_str());
+    if (copy || ::link(object.c_str(), tmpName.c_str()) != 0)
+    {
+        // A writable copy, or another file system
+        std::string data;
+        if (!readFile(object, data))
+        {
+            ERR("ArtifactStore::%s: cannot read object %s \n", __FUNCTION__, object.c_str());
+            return false;
+        }
+        std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+        file.write(data.data(), data.size());
+        file.close();
+        if (file.fail())
+        {
+            ERR("ArtifactStore::%s: failed to write file: %s \n", __FUNCTION__, tmpName.c_str());
+            std::remove(tmpName.c_str());
+            return false;
+        }
+    }
+    bool renamed = std::rename(tmpName.c_str(), filename.c_str()) == 0;
+    // Renaming a link over another link to the same object does nothing
+    std::remove(tmpName.c_str());
+    if (!renamed)
+    {
+        ERR("ArtifactStore::%s: cannot replace file: %s \n", __FUNCTION__, filename.c_str());
+    }
+    return renamed;
+}
+
+void ArtifactStore::record(const std::string &ckt, const std::string &stage, const std::string &object)
+{
+    std::string key = ckt + '\t' + stage;
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _index.find(key);
+    if (it != _index.end() && it->second == object)
+    {
+        return;
+    }
+    _index[key] = object;
+    // One append per line, so that the lines of concurrent flows do not interleave
+    std::string line = object + '\t' + key + '\n';
+    std::ofstream index(_root + "index", std::ios::app);
+    index.write(line.data(), line.size());
+}
+
+std::string ArtifactStore::tmpFile(const std::string &filename)
+{
+    return filename + ".tmp." + std::to_string(::getpid()) + "." + std::to_string(_numTmpFiles++);
+}
+
+bool ArtifactStore::checkout(const std::string &ckt, const std::string &stage, const std::string &filename) const
+{
+    std::string object = objectFile(ckt, stage);
+    return !object.empty() && linkObject(object, filename, isEditableStage(stage));
+}
+
+bool ArtifactStore::contains(const std::string &ckt, const std::string &stage) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _index.find(ckt + '\t' + stage) != _index.end();
+}
+
+std::string ArtifactStore::objectFile(const std::string &ckt, const std::string &stage) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _index.find(ckt + '\t' + stage);
+    return it == _index.end() ? "" : _root + it->second;
+}
+
+IndexType ArtifactStore::numArtifacts() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _index.size();
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,125 @@
+/**
+ * @file ArtifactStore.h
+ * @brief A content-addressed store of the files written into the result directory
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_ARTIFACT_STORE_H_
+#define MAGICAL_FLOW_ARTIFACT_STORE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::ArtifactStore
+/// @brief keep one copy of each distinct result file. A result file is moved into the store as an object named by the hash
+/// and size of its contents, and replaced by a hard link to the object. A file identical to an existing object is linked to it
+/// instead, so the identical files of different circuits, runs and flows sharing the store take the space once.
+/// An index maps the (circuit, stage) of every file to its object. The stage of a file is the rest of its base name after the
+/// circuit name, such as ".place.gds".
+/// The objects are read-only and shared by the links, so a result file must be released before a tool rewrites it in place.
+/// The constraint files users edit (.sym, .symnet and .sigpath) are stored the same, but written as copies of their objects, not links.
+/// The store may be shared by concurrent flows
+class ArtifactStore
+{
+    public:
+        /// @brief constructor. Create the store or read the index of an existing one
+        /// @param the root directory of the store
+        explicit ArtifactStore(const std::string &root);
+        /*------------------------------*/
+        /* Writing                      */
+        /*------------------------------*/
+        /// @brief take a result file into the store
+        /// @param first: the name of the circuit
+        /// @param second: the file just written. It is moved into the store or removed
+        /// @param third: the result file to link to the object. It may be the same as the written file
+        /// @return false if the file cannot be read or linked. The written file is then left as it is
+        bool commit(const std::string &ckt, const std::string &written, const std::string &filename);
+        /// @brief take a result file written in place into the store
+        /// @param first: the name of the circuit
+        /// @param second: the result file
+        /// @return whether the file is in the store
+        bool commit(const std::string &ckt, const std::string &filename) { return commit(ckt, filename, filename); }
+        /// @brief write a result file through the store. Nothing is written if the contents are already stored
+        /// @param first: the name of the circuit
+        /// @param second: the contents
+        /// @param third: the result file
+        /// @return whether the file is written
+        bool put(const std::string &ckt, const std::string &data, const std::string &filename);
+        /// @brief remove a result file, so that a tool can write it again without changing the stored object
+        /// @param the result file
+        void release(const std::string &filename) const;
+        /*------------------------------*/
+        /* Reading                      */
+        /*------------------------------*/
+        /// @brief link the last stored file of a circuit and stage to a result file
+        /// @param first: the name of the circuit
+        /// @param second: the stage
+        /// @param third: the result file
+        /// @return false if the index has no such file or the link fails
+        bool checkout(const std::string &ckt, const std::string &stage, const std::string &filename) const;
+        /// @brief whether the index has a file of a circuit and stage
+        /// @param first: the name of the circuit
+        /// @param second: the stage
+        /// @return whether the file is stored
+        bool contains(const std::string &ckt, const std::string &stage) const;
+        /// @brief get the object of the last stored file of a circuit and stage
+        /// @param first: the name of the circuit
+        /// @param second: the stage
+        /// @return the file name of the object. Empty if not stored
+        std::string objectFile(const std::string &ckt, const std::string &stage) const;
+        /// @brief get the stage of a result file
+        /// @param first: the name of the circuit
+        /// @param second: the result file
+        /// @return the rest of the base name after the circuit name. The base name if it does not start with the circuit name
+        static std::string stageOf(const std::string &ckt, const std::string &filename);
+        /*------------------------------*/
+        /* Statistics                   */
+        /*------------------------------*/
+        /// @brief get the number of (circuit, stage) in the index
+        /// @return the number of indexed files
+        IndexType numArtifacts() const;
+        /// @brief get the number of objects added by this store
+        /// @return the number of objects
+        IndexType numStored() const { return _numStored; }
+        /// @brief get the number of files linked to an existing object by this store
+        /// @return the number of deduplicated files
+        IndexType numDeduped() const { return _numDeduped; }
+        /// @brief get the number of bytes not stored again thanks to the deduplication
+        /// @return the number of bytes
+        std::uint64_t bytesDeduped() const { return _bytesDeduped; }
+    private:
+        /// @brief store the contents as an object, unless an identical one exists
+        /// @param first: the contents
+        /// @param second: the file holding the contents, moved to the object if possible. Empty to write the contents
+        /// @return the object file. Empty if failed
+        std::string storeObject(const std::string &data, const std::string &written);
+        /// @brief replace a file by a hard link to an object. Copy the object if it cannot be linked
+        /// @param first: the object file
+        /// @param second: the file to replace
+        /// @param third: whether to write a writable copy instead of a link
+        /// @return whether the file is linked or copied. The file is unchanged if not
+        bool linkObject(const std::string &object, const std::string &filename, bool copy) const;
+        /// @brief add a file to the index
+        void record(const std::string &ckt, const std::string &stage, const std::string &object);
+        /// @brief get a file name for writing aside before renaming
+        std::string tmpFile(const std::string &filename);
+    private:
+        std::string _root; ///< The root directory, ending with '/'
+        mutable std::mutex _mutex; ///< Guards the index
+        std::unordered_map<std::string, std::string> _index; ///< _index[ckt + '\t' + stage] = the object, relative to the root
+        std::atomic<IndexType> _numStored; ///< The number of objects added
+        std::atomic<IndexType> _numDeduped; ///< The number of deduplicated files
+        std::atomic<std::uint64_t> _bytesDeduped; ///< The bytes of the deduplicated files
+        std::atomic<IndexType> _numTmpFiles; ///< The number of files written aside, to name them uniquely
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_ARTIFACT_STORE_H_
@@ -0,0 +1,676 @@
+/**
+ * @file Checkpoint.cpp
+ * @brief The binary checkpoint of the design database
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/DesignDB.h"
+#include "util/BinaryIO.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /*
+     * The checkpoint file, in the native byte order:
+     *   magic, version, byte order mark
+     *   the symbol table, as strings in the order of the symbol ids
+     *   the PhyPropDB
+     *   the distinct TechDBs of the circuits
+     *   the circuits without their layouts, each after the index of its TechDB
+     *   the flipped copy of each circuit, INDEX_TYPE_MAX for none
+     *   the layouts of the circuits, one after another. A shared layout is written once, as the first circuit sharing it sees it
+     *   the layout index: (offset, size, sharing) of the layout of each circuit. sharing is NO_SHARING for a layout written for the
+     *     circuit, or 2 * the earlier circuit whose layout it shares + whether it sees that layout mirrored, with no offset and size
+     *   the offset of the layout index
+     * The layouts are at the end so that they can be left in the mapped file until they are used
+     */
+    constexpr char CHECKPOINT_MAGIC[8] = { 'M', 'A', 'G', 'I', 'C', 'K', 'P', 'T' };
+    constexpr std::uint32_t CHECKPOINT_VERSION = 5; ///< Increase it when the format changes
+    constexpr std::uint64_t NO_SHARING = ~std::uint64_t(0); ///< The layout index entry of a layout written for its circuit
+    constexpr std::uint32_t CHECKPOINT_BYTE_ORDER = 0x01020304;
+
+    /// @brief read an array that must have one entry per object
+    template<typename ArrayType>
+    void readSizedArray(BinaryReader &in, ArrayType &arr, IndexType size)
+    {
+        in.readArray(arr);
+        if (arr.size() != size)
+        {
+            throw std::runtime_error("checkpoint: array size mismatch");
+        }
+    }
+
+    /// @brief check the indices of an array read from a checkpoint
+    template<typename ArrayType>
+    void checkIndices(const ArrayType &arr, IndexType size, bool allowUnset, const char *what)
+    {
+        for (IndexType idx : arr)
+        {
+            if (idx >= size && !(allowUnset && idx == INDEX_TYPE_MAX))
+            {
+                throw std::runtime_error(std::string("checkpoint: invalid ") + what + " " + std::to_string(idx));
+            }
+        }
+    }
+}
+
+/*------------------------------*/
+/* TechDB                       */
+/*------------------------------*/
+void TechDB::save(BinaryWriter &out) const
+{
+    auto writeShapes = [&](const std::vector<LefShape> &shapes)
+    {
+        out.write<IndexType>(shapes.size());
+        for (const LefShape &shape : shapes)
+        {
+            out.write<IndexType>(shape.dbLayer);
+            out.writeBox(shape.rect);
+        }
+    };
+    out.write<IntType>(_units.dbu());
+    out.writeArray(_dbLayerToPdkLayer);
+    out.writeArray(_dbLayerToPdkDatatype);
+    out.writeArray(_datatypeToColumn);
+    out.write<IndexType>(_numDatatypeColumns);
+    out.writeArray(_layerDatatypeToDbLayer);
+    // In the order of the names, so that the same tech is always written the same
+    std::vector<std::pair<std::string, IndexType>> layerNames(_layerNameToDbLayer.begin(), _layerNameToDbLayer.end());
+    std::sort(layerNames.begin(), layerNames.end());
+    out.write<IndexType>(layerNames.size());
+    for (const auto &layerName : layerNames)
+    {
+        out.writeString(layerName.first);
+        out.write<IndexType>(layerName.second);
+    }
+    const LefTables &lef = this->lef();
+    out.write<IndexType>(lef.layers.size());
+    for (const LefLayer &layer : lef.layers)
+    {
+        out.writeString(layer.name);
+        out.writeString(layer.type);
+        out.writeString(layer.direction);
+        out.write<LocType>(layer.pitch);
+        out.write<LocType>(layer.width);
+        out.write<LocType>(layer.spacing);
+        out.write<RealType>(layer.area);
+        out.write<IndexType>(layer.dbLayer);
+    }
+    out.write<IndexType>(lef.vias.size());
+    for (const LefVia &via : lef.vias)
+    {
+        out.writeString(via.name);
+        out.write<Byte>(via.isDefault);
+        writeShapes(via.shapes);
+    }
+    out.write<IndexType>(lef.macros.size());
+    for (const LefMacro &macro : lef.macros)
+    {
+        out.writeString(macro.name);
+        out.writeString(macro.macroClass);
+        out.write<LocType>(macro.origin.x());
+        out.write<LocType>(macro.origin.y());
+        out.write<LocType>(macro.width);
+        out.write<LocType>(macro.height);
+        out.write<IndexType>(macro.pins.size());
+        for (const LefPin &pin : macro.pins)
+        {
+            out.writeString(pin.name);
+            out.writeString(pin.direction);
+            out.writeString(pin.use);
+            writeShapes(pin.shapes);
+        }
+        writeShapes(macro.obs);
+    }
+}
+
+void TechDB::load(BinaryReader &in)
+{
+    auto readShapes = [&](std::vector<LefShape> &shapes)
+    {
+        shapes.resize(in.read<IndexType>());
+        for (LefShape &shape : shapes)
+        {
+            shape.dbLayer = in.read<IndexType>();
+            shape.rect = in.readBox<LocType>();
+        }
+    };
+    TechDB tech;
+    tech._units.setDbu(in.read<IntType>());
+    in.readArray(tech._dbLayerToPdkLayer);
+    readSizedArray(in, tech._dbLayerToPdkDatatype, tech._dbLayerToPdkLayer.size());
+    readSizedArray(in, tech._datatypeToColumn, RESERVED_DATATYPES_NUMBER);
+    tech._numDatatypeColumns = in.read<IndexType>();
+    readSizedArray(in, tech._layerDatatypeToDbLayer, RESERVED_LAYERS_NUMBER * tech._numDatatypeColumns);
+    IndexType numLayerNames = in.read<IndexType>();
+    for (IndexType idx = 0; idx < numLayerNames; ++idx)
+    {
+        std::string name = in.readString();
+        tech._layerNameToDbLayer[name] = in.read<IndexType>();
+    }
+    LefTables lef;
+    lef.layers.resize(in.read<IndexType>());
+    for (LefLayer &layer : lef.layers)
+    {
+        layer.name = in.readString();
+        layer.type = in.readString();
+        layer.direction = in.readString();
+        layer.pitch = in.read<LocType>();
+        layer.width = in.read<LocType>();
+        layer.spacing = in.read<LocType>();
+        layer.area = in.read<RealType>();
+        layer.dbLayer = in.read<IndexType>();
+    }
+    lef.vias.resize(in.read<IndexType>());
+    for (LefVia &via : lef.vias)
+    {
+        via.name = in.readString();
+        via.isDefault = in.read<Byte>() != 0;
+        readShapes(via.shapes);
+    }
+    lef.macros.resize(in.read<IndexType>());
+    for (LefMacro &macro : lef.macros)
+    {
+        macro.name = in.readString();
+        macro.macroClass = in.readString();
+        LocType x = in.read<LocType>();
+        macro.origin = XY<LocType>(x, in.read<LocType>());
+        macro.width = in.read<LocType>();
+        macro.height = in.read<LocType>();
+        macro.pins.resize(in.read<IndexType>());
+        for (LefPin &pin : macro.pins)
+        {
+            pin.name = in.readString();
+            pin.direction = in.readString();
+            pin.use = in.readString();
+            readShapes(pin.shapes);
+        }
+        readShapes(macro.obs);
+    }
+    // The layer tables are indexed with these without checks
+    checkIndices(tech._layerDatatypeToDbLayer, tech.numLayers(), true, "layer");
+    for (IndexType column : tech._datatypeToColumn)
+    {
+        if (column >= tech._numDatatypeColumns)
+        {
+            throw std::runtime_error("checkpoint: invalid datatype column " + std::to_string(column));
+        }
+    }
+    if (!lef.layers.empty() || !lef.vias.empty() || !lef.macros.empty())
+    {
+        tech._lef = std::make_shared<const LefTables>(std::move(lef));
+    }
+    *this = std::move(tech);
+}
+
+/*------------------------------*/
+/* CktGraph                     */
+/*------------------------------*/
+void CktGraph::save(BinaryWriter &out) const
+{
+    out.write<SymbolId>(_nameId);
+    out.write<IntType>(static_cast<IntType>(_implType));
+    out.write<IndexType>(_implIdx);
+    out.write<Byte>(_isImplemented);
+    out.write<Byte>(_flipVertFlag);
+    out.write<Byte>(isFinalized());
+    // Nodes
+    out.write<IndexType>(_nodes.size());
+    out.writeArray(_nodes.graphIdx);
+    out.writeArray(_nodes.offset);
+    out.writeArray(_nodes.orient);
+    out.writeArray(_nodes.flipVertFlag);
+    for (const CktNodeArrays::Cold &node : _nodes.cold)
+    {
+        out.writeArray(node.pinIdxArray);
+        out.write<IntType>(static_cast<IntType>(node.implType));
+        out.write<SymbolId>(node.refNameId);
+        out.write<SymbolId>(node.nameId);
+        out.write<Byte>(node.implPhy);
+    }
+    // Pins
+    out.write<IndexType>(_pinArray.size());
+    for (const Pin &pin : _pinArray)
+    {
+        out.write<IntType>(static_cast<IntType>(pin.pinType()));
+        out.write<IndexType>(pin.nodeIdx());
+        out.write<IndexType>(pin.intNetIdx());
+        out.write<IndexType>(pin.netIdx());
+        out.write<Byte>(pin.valid());
+        out.write<IndexType>(pin.numLayoutRects());
+        for (IndexType idx = 0; idx < pin.numLayoutRects(); ++idx)
+        {
+            out.write<IndexType>(pin.layoutRectIdx(idx));
+        }
+    }
+    // Nets
+    out.write<IndexType>(_nets.size());
+    out.writeArray(_nets.flags);
+    for (const NetArrays::Cold &net : _nets.cold)
+    {
+        out.writeArray(net.pinIdxArray);
+        out.writeArray(net.subIdxArray);
+        out.write<SymbolId>(net.nameId);
+        out.write<IndexType>(net.ioPos);
+        out.write<IndexType>(net.ioInterfaces.size());
+        for (const IoPinConfigure &io : net.ioInterfaces)
+        {
+            out.writeBox(io.shape);
+            out.write<IndexType>(io.layer);
+            out.write<IntType>(io.isPowerStripe);
+        }
+    }
+    out.writeArray(_psubIdxArray);
+    out.writeArray(_nwellIdxArray);
+    // Integration
+    out.writeString(_gdsData.gdsFile());
+    out.writeBox(_gdsData.bbox());
+}
+
+void CktGraph::saveLayout(BinaryWriter &out) const
+{
+    if (_layoutFile)
+    {
+        out.writeBytes(_layoutFile->data() + _layoutOffset, _layoutSize);
+    }
+    else if (_sharedLayout && _sharedFlipVert)
+    {
+        Layout layout = *_sharedLayout;
+        layout.flipVert();
+        layout.save(out);
+    }
+    else
+    {
+        (_sharedLayout ? *_sharedLayout : _layout).save(out);
+    }
+}
+
+void CktGraph::load(BinaryReader &in)
+{
+    _nameId = in.readSymbol();
+    _implType = static_cast<ImplType>(in.read<IntType>());
+    _implIdx = in.read<IndexType>();
+    _isImplemented = in.read<Byte>() != 0;
+    _flipVertFlag = in.read<Byte>() != 0;
+    bool isFinalized = in.read<Byte>() != 0;
+    // Nodes
+    IndexType numNodes = in.read<IndexType>();
+    _nodes.clear();
+    _nodes.resize(numNodes);
+    readSizedArray(in, _nodes.graphIdx, numNodes);
+    readSizedArray(in, _nodes.offset, numNodes);
+    readSizedArray(in, _nodes.orient, numNodes);
+    readSizedArray(in, _nodes.flipVertFlag, numNodes);
+    for (CktNodeArrays::Cold &node : _nodes.cold)
+    {
+        in.readArray(node.pinIdxArray);
+        node.implType = static_cast<ImplType>(in.read<IntType>());
+        node.refNameId = in.readSymbol();
+        node.nameId = in.readSymbol();
+        node.implPhy = in.read<Byte>() != 0;
+    }
+    // Pins
+    _pinArray.assign(in.read<IndexType>(), Pin());
+    for (Pin &pin : _pinArray)
+    {
+        pin.setPinType(static_cast<PinType>(in.read<IntType>()));
+        pin.setNodeIdx(in.read<IndexType>());
+        pin.setIntNetIdx(in.read<IndexType>());
+        pin.setNetIdx(in.read<IndexType>());
+        pin.setValid(in.read<Byte>() != 0);
+        IndexType numRects = in.read<IndexType>();
+        for (IndexType idx = 0; idx < numRects; ++idx)
+        {
+            pin.addLayoutRectIdx(in.read<IndexType>());
+        }
+    }
+    // Nets
+    IndexType numNets = in.read<IndexType>();
+    _nets.clear();
+    _nets.resize(numNets);
+    readSizedArray(in, _nets.flags, numNets);
+    for (NetArrays::Cold &net : _nets.cold)
+    {
+        in.readArray(net.pinIdxArray);
+        in.readArray(net.subIdxArray);
+        net.nameId = in.readSymbol();
+        net.ioPos = in.read<IndexType>();
+        net.ioInterfaces.resize(in.read<IndexType>());
+        for (IoPinConfigure &io : net.ioInterfaces)
+        {
+            io.shape = in.readBox<LocType>();
+            io.layer = in.read<IndexType>();
+            io.isPowerStripe = in.read<IntType>();
+        }
+    }
+    in.readArray(_psubIdxArray);
+    in.readArray(_nwellIdxArray);
+    // Integration
+    _gdsData.setGdsFile(in.readString());
+    _gdsData.bbox() = in.readBox<LocType>();
+    // The indices within the circuit. The subgraphs are checked by DesignDB::load()
+    for (const CktNodeArrays::Cold &node : _nodes.cold)
+    {
+        checkIndices(node.pinIdxArray, _pinArray.size(), false, "pin of node");
+    }
+    for (const Pin &pin : _pinArray)
+    {
+        if ((pin.nodeIdx() >= numNodes && pin.nodeIdx() != INDEX_TYPE_MAX) || (pin.netIdx() >= numNets && pin.netIdx() != INDEX_TYPE_MAX))
+        {
+            throw std::runtime_error("checkpoint: invalid node or net of pin");
+        }
+    }
+    for (const NetArrays::Cold &net : _nets.cold)
+    {
+        checkIndices(net.pinIdxArray, _pinArray.size(), false, "pin of net");
+        checkIndices(net.subIdxArray, _pinArray.size(), false, "substrate pin of net");
+    }
+    checkIndices(_psubIdxArray, numNets, false, "substrate net");
+    checkIndices(_nwellIdxArray, numNets, false, "n-well net");
+    _layout.clear();
+    _layoutFile.reset();
+    _sharedLayout.reset();
+    _sharedFlipVert = false;
+    _journal.clear();
+    _isFinalized = false;
+    if (isFinalized)
+    {
+        this->finalize();
+    }
+}
+
+void CktGraph::remapSymbols(const std::function<SymbolId(SymbolId)> &symbol)
+{
+    _nameId = symbol(_nameId);
+    for (CktNodeArrays::Cold &node : _nodes.cold)
+    {
+        node.refNameId = symbol(node.refNameId);
+        node.nameId = symbol(node.nameId);
+    }
+    for (NetArrays::Cold &net : _nets.cold)
+    {
+        net.nameId = symbol(net.nameId);
+    }
+    _nodeNameIndex.invalidate();
+    _netNameIndex.invalidate();
+}
+
+void CktGraph::loadLayout()
+{
+    // Take the file first, so that a corrupted layout is not read again
+    std::shared_ptr<const boost::iostreams::mapped_file_source> file = std::move(_layoutFile);
+    BinaryReader in(file->data() + _layoutOffset, _layoutSize);
+    _layout.load(in);
+}
+
+/*------------------------------*/
+/* DesignDB                     */
+/*------------------------------*/
+bool DesignDB::save(const std::string &filename) const
+{
+    // Write next to the old checkpoint and replace it at the end. An interrupted save keeps the old one,
+    // and the layouts still mapped from it stay readable
+    std::string tmpName = filename + ".tmp";
+    // A circuit placed but not routed yet carries the nodes and pins its placement added. A resumed run implements it again,
+    // so it is saved as it was before, while the design keeps it for the routing
+    std::unordered_map<IndexType, CktGraph> rolledBack;
+    for (IndexType cktIdx = 0; cktIdx < _ckts.size(); ++cktIdx)
+    {
+        if (_ckts[cktIdx].isImplInProgress())
+        {
+            CktGraph &ckt = rolledBack.emplace(cktIdx, _ckts[cktIdx]).first->second;
+            ckt.rollbackImpl();
+        }
+    }
+    auto savedCkt = [&](IndexType cktIdx) -> const CktGraph &
+    {
+        auto it = rolledBack.find(cktIdx);
+        return it != rolledBack.end() ? it->second : _ckts[cktIdx];
+    };
+    {
+        std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            ERR("DesignDB::%s: cannot open file: %s \n", __FUNCTION__, tmpName.c_str());
+            return false;
+        }
+        BinaryWriter out(file);
+        out.writeBytes(CHECKPOINT_MAGIC, sizeof(CHECKPOINT_MAGIC));
+        out.write<std::uint32_t>(CHECKPOINT_VERSION);
+        out.write<std::uint32_t>(CHECKPOINT_BYTE_ORDER);
+        const SymbolTable &symbols = SymbolTable::global();
+        out.write<IndexType>(symbols.size());
+        for (SymbolId id = 0; id < symbols.size(); ++id)
+        {
+            out.writeString(symbols.str(id));
+        }
+        _phyPropDB.save(out);
+        // The circuits usually share one tech, or have none set. Write each distinct one once
+        std::unordered_map<std::string, IndexType> techIdx;
+        std::vector<const std::string *> techs;
+        std::vector<IndexType> cktTechs;
+        cktTechs.reserve(_ckts.size());
+        for (const CktGraph &ckt : _ckts)
+        {
+            std::ostringstream bytes(std::ios::binary);
+            BinaryWriter techOut(bytes);
+            ckt.techDB().save(techOut);
+            auto inserted = techIdx.emplace(bytes.str(), techs.size());
+            if (inserted.second)
+            {
+                techs.emplace_back(&inserted.first->first);
+            }
+            cktTechs.emplace_back(inserted.first->second);
+        }
+        out.write<IndexType>(techs.size());
+        for (const std::string *bytes : techs)
+        {
+            out.writeBytes(bytes->data(), bytes->size());
+        }
+        out.write<IndexType>(_ckts.size());
+        for (IndexType cktIdx = 0; cktIdx < _ckts.size(); ++cktIdx)
+        {
+            out.write<IndexType>(cktTechs[cktIdx]);
+            savedCkt(cktIdx).save(out);
+        }
+        std::vector<IndexType> flippedCopies(_ckts.size(), INDEX_TYPE_MAX);
+        std::copy(_flippedCopies.begin(), _flippedCopies.end(), flippedCopies.begin());
+        out.writeArray(flippedCopies);
+        std::vector<std::uint64_t> layoutIndex;
+        layoutIndex.reserve(3 * _ckts.size());
+        // The first circuit sharing each layout
+        std::unordered_map<const Layout *, IndexType> firstSharing;
+        for (IndexType cktIdx = 0; cktIdx < _ckts.size(); ++cktIdx)
+        {
+            const CktGraph &ckt = savedCkt(cktIdx);
+            if (ckt.isLayoutShared())
+            {
+                auto inserted = firstSharing.emplace(ckt.sharedLayout().get(), cktIdx);
+                if (!inserted.second)
+                {
+                    const CktGraph &first = savedCkt(inserted.first->second);
+                    bool mirrored = ckt.layoutSourceFlipVert() != first.layoutSourceFlipVert();
+                    layoutIndex.insert(layoutIndex.end(), { 0, 0, 2 * std::uint64_t(inserted.first->second) + mirrored });
+                    continue;
+                }
+            }
+            std::uint64_t offset = out.pos();
+            ckt.saveLayout(out);
+            layoutIndex.insert(layoutIndex.end(), { offset, out.pos() - offset, NO_SHARING });
+        }
+        std::uint64_t indexOffset = out.pos();
+        out.writeArray(layoutIndex);
+        out.write<std::uint64_t>(indexOffset);
+        file.close();
+        if (!out.good() || file.fail())
+        {
+            ERR("DesignDB::%s: failed to write file: %s \n", __FUNCTION__, tmpName.c_str());
+            std::remove(tmpName.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpName.c_str(), filename.c_str()) != 0)
+    {
+        ERR("DesignDB::%s: cannot replace file: %s \n", __FUNCTION__, filename.c_str());
+        std::remove(tmpName.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool DesignDB::load(const std::string &filename, bool lazyLayouts)
+{
+    auto file = std::make_shared<boost::iostreams::mapped_file_source>();
+    try
+    {
+        file->open(filename);
+    }
+    catch (const std::exception &e)
+    {
+        ERR("DesignDB::%s: cannot open file: %s \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    DesignDB loaded;
+    std::vector<std::string> savedNames;
+    try
+    {
+        BinaryReader in(file->data(), file->size());
+        char magic[sizeof(CHECKPOINT_MAGIC)];
+        for (char &ch : magic)
+        {
+            ch = in.read<char>();
+        }
+        if (!std::equal(magic, magic + sizeof(magic), CHECKPOINT_MAGIC))
+        {
+            ERR("DesignDB::%s: %s is not a checkpoint \n", __FUNCTION__, filename.c_str());
+            return false;
+        }
+        std::uint32_t version = in.read<std::uint32_t>();
+        std::uint32_t byteOrder = in.read<std::uint32_t>();
+        if (version != CHECKPOINT_VERSION || byteOrder != CHECKPOINT_BYTE_ORDER)
+        {
+            ERR("DesignDB::%s: %s is checkpoint version %u, expect version %u on a machine of the same byte order \n",
+                __FUNCTION__, filename.c_str(), version, CHECKPOINT_VERSION);
+            return false;
+        }
+        // Keep the saved ids while reading, and intern the names only once the whole file is read
+        savedNames.resize(in.read<IndexType>());
+        for (std::string &name : savedNames)
+        {
+            name = in.readString();
+        }
+        std::vector<SymbolId> identity(savedNames.size());
+        std::iota(identity.begin(), identity.end(), 0);
+        in.setSymbolMap(std::move(identity));
+        loaded._phyPropDB.load(in);
+        std::vector<TechDB> techs(in.read<IndexType>());
+        for (TechDB &tech : techs)
+        {
+            tech.load(in);
+        }
+        IndexType numCkts = in.read<IndexType>();
+        for (IndexType cktIdx = 0; cktIdx < numCkts; ++cktIdx)
+        {
+            CktGraph &ckt = loaded._ckts.emplace_back();
+            ckt.setRenameCounter(loaded._cktRenames);
+            IndexType techIdx = in.read<IndexType>();
+            if (techIdx >= techs.size())
+            {
+                throw std::runtime_error("invalid tech of circuit " + std::to_string(cktIdx));
+            }
+            ckt.setTechDB(techs[techIdx]);
+            ckt.load(in);
+            checkIndices(ckt.nodeSubgraphIdx(), numCkts, true, "subgraph of node");
+            // Throws on an invalid property index
+            loaded._phyPropDB.propHash(ckt.implType(), ckt.implIdx());
+        }
+        readSizedArray(in, loaded._flippedCopies, numCkts);
+        checkIndices(loaded._flippedCopies, numCkts, true, "flipped copy");
+        loaded._flippedOriginals.assign(numCkts, INDEX_TYPE_MAX);
+        for (IndexType cktIdx = 0; cktIdx < numCkts; ++cktIdx)
+        {
+            IndexType copyIdx = loaded._flippedCopies[cktIdx];
+            if (copyIdx != INDEX_TYPE_MAX)
+            {
+                if (copyIdx == cktIdx || loaded._flippedOriginals[copyIdx] != INDEX_TYPE_MAX)
+                {
+                    throw std::runtime_error("invalid flipped copy of circuit " + std::to_string(cktIdx));
+                }
+                loaded._flippedOriginals[copyIdx] = cktIdx;
+            }
+        }
+        // The layouts, through the index at the end of the file
+        BinaryReader tail(file->data() + file->size() - sizeof(std::uint64_t), sizeof(std::uint64_t));
+        std::uint64_t indexOffset = tail.read<std::uint64_t>();
+        if (indexOffset < in.pos() || indexOffset > file->size() - sizeof(std::uint64_t))
+        {
+            throw std::runtime_error("invalid layout index");
+        }
+        in.skip(indexOffset - in.pos());
+        std::vector<std::uint64_t> layoutIndex;
+        readSizedArray(in, layoutIndex, 3 * numCkts);
+        for (IndexType cktIdx = 0; cktIdx < numCkts; ++cktIdx)
+        {
+            std::uint64_t offset = layoutIndex[3 * cktIdx];
+            std::uint64_t size = layoutIndex[3 * cktIdx + 1];
+            std::uint64_t sharing = layoutIndex[3 * cktIdx + 2];
+            if (sharing != NO_SHARING)
+            {
+                // The shared layouts are read here, so that they are shared again
+                std::uint64_t firstIdx = sharing / 2;
+                if (firstIdx >= cktIdx || layoutIndex[3 * firstIdx + 2] != NO_SHARING)
+                {
+                    throw std::runtime_error("invalid shared layout of circuit " + std::to_string(cktIdx));
+                }
+                loaded._ckts[cktIdx].shareLayout(loaded._ckts[firstIdx], (sharing & 1) != 0);
+                continue;
+            }
+            if (offset > indexOffset || size > indexOffset - offset)
+            {
+                throw std::runtime_error("invalid layout of circuit " + std::to_string(cktIdx));
+            }
+            loaded._ckts[cktIdx].setLayoutSource(file, offset, size);
+            if (!lazyLayouts)
+            {
+                loaded._ckts[cktIdx].layoutSource();
+            }
+        }
+    }
+    catch (const std::exception &e)
+    {
+        ERR("DesignDB::%s: corrupted checkpoint %s: %s \n", __FUNCTION__, filename.c_str(), e.what());
+        return false;
+    }
+    if (!loaded.findRootCkt())
+    {
+        ERR("DesignDB::%s: the hierarchy in %s has a cycle \n", __FUNCTION__, filename.c_str());
+        return false;
+    }
+    // Intern the names in use. Their ids in this process may differ from the saved ones
+    std::vector<SymbolId> symbolMap(savedNames.size(), INDEX_TYPE_MAX);
+    auto symbol = [&](SymbolId saved)
+    {
+        if (symbolMap[saved] == INDEX_TYPE_MAX)
+        {
+            symbolMap[saved] = SymbolTable::global().intern(savedNames[saved]);
+        }
+        return symbolMap[saved];
+    };
+    loaded._phyPropDB.remapSymbols(symbol);
+    for (CktGraph &ckt : loaded._ckts)
+    {
+        ckt.remapSymbols(symbol);
+    }
+    *this = std::move(loaded);
+    return true;
+}
+
+PROJECT_NAMESPACE_END
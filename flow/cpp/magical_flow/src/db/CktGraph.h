@@ -12,9 +12,29 @@
 #include "parser/ParseGDS.h"
 #include "Layout.h"
 #include "TechDB.h"
+#include "util/Span.h"
+#include "NameIndex.h"
+#include "PackedRows.h"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <functional>
+#include <boost/iostreams/device/mapped_file.hpp>
 
 PROJECT_NAMESPACE_BEGIN
 
+struct CktMemory;
+
+/// @class MAGICAL_FLOW::CktEdit
+/// @brief one entry of the edit journal of a circuit graph
+struct CktEdit
+{
+    CktEditType type = CktEditType::ADD_NODE; ///< The type of the edit
+    IndexType idx = INDEX_TYPE_MAX; ///< ADD_NODE/REMOVE_NODE: the node. RECONNECT_PIN: the pin. EDIT_PROP: the property index
+    IndexType from = INDEX_TYPE_MAX; ///< REMOVE_NODE: the subgraph of the removed node. RECONNECT_PIN: the old net
+    IndexType to = INDEX_TYPE_MAX; ///< ADD_NODE: the subgraph of the node. REMOVE_NODE: the node moved into idx. RECONNECT_PIN: the new net
+};
+
 /// @class MAGICAL_FLOW::CktGraph
 /// @brief each CktGraph represent a level of circuit in the hierarchical flow
 class CktGraph
@@ -23,33 +43,30 @@ class CktGraph
         /// @brief default construtor
         explicit CktGraph() = default; 
         void setTechDB(TechDB & techDB) { _techDB = techDB; }
+        /// @brief get the technology the GDS of the circuit is read with
+        /// @return the TechDB
+        const TechDB & techDB() const { return _techDB; }
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
-        /// @brief get the array of circuit nodes
-        /// @return the array of circuit nodes
-        const std::vector<CktNode> &                                nodeArray() const                                   { return _nodeArray; }
-        /// @brief get the array of circuit nodes
-        /// @return the array of circuit nodes
-        std::vector<CktNode> &                                      nodeArray()                                         { return _nodeArray; }
+        /// @brief get the storage of circuit nodes
+        /// @return the node arrays
+        const CktNodeArrays &                                       nodeArrays() const                                  { return _nodes; }
         /// @brief resize the number of nodes
         /// @param the number of nodes
         void resizeNodeArray(IndexType numNodes)
         {
-            AssertMsg(numNodes <= _nodeArray.size(), "Try resize nodes from size %u to %u", _nodeArray.size(), numNodes);
-            _nodeArray.resize(numNodes);
+            AssertMsg(numNodes <= _nodes.size(), "Try resize nodes from size %u to %u", _nodes.size(), numNodes);
+            _nodes.resize(numNodes);
+            _isFinalized = false;
         }
         /// @brief get the number of nodes
         /// @return the number of nodes this graph has
-        IndexType                                                   numNodes() const                                    { return _nodeArray.size(); }
+        IndexType                                                   numNodes() const                                    { return _nodes.size(); }
         /// @brief get a circuit node of this graph
         /// @param the index of node
         /// @return the circuit node
-        //const CktNode &                                             node(IndexType nodeIdx) const                       { return _nodeArray.at(nodeIdx); }
-        /// @brief get a circuit node of this graph
-        /// @param the index of node
-        /// @return the circuit node
-        CktNode &                                                   node(IndexType nodeIdx)                             { return _nodeArray.at(nodeIdx); }
+        CktNode                                                     node(IndexType nodeIdx)                             { return CktNode(_nodes, nodeIdx); }
         /// @brief get the array of pins
         /// @return the array of pins
         const std::vector<Pin> &                                    pinArray() const                                    { return _pinArray; }
@@ -73,40 +90,43 @@ class CktGraph
         /// @param the index of the pin of this graph
         /// @return the pin object
         Pin &                                                       pin(IndexType pinIdx)                               { return _pinArray.at(pinIdx); }
-        /// @brief get the array of nets of this graph
-        /// @return the array of nets of this graph
-        const std::vector<Net> &                                    netArray() const                                    { return _netArray; }
-        /// @brief get the array of nets of this graph
-        /// @return the array of nets of this graph
-        std::vector<Net> &                                          netArray()                                          { return _netArray; }
+        /// @brief get the storage of the nets of this graph
+        /// @return the net arrays
+        const NetArrays &                                           netArrays() const                                   { return _nets; }
         /// @brief get the number of nets this graph contains
         /// @return the number of nets this graph contains
-        IndexType                                                   numNets() const                                     { return _netArray.size(); }
+        IndexType                                                   numNets() const                                     { return _nets.size(); }
         /// @brief get a net of this graph
         /// @param the index of net in this graph
         /// @return a net
-        //const Net &                                                 net(IndexType netIdx) const                         { return _netArray.at(netIdx); }
-        /// @brief get a net of this graph
-        /// @param the index of net in this graph
-        /// @return a net
-        Net &                                                       net(IndexType netIdx)                               { return _netArray.at(netIdx); }
+        Net                                                         net(IndexType netIdx)                               { return Net(_nets, netIdx); }
         /// @brief get the net of a psub according to psubIdx
         /// @param the index of a psub net
         /// @return a net
-        Net &                                                       psub(IndexType psubIdx)                             { return _netArray.at(_psubIdxArray.at(psubIdx)); }
+        Net                                                         psub(IndexType psubIdx)                             { return Net(_nets, _psubIdxArray.at(psubIdx)); }
         /// @brief get the net of a nwell according to nwellIdx
         /// @param the index of a nwell net
         /// @return a net
-        Net &                                                       nwell(IndexType nwellIdx)                            { return _netArray.at(_nwellIdxArray.at(nwellIdx)); }
+        Net                                                         nwell(IndexType nwellIdx)                           { return Net(_nets, _nwellIdxArray.at(nwellIdx)); }
         /// @brief get the name of this circuit graph
         /// @return the name of this circuit
-        const std::string &                                         name() const                                        { return _name; }
+        const std::string &                                         name() const                                        { return SymbolTable::global().str(_nameId); }
+        /// @brief get the symbol of the name of this circuit graph
+        /// @return the symbol id of the name
+        SymbolId                                                    nameId() const                                      { return _nameId; }
         /// @brief set the name of this circuit
         /// @param the name of this circuit
-        void                                                        setName(const std::string &name)                    { _name = name; }
-        /// @brief get the layout of this circuit
+        void                                                        setName(const std::string &name);
+        /// @brief set the counter of the renames of the circuits of a design. The circuit name index of the design compares it to tell if it is stale
+        /// @param the counter shared by the circuits of the design. Null for none
+        void                                                        setRenameCounter(std::shared_ptr<std::atomic<IndexType>> counter) { _renameCounter = std::move(counter); }
+        /// @brief get the layout of this circuit. A layout left in the checkpoint by DesignDB::load() is read on the first call,
+        /// and a layout shared with other circuits is copied, so the returned layout may be edited
         /// @param the layout implementation of this circuit
-        Layout &                                                    layout()                                            { return _layout; }
+        Layout &                                                    layout()                                            { if (_layoutFile) { loadLayout(); } if (_sharedLayout) { unshareLayout(); } return _layout; }
+        /// @brief whether the layout is in memory, or still in the checkpoint file
+        /// @return false if the layout has not been read from the checkpoint yet
+        bool                                                        isLayoutLoaded() const                              { return !_layoutFile; }
         /// @brief get the implementation type of this circuit
         /// @return the implementation type of this circuit
         ImplType implType() const { return _implType; }
@@ -122,6 +142,7 @@ class CktGraph
         /// @brief get GdsData 
         /// @return GdsData reference
         GdsData & gdsData() { return _gdsData; }
+        const GdsData & gdsData() const { return _gdsData; }
         /// @brief is Net Io shape has been flipped vertically
         /// @return boolean
         bool flipVertFlag() const { return _flipVertFlag; }
@@ -131,13 +152,13 @@ class CktGraph
         /*------------------------------*/ 
         /// @brief allocate a new node
         /// @return the index of the new node
-        IndexType allocateNode() { _nodeArray.emplace_back(CktNode()); return _nodeArray.size() - 1;}
+        IndexType allocateNode() { _isFinalized = false; _nodes.resize(_nodes.size() + 1); return _nodes.size() - 1;}
         /// @brief allocate a new pin
         /// @return the index of a new pin
-        IndexType allocatePin() { _pinArray.emplace_back(Pin()); return _pinArray.size() - 1; }
+        IndexType allocatePin() { _isFinalized = false; ++_nodes.untrackedEdits; _pinArray.emplace_back(Pin()); return _pinArray.size() - 1; }
         /// @brief allocate a new net
         /// @return the index of a new net
-        IndexType allocateNet() { _netArray.emplace_back(Net()); return _netArray.size() - 1; }
+        IndexType allocateNet() { _isFinalized = false; _nets.resize(_nets.size() + 1); return _nets.size() - 1; }
         /// @brief create a new substrate net
         /// @return the index of a new psub net
         IndexType allocatePsub() { IndexType netIdx = allocateNet(); _psubIdxArray.push_back(netIdx); return netIdx; }
@@ -154,7 +175,160 @@ class CktGraph
         void setIsImpl(bool impl) { _isImplemented = impl; }
         /// @brief readin GDSII file into _layout
         /// @param GDSII filename
-        void parseGDS(const std::string & fileName) { Parser parse(fileName, _layout, _techDB); }
+        void parseGDS(const std::string & fileName) { Parser parse(fileName, this->layout(), _techDB); }
+
+        /*------------------------------*/ 
+        /* Hot arrays                   */
+        /*------------------------------*/ 
+        /// @brief get the subgraph indices of all the nodes
+        /// @return the view of the subgraph indices, indexed by node
+        Span<const IndexType> nodeSubgraphIdx() const { return Span<const IndexType>(_nodes.graphIdx); }
+        /// @brief get the offsets of all the nodes
+        /// @return the view of the offsets, indexed by node
+        Span<XY<LocType>> nodeOffsets() { return Span<XY<LocType>>(_nodes.offset); }
+        /// @brief get the orientations of all the nodes
+        /// @return the view of the orientations, indexed by node
+        Span<OriType> nodeOrients() { return Span<OriType>(_nodes.orient); }
+        /// @brief get the flip flags of all the nodes
+        /// @return the view of the flip flags, indexed by node. Non-zero if flipped
+        Span<Byte> nodeFlipVertFlags() { return Span<Byte>(_nodes.flipVertFlag); }
+        /// @brief get the flags of all the nets
+        /// @return the view of the NetFlag bits, indexed by net
+        Span<const Byte> netFlags() const { return Span<const Byte>(_nets.flags); }
+        /// @brief get the nets that have all of some flags and none of others in one scan of the flags
+        /// @param first: the NetFlag bits that must all be set
+        /// @param second: the NetFlag bits that must all be clear
+        /// @return the indices of the matched nets, in increasing order
+        std::vector<IndexType> netsWithFlags(Byte required, Byte excluded = 0) const;
+        /*------------------------------*/ 
+        /* Bulk construction            */
+        /*------------------------------*/ 
+        /// @brief build the nodes, pins and nets of the graph from flat arrays in one pass. Replaces the existing ones.
+        /// Every pin is appended to its node and net in pin order. The PSUB/NWELL pins are also listed in the substrate pins of the net.
+        /// As the netlist parser keeps them, those of the leaf nodes are only there
+        /// The graph is finalized afterwards
+        /// @param first: nodeGraphIdx[nodeIdx] = the subgraph of the node. INDEX_TYPE_MAX for leaf
+        /// @param second: pinNodeIdx[pinIdx] = the node of the pin
+        /// @param third: pinNetIdx[pinIdx] = the net of the pin. INDEX_TYPE_MAX if not connected
+        /// @param fourth: pinTypes[pinIdx] = the PinType of the pin. Empty for all UNSET
+        /// @param fifth: netFlags[netIdx] = the NetFlag bits of the net. Its size is the number of nets. The IO bit comes from Net::setIoPos and is ignored here
+        void build(Span<const IndexType> nodeGraphIdx, Span<const IndexType> pinNodeIdx, Span<const IndexType> pinNetIdx,
+                   Span<const IntType> pinTypes, Span<const IntType> netFlags);
+        /// @brief set the names of all the nodes
+        /// @param first: the names of the nodes
+        /// @param second: the reference names of the nodes. Empty to keep them
+        void setNodeNames(const std::vector<std::string> &names, const std::vector<std::string> &refNames);
+        /// @brief set the names of all the nets
+        /// @param the names of the nets
+        void setNetNames(const std::vector<std::string> &names);
+        /*------------------------------*/ 
+        /* ECO edits                    */
+        /*------------------------------*/ 
+        // The edits update the nodes, the nets and the pins in time proportional to the pins of the edited node and the nets they
+        // touch, and append to the journal. DesignDB::propagateEdits() reads the journal to find what is dirty.
+        // They patch the rows of the packed connectivity and the entries of the node name index they touch, if those are up to date.
+        // DesignDB::updateDirty() rehashes the dirty circuits
+        /// @brief add a node and its pins
+        /// @param first: the name of the node
+        /// @param second: the subgraph of the node. INDEX_TYPE_MAX for leaf
+        /// @param third: the nets of the pins in port order. INDEX_TYPE_MAX for unconnected
+        /// @return the index of the new node
+        IndexType addNode(const std::string &name, IndexType graphIdx, const std::vector<IndexType> &pinNets);
+        /// @brief remove a node and its pins. The last node is moved into its index, and the last pins are moved into the indices
+        /// of the removed pins. The pin indices in the earlier entries of the journal are not updated
+        /// @param the index of the node
+        void removeNode(IndexType nodeIdx);
+        /// @brief connect a pin to another net
+        /// @param first: the index of the pin
+        /// @param second: the new net. INDEX_TYPE_MAX to disconnect
+        void reconnectPin(IndexType pinIdx, IndexType netIdx);
+        /// @brief record that the PhyPropDB property of this device circuit was changed
+        void markPropEdited() { _journal.push_back(CktEdit{ CktEditType::EDIT_PROP, _implIdx, INDEX_TYPE_MAX, INDEX_TYPE_MAX }); }
+        /// @brief get the edits since the journal was last cleared
+        /// @return the journal
+        const std::vector<CktEdit> & journal() const { return _journal; }
+        /// @brief clear the journal
+        void clearJournal() { _journal.clear(); }
+        /*------------------------------*/ 
+        /* Name lookup                  */
+        /*------------------------------*/ 
+        /// @brief find a node by name
+        /// @param the name of the node
+        /// @return the index of the node. INDEX_TYPE_MAX if not found
+        IndexType findNode(const std::string &name) const
+        {
+            if (_nodeNameIndex.isStale(_nodes.size(), _nodes.edits))
+            {
+                _nodeNameIndex.build(_nodes.size(), _nodes.edits, [&](IndexType idx) { return _nodes.cold[idx].nameId; });
+            }
+            return _nodeNameIndex.find(SymbolTable::global().find(name));
+        }
+        /// @brief find a net by name
+        /// @param the name of the net
+        /// @return the index of the net. INDEX_TYPE_MAX if not found
+        IndexType findNet(const std::string &name) const
+        {
+            if (_netNameIndex.isStale(_nets.size(), _nets.edits))
+            {
+                _netNameIndex.build(_nets.size(), _nets.edits, [&](IndexType idx) { return _nets.cold[idx].nameId; });
+            }
+            return _netNameIndex.find(SymbolTable::global().find(name));
+        }
+        /*------------------------------*/ 
+        /* Packed connectivity          */
+        /*------------------------------*/ 
+        /// @brief pack the net->pin and node->pin connectivity into contiguous arrays.
+        /// Call it after the graph is built. Allocating nodes, pins or nets, or editing the pins of a node or net
+        /// through its view, drops the packed arrays until the next finalize(). The edits of addNode(), removeNode() and reconnectPin() patch them
+        void finalize();
+        /// @brief whether the packed connectivity is up to date
+        /// @return whether the graph has been finalized since the last allocation or pin edit
+        bool isFinalized() const
+        {
+            return _isFinalized && _nodes.pinEdits == _finalizedNodePinEdits && _nets.pinEdits == _finalizedNetPinEdits;
+        }
+        /// @brief get the pins of a net
+        /// @param the index of the net
+        /// @return the view of the pin indices, including the substrate pins
+        Span<const IndexType> netPins(IndexType netIdx) const
+        {
+            if (isFinalized())
+            {
+                return _netPinRows.row(netIdx);
+            }
+            return Span<const IndexType>(_nets.cold.at(netIdx).pinIdxArray);
+        }
+        /// @brief get the substrate pins of a net
+        /// @param the index of the net
+        /// @return the view of the substrate pin indices
+        Span<const IndexType> netSubs(IndexType netIdx) const
+        {
+            if (isFinalized())
+            {
+                return _netSubRows.row(netIdx);
+            }
+            return Span<const IndexType>(_nets.cold.at(netIdx).subIdxArray);
+        }
+        /// @brief get the pins of a node
+        /// @param the index of the node
+        /// @return the view of the pin indices
+        Span<const IndexType> nodePins(IndexType nodeIdx) const
+        {
+            if (isFinalized())
+            {
+                return _nodePinRows.row(nodeIdx);
+            }
+            const auto &pins = _nodes.cold.at(nodeIdx).pinIdxArray;
+            return Span<const IndexType>(pins.data(), pins.size());
+        }
+        /// @brief get the net a pin connects to
+        /// @param the index of the pin
+        /// @return the index of the net
+        IndexType pinNet(IndexType pinIdx) const { return _pinArray.at(pinIdx).netIdx(); }
+        /// @brief get the node a pin belongs to
+        /// @param the index of the pin
+        /// @return the index of the node
+        IndexType pinNode(IndexType pinIdx) const { return _pinArray.at(pinIdx).nodeIdx(); }
 
         /*------------------------------*/ 
         /* Integration                  */
@@ -164,33 +338,538 @@ class CktGraph
         void flipVert(LocType axis)
         {
             _flipVertFlag = !_flipVertFlag;
-            for(Net &net : _netArray)
+            for (IndexType netIdx = 0; netIdx < numNets(); ++netIdx)
             {
-                net.flipVert(axis);
+                net(netIdx).flipVert(axis);
             }
         }
         
 
+        /*------------------------------*/ 
+        /* Shared layout                */
+        /*------------------------------*/ 
+        // A circuit may refer to an immutable layout shared with other circuits, seen as is or mirrored by Layout::flipVert().
+        // The readers below do not copy it. layout() copies it on first use, so that editing one circuit never changes the others
+        /// @brief drop the own layout and share the layout of another circuit
+        /// @param first: the circuit whose layout is shared. Its own layout becomes shared as well
+        /// @param second: whether this circuit sees the layout of the other circuit mirrored
+        void shareLayout(CktGraph &other, bool flipVertFlag);
+        /// @brief whether the layout is shared with other circuits
+        /// @return true until layout() copies the shared layout
+        bool isLayoutShared() const { return _sharedLayout != nullptr; }
+        /// @brief get the shared layout
+        /// @return the shared layout. Null if the layout is not shared
+        const std::shared_ptr<const Layout> & sharedLayout() const { return _sharedLayout; }
+        /// @brief get the stored layout without copying a shared one. The layout of the circuit is this one mirrored if layoutSourceFlipVert()
+        /// @return the shared layout, or the own layout
+        const Layout & layoutSource() { if (_layoutFile) { loadLayout(); } return _sharedLayout ? *_sharedLayout : _layout; }
+        /// @brief whether the layout of the circuit is layoutSource() mirrored
+        /// @return whether the shared layout is seen mirrored
+        bool layoutSourceFlipVert() const { return _sharedFlipVert; }
+        /// @brief get the boundary of the layout without copying a shared one. Mirroring keeps the boundary
+        /// @return the boundary box of the layout
+        Box<LocType> layoutBoundary() { return layoutSource().boundary(); }
+        /// @brief insert the layout into another layout without copying a shared one. See Layout::insertLayout()
+        /// @param first: the layout to insert into
+        /// @param second: x_offset
+        /// @param third: y_offset
+        /// @param fourth: whether to flip vertically
+        void insertLayoutInto(Layout &target, LocType xOffset, LocType yOffset, bool flipVertFlag)
+        {
+            const Layout &source = layoutSource();
+            target.insertLayout(source, xOffset, yOffset, flipVertFlag != _sharedFlipVert);
+        }
+
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        /// @brief write the circuit except its layout and its TechDB. See DesignDB::save()
+        /// @param the binary writer
+        void save(BinaryWriter &out) const;
+        /// @brief write the layout. A layout still in the checkpoint is copied without being read. A shared layout is written as a copy
+        /// @param the binary writer
+        void saveLayout(BinaryWriter &out) const;
+        /// @brief replace the circuit by one written by save(). The layout is cleared and the journal is empty
+        /// @param the binary reader, whose symbol map is set
+        void load(BinaryReader &in);
+        /// @brief translate the symbols read by load() into the running symbol table
+        /// @param the function maps a saved symbol to the running one
+        void remapSymbols(const std::function<SymbolId(SymbolId)> &symbol);
+        /// @brief leave the layout in a checkpoint file until layout() is called
+        /// @param first: the mapped checkpoint file
+        /// @param second: the position of the layout written by saveLayout()
+        /// @param third: the number of bytes of the layout
+        void setLayoutSource(std::shared_ptr<const boost::iostreams::mapped_file_source> file, std::uint64_t offset, std::uint64_t size)
+        {
+            _layoutFile = std::move(file);
+            _sharedLayout.reset();
+            _sharedFlipVert = false;
+            _layoutOffset = offset;
+            _layoutSize = size;
+        }
+        /*------------------------------*/ 
+        /* Implementation cache         */
+        /*------------------------------*/ 
+        /// @brief write the implementation of the circuit: the layout, the placement of the nodes, the IO pins and the gds data. See ImplCache.
+        /// The nodes and pins the implementation added, such as the IO pin nodes of the placer, are written with it
+        /// @param first: the binary writer
+        /// @param second: the number of nodes before the implementation. The nodes after them are added by it
+        /// @param third: the number of pins before the implementation. The pins after them are added by it
+        /// @param fourth: the function maps the subgraph of an added node to what is written for it
+        void saveImpl(BinaryWriter &out, IndexType numNodes, IndexType numPins, const std::function<IndexType(IndexType)> &subgraphRef) const;
+        /// @brief replace the implementation by one written by saveImpl(), add the nodes and pins it added, and mark the circuit implemented.
+        /// Throws std::runtime_error and leaves the circuit unchanged if the record is corrupted or the circuit differs from the one written
+        /// @param first: the binary reader
+        /// @param second: the function maps what was written for the subgraph of an added node back to a subgraph. It may throw
+        void loadImpl(BinaryReader &in, const std::function<IndexType(IndexType)> &subgraph);
+        /// @brief drop the implementation: the layout, the placement of the nodes, the IO pins and the gds data, and mark the circuit not implemented
+        void clearImpl();
+        /// @brief record the nodes and pins of the circuit before its implementation adds its own, such as the IO pin nodes of the placer
+        void beginImpl() { _implStartNodes = numNodes(); _implStartPins = numPins(); }
+        /// @brief whether the implementation of the circuit began with beginImpl() and is not finished
+        /// @return whether the implementation is in progress
+        bool isImplInProgress() const { return !_isImplemented && _implStartNodes != INDEX_TYPE_MAX; }
+        /// @brief drop an implementation in progress: remove the nodes and pins added since beginImpl(), if it was called, and clearImpl()
+        void rollbackImpl();
+        /*------------------------------*/ 
+        /* Memory                       */
+        /*------------------------------*/ 
+        /// @brief add up the heap memory of the circuit. See DesignDB::memoryReport()
+        /// @param first: the bytes of the circuit to fill. The layout is the own one only, without the shared layout
+        /// @param second: layerBytes[layerIdx] += the bytes of the layer in the own layout
+        void memoryUsage(CktMemory &usage, std::vector<std::uint64_t> &layerBytes) const;
+    private:
+        /// @brief move a pin between the pin arrays of the nets without journaling
+        /// @param first: the index of the pin
+        /// @param second: the new net. INDEX_TYPE_MAX to disconnect
+        void setPinNet(IndexType pinIdx, IndexType netIdx);
+        /// @brief copy the pins of a net into its packed rows after an edit. Nothing if the packed connectivity is not up to date
+        /// @param the index of the net
+        void patchNetRows(IndexType netIdx);
+        /// @brief copy the pins of a node into its packed row after an edit. Nothing if the packed connectivity is not up to date
+        /// @param the index of the node
+        void patchNodeRow(IndexType nodeIdx);
+        /// @brief pack the connectivity again once the patched rows left more space behind than they use
+        void packIfSparse();
+        /// @brief read the layout left in the checkpoint file and release the file
+        void loadLayout();
+        /// @brief turn the own layout into a shared one, unless already shared
+        void freezeLayout();
+        /// @brief replace the shared layout by an own copy, mirrored if needed
+        void unshareLayout();
     private:
         TechDB _techDB;
-        std::vector<CktNode> _nodeArray; ///< The circuit nodes of this graph
+        CktNodeArrays _nodes; ///< The circuit nodes of this graph
         std::vector<Pin> _pinArray; ///< The pins of the circuit
-        std::vector<Net> _netArray; ///< The nets of the circuit
-        std::vector<IndexType> _psubIdxArray; ///< The index of substrate nets in _netArray
-        std::vector<IndexType> _nwellIdxArray; ///< The index of nwell nets in _netArray
-        std::string _name = ""; ///< The name of this circuit
-        Layout _layout; ///< The layout implementation for this circuit
+        NetArrays _nets; ///< The nets of the circuit
+        std::vector<IndexType> _psubIdxArray; ///< The index of substrate nets in _nets
+        std::vector<IndexType> _nwellIdxArray; ///< The index of nwell nets in _nets
+        SymbolId _nameId = EMPTY_SYMBOL; ///< The name of this circuit
+        std::shared_ptr<std::atomic<IndexType>> _renameCounter; ///< Counts the renames of all the circuits of the design. Null outside a design
+        Layout _layout; ///< The layout implementation for this circuit. Without layers while the layout is shared
+        std::shared_ptr<const Layout> _sharedLayout; ///< The immutable layout shared with other circuits. Null if the layout is not shared
+        bool _sharedFlipVert = false; ///< Whether this circuit sees _sharedLayout mirrored
         ImplType _implType = ImplType::UNSET; ///< The implementation set of this circuit
         IndexType _implIdx = INDEX_TYPE_MAX; ///< The index of this implementation type configuration in the database
         bool _isImplemented = false; 
+        IndexType _implStartNodes = INDEX_TYPE_MAX; ///< The number of nodes before the implementation. INDEX_TYPE_MAX if beginImpl() was not called
+        IndexType _implStartPins = INDEX_TYPE_MAX; ///< The number of pins before the implementation
         bool _flipVertFlag = false; ///< Flag indicating that net Io shape has been flipped vertically
         /*------------------------------*/ 
+        /* Packed connectivity          */
+        /*------------------------------*/ 
+        std::vector<CktEdit> _journal; ///< The edits since the journal was cleared
+        mutable NameIndex _nodeNameIndex; ///< Lazily built name index of the nodes
+        mutable NameIndex _netNameIndex; ///< Lazily built name index of the nets
+        bool _isFinalized = false; ///< Whether the packed arrays are up to date
+        IndexType _finalizedNodePinEdits = 0; ///< _nodes.pinEdits when the packed arrays were built
+        IndexType _finalizedNetPinEdits = 0; ///< _nets.pinEdits when the packed arrays were built
+        PackedRows _netPinRows; ///< Row netIdx is the pins of the net
+        PackedRows _netSubRows; ///< Row netIdx is the substrate pins of the net
+        PackedRows _nodePinRows; ///< Row nodeIdx is the pins of the node
+        /*------------------------------*/ 
         /* Integration                  */
         /*------------------------------*/ 
         GdsData _gdsData; ///< The gds data
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        std::shared_ptr<const boost::iostreams::mapped_file_source> _layoutFile; ///< The checkpoint holding the layout. Null once the layout is in memory
+        std::uint64_t _layoutOffset = 0; ///< The position of the layout in _layoutFile
+        std::uint64_t _layoutSize = 0; ///< The number of bytes of the layout in _layoutFile
 
 };
 
+inline std::vector<IndexType> CktGraph::netsWithFlags(Byte required, Byte excluded) const
+{
+    std::vector<IndexType> nets;
+    for (IndexType netIdx = 0; netIdx < _nets.flags.size(); ++netIdx)
+    {
+        Byte flags = _nets.flags[netIdx];
+        if ((flags & required) == required && (flags & excluded) == 0)
+        {
+            nets.emplace_back(netIdx);
+        }
+    }
+    return nets;
+}
+
+inline void CktGraph::shareLayout(CktGraph &other, bool flipVertFlag)
+{
+    if (&other == this)
+    {
+        return;
+    }
+    other.freezeLayout();
+    _sharedLayout = other._sharedLayout;
+    _sharedFlipVert = other._sharedFlipVert != flipVertFlag;
+    _layout = Layout(0);
+    _layoutFile.reset();
+}
+
+inline void CktGraph::freezeLayout()
+{
+    if (_layoutFile)
+    {
+        loadLayout();
+    }
+    if (!_sharedLayout)
+    {
+        _sharedLayout = std::make_shared<Layout>(std::move(_layout));
+        _sharedFlipVert = false;
+        _layout = Layout(0);
+    }
+}
+
+inline void CktGraph::unshareLayout()
+{
+    if (_sharedLayout.use_count() == 1)
+    {
+        // The last one sharing the layout takes it. It was created non-const by freezeLayout()
+        _layout = std::move(const_cast<Layout &>(*_sharedLayout));
+    }
+    else
+    {
+        _layout = *_sharedLayout;
+    }
+    if (_sharedFlipVert)
+    {
+        _layout.flipVert();
+    }
+    _sharedLayout.reset();
+    _sharedFlipVert = false;
+}
+
+inline void CktGraph::finalize()
+{
+    _netPinRows.pack(_nets.cold, [](const NetArrays::Cold &net) -> const std::vector<IndexType> & { return net.pinIdxArray; });
+    _netSubRows.pack(_nets.cold, [](const NetArrays::Cold &net) -> const std::vector<IndexType> & { return net.subIdxArray; });
+    _nodePinRows.pack(_nodes.cold, [](const CktNodeArrays::Cold &node) -> const SmallVector<IndexType, 4> & { return node.pinIdxArray; });
+    _finalizedNodePinEdits = _nodes.pinEdits;
+    _finalizedNetPinEdits = _nets.pinEdits;
+    _isFinalized = true;
+}
+
+inline void CktGraph::build(Span<const IndexType> nodeGraphIdx, Span<const IndexType> pinNodeIdx, Span<const IndexType> pinNetIdx,
+                            Span<const IntType> pinTypes, Span<const IntType> netFlags)
+{
+    IndexType numNodes = nodeGraphIdx.size();
+    IndexType numPins = pinNodeIdx.size();
+    IndexType numNets = netFlags.size();
+    AssertMsg(pinNetIdx.size() == numPins, "CktGraph::build: %u pin nets for %u pins \n", pinNetIdx.size(), numPins);
+    AssertMsg(pinTypes.empty() || pinTypes.size() == numPins, "CktGraph::build: %u pin types for %u pins \n", pinTypes.size(), numPins);
+    // Count the pins of each node and net so that every vector is allocated once
+    std::vector<IndexType> nodeNumPins(numNodes, 0);
+    std::vector<IndexType> netNumPins(numNets, 0);
+    std::vector<IndexType> netNumSubs(numNets, 0);
+    auto isSub = [&](IndexType pinIdx)
+    {
+        return !pinTypes.empty() && static_cast<PinType>(pinTypes[pinIdx]) != PinType::UNSET;
+    };
+    auto isNetPin = [&](IndexType pinIdx)
+    {
+        return !isSub(pinIdx) || nodeGraphIdx[pinNodeIdx[pinIdx]] != INDEX_TYPE_MAX;
+    };
+    for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx)
+    {
+        AssertMsg(pinNodeIdx[pinIdx] < numNodes, "CktGraph::build: pin %u has invalid node %u \n", pinIdx, pinNodeIdx[pinIdx]);
+        ++nodeNumPins[pinNodeIdx[pinIdx]];
+        IndexType netIdx = pinNetIdx[pinIdx];
+        if (netIdx == INDEX_TYPE_MAX)
+        {
+            continue;
+        }
+        AssertMsg(netIdx < numNets, "CktGraph::build: pin %u has invalid net %u \n", pinIdx, netIdx);
+        if (isNetPin(pinIdx))
+        {
+            ++netNumPins[netIdx];
+        }
+        if (isSub(pinIdx))
+        {
+            ++netNumSubs[netIdx];
+        }
+    }
+    _nodes.clear();
+    _nodes.resize(numNodes);
+    std::copy(nodeGraphIdx.begin(), nodeGraphIdx.end(), _nodes.graphIdx.begin());
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        _nodes.cold[nodeIdx].pinIdxArray.reserve(nodeNumPins[nodeIdx]);
+    }
+    _nets.clear();
+    _nets.resize(numNets);
+    _psubIdxArray.clear();
+    _nwellIdxArray.clear();
+    for (IndexType netIdx = 0; netIdx < numNets; ++netIdx)
+    {
+        _nets.cold[netIdx].pinIdxArray.reserve(netNumPins[netIdx]);
+        _nets.cold[netIdx].subIdxArray.reserve(netNumSubs[netIdx]);
+        _nets.flags[netIdx] = static_cast<Byte>(netFlags[netIdx]) & ~static_cast<Byte>(NetFlag::IO);
+    }
+    _pinArray.clear();
+    _pinArray.resize(numPins);
+    _nodeNameIndex.invalidate();
+    _netNameIndex.invalidate();
+    for (IndexType pinIdx = 0; pinIdx < numPins; ++pinIdx)
+    {
+        Pin &pin = _pinArray[pinIdx];
+        IndexType nodeIdx = pinNodeIdx[pinIdx];
+        IndexType netIdx = pinNetIdx[pinIdx];
+        pin.setNodeIdx(nodeIdx);
+        pin.setNetIdx(netIdx);
+        _nodes.cold[nodeIdx].pinIdxArray.emplace_back(pinIdx);
+        if (!pinTypes.empty())
+        {
+            pin.setPinType(static_cast<PinType>(pinTypes[pinIdx]));
+        }
+        if (netIdx == INDEX_TYPE_MAX)
+        {
+            continue;
+        }
+        if (isNetPin(pinIdx))
+        {
+            _nets.cold[netIdx].pinIdxArray.emplace_back(pinIdx);
+        }
+        if (isSub(pinIdx))
+        {
+            _nets.cold[netIdx].subIdxArray.emplace_back(pinIdx);
+        }
+    }
+    finalize();
+}
+
+inline void CktGraph::setName(const std::string &name)
+{
+    SymbolId nameId = SymbolTable::global().intern(name);
+    if (nameId != _nameId)
+    {
+        _nameId = nameId;
+        if (_renameCounter)
+        {
+            _renameCounter->fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+inline IndexType CktGraph::addNode(const std::string &name, IndexType graphIdx, const std::vector<IndexType> &pinNets)
+{
+    IndexType edits = _nodes.edits;
+    // Allocated without dropping the packed connectivity, which is patched below
+    IndexType nodeIdx = _nodes.size();
+    _nodes.resizeJournaled(nodeIdx + 1);
+    _nodes.graphIdx[nodeIdx] = graphIdx;
+    // Named without counting a rename, so the node name index is extended instead of rebuilt
+    _nodes.cold[nodeIdx].nameId = SymbolTable::global().intern(name);
+    _nodeNameIndex.append(_nodes.cold[nodeIdx].nameId, nodeIdx, edits, _nodes.edits);
+    _nodes.cold[nodeIdx].pinIdxArray.reserve(pinNets.size());
+    for (IndexType netIdx : pinNets)
+    {
+        AssertMsg(netIdx == INDEX_TYPE_MAX || netIdx < numNets(), "CktGraph::addNode: invalid net %u \n", netIdx);
+        IndexType pinIdx = _pinArray.size();
+        _pinArray.emplace_back(Pin());
+        _pinArray[pinIdx].setNodeIdx(nodeIdx);
+        _pinArray[pinIdx].setNetIdx(netIdx);
+        _nodes.cold[nodeIdx].pinIdxArray.emplace_back(pinIdx);
+        if (netIdx != INDEX_TYPE_MAX)
+        {
+            _nets.cold[netIdx].pinIdxArray.emplace_back(pinIdx);
+            patchNetRows(netIdx);
+        }
+    }
+    if (isFinalized())
+    {
+        _nodePinRows.appendRow(_nodes.cold[nodeIdx].pinIdxArray);
+    }
+    packIfSparse();
+    _journal.push_back(CktEdit{ CktEditType::ADD_NODE, nodeIdx, INDEX_TYPE_MAX, graphIdx });
+    return nodeIdx;
+}
+
+inline void CktGraph::removeNode(IndexType nodeIdx)
+{
+    AssertMsg(nodeIdx < numNodes(), "CktGraph::removeNode: invalid node %u \n", nodeIdx);
+    IndexType graphIdx = _nodes.graphIdx[nodeIdx];
+    std::vector<IndexType> pins(_nodes.cold[nodeIdx].pinIdxArray.begin(), _nodes.cold[nodeIdx].pinIdxArray.end());
+    // The nets and the nodes whose pins are renumbered, to patch their packed rows
+    std::vector<IndexType> touchedNets;
+    std::vector<IndexType> touchedNodes;
+    for (IndexType pinIdx : pins)
+    {
+        touchedNets.emplace_back(_pinArray[pinIdx].netIdx());
+        setPinNet(pinIdx, INDEX_TYPE_MAX);
+    }
+    // From the highest, so that the last pin is never one still to be removed
+    std::sort(pins.begin(), pins.end(), std::greater<IndexType>());
+    for (IndexType pinIdx : pins)
+    {
+        IndexType lastPin = numPins() - 1;
+        if (pinIdx != lastPin)
+        {
+            // Point the node and the net of the last pin to its new index
+            const Pin &moved = _pinArray[lastPin];
+            auto renumber = [&](auto &pinIdxArray)
+            {
+                std::replace(pinIdxArray.begin(), pinIdxArray.end(), lastPin, pinIdx);
+            };
+            renumber(_nodes.cold.at(moved.nodeIdx()).pinIdxArray);
+            touchedNodes.emplace_back(moved.nodeIdx());
+            if (moved.netIdx() != INDEX_TYPE_MAX)
+            {
+                renumber(_nets.cold[moved.netIdx()].pinIdxArray);
+                renumber(_nets.cold[moved.netIdx()].subIdxArray);
+                touchedNets.emplace_back(moved.netIdx());
+            }
+            _pinArray[pinIdx] = std::move(_pinArray[lastPin]);
+        }
+        _pinArray.pop_back();
+    }
+    IndexType last = numNodes() - 1;
+    IndexType edits = _nodes.edits;
+    SymbolId nameId = _nodes.cold[nodeIdx].nameId;
+    SymbolId lastNameId = _nodes.cold[last].nameId;
+    bool wasFinalized = isFinalized();
+    _nodes.swapRemove(nodeIdx);
+    _nodeNameIndex.swapRemove(nameId, nodeIdx, lastNameId, last, edits, _nodes.edits);
+    if (nodeIdx != last)
+    {
+        for (IndexType pinIdx : _nodes.cold[nodeIdx].pinIdxArray)
+        {
+            _pinArray[pinIdx].setNodeIdx(nodeIdx);
+        }
+    }
+    if (wasFinalized)
+    {
+        _nodePinRows.popRow();
+        if (nodeIdx != last)
+        {
+            touchedNodes.emplace_back(nodeIdx);
+        }
+        for (IndexType idx : touchedNodes)
+        {
+            // The last node took the place of the removed one
+            patchNodeRow(idx == last ? nodeIdx : idx);
+        }
+        for (IndexType netIdx : touchedNets)
+        {
+            patchNetRows(netIdx);
+        }
+        packIfSparse();
+    }
+    _journal.push_back(CktEdit{ CktEditType::REMOVE_NODE, nodeIdx, graphIdx, nodeIdx != last ? last : INDEX_TYPE_MAX });
+}
+
+inline void CktGraph::reconnectPin(IndexType pinIdx, IndexType netIdx)
+{
+    AssertMsg(netIdx == INDEX_TYPE_MAX || netIdx < numNets(), "CktGraph::reconnectPin: invalid net %u \n", netIdx);
+    IndexType oldNetIdx = _pinArray.at(pinIdx).netIdx();
+    setPinNet(pinIdx, netIdx);
+    patchNetRows(oldNetIdx);
+    patchNetRows(netIdx);
+    packIfSparse();
+    _journal.push_back(CktEdit{ CktEditType::RECONNECT_PIN, pinIdx, oldNetIdx, netIdx });
+}
+
+inline void CktGraph::setPinNet(IndexType pinIdx, IndexType netIdx)
+{
+    Pin &pin = _pinArray.at(pinIdx);
+    IndexType oldNetIdx = pin.netIdx();
+    if (oldNetIdx != INDEX_TYPE_MAX)
+    {
+        auto erasePin = [&](std::vector<IndexType> &pins)
+        {
+            auto it = std::find(pins.begin(), pins.end(), pinIdx);
+            if (it != pins.end())
+            {
+                pins.erase(it);
+            }
+        };
+        erasePin(_nets.cold[oldNetIdx].pinIdxArray);
+        erasePin(_nets.cold[oldNetIdx].subIdxArray);
+    }
+    pin.setNetIdx(netIdx);
+    if (netIdx != INDEX_TYPE_MAX)
+    {
+        // As the netlist parser puts them, the substrate pins are also in the substrate pins of the net, and those of the leaf nodes only there
+        bool isSub = pin.pinType() != PinType::UNSET;
+        if (!isSub || (pin.nodeIdx() != INDEX_TYPE_MAX && _nodes.graphIdx.at(pin.nodeIdx()) != INDEX_TYPE_MAX))
+        {
+            _nets.cold[netIdx].pinIdxArray.emplace_back(pinIdx);
+        }
+        if (isSub)
+        {
+            _nets.cold[netIdx].subIdxArray.emplace_back(pinIdx);
+        }
+    }
+}
+
+inline void CktGraph::patchNetRows(IndexType netIdx)
+{
+    if (netIdx != INDEX_TYPE_MAX && isFinalized())
+    {
+        _netPinRows.setRow(netIdx, _nets.cold[netIdx].pinIdxArray);
+        _netSubRows.setRow(netIdx, _nets.cold[netIdx].subIdxArray);
+    }
+}
+
+inline void CktGraph::patchNodeRow(IndexType nodeIdx)
+{
+    if (isFinalized())
+    {
+        _nodePinRows.setRow(nodeIdx, _nodes.cold[nodeIdx].pinIdxArray);
+    }
+}
+
+inline void CktGraph::packIfSparse()
+{
+    if (isFinalized() && (_netPinRows.isSparse() || _netSubRows.isSparse() || _nodePinRows.isSparse()))
+    {
+        finalize();
+    }
+}
+
+inline void CktGraph::setNodeNames(const std::vector<std::string> &names, const std::vector<std::string> &refNames)
+{
+    AssertMsg(names.size() == numNodes(), "CktGraph::setNodeNames: %u names for %u nodes \n", names.size(), numNodes());
+    AssertMsg(refNames.empty() || refNames.size() == numNodes(), "CktGraph::setNodeNames: %u reference names for %u nodes \n", refNames.size(), numNodes());
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes(); ++nodeIdx)
+    {
+        node(nodeIdx).setName(names[nodeIdx]);
+        if (!refNames.empty())
+        {
+            node(nodeIdx).setRefName(refNames[nodeIdx]);
+        }
+    }
+}
+
+inline void CktGraph::setNetNames(const std::vector<std::string> &names)
+{
+    AssertMsg(names.size() == numNets(), "CktGraph::setNetNames: %u names for %u nets \n", names.size(), numNets());
+    for (IndexType netIdx = 0; netIdx < numNets(); ++netIdx)
+    {
+        net(netIdx).setName(names[netIdx]);
+    }
+}
+
 PROJECT_NAMESPACE_END
 
 #endif //MAGICAL_FLOW_CKTGRAPH_H_
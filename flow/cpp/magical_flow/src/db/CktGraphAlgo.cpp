@@ -0,0 +1,236 @@
+/**
+ * @file CktGraphAlgo.cpp
+ * @brief Graph algorithms over the bipartite device/net view of a CktGraph
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/CktGraphAlgo.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <boost/graph/breadth_first_search.hpp>
+#include <boost/graph/connected_components.hpp>
+#include "db/CktGraphBGL.h"
+#include "util/Hash.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace CktGraphAlgo
+{
+
+IndexType connectedComponents(CktGraph &ckt, std::vector<IndexType> &component)
+{
+    if (!ckt.isFinalized())
+    {
+        ckt.finalize();
+    }
+    CktBipartiteGraph g(ckt);
+    component.assign(g.numVertices(), 0);
+    std::vector<boost::default_color_type> colors(g.numVertices());
+    auto index = get(boost::vertex_index, g);
+    return boost::connected_components(g, boost::make_iterator_property_map(component.begin(), index),
+                                       boost::color_map(boost::make_iterator_property_map(colors.begin(), index)));
+}
+
+std::vector<IndexType> bfsDistances(CktGraph &ckt, IndexType source)
+{
+    if (!ckt.isFinalized())
+    {
+        ckt.finalize();
+    }
+    CktBipartiteGraph g(ckt);
+    if (source >= g.numVertices())
+    {
+        throw std::out_of_range("CktGraphAlgo::bfsDistances: vertex " + std::to_string(source) + " out of range " + std::to_string(g.numVertices()));
+    }
+    std::vector<IndexType> dist(g.numVertices(), INDEX_TYPE_MAX);
+    std::vector<boost::default_color_type> colors(g.numVertices());
+    auto index = get(boost::vertex_index, g);
+    auto distMap = boost::make_iterator_property_map(dist.begin(), index);
+    dist[source] = 0;
+    boost::breadth_first_search(g, source,
+            boost::visitor(boost::make_bfs_visitor(boost::record_distances(distMap, boost::on_tree_edge())))
+            .color_map(boost::make_iterator_property_map(colors.begin(), index)));
+    return dist;
+}
+
+IndexType eccentricity(CktGraph &ckt, IndexType v)
+{
+    IndexType ecc = 0;
+    for (IndexType dist : bfsDistances(ckt, v))
+    {
+        if (dist != INDEX_TYPE_MAX)
+        {
+            ecc = std::max(ecc, dist);
+        }
+    }
+    return ecc;
+}
+
+namespace
+{
+    /// @brief group the pins by an index in pin order
+    /// @param first: the pins
+    /// @param second: the number of groups
+    /// @param third: the getter for the group of a pin. INDEX_TYPE_MAX to skip the pin
+    /// @param fourth: the offset array to fill, of size numGroups + 1
+    /// @param fifth: the grouped pins to fill
+    template<typename GetterType>
+    void groupPins(const std::vector<Pin> &pins, IndexType numGroups, GetterType getter, std::vector<IndexType> &start, std::vector<IndexType> &grouped)
+    {
+        start.assign(numGroups + 2, 0);
+        for (const Pin &pin : pins)
+        {
+            IndexType group = getter(pin);
+            if (group != INDEX_TYPE_MAX)
+            {
+                ++start[group + 2];
+            }
+        }
+        for (IndexType group = 0; group < numGroups; ++group)
+        {
+            start[group + 2] += start[group + 1];
+        }
+        grouped.resize(start[numGroups + 1]);
+        for (IndexType pinIdx = 0; pinIdx < pins.size(); ++pinIdx)
+        {
+            IndexType group = getter(pins[pinIdx]);
+            if (group != INDEX_TYPE_MAX)
+            {
+                grouped[start[group + 1]++] = pinIdx;
+            }
+        }
+        start.pop_back();
+    }
+
+    /// @brief count the distinct labels
+    /// @param first: the node labels
+    /// @param second: the net labels
+    /// @return the number of distinct labels
+    IndexType numDistinct(const std::vector<HashType> &nodeLabels, const std::vector<HashType> &netLabels)
+    {
+        std::vector<HashType> labels(nodeLabels);
+        labels.insert(labels.end(), netLabels.begin(), netLabels.end());
+        std::sort(labels.begin(), labels.end());
+        return std::unique(labels.begin(), labels.end()) - labels.begin();
+    }
+
+    /// @brief fold labels into one hash regardless of their order
+    /// @param first: the running hash
+    /// @param second: the labels. Sorted in place
+    /// @return the new running hash
+    HashType combineUnordered(HashType seed, std::vector<HashType> &labels)
+    {
+        std::sort(labels.begin(), labels.end());
+        for (HashType label : labels)
+        {
+            seed = HashUtil::combine(seed, label);
+        }
+        return seed;
+    }
+} // End of the anonymous namespace
+
+HashType structuralHash(const CktGraph &ckt, const std::vector<HashType> &cktHashes, HashType propHash)
+{
+    const CktNodeArrays &nodes = ckt.nodeArrays();
+    const NetArrays &nets = ckt.netArrays();
+    const std::vector<Pin> &pins = ckt.pinArray();
+    const IndexType numNodes = ckt.numNodes();
+    const IndexType numNets = ckt.numNets();
+    // Group the pins from the pin side. The pin index arrays of the nodes and nets are not always filled,
+    // and the substrate pins are only in the substrate arrays
+    std::vector<IndexType> nodePinStart, nodePins, netPinStart, netPins;
+    groupPins(pins, numNodes, [](const Pin &pin) { return pin.nodeIdx(); }, nodePinStart, nodePins);
+    groupPins(pins, numNets, [](const Pin &pin) { return pin.netIdx(); }, netPinStart, netPins);
+
+    // A pin is labelled by its port position in the node, which is the position of the pin in the node
+    std::vector<HashType> pinLabels(pins.size(), 0);
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        for (IndexType pos = nodePinStart[nodeIdx]; pos < nodePinStart[nodeIdx + 1]; ++pos)
+        {
+            const Pin &pin = pins[nodePins[pos]];
+            HashType label = HashUtil::combine(pos - nodePinStart[nodeIdx], static_cast<HashType>(pin.pinType()));
+            pinLabels[nodePins[pos]] = HashUtil::combine(label, pin.valid());
+        }
+    }
+    // A node starts from its subgraph, a leaf from its reference name
+    std::vector<HashType> nodeLabels(numNodes);
+    for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+    {
+        IndexType graphIdx = nodes.graphIdx[nodeIdx];
+        HashType label = graphIdx == INDEX_TYPE_MAX ?
+            HashUtil::combine(1, HashUtil::hashString(SymbolTable::global().str(nodes.cold[nodeIdx].refNameId))) :
+            HashUtil::combine(2, cktHashes.at(graphIdx));
+        nodeLabels[nodeIdx] = HashUtil::combine(label, nodePinStart[nodeIdx + 1] - nodePinStart[nodeIdx]);
+    }
+    // A net starts from its port position and power flags. The port position is the rank of ioPos among the IO nets,
+    // so that the numbering of the internal nets does not matter
+    std::vector<IndexType> ioNets;
+    for (IndexType netIdx = 0; netIdx < numNets; ++netIdx)
+    {
+        if (nets.cold[netIdx].ioPos != INDEX_TYPE_MAX)
+        {
+            ioNets.emplace_back(netIdx);
+        }
+    }
+    std::sort(ioNets.begin(), ioNets.end(), [&](IndexType lhs, IndexType rhs) { return nets.cold[lhs].ioPos < nets.cold[rhs].ioPos; });
+    std::vector<HashType> netLabels(numNets);
+    const Byte powerBits = static_cast<Byte>(NetFlag::VDD) | static_cast<Byte>(NetFlag::VSS);
+    for (IndexType netIdx = 0; netIdx < numNets; ++netIdx)
+    {
+        netLabels[netIdx] = HashUtil::combine(3, nets.flags[netIdx] & powerBits);
+    }
+    for (IndexType rank = 0; rank < ioNets.size(); ++rank)
+    {
+        netLabels[ioNets[rank]] = HashUtil::combine(netLabels[ioNets[rank]], rank);
+    }
+
+    // Refine until the partition of the nodes and nets stops splitting
+    IndexType numClasses = numDistinct(nodeLabels, netLabels);
+    std::vector<HashType> newNodeLabels(numNodes), newNetLabels(numNets), neighbors;
+    for (IndexType round = 0; round < numNodes + numNets; ++round)
+    {
+        for (IndexType nodeIdx = 0; nodeIdx < numNodes; ++nodeIdx)
+        {
+            // The pins of a node are ordered, so they are folded in order
+            HashType label = nodeLabels[nodeIdx];
+            for (IndexType pos = nodePinStart[nodeIdx]; pos < nodePinStart[nodeIdx + 1]; ++pos)
+            {
+                IndexType netIdx = pins[nodePins[pos]].netIdx();
+                label = HashUtil::combine(label, netIdx == INDEX_TYPE_MAX ? 0 : netLabels[netIdx]);
+            }
+            newNodeLabels[nodeIdx] = label;
+        }
+        for (IndexType netIdx = 0; netIdx < numNets; ++netIdx)
+        {
+            // The pins of a net are not, so they are folded as a multiset
+            neighbors.clear();
+            for (IndexType pos = netPinStart[netIdx]; pos < netPinStart[netIdx + 1]; ++pos)
+            {
+                IndexType pinIdx = netPins[pos];
+                neighbors.emplace_back(HashUtil::combine(pinLabels[pinIdx], nodeLabels[pins[pinIdx].nodeIdx()]));
+            }
+            newNetLabels[netIdx] = combineUnordered(netLabels[netIdx], neighbors);
+        }
+        nodeLabels.swap(newNodeLabels);
+        netLabels.swap(newNetLabels);
+        IndexType numNewClasses = numDistinct(nodeLabels, netLabels);
+        if (numNewClasses == numClasses)
+        {
+            break;
+        }
+        numClasses = numNewClasses;
+    }
+
+    HashType hash = HashUtil::combine(static_cast<HashType>(ckt.implType()), propHash);
+    hash = HashUtil::combine(hash, numNodes);
+    hash = HashUtil::combine(hash, numNets);
+    hash = combineUnordered(hash, nodeLabels);
+    return combineUnordered(hash, netLabels);
+}
+
+} // End of the CktGraphAlgo namespace
+
+PROJECT_NAMESPACE_END
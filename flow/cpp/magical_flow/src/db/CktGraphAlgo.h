@@ -0,0 +1,47 @@
+/**
+ * @file CktGraphAlgo.h
+ * @brief Graph algorithms over the bipartite device/net view of a CktGraph
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_CKTGRAPH_ALGO_H_
+#define MAGICAL_FLOW_CKTGRAPH_ALGO_H_
+
+#include "db/CktGraph.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The vertices are numbered as in CktBipartiteGraph: nodes first, then numNodes() + netIdx for the nets.
+/// A distance of 2 is one device-net-device hop. The graph is finalized if it is not yet
+namespace CktGraphAlgo
+{
+    /// @brief label the connected components
+    /// @param first: the circuit graph
+    /// @param second: the component of each vertex to fill
+    /// @return the number of components
+    IndexType connectedComponents(CktGraph &ckt, std::vector<IndexType> &component);
+    /// @brief compute the BFS distance from a vertex to every vertex
+    /// @param first: the circuit graph
+    /// @param second: the source vertex
+    /// @return the distance of each vertex. INDEX_TYPE_MAX if unreachable. Throws std::out_of_range if the source is not a vertex
+    std::vector<IndexType> bfsDistances(CktGraph &ckt, IndexType source);
+    /// @brief compute the eccentricity of a vertex within its component
+    /// @param first: the circuit graph
+    /// @param second: the vertex
+    /// @return the largest distance to a reachable vertex
+    IndexType eccentricity(CktGraph &ckt, IndexType v);
+    /// @brief compute a hash of the circuit that does not depend on the names or the order of the nodes and nets.
+    /// The nodes and nets are labelled by Weisfeiler-Lehman refinement over the port-ordered pins, starting from
+    /// the hash of the subgraph of each node and the port position and power flags of each net.
+    /// Structurally identical circuits get the same hash. Different circuits get different hashes with high probability
+    /// @param first: the circuit graph
+    /// @param second: cktHashes[graphIdx] = the hash of the subgraph. Must cover the subgraphs of the nodes
+    /// @param third: the hash of the device property of the circuit. 0 if not a device
+    /// @return the structural hash
+    HashType structuralHash(const CktGraph &ckt, const std::vector<HashType> &cktHashes, HashType propHash);
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_CKTGRAPH_ALGO_H_
@@ -0,0 +1,187 @@
+/**
+ * @file CktGraphBGL.h
+ * @brief Present a CktGraph to the Boost Graph Library as a bipartite device/net graph
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_CKTGRAPH_BGL_H_
+#define MAGICAL_FLOW_CKTGRAPH_BGL_H_
+
+#include <boost/graph/graph_traits.hpp>
+#include <boost/graph/properties.hpp>
+#include <boost/iterator/counting_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/property_map/property_map.hpp>
+#include "db/CktGraph.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief an edge of the bipartite graph. Each connected pin is one edge between its node and its net
+struct CktBipartiteEdge
+{
+    IndexType pinIdx = INDEX_TYPE_MAX; ///< The pin of the edge
+    bool fromNet = false; ///< Whether the edge is traversed from the net side
+
+    bool operator==(const CktBipartiteEdge &rhs) const { return pinIdx == rhs.pinIdx; }
+    bool operator!=(const CktBipartiteEdge &rhs) const { return pinIdx != rhs.pinIdx; }
+};
+
+/// @class MAGICAL_FLOW::CktBipartiteGraph
+/// @brief An undirected view of a finalized CktGraph. Vertices [0, numNodes) are the nodes and
+/// [numNodes, numNodes + numNets) are the nets. It reads the packed connectivity of the graph and copies nothing,
+/// so the graph must stay finalized and unchanged while the view is in use
+class CktBipartiteGraph
+{
+    public:
+        /// @brief constructor
+        /// @param the finalized circuit graph
+        explicit CktBipartiteGraph(const CktGraph &ckt) : _ckt(ckt)
+        {
+            AssertMsg(ckt.isFinalized(), "CktBipartiteGraph: the graph needs to be finalized \n");
+        }
+        /// @brief get the circuit graph
+        /// @return the circuit graph
+        const CktGraph & ckt() const { return _ckt; }
+        /// @brief get the number of vertices
+        /// @return the number of nodes plus the number of nets
+        IndexType numVertices() const { return _ckt.numNodes() + _ckt.numNets(); }
+        /// @brief get the vertex of a node
+        /// @param the index of the node
+        /// @return the vertex
+        IndexType nodeVertex(IndexType nodeIdx) const { return nodeIdx; }
+        /// @brief get the vertex of a net
+        /// @param the index of the net
+        /// @return the vertex
+        IndexType netVertex(IndexType netIdx) const { return _ckt.numNodes() + netIdx; }
+        /// @brief whether a vertex is a net
+        /// @param the vertex
+        /// @return true if the vertex is a net, false if a node
+        bool isNetVertex(IndexType v) const { return v >= _ckt.numNodes(); }
+        /// @brief get the pins incident to a vertex
+        /// @param the vertex
+        /// @return the pins of the node or the net
+        Span<const IndexType> pins(IndexType v) const
+        {
+            return isNetVertex(v) ? _ckt.netPins(v - _ckt.numNodes()) : _ckt.nodePins(v);
+        }
+        /// @brief get the node end of an edge
+        /// @param the edge
+        /// @return the node vertex
+        IndexType nodeEnd(const CktBipartiteEdge &e) const { return nodeVertex(_ckt.pinNode(e.pinIdx)); }
+        /// @brief get the net end of an edge
+        /// @param the edge
+        /// @return the net vertex
+        IndexType netEnd(const CktBipartiteEdge &e) const { return netVertex(_ckt.pinNet(e.pinIdx)); }
+    private:
+        const CktGraph &_ckt; ///< The circuit graph
+};
+
+/// @class MAGICAL_FLOW::CktBipartiteOutEdgeIterator
+/// @brief Iterate the pins of a vertex, skipping the pins that are not connected to a net
+class CktBipartiteOutEdgeIterator
+    : public boost::iterator_facade<CktBipartiteOutEdgeIterator, CktBipartiteEdge, boost::forward_traversal_tag, CktBipartiteEdge>
+{
+    public:
+        CktBipartiteOutEdgeIterator() = default;
+        /// @brief constructor
+        /// @param first: the graph
+        /// @param second: the current position in the pins of the vertex
+        /// @param third: the end of the pins of the vertex
+        /// @param fourth: whether the vertex is a net
+        CktBipartiteOutEdgeIterator(const CktBipartiteGraph *g, const IndexType *cur, const IndexType *end, bool fromNet)
+            : _g(g), _cur(cur), _end(end), _fromNet(fromNet)
+        {
+            skipUnconnected();
+        }
+    private:
+        friend class boost::iterator_core_access;
+        CktBipartiteEdge dereference() const { return CktBipartiteEdge{ *_cur, _fromNet }; }
+        bool equal(const CktBipartiteOutEdgeIterator &other) const { return _cur == other._cur; }
+        void increment() { ++_cur; skipUnconnected(); }
+        /// @brief move to the next connected pin
+        void skipUnconnected()
+        {
+            while (_cur != _end && _g->ckt().pinNet(*_cur) == INDEX_TYPE_MAX)
+            {
+                ++_cur;
+            }
+        }
+    private:
+        const CktBipartiteGraph *_g = nullptr; ///< The graph
+        const IndexType *_cur = nullptr; ///< The current pin
+        const IndexType *_end = nullptr; ///< The end of the pins
+        bool _fromNet = false; ///< Whether the vertex is a net
+};
+
+PROJECT_NAMESPACE_END
+
+namespace boost
+{
+    template<>
+    struct graph_traits<PROJECT_NAMESPACE::CktBipartiteGraph>
+    {
+        struct traversal_category : public virtual incidence_graph_tag, public virtual vertex_list_graph_tag {};
+        typedef PROJECT_NAMESPACE::IndexType vertex_descriptor;
+        typedef PROJECT_NAMESPACE::CktBipartiteEdge edge_descriptor;
+        typedef PROJECT_NAMESPACE::CktBipartiteOutEdgeIterator out_edge_iterator;
+        typedef counting_iterator<PROJECT_NAMESPACE::IndexType> vertex_iterator;
+        typedef void adjacency_iterator;
+        typedef void in_edge_iterator;
+        typedef void edge_iterator;
+        typedef undirected_tag directed_category;
+        typedef allow_parallel_edge_tag edge_parallel_category;
+        typedef PROJECT_NAMESPACE::IndexType vertices_size_type;
+        typedef PROJECT_NAMESPACE::IndexType edges_size_type;
+        typedef PROJECT_NAMESPACE::IndexType degree_size_type;
+        static vertex_descriptor null_vertex() { return PROJECT_NAMESPACE::INDEX_TYPE_MAX; }
+    };
+
+    template<>
+    struct property_map<PROJECT_NAMESPACE::CktBipartiteGraph, vertex_index_t>
+    {
+        typedef typed_identity_property_map<PROJECT_NAMESPACE::IndexType> type;
+        typedef type const_type;
+    };
+} // End of the boost namespace
+
+PROJECT_NAMESPACE_BEGIN
+
+/*------------------------------*/
+/* BGL concepts                 */
+/*------------------------------*/
+// Found through argument-dependent lookup on CktBipartiteGraph
+
+inline IndexType source(const CktBipartiteEdge &e, const CktBipartiteGraph &g) { return e.fromNet ? g.netEnd(e) : g.nodeEnd(e); }
+
+inline IndexType target(const CktBipartiteEdge &e, const CktBipartiteGraph &g) { return e.fromNet ? g.nodeEnd(e) : g.netEnd(e); }
+
+inline std::pair<CktBipartiteOutEdgeIterator, CktBipartiteOutEdgeIterator> out_edges(IndexType v, const CktBipartiteGraph &g)
+{
+    Span<const IndexType> pins = g.pins(v);
+    bool fromNet = g.isNetVertex(v);
+    return std::make_pair(CktBipartiteOutEdgeIterator(&g, pins.begin(), pins.end(), fromNet),
+                          CktBipartiteOutEdgeIterator(&g, pins.end(), pins.end(), fromNet));
+}
+
+inline IndexType out_degree(IndexType v, const CktBipartiteGraph &g)
+{
+    auto edges = out_edges(v, g);
+    return static_cast<IndexType>(std::distance(edges.first, edges.second));
+}
+
+inline std::pair<boost::counting_iterator<IndexType>, boost::counting_iterator<IndexType>> vertices(const CktBipartiteGraph &g)
+{
+    return std::make_pair(boost::counting_iterator<IndexType>(0), boost::counting_iterator<IndexType>(g.numVertices()));
+}
+
+inline IndexType num_vertices(const CktBipartiteGraph &g) { return g.numVertices(); }
+
+inline boost::typed_identity_property_map<IndexType> get(boost::vertex_index_t, const CktBipartiteGraph &)
+{
+    return boost::typed_identity_property_map<IndexType>();
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_CKTGRAPH_BGL_H_
@@ -5,69 +5,656 @@
  */
 
 #include "db/DesignDB.h"
+#include "db/CktGraphAlgo.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
 
 PROJECT_NAMESPACE_BEGIN
 
 
-bool DesignDB::findRootCkt()                        // 设计找到层次结构根电路
+bool DesignDB::findRootCkt()
 {
-    if (this->numCkts() == 0) { return true; }      // 检查设计中是否有电路，如果没有直接返回True
+    IndexType numCkts = this->numCkts();
+    _rootCkt = INDEX_TYPE_MAX;
+    _rootCkts.clear();
+    _cktLevels.assign(numCkts, 0);
+    _levelStart.assign(1, 0);
+    _levelCkts.clear();
+    if (numCkts == 0) { return true; }
 
-    std::stack<IndexType> sortStack; //< Store the sorted indices here
-    std::vector<IntType> visited; //< Mark whether one sub circuit has been visited
-    std::stack<IndexType> stack; //< for DFS
-                                                    // 这几行定义了几个stack与vector用于DFS和拓扑排序
-    // Initialize the variables
-    visited.resize(this->numCkts(), 0);             // 初始化visited向量，大小为电路数量，每个元素初始化为0
+    // The level of a circuit is the height of its sub tree, computed by an iterative post-order DFS
+    // 0: not visited, 1: children pushed, 2: done. Meeting a circuit in state 1 again means a cycle
+    std::vector<Byte> state(numCkts, 0);
+    std::vector<IndexType> numParents(numCkts, 0);
+    std::vector<IndexType> stack;
+    for (IndexType startIdx = 0; startIdx < numCkts; ++startIdx)
+    {
+        if (state[startIdx] != 0)
+        {
+            continue;
+        }
+        stack.push_back(startIdx);
+        while (!stack.empty())
+        {
+            IndexType cktIdx = stack.back();
+            if (state[cktIdx] == 0)
+            {
+                state[cktIdx] = 1;
+                for (IndexType graphIdx : _ckts[cktIdx].nodeSubgraphIdx())
+                {
+                    if (graphIdx == INDEX_TYPE_MAX)
+                    {
+                        continue;
+                    }
+                    if (state.at(graphIdx) == 1)
+                    {
+                        ERR("DesignDB::%s: circuit %s instantiates its ancestor %s \n", __FUNCTION__, _ckts[cktIdx].name().c_str(), _ckts[graphIdx].name().c_str());
+                        return false;
+                    }
+                    if (state[graphIdx] == 0)
+                    {
+                        stack.push_back(graphIdx);
+                    }
+                }
+                continue;
+            }
+            stack.pop_back();
+            if (state[cktIdx] == 1)
+            {
+                IndexType level = 0;
+                for (IndexType graphIdx : _ckts[cktIdx].nodeSubgraphIdx())
+                {
+                    if (graphIdx != INDEX_TYPE_MAX)
+                    {
+                        level = std::max(level, _cktLevels[graphIdx] + 1);
+                        ++numParents[graphIdx];
+                    }
+                }
+                _cktLevels[cktIdx] = level;
+                state[cktIdx] = 2;
+            }
+        }
+    }
+
+    // Bucket the circuits by level, in index order within a level
+    IndexType numLevels = *std::max_element(_cktLevels.begin(), _cktLevels.end()) + 1;
+    _levelStart.assign(numLevels + 1, 0);
+    for (IndexType level : _cktLevels)
+    {
+        ++_levelStart[level + 1];
+    }
+    for (IndexType level = 0; level < numLevels; ++level)
+    {
+        _levelStart[level + 1] += _levelStart[level];
+    }
+    _levelCkts.resize(numCkts);
+    std::vector<IndexType> fill(_levelStart.begin(), _levelStart.end() - 1);
+    for (IndexType cktIdx = 0; cktIdx < numCkts; ++cktIdx)
+    {
+        _levelCkts[fill[_cktLevels[cktIdx]]++] = cktIdx;
+    }
+
+    // The root is the highest circuit nobody instantiates. The last one if there are several at the same level
+    for (IndexType cktIdx = 0; cktIdx < numCkts; ++cktIdx)
+    {
+        if (numParents[cktIdx] != 0)
+        {
+            continue;
+        }
+        _rootCkts.emplace_back(cktIdx);
+        if (_rootCkt == INDEX_TYPE_MAX || _cktLevels[cktIdx] >= _cktLevels[_rootCkt])
+        {
+            _rootCkt = cktIdx;
+        }
+    }
+    return true;
+}
+
+std::vector<IndexType> DesignDB::topoOrder() const
+{
+    std::vector<IndexType> order;
+    order.reserve(_levelCkts.size());
+    for (IndexType level = numLevels(); level > 0; --level)
+    {
+        auto ckts = levelCkts(level - 1);
+        order.insert(order.end(), ckts.begin(), ckts.end());
+    }
+    return order;
+}
+
+std::vector<IndexType> DesignDB::subtreeCkts(IndexType cktIdx) const
+{
+    AssertMsg(cktIdx < _cktLevels.size(), "DesignDB::%s: the levels of circuit %u are not computed \n", __FUNCTION__, cktIdx);
+    std::vector<Byte> inTree(this->numCkts(), 0);
+    std::vector<IndexType> stack(1, cktIdx);
+    inTree[cktIdx] = 1;
+    while (!stack.empty())
+    {
+        IndexType idx = stack.back();
+        stack.pop_back();
+        for (IndexType graphIdx : _ckts[idx].nodeSubgraphIdx())
+        {
+            if (graphIdx != INDEX_TYPE_MAX && !inTree[graphIdx])
+            {
+                inTree[graphIdx] = 1;
+                stack.push_back(graphIdx);
+            }
+        }
+    }
+    std::vector<IndexType> ckts;
+    for (IndexType idx : _levelCkts)
+    {
+        if (inTree[idx])
+        {
+            ckts.emplace_back(idx);
+        }
+    }
+    return ckts;
+}
+
+FlatDesign DesignDB::flatten() const
+{
+    AssertMsg(_rootCkt != INDEX_TYPE_MAX, "DesignDB::%s: the root circuit is not found yet \n", __FUNCTION__);
+    FlatDesign flat;
+    flat.build(*this, _rootCkt);
+    return flat;
+}
+
+void DesignDB::computeStructHashes()
+{
+    std::vector<IndexType> all(this->numCkts());
+    std::iota(all.begin(), all.end(), 0);
+    updateStructHashes(all, std::vector<Byte>(this->numCkts(), 1));
+}
+
+HashType DesignDB::structHash(IndexType cktIdx)
+{
+    if (cktIdx >= this->numCkts())
+    {
+        throw std::out_of_range("DesignDB::structHash: invalid circuit " + std::to_string(cktIdx));
+    }
+    updateStructHashes(std::vector<IndexType>{ cktIdx }, std::vector<Byte>());
+    return _structHashes[cktIdx];
+}
+
+HashType DesignDB::structInputs(IndexType cktIdx) const
+{
+    const CktGraph &ckt = _ckts[cktIdx];
+    HashType hash = HashUtil::combine(static_cast<HashType>(ckt.implType()), _phyPropDB.propHash(ckt.implType(), ckt.implIdx()));
+    hash = HashUtil::combine(hash, ckt.numPins());
+    for (const Pin &pin : ckt.pinArray())
+    {
+        hash = HashUtil::combine(hash, pin.nodeIdx());
+        hash = HashUtil::combine(hash, pin.netIdx());
+        hash = HashUtil::combine(hash, static_cast<HashType>(pin.pinType()) * 2 + pin.valid());
+    }
+    const CktNodeArrays &nodes = ckt.nodeArrays();
+    hash = HashUtil::combine(hash, nodes.size());
+    for (IndexType nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+    {
+        IndexType graphIdx = nodes.graphIdx[nodeIdx];
+        hash = HashUtil::combine(hash, graphIdx == INDEX_TYPE_MAX ? nodes.cold[nodeIdx].refNameId : _structHashes.at(graphIdx));
+    }
+    const NetArrays &nets = ckt.netArrays();
+    hash = HashUtil::combine(hash, nets.size());
+    for (IndexType netIdx = 0; netIdx < nets.size(); ++netIdx)
+    {
+        hash = HashUtil::combine(hash, nets.flags[netIdx]);
+        hash = HashUtil::combine(hash, nets.cold[netIdx].ioPos);
+    }
+    return hash;
+}
+
+bool DesignDB::sameStructure(IndexType lhsIdx, IndexType rhsIdx) const
+{
+    const CktGraph &lhs = _ckts[lhsIdx];
+    const CktGraph &rhs = _ckts[rhsIdx];
+    if (lhs.implType() != rhs.implType() || !_phyPropDB.propEquals(lhs.implType(), lhs.implIdx(), rhs.implIdx()))
+    {
+        return false;
+    }
+    if (lhs.numPins() != rhs.numPins() || lhs.numNodes() != rhs.numNodes() || lhs.numNets() != rhs.numNets())
+    {
+        return false;
+    }
+    const CktNodeArrays &lhsNodes = lhs.nodeArrays();
+    const CktNodeArrays &rhsNodes = rhs.nodeArrays();
+    const NetArrays &lhsNets = lhs.netArrays();
+    const NetArrays &rhsNets = rhs.netArrays();
+    // A node is its reference name if it is a leaf, or the hash of its subgraph
+    auto nodeKey = [&](const CktNodeArrays &nodes, IndexType nodeIdx)
+    {
+        IndexType graphIdx = nodes.graphIdx[nodeIdx];
+        return graphIdx == INDEX_TYPE_MAX ? std::make_pair(0, static_cast<HashType>(nodes.cold[nodeIdx].refNameId))
+                                          : std::make_pair(1, _structHashes.at(graphIdx));
+    };
+    if (MfUtil::isImplTypeDevice(lhs.implType()))
+    {
+        // The pins of a device are in the order of its ports, so the devices are compared as they are
+        for (IndexType pinIdx = 0; pinIdx < lhs.numPins(); ++pinIdx)
+        {
+            const Pin &lhsPin = lhs.pinArray()[pinIdx];
+            const Pin &rhsPin = rhs.pinArray()[pinIdx];
+            if (lhsPin.nodeIdx() != rhsPin.nodeIdx() || lhsPin.netIdx() != rhsPin.netIdx()
+                || lhsPin.pinType() != rhsPin.pinType() || lhsPin.valid() != rhsPin.valid())
+            {
+                return false;
+            }
+        }
+        for (IndexType nodeIdx = 0; nodeIdx < lhsNodes.size(); ++nodeIdx)
+        {
+            if (nodeKey(lhsNodes, nodeIdx) != nodeKey(rhsNodes, nodeIdx))
+            {
+                return false;
+            }
+        }
+        for (IndexType netIdx = 0; netIdx < lhsNets.size(); ++netIdx)
+        {
+            if (lhsNets.flags[netIdx] != rhsNets.flags[netIdx] || lhsNets.cold[netIdx].ioPos != rhsNets.cold[netIdx].ioPos)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+    // The hash of the other circuits does not depend on the order of the nodes and nets. Compare what does not either
+    auto sortedNodes = [&](const CktNodeArrays &nodes)
+    {
+        std::vector<std::pair<int, HashType>> keys;
+        for (IndexType nodeIdx = 0; nodeIdx < nodes.size(); ++nodeIdx)
+        {
+            keys.emplace_back(nodeKey(nodes, nodeIdx));
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    auto sortedNets = [&](const NetArrays &nets)
+    {
+        std::vector<std::pair<Byte, IndexType>> keys;
+        for (IndexType netIdx = 0; netIdx < nets.size(); ++netIdx)
+        {
+            keys.emplace_back(nets.flags[netIdx], nets.cold[netIdx].ioPos);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    auto sortedPins = [&](const CktGraph &ckt)
+    {
+        std::vector<std::pair<IntType, bool>> keys;
+        for (const Pin &pin : ckt.pinArray())
+        {
+            keys.emplace_back(static_cast<IntType>(pin.pinType()), pin.valid());
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    };
+    return sortedNodes(lhsNodes) == sortedNodes(rhsNodes) && sortedNets(lhsNets) == sortedNets(rhsNets) && sortedPins(lhs) == sortedPins(rhs);
+}
+
+void DesignDB::updateStructHashes(const std::vector<IndexType> &tops, const std::vector<Byte> &forced, bool onlyForced)
+{
+    // The circuits added since the last update have never been hashed
+    std::vector<Byte> rehash(forced);
+    rehash.resize(this->numCkts(), 0);
+    for (IndexType cktIdx = _structHashes.size(); cktIdx < this->numCkts(); ++cktIdx)
+    {
+        rehash[cktIdx] = 1;
+    }
+    _structHashes.resize(this->numCkts(), 0);
+    _structInputs.resize(this->numCkts(), 0);
+    // 0: not visited, 1: children pushed, 2: up to date
+    std::vector<Byte> state(this->numCkts(), 0);
+    std::vector<IndexType> stack;
+    for (IndexType startIdx : tops)
+    {
+        if (state[startIdx] != 0)
+        {
+            continue;
+        }
+        stack.push_back(startIdx);
+        while (!stack.empty())
+        {
+            IndexType cktIdx = stack.back();
+            if (state[cktIdx] == 0)
+            {
+                // Bring the children up to date first, their hashes are part of the digest
+                state[cktIdx] = 1;
+                for (IndexType graphIdx : _ckts[cktIdx].nodeSubgraphIdx())
+                {
+                    if (graphIdx == INDEX_TYPE_MAX || state.at(graphIdx) != 0)
+                    {
+                        continue;
+                    }
+                    if (onlyForced && !rehash[graphIdx])
+                    {
+                        state[graphIdx] = 2;
+                        continue;
+                    }
+                    stack.push_back(graphIdx);
+                }
+                continue;
+            }
+            stack.pop_back();
+            if (state[cktIdx] == 1)
+            {
+                HashType inputs = structInputs(cktIdx);
+                if (rehash[cktIdx] || inputs != _structInputs[cktIdx])
+                {
+                    const CktGraph &ckt = _ckts[cktIdx];
+                    _structHashes[cktIdx] = CktGraphAlgo::structuralHash(ckt, _structHashes, _phyPropDB.propHash(ckt.implType(), ckt.implIdx()));
+                    _structInputs[cktIdx] = inputs;
+                }
+                state[cktIdx] = 2;
+            }
+        }
+    }
+}
 
+std::vector<IndexType> DesignDB::structEquivClasses()
+{
+    std::vector<IndexType> all(this->numCkts());
+    std::iota(all.begin(), all.end(), 0);
+    updateStructHashes(all, std::vector<Byte>());
+    std::vector<IndexType> classes(this->numCkts());
+    // The representatives of each hash. The circuits of equal hash are only grouped if they really are equal
+    std::unordered_map<HashType, std::vector<IndexType>> reps;
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        std::vector<IndexType> &candidates = reps[_structHashes[cktIdx]];
+        auto it = std::find_if(candidates.begin(), candidates.end(), [&](IndexType rep) { return sameStructure(rep, cktIdx); });
+        if (it == candidates.end())
+        {
+            candidates.emplace_back(cktIdx);
+            classes[cktIdx] = cktIdx;
+        }
+        else
+        {
+            classes[cktIdx] = *it;
+        }
+    }
+    return classes;
+}
 
+void DesignDB::resizeSubCkts(IndexType numCkts)
+{
+    Assert(numCkts <= _ckts.size());
+    std::vector<IndexType> newIdx(_ckts.size(), INDEX_TYPE_MAX);
+    std::iota(newIdx.begin(), newIdx.begin() + numCkts, 0);
+    remapFlippedCopies(newIdx);
+    _ckts.resize(numCkts);
+    ++_cktEdits;
+}
 
-    //============================ DFS 约束图缺少位置约束 =============================//
-    
-    for (IndexType startIdx = 0;  startIdx < this->numCkts(); ++startIdx)           // 开始遍历所有电路，进行DFS
+void DesignDB::remapFlippedCopies(const std::vector<IndexType> &newIdx)
+{
+    std::vector<IndexType> copies = std::move(_flippedCopies);
+    _flippedCopies.clear();
+    _flippedOriginals.clear();
+    for (IndexType cktIdx = 0; cktIdx < copies.size(); ++cktIdx)
     {
-        if (visited[startIdx] == 1)                                                 // 下面几行判断当前电路是否访问过，如果访问过则继续循环，否则入栈
+        if (copies[cktIdx] == INDEX_TYPE_MAX)
         {
             continue;
         }
-        stack.push(startIdx);                   
-       
+        IndexType origIdx = newIdx[cktIdx];
+        IndexType copyIdx = newIdx[copies[cktIdx]];
+        // A dropped copy, or one merged back into its circuit, is made again when needed
+        if (origIdx == INDEX_TYPE_MAX || copyIdx == INDEX_TYPE_MAX || origIdx == copyIdx)
+        {
+            continue;
+        }
+        IndexType size = std::max(origIdx, copyIdx) + 1;
+        if (_flippedCopies.size() < size)
+        {
+            _flippedCopies.resize(size, INDEX_TYPE_MAX);
+            _flippedOriginals.resize(size, INDEX_TYPE_MAX);
+        }
+        _flippedCopies[origIdx] = copyIdx;
+        _flippedOriginals[copyIdx] = origIdx;
+    }
+}
 
-       std::stack<IndexType> innerStack; //< Store the sorting of the current DFS
-        while (!stack.empty())                                                      
+IndexType DesignDB::dedupDevices()
+{
+    std::vector<IndexType> classes = structEquivClasses();
+    std::vector<IndexType> newIdx(this->numCkts(), INDEX_TYPE_MAX);
+    IndexType numDevices = 0;
+    IndexType numKept = 0;
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        bool isDevice = MfUtil::isImplTypeDevice(_ckts[cktIdx].implType());
+        numDevices += isDevice ? 1 : 0;
+        if (isDevice && classes[cktIdx] != cktIdx)
+        {
+            // The master comes first, so it already has its new index
+            newIdx[cktIdx] = newIdx[classes[cktIdx]];
+            continue;
+        }
+        classes[cktIdx] = cktIdx;
+        newIdx[cktIdx] = numKept++;
+    }
+    IndexType numMasters = numDevices - (this->numCkts() - numKept);
+    INF("DesignDB::%s: %u device circuits merged into %u unique cells \n", __FUNCTION__, numDevices, numMasters);
+    if (numKept == this->numCkts())
+    {
+        return numMasters;
+    }
+    // Compact the kept circuits and remap the nodes
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        if (classes[cktIdx] != cktIdx)
         {
-            auto nodeIdx = stack.top();
-            stack.pop();
-            visited.at(nodeIdx) = 1;                                                // 这几行开始DFS遍历，获取当前电路编号nodeIdx，标记为已访问，并从栈中弹出
-            
-            
-            for (const auto & childNode : _ckts.at(nodeIdx).nodeArray())            // 开始遍历当前电路的所有节点
+            continue;
+        }
+        if (newIdx[cktIdx] != cktIdx)
+        {
+            _ckts[newIdx[cktIdx]] = std::move(_ckts[cktIdx]);
+            _structHashes[newIdx[cktIdx]] = _structHashes[cktIdx];
+            _structInputs[newIdx[cktIdx]] = _structInputs[cktIdx];
+        }
+        CktGraph &ckt = _ckts[newIdx[cktIdx]];
+        for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx)
+        {
+            IndexType graphIdx = ckt.nodeSubgraphIdx()[nodeIdx];
+            if (graphIdx != INDEX_TYPE_MAX)
             {
-                if (childNode.isLeaf())
+                ckt.node(nodeIdx).setSubgraphIdx(newIdx.at(graphIdx));
+            }
+        }
+    }
+    remapFlippedCopies(newIdx);
+    _ckts.resize(numKept);
+    ++_cktEdits;
+    _structHashes.resize(numKept);
+    _structInputs.resize(numKept);
+    _cktNameIndex.invalidate();
+    _parents.clear();
+    _parentEdits.clear();
+    _dirty.clear();
+    _layoutMasters.clear();
+    if (_rootCkt != INDEX_TYPE_MAX)
+    {
+        findRootCkt();
+    }
+    return numMasters;
+}
+
+IndexType DesignDB::shareIdenticalLayouts()
+{
+    _layoutMasters.clear();
+    IndexType numLayouts = 0;
+    IndexType numSharing = 0;
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        if (!_ckts[cktIdx].isLayoutLoaded())
+        {
+            continue;
+        }
+        if (shareIdenticalLayout(cktIdx))
+        {
+            ++numSharing;
+        }
+        else
+        {
+            ++numLayouts;
+        }
+    }
+    INF("DesignDB::%s: %u circuits share %u unique layouts \n", __FUNCTION__, numLayouts + numSharing, numLayouts);
+    return numLayouts;
+}
+
+bool DesignDB::shareIdenticalLayout(IndexType cktIdx)
+{
+    CktGraph &ckt = _ckts.at(cktIdx);
+    if (!ckt.isLayoutLoaded())
+    {
+        return false;
+    }
+    // Look for a circuit offering the same layout as this one sees it, or its mirror
+    const Layout &layout = ckt.layoutSource();
+    bool flip = ckt.layoutSourceFlipVert();
+    for (bool mirror : { false, true })
+    {
+        auto range = _layoutMasters.equal_range(layout.hash(flip != mirror));
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            // The masters removed since, or edited since under another hash, are skipped by the checks
+            if (it->second >= this->numCkts() || !_ckts[it->second].isLayoutLoaded())
+            {
+                continue;
+            }
+            CktGraph &master = _ckts[it->second];
+            const Layout &masterLayout = master.layoutSource();
+            bool relFlip = (flip != master.layoutSourceFlipVert()) != mirror;
+            if (&masterLayout == &layout ? !relFlip : layout.equals(masterLayout, relFlip))
+            {
+                if (it->second == cktIdx)
                 {
-                    continue;
+                    return false;
                 }
-                IndexType graphIdx = childNode.subgraphIdx();                       //============= 叶节点 ==============//
-                if (visited[graphIdx] == 1)                                         // 这里的叶节点指在设计的层级结构中最底层的节点，不包含子电路
-                {                                                                   // 叶节点通常对应一个实例或基本单元
-                    continue;                                                       //==================================//
+                ckt.shareLayout(master, mirror);
+                return true;
+            }
+        }
+    }
+    _layoutMasters.emplace(layout.hash(flip), cktIdx);
+    return false;
+}
+
+IndexType DesignDB::propagateEdits()
+{
+    _dirty.resize(this->numCkts(), 0);
+    std::vector<IndexType> stack;
+    // The parents are kept up to date from the journals once built. A circuit changed outside its journal, such as a node moved to
+    // another subgraph through its view or an implementation restored, is edited, and the parents are built again
+    bool rebuildParents = _parents.size() != this->numCkts();
+    for (IndexType cktIdx = 0; cktIdx < _parentEdits.size() && cktIdx < this->numCkts(); ++cktIdx)
+    {
+        if (_ckts[cktIdx].nodeArrays().untrackedEdits != _parentEdits[cktIdx])
+        {
+            rebuildParents = true;
+            _dirty[cktIdx] = 2;
+            stack.push_back(cktIdx);
+        }
+    }
+    if (rebuildParents)
+    {
+        _parents.assign(this->numCkts(), std::vector<IndexType>());
+        _parentEdits.resize(this->numCkts());
+        for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+        {
+            _parentEdits[cktIdx] = _ckts[cktIdx].nodeArrays().untrackedEdits;
+            for (IndexType graphIdx : _ckts[cktIdx].nodeSubgraphIdx())
+            {
+                if (graphIdx != INDEX_TYPE_MAX)
+                {
+                    _parents.at(graphIdx).emplace_back(cktIdx);
                 }
-                stack.push(graphIdx);                                               // 循环内判断子节点是否叶节点，以及对应子电路是否访问过，
-                                                                                    // 如果是叶节点或已访问则继续循环，否则将子电路入栈
             }
-            innerStack.push(nodeIdx); // Add to the vector (used as stack)          // 将当前电路入innerStack栈，用于后续拓扑排序
         }
-        // Add the DFS result to the overall order
-        while (!innerStack.empty())
+    }
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        CktGraph &ckt = _ckts[cktIdx];
+        if (ckt.journal().empty())
+        {
+            continue;
+        }
+        for (const CktEdit &edit : ckt.journal())
         {
-            sortStack.push(innerStack.top());
-            innerStack.pop();
-        }                                                                           // 这几行从innerstack中弹出元素，并将排序结果push到sortStack，实现当前DFS的拓扑排序
+            if (rebuildParents)
+            {
+                break;
+            }
+            if (edit.type == CktEditType::ADD_NODE && edit.to != INDEX_TYPE_MAX)
+            {
+                _parents.at(edit.to).emplace_back(cktIdx);
+            }
+            else if (edit.type == CktEditType::REMOVE_NODE && edit.from != INDEX_TYPE_MAX)
+            {
+                auto &parents = _parents.at(edit.from);
+                auto it = std::find(parents.begin(), parents.end(), cktIdx);
+                if (it != parents.end())
+                {
+                    parents.erase(it);
+                }
+            }
+        }
+        ckt.clearJournal();
+        _dirty[cktIdx] = 2;
+        stack.push_back(cktIdx);
+    }
+    // Mark the ancestors
+    while (!stack.empty())
+    {
+        IndexType cktIdx = stack.back();
+        stack.pop_back();
+        for (IndexType parentIdx : _parents[cktIdx])
+        {
+            if (_dirty[parentIdx] == 0)
+            {
+                _dirty[parentIdx] = 1;
+                stack.push_back(parentIdx);
+            }
+        }
     }
+    return std::count_if(_dirty.begin(), _dirty.end(), [](Byte dirty) { return dirty != 0; });
+}
 
-    _rootCkt = sortStack.top();                                                     // 这行获取sortstack栈顶元素作为根电路
-    return true;
+std::vector<IndexType> DesignDB::dirtyCkts() const
+{
+    std::vector<IndexType> ckts;
+    for (IndexType cktIdx = 0; cktIdx < _dirty.size(); ++cktIdx)
+    {
+        if (_dirty[cktIdx] != 0)
+        {
+            ckts.emplace_back(cktIdx);
+        }
+    }
+    return ckts;
+}
+
+void DesignDB::updateDirty()
+{
+    _dirty.resize(this->numCkts(), 0);
+    std::vector<IndexType> dirty = dirtyCkts();
+    for (IndexType cktIdx : dirty)
+    {
+        // The edits patch the packed connectivity. Only the one dropped by an allocation or a view is rebuilt
+        if (_dirty[cktIdx] == 2 && !_ckts[cktIdx].isFinalized())
+        {
+            _ckts[cktIdx].finalize();
+        }
+    }
+    // The clean circuits are up to date, so only the dirty ones are visited
+    updateStructHashes(dirty, _dirty, true);
+    for (IndexType cktIdx : dirty)
+    {
+        _dirty[cktIdx] = 0;
+    }
 }
 
 PROJECT_NAMESPACE_END
@@ -11,6 +11,14 @@
 #include "GraphComponents.h"
 #include "CktGraph.h"
 #include "PhysicalProp.h"
+#include "SymbolTable.h"
+#include "FlatDesign.h"
+#include "MemoryReport.h"
+#include "util/StableVector.h"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -20,48 +28,216 @@ class DesignDB
 {
     public:
         /// @brief default constructor
-        explicit DesignDB() 
-        {
-            _ckts.reserve(10000); // reserve enough spaces
-        }
+        explicit DesignDB() = default;
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
         /// @brief get the circuit hierarchical tree
         /// @return the circuit hierarchical tree
-        const std::vector<CktGraph> & ckts() const { return _ckts; }
+        const StableVector<CktGraph> & ckts() const { return _ckts; }
         /// @brief get the circuit hierarchical tree
         /// @return the circuit hierarchical tree
-        std::vector<CktGraph> & ckts() { return _ckts; }
+        StableVector<CktGraph> & ckts() { return _ckts; }
         /// @brief get the number of circuits
         /// @return the number of circuits
         IndexType numCkts() const { return _ckts.size(); }
-        /// @brief resize the sub ckts
+        /// @brief resize the sub ckts. The dropped flipped copies are forgotten
         /// @param the size of the resulting vector
-        void resizeSubCkts(IndexType numCkts) { Assert(numCkts <= _ckts.size()); _ckts.resize(numCkts); }
-        /// @brief get a sub circuit
+        void resizeSubCkts(IndexType numCkts);
+        /// @brief get a sub circuit. The reference stays valid when circuits are allocated
         /// @param the index of the sub circuit
         /// @return the sub circuit in the hierarchical tree
         CktGraph & subCkt(IndexType idx) { return _ckts.at(idx); }
+        /// @brief find a sub circuit by name
+        /// @param the name of the circuit
+        /// @return the index of the circuit. INDEX_TYPE_MAX if not found
+        IndexType findCkt(const std::string &name) const
+        {
+            // The circuits count their renames in the counter of the design. The sum with the circuits added and removed only grows,
+            // so it tells if any circuit changed
+            IndexType edits = _cktEdits + _cktRenames->load(std::memory_order_relaxed);
+            if (_cktNameIndex.isStale(_ckts.size(), edits))
+            {
+                _cktNameIndex.build(_ckts.size(), edits, [&](IndexType idx) { return _ckts[idx].nameId(); });
+            }
+            return _cktNameIndex.find(SymbolTable::global().find(name));
+        }
         /// @brief get the index of the root node 获取根节点的索引
         /// @return the index of the root node  返回根节点的索引
         IndexType rootCktIdx() const { return _rootCkt; }
         /// @brief get PhyPropDB
         /// @return the physical property DB
         PhyPropDB & phyPropDB() { return _phyPropDB; }
+        /// @brief get the symbol table of the names. It is shared by all the designs of the process
+        /// @return the symbol table
+        SymbolTable & symbolTable() { return SymbolTable::global(); }
         /*------------------------------*/ 
         /* Vector operation             */
         /*------------------------------*/ 
-        /// @brief allocate a new sub circuit 
+        /// @brief allocate a new sub circuit. The circuit table mutex is held meanwhile, see setCktTableMutex()
         /// @return the index of the new sub circuit
-        IndexType allocateCkt() { _ckts.emplace_back(CktGraph()); return _ckts.size() - 1; }
+        IndexType allocateCkt()
+        {
+            std::unique_lock<std::mutex> lock = lockCktTable();
+            _ckts.emplace_back(CktGraph()).setRenameCounter(_cktRenames);
+            ++_cktEdits;
+            return _ckts.size() - 1;
+        }
+        /// @brief append a copy of a circuit under another name. The copy refers to the same device property and is not implemented
+        /// @param first: the index of the circuit
+        /// @param second: the name of the copy
+        /// @return the index of the copy
+        IndexType copyCkt(IndexType cktIdx, const std::string &name)
+        {
+            CktGraph copy = _ckts.at(cktIdx);
+            copy.setName(name);
+            copy.clearImpl();
+            std::unique_lock<std::mutex> lock = lockCktTable();
+            _ckts.emplace_back(std::move(copy));
+            ++_cktEdits;
+            return _ckts.size() - 1;
+        }
+        /// @brief get the flipped copy of a circuit, or append one with copyCkt() the first time. The relation is kept in the checkpoint
+        /// @param first: the index of the circuit
+        /// @param second: the name of the copy if it is made
+        /// @return the index of the flipped copy
+        IndexType flippedCopyOf(IndexType cktIdx, const std::string &name)
+        {
+            IndexType copyIdx = flippedCopy(cktIdx);
+            if (copyIdx != INDEX_TYPE_MAX)
+            {
+                return copyIdx;
+            }
+            copyIdx = copyCkt(cktIdx, name);
+            _flippedCopies.resize(_ckts.size(), INDEX_TYPE_MAX);
+            _flippedOriginals.resize(_ckts.size(), INDEX_TYPE_MAX);
+            _flippedCopies[cktIdx] = copyIdx;
+            _flippedOriginals[copyIdx] = cktIdx;
+            return copyIdx;
+        }
+        /// @brief get the flipped copy of a circuit made by flippedCopyOf()
+        /// @param the index of the circuit
+        /// @return the index of the copy. INDEX_TYPE_MAX if there is none
+        IndexType flippedCopy(IndexType cktIdx) const { return cktIdx < _flippedCopies.size() ? _flippedCopies[cktIdx] : INDEX_TYPE_MAX; }
+        /// @brief get the circuit a flipped copy made by flippedCopyOf() is of
+        /// @param the index of the circuit
+        /// @return the index of the original circuit. INDEX_TYPE_MAX if the circuit is not a flipped copy
+        IndexType flippedOriginal(IndexType cktIdx) const { return cktIdx < _flippedOriginals.size() ? _flippedOriginals[cktIdx] : INDEX_TYPE_MAX; }
+        /// @brief set the mutex held while a circuit is appended, so that another thread may look up the circuits under it meanwhile.
+        /// ImplScheduler::run() sets its own, as its workers read the circuits without the GIL while the callbacks allocate
+        /// @param the mutex. Null for none
+        void setCktTableMutex(std::mutex *mutex) { _cktTableMutex = mutex; }
         
         /*------------------------------*/ 
         /* Maintainence of the hierarch */
         /*------------------------------*/ 
-        /// @brief topological sort of the hierarchical tree. The top level therefore is surely placed at the first level
-        /// @return if successful
+        /// @brief levelize the hierarchy and find its roots. A circuit without sub circuits is at level 0, and every other circuit
+        /// is one level above its highest sub circuit, so the circuits of one level do not depend on each other.
+        /// The root is the highest of the circuits that are not instantiated. Call it again after changing the hierarchy
+        /// @return false if the hierarchy has a cycle
         bool findRootCkt();
+        /// @brief get all the circuits that are not instantiated by other circuits. Computed by findRootCkt()
+        /// @return the indices of the root circuits, in increasing order
+        const std::vector<IndexType> & rootCkts() const { return _rootCkts; }
+        /// @brief get the number of levels of the hierarchy. Computed by findRootCkt()
+        /// @return the number of levels
+        IndexType numLevels() const { return _levelStart.empty() ? 0 : _levelStart.size() - 1; }
+        /// @brief get the level of a circuit. Computed by findRootCkt()
+        /// @param the index of the circuit
+        /// @return the level. 0 for the circuits without sub circuits
+        IndexType cktLevel(IndexType cktIdx) const { return _cktLevels.at(cktIdx); }
+        /// @brief get the circuits at a level. Computed by findRootCkt()
+        /// @param the level
+        /// @return the view of the circuit indices, in increasing order
+        Span<const IndexType> levelCkts(IndexType level) const
+        {
+            IndexType end = _levelStart.at(level + 1);
+            return Span<const IndexType>(_levelCkts.data() + _levelStart[level], end - _levelStart[level]);
+        }
+        /// @brief get all the circuits in topological order, by level from the top. Computed by findRootCkt()
+        /// @return the circuit indices. Every circuit comes before its sub circuits
+        std::vector<IndexType> topoOrder() const;
+        /// @brief get a circuit and all the circuits under it, bottom-up by level. Computed by findRootCkt()
+        /// @param the index of the circuit
+        /// @return the circuit indices. Every circuit comes after its sub circuits
+        std::vector<IndexType> subtreeCkts(IndexType cktIdx) const;
+        /// @brief pack the connectivity of all the circuits. See CktGraph::finalize()
+        void finalize() { for (auto &ckt : _ckts) { ckt.finalize(); } }
+        /// @brief expand the hierarchy under the root circuit down to the devices. See FlatDesign
+        /// @return the flat view. It is not updated by later changes to the design
+        FlatDesign flatten() const;
+        /*------------------------------*/ 
+        /* Memory                       */
+        /*------------------------------*/ 
+        /// @brief count the heap memory held by the design: the circuits by kind, the layouts by layer and the PhyPropDB.
+        /// The bytes are allocated capacity, not size. The layouts still in a checkpoint file are not read. The process-wide symbol table is reported on its own
+        /// @param the number of heaviest circuits to list
+        /// @return the report
+        MemoryReport memoryReport(IndexType topN = 10) const;
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        /// @brief save the circuits, the device properties, the layouts and the implementation state to a versioned binary file.
+        /// The edit journals are not saved. The circuits sharing a TechDB share one copy in the file. The circuits whose implementation is in progress
+        /// are saved as CktGraph::rollbackImpl() leaves them, without what their placement added
+        /// @param the file name. The file is replaced only after the new one is completely written
+        /// @return whether the file is written
+        bool save(const std::string &filename) const;
+        /// @brief replace the design by a checkpoint written by save(), and levelize the hierarchy again.
+        /// The references to the old circuits and their node and net views are invalidated
+        /// @param first: the file name
+        /// @param second: whether to leave the layouts in the memory-mapped file until CktGraph::layout() is first called
+        /// @return false if the file is not a checkpoint of this version, is corrupted, has indices out of range or a hierarchy with a cycle.
+        /// The design is unchanged then
+        bool load(const std::string &filename, bool lazyLayouts = true);
+        /*------------------------------*/ 
+        /* Structural equivalence       */
+        /*------------------------------*/ 
+        /// @brief compute the structural hash of every circuit, children before parents. See CktGraphAlgo::structuralHash
+        void computeStructHashes();
+        /// @brief get the structural hash of a circuit. The circuit and its descendants are checked on every call, and the ones
+        /// whose pins, nodes, nets, device property or subgraph hashes changed since they were hashed are hashed again
+        /// @param the index of the circuit
+        /// @return the hash. The same for circuits of the same netlist structure and device properties, regardless of the names
+        HashType structHash(IndexType cktIdx);
+        /// @brief group the circuits by structural hash. The circuits of equal hash are compared before they are grouped, so a hash
+        /// collision never merges two different devices. See sameStructure()
+        /// @return the representative of each circuit, which is the first circuit of the same hash and structure
+        std::vector<IndexType> structEquivClasses();
+        /// @brief merge the structurally identical device circuits into one master each. The nodes are remapped to the masters
+        /// and keep their own offset, orientation and flip flag. The merged circuits are removed and the remaining circuits are
+        /// compacted in order, so the circuits before the first merged one keep their indices.
+        /// The kept circuits are move-assigned into their new indices: references to circuits and the node, net and pin views
+        /// taken before, including the ones held by Python, must be taken again
+        /// @return the number of unique device circuits
+        IndexType dedupDevices();
+        /// @brief let the circuits with identical layouts, or layouts mirrored by Layout::flipVert(), share one copy.
+        /// See CktGraph::shareLayout(). The layouts still in a checkpoint file are left there. Not safe while the circuits are being implemented
+        /// @return the number of unique layouts, counting a layout and its mirror once
+        IndexType shareIdenticalLayouts();
+        /// @brief let a circuit share the layout of an earlier circuit passed here with an identical or mirrored layout, or offer its own
+        /// to the later ones. Call it once the layout of a circuit is final, so that the identical layouts are kept once during the implementation.
+        /// A layout still in a checkpoint file is left there. Not safe while another thread reads or edits the layouts
+        /// @param the index of the circuit
+        /// @return whether the circuit shares the layout of another circuit passed here
+        bool shareIdenticalLayout(IndexType cktIdx);
+        /*------------------------------*/ 
+        /* ECO                          */
+        /*------------------------------*/ 
+        /// @brief read and clear the edit journals of the circuits. The edited circuits and their ancestors are marked dirty.
+        /// The circuits changed outside their journals since the last call are edited too. See CktNodeArrays::untrackedEdits
+        /// @return the number of dirty circuits
+        IndexType propagateEdits();
+        /// @brief whether a circuit or one of its descendants was edited since the last updateDirty()
+        /// @param the index of the circuit
+        /// @return whether the circuit is dirty
+        bool isDirty(IndexType cktIdx) const { return cktIdx < _dirty.size() && _dirty[cktIdx] != 0; }
+        /// @brief get the dirty circuits
+        /// @return the indices of the dirty circuits
+        std::vector<IndexType> dirtyCkts() const;
+        /// @brief refresh the derived data of the dirty circuits, children first: the packed connectivity of the edited circuits
+        /// if an edit dropped it, and the structural hashes of the dirty ones. The clean circuits are not visited. Then clear the dirty flags
+        void updateDirty();
         /*------------------------------*/ 
         /* Exposed public python memory */
         /*------------------------------*/ 
@@ -72,9 +248,50 @@ class DesignDB
         /// @return exposed vector of ground names for pybind
         std::vector<std::string> ground;
     private:
-        std::vector<CktGraph> _ckts; ///< The hierarchical tree of the circuits. Each circuit is represented as a graph.
-        IndexType _rootCkt = INDEX_TYPE_MAX; ///< The root node of the hierarchy. Should have only one.
+        StableVector<CktGraph> _ckts; ///< The hierarchical tree of the circuits. Each circuit is represented as a graph. The circuits never move
+        IndexType _rootCkt = INDEX_TYPE_MAX; ///< The root node of the hierarchy. The highest one if there are several
+        std::vector<IndexType> _rootCkts; ///< The circuits that are not instantiated
+        std::vector<IndexType> _cktLevels; ///< _cktLevels[cktIdx] = the level of the circuit
+        std::vector<IndexType> _levelStart; ///< The circuits at level l are _levelCkts[_levelStart[l], _levelStart[l + 1])
+        std::vector<IndexType> _levelCkts; ///< The circuits sorted by level
         PhyPropDB _phyPropDB; ///< Store the property of each specific devices
+        mutable NameIndex _cktNameIndex; ///< Lazily built name index of the circuits
+        IndexType _cktEdits = 0; ///< The number of times circuits were added or removed
+        std::shared_ptr<std::atomic<IndexType>> _cktRenames = std::make_shared<std::atomic<IndexType>>(0); ///< The number of times circuits were renamed. Shared with the circuits
+        std::vector<HashType> _structHashes; ///< The structural hash of each circuit
+        std::vector<HashType> _structInputs; ///< _structInputs[cktIdx] = the digest of the circuit when it was hashed. See structInputs()
+        std::vector<std::vector<IndexType>> _parents; ///< _parents[cktIdx] = the circuits instantiating it, once per instance
+        std::vector<IndexType> _parentEdits; ///< _parentEdits[cktIdx] = the edits of the circuit outside its journal when last seen by propagateEdits()
+        std::vector<Byte> _dirty; ///< _dirty[cktIdx]: 0 clean, 1 a descendant edited, 2 edited
+        std::unordered_multimap<HashType, IndexType> _layoutMasters; ///< The circuits offering their layouts in shareIdenticalLayout(), by the hash of the layout as each sees it
+        std::vector<IndexType> _flippedCopies; ///< _flippedCopies[cktIdx] = the flipped copy of the circuit. INDEX_TYPE_MAX if none. Possibly shorter than _ckts
+        std::vector<IndexType> _flippedOriginals; ///< _flippedOriginals[copyIdx] = the circuit a flipped copy is of. INDEX_TYPE_MAX if none. Possibly shorter than _ckts
+        std::mutex *_cktTableMutex = nullptr; ///< Held while a circuit is appended. See setCktTableMutex()
+    private:
+        /// @brief lock the circuit table mutex, if any
+        /// @return the lock. It owns nothing without a mutex
+        std::unique_lock<std::mutex> lockCktTable() { return _cktTableMutex ? std::unique_lock<std::mutex>(*_cktTableMutex) : std::unique_lock<std::mutex>(); }
+        /// @brief renumber the circuits in the flipped copy table
+        /// @param newIdx[cktIdx] = the new index of the circuit. INDEX_TYPE_MAX for a dropped one
+        void remapFlippedCopies(const std::vector<IndexType> &newIdx);
+        /// @brief digest what the structural hash of a circuit is computed from: the pins, the nodes with the hashes of their subgraphs,
+        /// the net flags and IO positions, the implementation type and the device property. It is cheap next to the hash itself
+        /// @param the index of the circuit
+        /// @return the digest
+        HashType structInputs(IndexType cktIdx) const;
+        /// @brief confirm two circuits of equal structural hash. The implementation types and the device properties must be equal.
+        /// The devices must have the same pins, nodes and nets in order. The other circuits, whose hash ignores the order, must have
+        /// the same nodes, nets and pin types in any order. The subgraphs of the nodes are compared by structural hash
+        /// @param first: the index of one circuit
+        /// @param second: the index of the other circuit
+        /// @return whether the circuits are equal
+        bool sameStructure(IndexType lhsIdx, IndexType rhsIdx) const;
+        /// @brief bring the structural hashes of some circuits and their descendants up to date, children first.
+        /// A circuit is rehashed if its digest changed, or if it is forced
+        /// @param first: the circuits to start from
+        /// @param second: forced[cktIdx] = non-zero to rehash the circuit anyway. Empty for none
+        /// @param third: whether the circuits neither forced nor new are taken as up to date without visiting them
+        void updateStructHashes(const std::vector<IndexType> &tops, const std::vector<Byte> &forced, bool onlyForced = false);
 };
 
 PROJECT_NAMESPACE_END
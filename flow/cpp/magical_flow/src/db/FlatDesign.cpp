@@ -0,0 +1,188 @@
+/**
+ * @file FlatDesign.cpp
+ * @brief The flattened, device-level view of the hierarchical design
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/FlatDesign.h"
+#include "db/DesignDB.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /// @brief find the representative of a net instance, halving the path on the way
+    /// @param first: the union-find parents
+    /// @param second: the net instance
+    /// @return the representative, which is the smallest net instance of the set
+    IndexType findRoot(std::vector<IndexType> &parent, IndexType x)
+    {
+        while (parent[x] != x)
+        {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+    /// @brief merge the sets of two net instances. The smaller representative is kept
+    void unite(std::vector<IndexType> &parent, IndexType a, IndexType b)
+    {
+        a = findRoot(parent, a);
+        b = findRoot(parent, b);
+        if (a < b)
+        {
+            parent[b] = a;
+        }
+        else if (b < a)
+        {
+            parent[a] = b;
+        }
+    }
+}
+
+void FlatDesign::build(const DesignDB &db, IndexType rootCkt)
+{
+    if (rootCkt >= db.numCkts())
+    {
+        throw std::out_of_range("FlatDesign::build: invalid root circuit " + std::to_string(rootCkt));
+    }
+    const StableVector<CktGraph> &ckts = db.ckts();
+    _pathParent.clear();
+    _pathNode.clear();
+    _pathCkt.clear();
+    _pathNameId.clear();
+    _pathNetStart.clear();
+    _devPath.clear();
+    _devPinStart.assign(1, 0);
+    _netPath.clear();
+    _netIdx.clear();
+    // The nets of every circuit instance are numbered consecutively in path order, and merged with union-find
+    std::vector<IndexType> netParent;
+    std::vector<IndexType> devPinInst; ///< The net instance of each device pin
+    std::vector<std::pair<IndexType, IndexType>> stack; ///< The instances to visit, as (parent path, node)
+    stack.emplace_back(INDEX_TYPE_MAX, INDEX_TYPE_MAX);
+    while (!stack.empty())
+    {
+        IndexType parentPath = stack.back().first;
+        IndexType nodeIdx = stack.back().second;
+        stack.pop_back();
+        const CktGraph *parentCkt = parentPath == INDEX_TYPE_MAX ? nullptr : &ckts[_pathCkt[parentPath]];
+        IndexType cktIdx = parentCkt ? parentCkt->nodeSubgraphIdx()[nodeIdx] : rootCkt;
+        IndexType pathId = _pathParent.size();
+        _pathParent.emplace_back(parentPath);
+        _pathNode.emplace_back(nodeIdx);
+        _pathCkt.emplace_back(cktIdx);
+        _pathNameId.emplace_back(parentCkt ? parentCkt->nodeArrays().cold[nodeIdx].nameId : EMPTY_SYMBOL);
+        _pathNetStart.emplace_back(netParent.size());
+        if (parentCkt && (cktIdx == INDEX_TYPE_MAX || MfUtil::isImplTypeDevice(ckts[cktIdx].implType())))
+        {
+            // A device. Its pins connect to the nets of the parent
+            _devPath.emplace_back(pathId);
+            for (IndexType pinIdx : parentCkt->nodePins(nodeIdx))
+            {
+                IndexType netIdx = parentCkt->pinNet(pinIdx);
+                devPinInst.emplace_back(netIdx == INDEX_TYPE_MAX ? INDEX_TYPE_MAX : _pathNetStart[parentPath] + netIdx);
+            }
+            _devPinStart.emplace_back(devPinInst.size());
+            continue;
+        }
+        const CktGraph &ckt = ckts[cktIdx];
+        IndexType netStart = netParent.size();
+        netParent.resize(netStart + ckt.numNets());
+        std::iota(netParent.begin() + netStart, netParent.end(), netStart);
+        if (parentCkt)
+        {
+            // The pins of the instance join the nets outside and inside
+            for (IndexType pinIdx : parentCkt->nodePins(nodeIdx))
+            {
+                IndexType outerNet = parentCkt->pinNet(pinIdx);
+                IndexType innerNet = parentCkt->pinArray()[pinIdx].intNetIdx();
+                if (outerNet != INDEX_TYPE_MAX && innerNet != INDEX_TYPE_MAX)
+                {
+                    if (innerNet >= ckt.numNets())
+                    {
+                        throw std::out_of_range("FlatDesign::build: pin " + std::to_string(pinIdx) + " of " + parentCkt->name()
+                                                + " connects to invalid net " + std::to_string(innerNet) + " of " + ckt.name());
+                    }
+                    unite(netParent, _pathNetStart[parentPath] + outerNet, netStart + innerNet);
+                }
+            }
+        }
+        // Visit the children in node order
+        for (IndexType childIdx = ckt.numNodes(); childIdx > 0; --childIdx)
+        {
+            stack.emplace_back(pathId, childIdx - 1);
+        }
+    }
+    _pathNetStart.emplace_back(netParent.size());
+    // The representative of each set is its first net instance in path order, which is the highest in the hierarchy
+    _netInstFlat.resize(netParent.size());
+    for (IndexType pathId = 0; pathId < numPaths(); ++pathId)
+    {
+        for (IndexType netInst = _pathNetStart[pathId]; netInst < _pathNetStart[pathId + 1]; ++netInst)
+        {
+            IndexType root = findRoot(netParent, netInst);
+            if (root == netInst)
+            {
+                _netInstFlat[netInst] = _netPath.size();
+                _netPath.emplace_back(pathId);
+                _netIdx.emplace_back(netInst - _pathNetStart[pathId]);
+            }
+            else
+            {
+                _netInstFlat[netInst] = _netInstFlat[root];
+            }
+        }
+    }
+    _devPinNet.resize(devPinInst.size());
+    for (IndexType pin = 0; pin < devPinInst.size(); ++pin)
+    {
+        _devPinNet[pin] = devPinInst[pin] == INDEX_TYPE_MAX ? INDEX_TYPE_MAX : _netInstFlat[devPinInst[pin]];
+    }
+}
+
+std::string FlatDesign::pathName(IndexType pathId, const std::string &separator) const
+{
+    std::vector<IndexType> levels;
+    for (IndexType path = pathId; _pathParent.at(path) != INDEX_TYPE_MAX; path = _pathParent[path])
+    {
+        levels.emplace_back(path);
+    }
+    std::string name;
+    for (auto it = levels.rbegin(); it != levels.rend(); ++it)
+    {
+        if (it != levels.rbegin())
+        {
+            name += separator;
+        }
+        name += SymbolTable::global().str(_pathNameId[*it]);
+    }
+    return name;
+}
+
+std::vector<IndexType> FlatDesign::deviceMasters() const
+{
+    std::vector<IndexType> masters(_devPath.size());
+    for (IndexType devIdx = 0; devIdx < _devPath.size(); ++devIdx)
+    {
+        masters[devIdx] = _pathCkt[_devPath[devIdx]];
+    }
+    return masters;
+}
+
+IndexType FlatDesign::flatNet(IndexType pathId, IndexType netIdx) const
+{
+    IndexType netInst = _pathNetStart.at(pathId) + netIdx;
+    if (netInst >= _pathNetStart.at(pathId + 1))
+    {
+        throw std::out_of_range("FlatDesign::flatNet: net " + std::to_string(netIdx) + " is not in path " + std::to_string(pathId));
+    }
+    return _netInstFlat[netInst];
+}
+
+PROJECT_NAMESPACE_END
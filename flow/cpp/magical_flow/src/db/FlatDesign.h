@@ -0,0 +1,123 @@
+/**
+ * @file FlatDesign.h
+ * @brief The flattened, device-level view of the hierarchical design
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_FLAT_DESIGN_H_
+#define MAGICAL_FLOW_FLAT_DESIGN_H_
+
+#include <string>
+#include <vector>
+#include "global/global.h"
+#include "db/SymbolTable.h"
+#include "util/Span.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+class DesignDB;
+
+/// @class MAGICAL_FLOW::FlatDesign
+/// @brief the hierarchy of a DesignDB expanded down to the devices.
+/// Every instance is one entry of the instance path table, which stores the parent path and the node instead of the full name.
+/// The paths are numbered in depth-first preorder from the root, so a parent always comes before its children.
+/// A device is an instance of a device circuit, or a leaf node outside of the device circuits.
+/// The nets of all the circuit instances are merged across the pins of the instances (Pin::intNetIdx), and each flat net
+/// is represented by its highest net in the hierarchy
+class FlatDesign
+{
+    public:
+        /// @brief default constructor
+        explicit FlatDesign() = default;
+        /// @brief flatten a design. Throws std::out_of_range if the root circuit or the inner net of a pin is invalid
+        /// @param first: the design
+        /// @param second: the circuit at the top. Its path is 0
+        void build(const DesignDB &db, IndexType rootCkt);
+        /*------------------------------*/
+        /* Instance paths               */
+        /*------------------------------*/
+        /// @brief get the number of instance paths, including the root
+        /// @return the number of instance paths
+        IndexType numPaths() const { return _pathParent.size(); }
+        /// @brief get the parent of an instance path
+        /// @param the path id
+        /// @return the path id of the parent. INDEX_TYPE_MAX for the root
+        IndexType pathParent(IndexType pathId) const { return _pathParent.at(pathId); }
+        /// @brief get the node of an instance path in the circuit of its parent
+        /// @param the path id
+        /// @return the node index. INDEX_TYPE_MAX for the root
+        IndexType pathNode(IndexType pathId) const { return _pathNode.at(pathId); }
+        /// @brief get the circuit instantiated at an instance path
+        /// @param the path id
+        /// @return the circuit index. INDEX_TYPE_MAX for a leaf node
+        IndexType pathCkt(IndexType pathId) const { return _pathCkt.at(pathId); }
+        /// @brief get the name of an instance path, from the instance names of its ancestors below the root
+        /// @param first: the path id
+        /// @param second: the separator between the levels
+        /// @return the name of the path. Empty for the root
+        std::string pathName(IndexType pathId, const std::string &separator = "/") const;
+        /*------------------------------*/
+        /* Devices                      */
+        /*------------------------------*/
+        /// @brief get the number of devices
+        /// @return the number of devices
+        IndexType numDevices() const { return _devPath.size(); }
+        /// @brief get the device circuit of a device
+        /// @param the device index
+        /// @return the circuit index. INDEX_TYPE_MAX for a leaf node
+        IndexType deviceMaster(IndexType devIdx) const { return _pathCkt[_devPath.at(devIdx)]; }
+        /// @brief get the instance path of a device
+        /// @param the device index
+        /// @return the path id
+        IndexType devicePath(IndexType devIdx) const { return _devPath.at(devIdx); }
+        /// @brief get the flat nets of the pins of a device, in the pin order of its node
+        /// @param the device index
+        /// @return the view of the flat net indices. INDEX_TYPE_MAX for an unconnected pin
+        Span<const IndexType> deviceNets(IndexType devIdx) const
+        {
+            IndexType end = _devPinStart.at(devIdx + 1);
+            return Span<const IndexType>(_devPinNet.data() + _devPinStart[devIdx], end - _devPinStart[devIdx]);
+        }
+        /// @brief get the masters of all the devices
+        /// @return deviceMasters[devIdx] = the device circuit. INDEX_TYPE_MAX for a leaf node
+        std::vector<IndexType> deviceMasters() const;
+        /// @brief get the paths of all the devices
+        /// @return the view of the path ids, indexed by device
+        Span<const IndexType> devicePaths() const { return Span<const IndexType>(_devPath); }
+        /*------------------------------*/
+        /* Nets                         */
+        /*------------------------------*/
+        /// @brief get the number of flat nets
+        /// @return the number of flat nets
+        IndexType numNets() const { return _netPath.size(); }
+        /// @brief get the instance path of the highest net of a flat net
+        /// @param the flat net index
+        /// @return the path id
+        IndexType netPath(IndexType flatNetIdx) const { return _netPath.at(flatNetIdx); }
+        /// @brief get the highest net of a flat net in the circuit at its path
+        /// @param the flat net index
+        /// @return the net index in the circuit
+        IndexType netIdx(IndexType flatNetIdx) const { return _netIdx.at(flatNetIdx); }
+        /// @brief get the flat net of a net of a circuit instance
+        /// @param first: the path id of the circuit instance
+        /// @param second: the net index in the circuit
+        /// @return the flat net index. Throws std::out_of_range if the path or the net is invalid
+        IndexType flatNet(IndexType pathId, IndexType netIdx) const;
+    private:
+        std::vector<IndexType> _pathParent; ///< _pathParent[pathId] = the parent path
+        std::vector<IndexType> _pathNode; ///< _pathNode[pathId] = the node in the circuit of the parent
+        std::vector<IndexType> _pathCkt; ///< _pathCkt[pathId] = the circuit instantiated
+        std::vector<SymbolId> _pathNameId; ///< _pathNameId[pathId] = the name of the node
+        std::vector<IndexType> _pathNetStart; ///< The nets of path p are the net instances [_pathNetStart[p], _pathNetStart[p + 1])
+        std::vector<IndexType> _netInstFlat; ///< _netInstFlat[netInst] = the flat net of a net instance
+        std::vector<IndexType> _devPath; ///< _devPath[devIdx] = the path of the device
+        std::vector<IndexType> _devPinStart; ///< The pins of device d are [_devPinStart[d], _devPinStart[d + 1])
+        std::vector<IndexType> _devPinNet; ///< _devPinNet[pin] = the flat net of the device pin
+        std::vector<IndexType> _netPath; ///< _netPath[flatNetIdx] = the path of the highest net
+        std::vector<IndexType> _netIdx; ///< _netIdx[flatNetIdx] = the index of the highest net in its circuit
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_FLAT_DESIGN_H_
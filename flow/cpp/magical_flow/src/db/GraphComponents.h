@@ -8,7 +8,10 @@
 #ifndef MAGICAL_FLOW_GRAPH_COMPONENTS_H_
 #define MAGICAL_FLOW_GRAPH_COMPONENTS_H_
 
+#include <stdexcept>
 #include "global/global.h"
+#include "db/SymbolTable.h"
+#include "util/SmallVector.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -21,12 +24,13 @@ class GdsData
         /// @brief get the bounding box
         /// @return the reference to the bounding box
         Box<LocType> & bbox() { return _bbox; }
+        const Box<LocType> & bbox() const { return _bbox; }
         /// @brief set the bounding box
         /// @param xlo ylo xhi yhi
         void setBBox(LocType xLo, LocType yLo, LocType xHi, LocType yHi) { _bbox = Box<LocType>(xLo, yLo, xHi, yHi); }
         /// @brief get the gds filename
         /// @return gds filename
-        std::string gdsFile() { return _gdsFile; }
+        const std::string & gdsFile() const { return _gdsFile; }
         /// @breif set gds filename
         /// @param gds filename
         void setGdsFile(const std::string &filename) { _gdsFile = filename; }
@@ -35,112 +39,214 @@ class GdsData
         Box<LocType> _bbox; ///< The bounding box of the layout
 };
 
+/// @class MAGICAL_FLOW::CktNodeArrays
+/// @brief the storage of all the nodes of a graph, one array per field.
+/// The fields read by the placement loops are kept apart from the names and pins so that scanning them stays in cache
+struct CktNodeArrays
+{
+    /// @brief the fields of a node that are not on the placement loops
+    struct Cold
+    {
+        SmallVector<IndexType, 4> pinIdxArray; ///< The pins this node containing. Devices have up to 4 pins
+        ImplType implType = ImplType::UNSET; ///< what is the implementation type of the node 
+        SymbolId refNameId = EMPTY_SYMBOL; ///< The reference name of this node
+        SymbolId nameId = EMPTY_SYMBOL; ///< The name of this node
+        bool implPhy = false; ///< Whether this node has been implemented physically
+    };
+    /// @brief get the number of nodes
+    /// @return the number of nodes
+    IndexType size() const { return cold.size(); }
+    /// @brief resize the number of nodes. New nodes are default. Counted as an edit outside the journal
+    /// @param the number of nodes
+    void resize(IndexType numNodes)
+    {
+        ++untrackedEdits;
+        resizeJournaled(numNodes);
+    }
+    /// @brief resize the number of nodes for an edit of the journal of the graph. New nodes are default
+    /// @param the number of nodes
+    void resizeJournaled(IndexType numNodes)
+    {
+        ++edits;
+        graphIdx.resize(numNodes, INDEX_TYPE_MAX);
+        offset.resize(numNodes, XY<LocType>(0, 0));
+        orient.resize(numNodes, OriType::N);
+        flipVertFlag.resize(numNodes, 0);
+        cold.resize(numNodes);
+    }
+    /// @brief remove all the nodes
+    void clear() { resize(0); }
+    /// @brief remove a node by moving the last node into its place
+    /// @param the index of the node to remove
+    void swapRemove(IndexType nodeIdx)
+    {
+        IndexType last = size() - 1;
+        if (nodeIdx != last)
+        {
+            graphIdx[nodeIdx] = graphIdx[last];
+            offset[nodeIdx] = offset[last];
+            orient[nodeIdx] = orient[last];
+            flipVertFlag[nodeIdx] = flipVertFlag[last];
+            cold[nodeIdx] = std::move(cold[last]);
+        }
+        resizeJournaled(last);
+    }
+    /*------------------------------*/ 
+    /* Hot                          */
+    /*------------------------------*/ 
+    std::vector<IndexType> graphIdx; ///< graphIdx[nodeIdx] = the sub graph of the node. INDEX_TYPE_MAX for leaf
+    std::vector<XY<LocType>> offset; ///< offset[nodeIdx] = the offset of the location
+    std::vector<OriType> orient; ///< orient[nodeIdx] = the orientation of the node
+    std::vector<Byte> flipVertFlag; ///< flipVertFlag[nodeIdx] = whether the node should be fliped due to symmetry constraint
+    /*------------------------------*/ 
+    /* Cold                         */
+    /*------------------------------*/ 
+    /// @brief change the name of a node and count the rename
+    /// @param first: the symbol of the node name
+    /// @param second: the new symbol
+    void rename(SymbolId &nameId, SymbolId newId)
+    {
+        if (nameId != newId)
+        {
+            nameId = newId;
+            ++edits;
+        }
+    }
+    std::vector<Cold> cold; ///< cold[nodeIdx] = the rest of the node
+    IndexType pinEdits = 0; ///< Counts the pins appended through the CktNode views. The views read the pins through const references only
+    IndexType edits = 0; ///< Counts the resizes and the renames of the nodes. The node name index compares it to tell if it is stale
+    IndexType untrackedEdits = 0; ///< Counts the changes of the nodes, their subgraphs and the pins made outside the journal of the graph.
+                                  ///< DesignDB::propagateEdits() compares it to tell if the circuit changed and its parents are stale
+};
+
 /// @class MAGICAL_FLOW::CktNode
-/// @brief the abstracted node concepts for representing the physical components circuits
+/// @brief the abstracted node concepts for representing the physical components circuits.
+/// A view of one node in the CktNodeArrays of its graph. It holds a pointer to the arrays of the graph and the node index, so
+/// it stays valid when nodes are added, but it does not follow the node when:
+///   - the graph is moved or assigned to. DesignDB::dedupDevices() and DesignDB::load() do so to the circuits they keep;
+///   - the node is removed, or the node arrays are shrunk. CktGraph::removeNode() moves the last node into the removed index.
+/// Take a new view from the graph after any of them
 class CktNode 
 {
     public:
-        /// @brief default constructor
-        explicit CktNode() = default; 
+        /// @brief constructor
+        /// @param first: the node storage of the graph
+        /// @param second: the index of the node
+        explicit CktNode(CktNodeArrays &arrays, IndexType idx) : _arrays(&arrays), _idx(idx)
+        {
+            if (idx >= arrays.size())
+            {
+                throw std::out_of_range("CktNode: node index out of range");
+            }
+        }
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
+        /// @brief get the index of this node in its graph
+        /// @return the node index
+        IndexType idx() const { return _idx; }
         /// @brief get the graph index of the subgraph this node representing
         /// @return the subgraph graph index
-        IndexType subgraphIdx() const { return _graphIdx; }
+        IndexType subgraphIdx() const { return _arrays->graphIdx[_idx]; }
         /// @brief get the array of pin indices this node has (at the current level of graph)
         /// @return the array of pin indices
-        std::vector<IndexType> & pinIdxArray() { return _pinIdxArray; }
-        /// @brief get the array of pin indices this node has (at the current level of graph)
-        /// @return the array of pin indices
-        const std::vector<IndexType> & pinIdxArray() const { return _pinIdxArray; }
+        const SmallVector<IndexType, 4> & pinIdxArray() const { return cold().pinIdxArray; }
         /// @brief get the number of pins this CktNode contains
         /// @return the number of pins this CktNode contains
-        IndexType numPins() const { return _pinIdxArray.size(); }
+        IndexType numPins() const { return cold().pinIdxArray.size(); }
         /// @brief get the index n-th pin of this node
         /// @return the index of n-th pin of this node
-        IndexType pinIdx(IndexType nth) const { return _pinIdxArray.at(nth); }
+        IndexType pinIdx(IndexType nth) const { return cold().pinIdxArray.at(nth); }
         /// @brief get the reference name
         /// @return the reference name of the node
-        const std::string & refName() const { return _refName; }
+        const std::string & refName() const { return SymbolTable::global().str(cold().refNameId); }
         /// @brief get the name of the node
         /// @return the name of node
-        const std::string & name() const { return _name; }
+        const std::string & name() const { return SymbolTable::global().str(cold().nameId); }
+        /// @brief get the symbol of the reference name
+        /// @return the symbol id of the reference name
+        SymbolId refNameId() const { return cold().refNameId; }
+        /// @brief get the symbol of the name
+        /// @return the symbol id of the name
+        SymbolId nameId() const { return cold().nameId; }
         /// @brief get if the node should be flipped
         /// @return the flip vert flag
-        bool flipVertFlag() const { return _flipVertFlag; }
+        bool flipVertFlag() const { return _arrays->flipVertFlag[_idx] != 0; }
 
         /*------------------------------*/ 
         /* Setters                      */
         /*------------------------------*/ 
-        /// @brief set the graph index of the subgraph this node representing
+        /// @brief set the graph index of the subgraph this node representing. Counted as an edit outside the journal of the graph
         /// @param the subgraph index
-        void setSubgraphIdx(IndexType subgraphIdx) { _graphIdx = subgraphIdx; }
+        void setSubgraphIdx(IndexType subgraphIdx)
+        {
+            if (_arrays->graphIdx[_idx] != subgraphIdx)
+            {
+                _arrays->graphIdx[_idx] = subgraphIdx;
+                ++_arrays->untrackedEdits;
+            }
+        }
         /// @brief set if this node has been physical implemented
         /// @param if this node has been physical implemented
-        void setIsImpl(bool isImpl)  {_implPhy = isImpl; }
+        void setIsImpl(bool isImpl)  { cold().implPhy = isImpl; }
         /// @brief set the reference name of this node
         /// @param the reference name of the node
-        void setRefName(const std::string &refName) { _refName = refName; }
+        void setRefName(const std::string &refName) { cold().refNameId = SymbolTable::global().intern(refName); }
         /// @brief set the name of this node
         /// @param the name of the node
-        void setName(const std::string &name) { _name = name; }
+        void setName(const std::string &name) { _arrays->rename(cold().nameId, SymbolTable::global().intern(name)); }
         /// @brief set the coordinate offset of this node
         /// @set the offset of this node
-        void setOffset(LocType x, LocType y) { _offset = XY<LocType>(x, y); }
+        void setOffset(LocType x, LocType y) { _arrays->offset[_idx] = XY<LocType>(x, y); }
         /// @brief set the flip flag
         /// @set the flip flag
-        void setFlipVertFlag(bool flag) { _flipVertFlag = flag; }
+        void setFlipVertFlag(bool flag) { _arrays->flipVertFlag[_idx] = flag ? 1 : 0; }
 
         /*------------------------------*/ 
         /* Attributes                   */
         /*------------------------------*/ 
         /// @brief get the coordinate offset of this node
         /// @return the offset of this node
-        //const XY<LocType> & offset() const { return _offset; }
+        const XY<LocType> & offset() const { return _arrays->offset[_idx]; }
         /// @brief get the coordinate offset of this node
         /// @return the offset of this node
-        XY<LocType> & offset() { return _offset; }
+        XY<LocType> & offset() { return _arrays->offset[_idx]; }
         /// @brief get the orientation of this node
         /// @return the orientation of this node
-        //const OriType & orient() const { return _orient; }
+        const OriType & orient() const { return _arrays->orient[_idx]; }
         /// @brief get the orientation of this node
         /// @return the orientation of this node
-        OriType & orient() { return _orient; }
+        OriType & orient() { return _arrays->orient[_idx]; }
         /// @brief set the orientation of this node
         /// @param the orientation of this node
-        void setOrient(OriType ori) { _orient = ori; }
+        void setOrient(OriType ori) { _arrays->orient[_idx] = ori; }
         /// @brief get whether this node has been physically implemented
         /// @return if this node has been physically implemented
-        bool isImpl() const { return _implPhy; }
+        bool isImpl() const { return cold().implPhy; }
         /// @brief get the implementation type
         /// @return the implementation type of this node
-        ImplType implType() const { return _implType; }
+        ImplType implType() const { return cold().implType; }
         /// @brief set the implementation type
         /// @param the implementation type of this node
-        void setImplType(ImplType impl) { _implType = impl; }
+        void setImplType(ImplType impl) { cold().implType = impl; }
         /*------------------------------*/ 
         /* Vector operation             */
         /*------------------------------*/ 
         /// @brief append a pinIdx to the pinIdxArray
         /// @param a pinIdx
-        void appendPinIdx(IndexType pinIdx) { _pinIdxArray.emplace_back(pinIdx); }
+        void appendPinIdx(IndexType pinIdx) { ++_arrays->pinEdits; cold().pinIdxArray.emplace_back(pinIdx); }
         /*------------------------------*/ 
         /* Graph Properties             */
         /*------------------------------*/ 
         /// @brief if this node is a leaf node
         /// @return whether this node is a leaf node in the graph. If not, it represents a subgraph
-        bool isLeaf() const { return _graphIdx == INDEX_TYPE_MAX; }
+        bool isLeaf() const { return subgraphIdx() == INDEX_TYPE_MAX; }
+    private:
+        /// @brief get the cold fields of this node
+        CktNodeArrays::Cold & cold() const { return _arrays->cold[_idx]; }
     private:
-        IndexType _graphIdx = INDEX_TYPE_MAX; ///< The index of the sub graph this node corresponding to. If INDEX_TYPE_MAX, then this is a leaf node
-        std::vector<IndexType> _pinIdxArray; ///< The pins this node containing
-        XY<LocType> _offset = XY<LocType>(0, 0); ///< The offset of the location
-        OriType _orient = OriType::N; ///< The orientation of this node
-        bool _implPhy = false; ///< Whether this node has been implemented physically
-        bool _flipVertFlag = false; ///< Whether this node should be fliped due to symmetry constraint
-        ImplType _implType = ImplType::UNSET; ///< what is the implementation type of the node 
-        std::string _refName = ""; ///< The reference name of this node
-        std::string _name = ""; ///< The name of this node
+        CktNodeArrays *_arrays = nullptr; ///< The node storage of the graph
+        IndexType _idx = INDEX_TYPE_MAX; ///< The index of this node
 };
 
 /// @brief the IO pin shape configuration
@@ -153,88 +259,151 @@ struct IoPinConfigure
 
 };
 
+/// @class MAGICAL_FLOW::NetArrays
+/// @brief the storage of all the nets of a graph. The flags are kept apart from the pins and the IO shapes
+struct NetArrays
+{
+    /// @brief the fields of a net other than the flags
+    struct Cold
+    {
+        std::vector<IndexType> pinIdxArray; ///< The indices of pins this nets connecting to (includes sub pins)
+        std::vector<IndexType> subIdxArray; ///< The indices of device substrate pins this nets connecting to
+        SymbolId nameId = EMPTY_SYMBOL; ///< The name of this net
+        IndexType ioPos = INDEX_TYPE_MAX; ///< The index of net if it is IO.
+        /*------------------------------*/ 
+        /* For higher hierarchy         */
+        /*------------------------------*/ 
+        SmallVector<IoPinConfigure, 1> ioInterfaces = SmallVector<IoPinConfigure, 1>(1); ///< The shape for pin for accessing from external
+    };
+    /// @brief get the number of nets
+    /// @return the number of nets
+    IndexType size() const { return cold.size(); }
+    /// @brief resize the number of nets. New nets are default
+    /// @param the number of nets
+    void resize(IndexType numNets)
+    {
+        ++edits;
+        flags.resize(numNets, 0);
+        cold.resize(numNets);
+    }
+    /// @brief remove all the nets
+    void clear() { resize(0); }
+    std::vector<Byte> flags; ///< flags[netIdx] = the NetFlag bits of the net
+    /// @brief change the name of a net and count the rename
+    /// @param first: the symbol of the net name
+    /// @param second: the new symbol
+    void rename(SymbolId &nameId, SymbolId newId)
+    {
+        if (nameId != newId)
+        {
+            nameId = newId;
+            ++edits;
+        }
+    }
+    std::vector<Cold> cold; ///< cold[netIdx] = the rest of the net
+    IndexType pinEdits = 0; ///< Counts the pins appended through the Net views. The views read the pins through const references only
+    IndexType edits = 0; ///< Counts the resizes and the renames of the nets. The net name index compares it to tell if it is stale
+};
+
 /// @class MAGICAL_FLOW::Net
-/// @brief the abstracted net concepts for representing the connectivity of the circuits
+/// @brief the abstracted net concepts for representing the connectivity of the circuits.
+/// A view of one net in the NetArrays of its graph. Like CktNode, it stays valid when nets are added,
+/// but not after the graph is moved or assigned to, which DesignDB::dedupDevices() and DesignDB::load() do
 class Net
 {
     public:
-        /// @brief default constructor
-        explicit Net() 
+        /// @brief constructor
+        /// @param first: the net storage of the graph
+        /// @param second: the index of the net
+        explicit Net(NetArrays &arrays, IndexType idx) : _arrays(&arrays), _idx(idx)
         {
-            _ioInterfaces.resize(1);
-            Assert(_ioInterfaces.at(0).layer == INDEX_TYPE_MAX);
-            Assert(_ioInterfaces.at(0).isPowerStripe == 0);
+            if (idx >= arrays.size())
+            {
+                throw std::out_of_range("Net: net index out of range");
+            }
         }
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
+        /// @brief get the index of this net in its graph
+        /// @return the net index
+        IndexType idx() const { return _idx; }
         /// @brief get the array of pin indices that the net connecting
         /// @return the array of pin indices that the net connecting
-        std::vector<IndexType> & pinIdxArray() { return _pinIdxArray; }
+        const std::vector<IndexType> & pinIdxArray() const { return cold().pinIdxArray; }
+        /// @brief get the array of substrate pin indices that the net connecting
+        /// @return the array of substrate pin indices that the net connecting
+        const std::vector<IndexType> & subIdxArray() const { return cold().subIdxArray; }
         /// @brief get the number of pins this net is connecting
         /// @return the number of pins this net is connecting
-        IndexType numPins() const { return _pinIdxArray.size(); }
+        IndexType numPins() const { return cold().pinIdxArray.size(); }
         /// @brief get the number of substrate pins this CktNode contains
         /// @return the number of substrate pins this CktNode contains
-        IndexType numSubs() const { return _subIdxArray.size(); }
+        IndexType numSubs() const { return cold().subIdxArray.size(); }
         /// @brief get the n-th pin index of this net
         /// @return the n-th pin index of this net
-        IndexType pinIdx(IndexType nth) const { return _pinIdxArray.at(nth); }
+        IndexType pinIdx(IndexType nth) const { return cold().pinIdxArray.at(nth); }
         /// @brief get the name of the net
         /// @return the name of the net
-        const std::string & name() const { return _name; }
+        const std::string & name() const { return SymbolTable::global().str(cold().nameId); }
+        /// @brief get the symbol of the name
+        /// @return the symbol id of the name
+        SymbolId nameId() const { return cold().nameId; }
         /// @brief get the index of io
         /// @return index of the net io
-        IndexType ioPos() const { return _ioPos; }
+        IndexType ioPos() const { return cold().ioPos; }
+        /// @brief get the NetFlag bits of this net
+        /// @return the flags
+        Byte flags() const { return _arrays->flags[_idx]; }
         /// @brief get whether this net is power nets
-        bool isPower() const { return _isVss or _isVdd; }
+        bool isPower() const { return hasFlag(NetFlag::VDD) or hasFlag(NetFlag::VSS); }
         /// @brief get whether this net is vdd net
-        bool isVdd() const { return _isVdd; }
+        bool isVdd() const { return hasFlag(NetFlag::VDD); }
         /// @brief get whether this net is vss net
-        bool isVss() const { return _isVss; }
+        bool isVss() const { return hasFlag(NetFlag::VSS); }
         /// @brief get whether this net is digital net
-        bool isDigital() const { return _isDigital; }
+        bool isDigital() const { return hasFlag(NetFlag::DIGITAL); }
         /// @brief get whether this net is analog net
-        bool isAnalog() const { return _isAnalog; }
+        bool isAnalog() const { return hasFlag(NetFlag::ANALOG); }
         /*------------------------------*/ 
         /* Setters                      */
         /*------------------------------*/ 
         /// @brief set the name for the net
         /// @param the name for the net
-        void setName(const std::string &name) { _name = name; }
+        void setName(const std::string &name) { _arrays->rename(cold().nameId, SymbolTable::global().intern(name)); }
         /// @brief set pos of io
         /// @param the index pos of io
-        void setIoPos(IndexType ioPos) { _ioPos = ioPos; }
+        void setIoPos(IndexType ioPos) { cold().ioPos = ioPos; setFlag(NetFlag::IO, ioPos != INDEX_TYPE_MAX); }
         /// @brief mark this net as VDD
-        void markVddFlag() { Assert(!_isVss); _isVdd = true; }
+        void markVddFlag() { Assert(!isVss()); setFlag(NetFlag::VDD, true); }
         /// @brief remove the VDD flag from this net
-        void revokeVddFlag() { _isVdd = false; }
+        void revokeVddFlag() { setFlag(NetFlag::VDD, false); }
         /// @brief mark this net as VSS
-        void markVssFlag() { Assert(!_isVdd); _isVss = true; }
+        void markVssFlag() { Assert(!isVdd()); setFlag(NetFlag::VSS, true); }
         /// @brief remove the VSS flag from this net
-        void revokeVssFlag() { _isVss = false; }
+        void revokeVssFlag() { setFlag(NetFlag::VSS, false); }
         /// @brief mark this net as digital
-        void markDigitalFlag() { _isDigital = true; _isAnalog = false; }
+        void markDigitalFlag() { setFlag(NetFlag::DIGITAL, true); setFlag(NetFlag::ANALOG, false); }
         /// @brief mark this net as analog
-        void markAnalogFlag() { _isDigital = false; _isAnalog = true; }
+        void markAnalogFlag() { setFlag(NetFlag::DIGITAL, false); setFlag(NetFlag::ANALOG, true); }
         /*------------------------------*/ 
         /* Attributes                   */
         /*------------------------------*/ 
         /// @brief check if the net is io
         /// @param return true if net is io
-        bool isIo() { return _ioPos != INDEX_TYPE_MAX; }
+        bool isIo() const { return hasFlag(NetFlag::IO); }
         /// @brief return true if net is a substrate net
         /// @return true if a substrate net
-        bool isSub() { return _subIdxArray.empty(); }
+        bool isSub() const { return cold().subIdxArray.empty(); }
         /*------------------------------*/ 
         /* Vector operation             */
         /*------------------------------*/ 
         /// @brief append a pinIdx to the pinIdxArray
         /// @param a pinIdx
-        void appendPinIdx(IndexType pinIdx) { _pinIdxArray.emplace_back(pinIdx); }
+        void appendPinIdx(IndexType pinIdx) { ++_arrays->pinEdits; cold().pinIdxArray.emplace_back(pinIdx); }
         /// @brief append a pinIdx to the subIdxArray
         /// @param a pinIdx
-        void appendSubIdx(IndexType pinIdx) { _subIdxArray.emplace_back(pinIdx); }
+        void appendSubIdx(IndexType pinIdx) { ++_arrays->pinEdits; cold().subIdxArray.emplace_back(pinIdx); }
         /*------------------------------*/ 
         /* Integration                  */
         /*------------------------------*/ 
@@ -243,19 +412,19 @@ class Net
         /// @param second: ylo
         /// @param third: xhi
         /// @param fourth: yhi
-        void setIoShape(LocType xLo, LocType yLo, LocType xHi, LocType yHi) { _ioInterfaces.at(0).shape = Box<LocType>(xLo, yLo, xHi, yHi); }
+        void setIoShape(LocType xLo, LocType yLo, LocType xHi, LocType yHi) { ioInterfaces().at(0).shape = Box<LocType>(xLo, yLo, xHi, yHi); }
         /// @brief get the pin shape of this net for external accessing
         /// @return the pin shape as rectangle
-        Box<LocType> & ioShape() { return _ioInterfaces.at(0).shape; }
+        Box<LocType> & ioShape() { return ioInterfaces().at(0).shape; }
         /// @brief get io shape layer. Metal layer
         /// @return IO shape layer, metal layer
-        IndexType ioLayer() const { return _ioInterfaces.at(0).layer; }
+        IndexType ioLayer() const { return ioInterfaces().at(0).layer; }
         /// @brief set IO shape layer. Metal layer
         /// @param metal layer
-        void setIoLayer(IndexType ioLayer) { _ioInterfaces.at(0).layer = ioLayer; }
+        void setIoLayer(IndexType ioLayer) { ioInterfaces().at(0).layer = ioLayer; }
         /// @brief get the number of io pins
         /// @return the number of io pins
-        IndexType numIoPins() const { return _ioInterfaces.size(); }
+        IndexType numIoPins() const { return ioInterfaces().size(); }
         /// @brief add a io pin
         /// @param first: io pin shape xLo 
         /// @param second: io pin shape yLo 
@@ -264,39 +433,40 @@ class Net
         /// @param fifth: metal layer 
         void addIoPin(LocType xLo, LocType yLo, LocType xHi, LocType yHi, IndexType metalLayer)
         {
-            if (_ioInterfaces.at(0).layer == INDEX_TYPE_MAX)
+            auto &ios = ioInterfaces();
+            if (ios.at(0).layer == INDEX_TYPE_MAX)
             {
-                _ioInterfaces[0].shape = Box<LocType>(xLo, yLo, xHi, yHi);
-                _ioInterfaces[0].layer = metalLayer;
+                ios[0].shape = Box<LocType>(xLo, yLo, xHi, yHi);
+                ios[0].layer = metalLayer;
             }
             else
             {
-                _ioInterfaces.emplace_back(IoPinConfigure());
-                _ioInterfaces.back().shape = Box<LocType>(xLo, yLo, xHi, yHi);
-                _ioInterfaces.back().layer = metalLayer;
+                ios.emplace_back(IoPinConfigure());
+                ios.back().shape = Box<LocType>(xLo, yLo, xHi, yHi);
+                ios.back().layer = metalLayer;
             }
         }
         /// @brief get whether a io shape is power stripe
         /// @param the index of the io interface
-        bool isIoPowerStripe(IndexType ioIdx) const { return _ioInterfaces.at(ioIdx).isPowerStripe == 1; }
+        bool isIoPowerStripe(IndexType ioIdx) const { return ioInterfaces().at(ioIdx).isPowerStripe == 1; }
         /// @brief mark a io shape as power stripe
         /// @param the index of the io interface
-        void markIoPowerStripe(IndexType ioIdx) { _ioInterfaces.at(ioIdx).isPowerStripe = 1; }
+        void markIoPowerStripe(IndexType ioIdx) { ioInterfaces().at(ioIdx).isPowerStripe = 1; }
         /// @brief mark the last io shape as power stripe
-        void markLastIoPowerStripe() { _ioInterfaces.back().isPowerStripe = 1; }
+        void markLastIoPowerStripe() { ioInterfaces().back().isPowerStripe = 1; }
         /// @brief get the io pin shape
         /// @param the index 
         /// @return the shape
-        Box<LocType> & ioPinShape(IndexType idx) { return _ioInterfaces.at(idx).shape; }
+        Box<LocType> & ioPinShape(IndexType idx) { return ioInterfaces().at(idx).shape; }
         /// @brief get the io pin metal layer
         /// @param the index
         /// @return the metal layer
-        IndexType ioPinMetalLayer(IndexType idx) { return _ioInterfaces.at(idx).layer; }
+        IndexType ioPinMetalLayer(IndexType idx) const { return ioInterfaces().at(idx).layer; }
         /// @brief flip io shape according to vertical axis
         /// @param symmetry vertical axis x=axis
         void flipVert(LocType axis) 
         { 
-            for (auto &io : _ioInterfaces)
+            for (auto &io : ioInterfaces())
             {
                 auto & ioshape = io.shape;
                 LocType xLo = ioshape.xLo();    
@@ -306,18 +476,21 @@ class Net
         }
 
     private:
-        std::vector<IndexType> _pinIdxArray; ///< The indices of pins this nets connecting to (includes sub pins)
-        std::vector<IndexType> _subIdxArray; ///< The indices of device substrate pins this nets connecting to
-        std::string _name = ""; ///< The name of this net
-        IndexType _ioPos = INDEX_TYPE_MAX; ///< The index of net if it is IO.
-        bool _isVdd = false; ///< Whether this net is a VDD net
-        bool _isVss = false; ///< Whether this net is a VSS net
-        bool _isDigital = false; ///< Whether this net is digital
-        bool _isAnalog =  false; ///< whether this net is analog
-        /*------------------------------*/ 
-        /* For higher hierarchy         */
-        /*------------------------------*/ 
-        std::vector<IoPinConfigure> _ioInterfaces; ///< The shape for pin for accessing from external
+        /// @brief get the cold fields of this net
+        NetArrays::Cold & cold() const { return _arrays->cold[_idx]; }
+        /// @brief get the io interfaces of this net
+        SmallVector<IoPinConfigure, 1> & ioInterfaces() const { return cold().ioInterfaces; }
+        /// @brief whether a flag is set
+        bool hasFlag(NetFlag flag) const { return (_arrays->flags[_idx] & static_cast<Byte>(flag)) != 0; }
+        /// @brief set or clear a flag
+        void setFlag(NetFlag flag, bool value)
+        {
+            Byte &flags = _arrays->flags[_idx];
+            flags = value ? (flags | static_cast<Byte>(flag)) : (flags & ~static_cast<Byte>(flag));
+        }
+    private:
+        NetArrays *_arrays = nullptr; ///< The net storage of the graph
+        IndexType _idx = INDEX_TYPE_MAX; ///< The index of this net
 };
 
 /// @class MAGICAL_FLOW::Pin
@@ -381,12 +554,15 @@ class Pin
         /// @param An index of rectangle in Layout
         /// @return the index of the new rectangle
         IndexType addLayoutRectIdx(IndexType rectIdx) { _layoutRectIdx.emplace_back(rectIdx); return _layoutRectIdx.size() - 1; }
+        /// @brief get the heap bytes of the pin
+        /// @return the bytes of the rectangle indices beyond the inline capacity
+        std::uint64_t heapBytes() const { return _layoutRectIdx.isHeap() ? static_cast<std::uint64_t>(_layoutRectIdx.capacity()) * sizeof(IndexType) : 0; }
     private:
         PinType _pinType = PinType::UNSET; ///< The pin is a substrate pin psub/nwell
         IndexType _nodeIdx = INDEX_TYPE_MAX; ///< The node index of the pin
         IndexType _intNetIdx = INDEX_TYPE_MAX; ///< The corresponding internal pin index in the internal node
         IndexType _netIdx = INDEX_TYPE_MAX; ///< The nets this pin corresponding to
-        std::vector<IndexType> _layoutRectIdx; ///< The corresponding indices of rectangles in the Layout
+        SmallVector<IndexType, 2> _layoutRectIdx; ///< The corresponding indices of rectangles in the Layout
         bool _valid = true; ///< If the pin is valid and should be routed to net.
 };
 
@@ -0,0 +1,601 @@
+/**
+ * @file ImplCache.cpp
+ * @brief A persistent cache of the implemented circuits, keyed by fingerprints of their inputs
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/ImplCache.h"
+#include "db/DesignDB.h"
+#include "util/BinaryIO.h"
+#include "util/Hash.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <unordered_map>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /*
+     * The entry file, in the native byte order:
+     *   magic, version, byte order mark, fingerprint
+     *   whether the gds file is in the result directory, and the gds file relative to it if so
+     *   the number of result files, and the name relative to the result directory and the contents of each
+     *   the symbols of the added circuits, as strings in the order of their ids in the entry
+     *   the number of added circuits, and each written by CktGraph::save() and CktGraph::saveLayout()
+     *   the implementation written by CktGraph::saveImpl(). The subgraph of an added node is the index of its added circuit
+     * The added circuits are the subgraphs of the nodes the implementation added, such as the IO pin circuits of the placer
+     */
+    constexpr char IMPL_CACHE_MAGIC[8] = { 'M', 'A', 'G', 'I', 'C', 'I', 'M', 'P' };
+    constexpr std::uint32_t IMPL_CACHE_VERSION = 4; ///< Increase it when the format or the fingerprint changes
+    constexpr std::uint32_t IMPL_CACHE_BYTE_ORDER = 0x01020304;
+
+    /// @brief read a whole file
+    bool readFile(const std::string &filename, std::string &data)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            return false;
+        }
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return !file.bad();
+    }
+
+    /// @brief write a whole file aside and rename it over the file. A hard link in its place is replaced, not written through
+    bool writeFile(const std::string &filename, const std::string &data)
+    {
+        std::string tmpName = filename + ".tmp";
+        {
+            std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+            file.write(data.data(), data.size());
+            file.close();
+            if (file.fail())
+            {
+                std::remove(tmpName.c_str());
+                return false;
+            }
+        }
+        if (std::rename(tmpName.c_str(), filename.c_str()) != 0)
+        {
+            std::remove(tmpName.c_str());
+            return false;
+        }
+        return true;
+    }
+}
+
+/*------------------------------*/
+/* CktGraph                     */
+/*------------------------------*/
+void CktGraph::saveImpl(BinaryWriter &out, IndexType numNodes, IndexType numPins, const std::function<IndexType(IndexType)> &subgraphRef) const
+{
+    // The nodes and pins added by the implementation, and where they are in the nets
+    out.write<IndexType>(numNodes);
+    out.write<IndexType>(numPins);
+    out.write<IndexType>(_nodes.size() - numNodes);
+    for (IndexType nodeIdx = numNodes; nodeIdx < _nodes.size(); ++nodeIdx)
+    {
+        const CktNodeArrays::Cold &node = _nodes.cold[nodeIdx];
+        IndexType graphIdx = _nodes.graphIdx[nodeIdx];
+        out.write<IndexType>(graphIdx == INDEX_TYPE_MAX ? INDEX_TYPE_MAX : subgraphRef(graphIdx));
+        out.writeString(SymbolTable::global().str(node.nameId));
+        out.writeString(SymbolTable::global().str(node.refNameId));
+        out.write<IntType>(static_cast<IntType>(node.implType));
+        out.write<Byte>(node.implPhy);
+        out.writeArray(node.pinIdxArray);
+    }
+    out.write<IndexType>(_pinArray.size() - numPins);
+    for (IndexType pinIdx = numPins; pinIdx < _pinArray.size(); ++pinIdx)
+    {
+        const Pin &pin = _pinArray[pinIdx];
+        out.write<IntType>(static_cast<IntType>(pin.pinType()));
+        out.write<IndexType>(pin.nodeIdx());
+        out.write<IndexType>(pin.intNetIdx());
+        out.write<IndexType>(pin.netIdx());
+        out.write<Byte>(pin.valid());
+        out.write<IndexType>(pin.numLayoutRects());
+        for (IndexType idx = 0; idx < pin.numLayoutRects(); ++idx)
+        {
+            out.write<IndexType>(pin.layoutRectIdx(idx));
+        }
+    }
+    auto addedPins = [&](const std::vector<IndexType> &pins)
+    {
+        std::vector<IndexType> added;
+        std::copy_if(pins.begin(), pins.end(), std::back_inserter(added), [&](IndexType pinIdx) { return pinIdx >= numPins; });
+        return added;
+    };
+    for (const NetArrays::Cold &net : _nets.cold)
+    {
+        out.writeArray(addedPins(net.pinIdxArray));
+        out.writeArray(addedPins(net.subIdxArray));
+    }
+    // The implementation
+    out.write<Byte>(_flipVertFlag);
+    out.write<IndexType>(_nodes.size());
+    out.writeArray(_nodes.offset);
+    out.writeArray(_nodes.orient);
+    out.writeArray(_nodes.flipVertFlag);
+    out.write<IndexType>(_nets.size());
+    for (const NetArrays::Cold &net : _nets.cold)
+    {
+        out.write<IndexType>(net.ioInterfaces.size());
+        for (const IoPinConfigure &io : net.ioInterfaces)
+        {
+            out.writeBox(io.shape);
+            out.write<IndexType>(io.layer);
+            out.write<IntType>(io.isPowerStripe);
+        }
+    }
+    out.writeString(_gdsData.gdsFile());
+    out.writeBox(_gdsData.bbox());
+    this->saveLayout(out);
+}
+
+void CktGraph::loadImpl(BinaryReader &in, const std::function<IndexType(IndexType)> &subgraph)
+{
+    // Read everything before touching the circuit
+    IndexType numNodes = in.read<IndexType>();
+    IndexType numPins = in.read<IndexType>();
+    if (numNodes != _nodes.size() || numPins != _pinArray.size())
+    {
+        throw std::runtime_error("the numbers of nodes or pins before the implementation differ");
+    }
+    std::vector<IndexType> addedGraphIdx(in.read<IndexType>());
+    IndexType numAllNodes = numNodes + addedGraphIdx.size();
+    std::vector<CktNodeArrays::Cold> addedNodes(addedGraphIdx.size());
+    for (IndexType idx = 0; idx < addedNodes.size(); ++idx)
+    {
+        IndexType ref = in.read<IndexType>();
+        addedGraphIdx[idx] = ref == INDEX_TYPE_MAX ? INDEX_TYPE_MAX : subgraph(ref);
+        CktNodeArrays::Cold &node = addedNodes[idx];
+        node.nameId = SymbolTable::global().intern(in.readString());
+        node.refNameId = SymbolTable::global().intern(in.readString());
+        node.implType = static_cast<ImplType>(in.read<IntType>());
+        node.implPhy = in.read<Byte>() != 0;
+        in.readArray(node.pinIdxArray);
+    }
+    std::vector<Pin> addedPins(in.read<IndexType>());
+    IndexType numAllPins = numPins + addedPins.size();
+    for (Pin &pin : addedPins)
+    {
+        pin.setPinType(static_cast<PinType>(in.read<IntType>()));
+        pin.setNodeIdx(in.read<IndexType>());
+        pin.setIntNetIdx(in.read<IndexType>());
+        pin.setNetIdx(in.read<IndexType>());
+        pin.setValid(in.read<Byte>() != 0);
+        IndexType numRects = in.read<IndexType>();
+        for (IndexType idx = 0; idx < numRects; ++idx)
+        {
+            pin.addLayoutRectIdx(in.read<IndexType>());
+        }
+        if ((pin.nodeIdx() >= numAllNodes && pin.nodeIdx() != INDEX_TYPE_MAX) || (pin.netIdx() >= _nets.size() && pin.netIdx() != INDEX_TYPE_MAX))
+        {
+            throw std::runtime_error("invalid node or net of an added pin");
+        }
+    }
+    auto checkAddedPins = [&](const std::vector<IndexType> &pins)
+    {
+        for (IndexType pinIdx : pins)
+        {
+            if (pinIdx < numPins || pinIdx >= numAllPins)
+            {
+                throw std::runtime_error("invalid added pin " + std::to_string(pinIdx));
+            }
+        }
+    };
+    for (const CktNodeArrays::Cold &node : addedNodes)
+    {
+        checkAddedPins(std::vector<IndexType>(node.pinIdxArray.begin(), node.pinIdxArray.end()));
+    }
+    std::vector<std::pair<std::vector<IndexType>, std::vector<IndexType>>> netAddedPins(_nets.size());
+    for (auto &pins : netAddedPins)
+    {
+        in.readArray(pins.first);
+        in.readArray(pins.second);
+        checkAddedPins(pins.first);
+        checkAddedPins(pins.second);
+    }
+    bool flipVertFlag = in.read<Byte>() != 0;
+    if (in.read<IndexType>() != numAllNodes)
+    {
+        throw std::runtime_error("the number of nodes differs");
+    }
+    std::vector<XY<LocType>> offsets;
+    std::vector<OriType> orients;
+    std::vector<Byte> flipVertFlags;
+    in.readArray(offsets);
+    in.readArray(orients);
+    in.readArray(flipVertFlags);
+    if (offsets.size() != numAllNodes || orients.size() != numAllNodes || flipVertFlags.size() != numAllNodes)
+    {
+        throw std::runtime_error("node array size mismatch");
+    }
+    if (in.read<IndexType>() != _nets.size())
+    {
+        throw std::runtime_error("the number of nets differs");
+    }
+    std::vector<SmallVector<IoPinConfigure, 1>> ioInterfaces(_nets.size());
+    for (auto &ios : ioInterfaces)
+    {
+        ios.resize(in.read<IndexType>());
+        for (IoPinConfigure &io : ios)
+        {
+            io.shape = in.readBox<LocType>();
+            io.layer = in.read<IndexType>();
+            io.isPowerStripe = in.read<IntType>();
+        }
+    }
+    std::string gdsFile = in.readString();
+    Box<LocType> bbox = in.readBox<LocType>();
+    Layout layout;
+    layout.load(in);
+    // Apply
+    if (!addedNodes.empty() || !addedPins.empty())
+    {
+        _nodes.resize(numAllNodes);
+        for (IndexType idx = 0; idx < addedNodes.size(); ++idx)
+        {
+            _nodes.graphIdx[numNodes + idx] = addedGraphIdx[idx];
+            _nodes.cold[numNodes + idx] = std::move(addedNodes[idx]);
+        }
+        _pinArray.insert(_pinArray.end(), addedPins.begin(), addedPins.end());
+        for (IndexType netIdx = 0; netIdx < _nets.size(); ++netIdx)
+        {
+            NetArrays::Cold &net = _nets.cold[netIdx];
+            net.pinIdxArray.insert(net.pinIdxArray.end(), netAddedPins[netIdx].first.begin(), netAddedPins[netIdx].first.end());
+            net.subIdxArray.insert(net.subIdxArray.end(), netAddedPins[netIdx].second.begin(), netAddedPins[netIdx].second.end());
+        }
+        _isFinalized = false;
+    }
+    _flipVertFlag = flipVertFlag;
+    _nodes.offset = std::move(offsets);
+    _nodes.orient = std::move(orients);
+    _nodes.flipVertFlag = std::move(flipVertFlags);
+    for (IndexType netIdx = 0; netIdx < _nets.size(); ++netIdx)
+    {
+        _nets.cold[netIdx].ioInterfaces = std::move(ioInterfaces[netIdx]);
+    }
+    _gdsData.setGdsFile(gdsFile);
+    _gdsData.bbox() = bbox;
+    _layout = std::move(layout);
+    _layoutFile.reset();
+    _sharedLayout.reset();
+    _sharedFlipVert = false;
+    _isImplemented = true;
+}
+
+void CktGraph::clearImpl()
+{
+    _flipVertFlag = false;
+    std::fill(_nodes.offset.begin(), _nodes.offset.end(), XY<LocType>(0, 0));
+    std::fill(_nodes.orient.begin(), _nodes.orient.end(), OriType::N);
+    std::fill(_nodes.flipVertFlag.begin(), _nodes.flipVertFlag.end(), 0);
+    for (NetArrays::Cold &net : _nets.cold)
+    {
+        // A net starts with one unset IO interface, which Net::addIoPin() fills first
+        net.ioInterfaces = SmallVector<IoPinConfigure, 1>(1);
+    }
+    _gdsData = GdsData();
+    _layout = Layout();
+    _layoutFile.reset();
+    _sharedLayout.reset();
+    _sharedFlipVert = false;
+    _isImplemented = false;
+}
+
+void CktGraph::rollbackImpl()
+{
+    if (_implStartNodes != INDEX_TYPE_MAX && (_implStartNodes < _nodes.size() || _implStartPins < _pinArray.size()))
+    {
+        auto dropAdded = [&](auto &pinIdxArray)
+        {
+            IndexType numKept = 0;
+            for (IndexType pinIdx : pinIdxArray)
+            {
+                if (pinIdx < _implStartPins)
+                {
+                    pinIdxArray[numKept++] = pinIdx;
+                }
+            }
+            pinIdxArray.resize(numKept);
+        };
+        _nodes.resize(_implStartNodes);
+        _pinArray.resize(_implStartPins);
+        for (CktNodeArrays::Cold &node : _nodes.cold)
+        {
+            dropAdded(node.pinIdxArray);
+        }
+        for (NetArrays::Cold &net : _nets.cold)
+        {
+            dropAdded(net.pinIdxArray);
+            dropAdded(net.subIdxArray);
+        }
+        _isFinalized = false;
+    }
+    _implStartNodes = INDEX_TYPE_MAX;
+    _implStartPins = INDEX_TYPE_MAX;
+    clearImpl();
+}
+
+/*------------------------------*/
+/* ImplCache                    */
+/*------------------------------*/
+ImplCache::ImplCache(DesignDB &db, const std::string &dir)
+    : _db(db), _dir(dir), _fingerprints(db.numCkts(), 0), _hasFingerprint(db.numCkts(), 0), _numNodes(db.numCkts(), 0), _numPins(db.numCkts(), 0),
+      _numHits(0), _numMisses(0)
+{
+    if (!_dir.empty() && _dir.back() != '/')
+    {
+        _dir += '/';
+    }
+    // Take the structural hashes here, so that fingerprinting does not update the design concurrently
+    _structHashes.reserve(_db.numCkts());
+    for (IndexType cktIdx = 0; cktIdx < _db.numCkts(); ++cktIdx)
+    {
+        _structHashes.emplace_back(_db.structHash(cktIdx));
+    }
+}
+
+HashType ImplCache::computeFingerprint(IndexType cktIdx, HashType salt)
+{
+    CktGraph &ckt = _db.subCkt(cktIdx);
+    HashType hash = HashUtil::combine(_structHashes.at(cktIdx), HashUtil::hashString(ckt.name()));
+    hash = HashUtil::combine(hash, salt);
+    // The structural hash ignores the names and the order, while the constraints and the stored implementation depend on them
+    for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx)
+    {
+        IndexType graphIdx = ckt.nodeSubgraphIdx()[nodeIdx];
+        HashType subHash = 0;
+        if (graphIdx != INDEX_TYPE_MAX)
+        {
+            // A salt made up here would not cover the inputs of the sub circuit
+            AssertMsg(hasFingerprint(graphIdx), "ImplCache::%s: sub circuit %u of circuit %u is not fingerprinted \n", __FUNCTION__, graphIdx, cktIdx);
+            subHash = _fingerprints[graphIdx];
+        }
+        hash = HashUtil::combine(hash, HashUtil::hashString(ckt.node(nodeIdx).name()));
+        hash = HashUtil::combine(hash, subHash);
+    }
+    for (IndexType pinIdx = 0; pinIdx < ckt.numPins(); ++pinIdx)
+    {
+        hash = HashUtil::combine(hash, ckt.pinNode(pinIdx));
+        hash = HashUtil::combine(hash, ckt.pinNet(pinIdx));
+        hash = HashUtil::combine(hash, static_cast<HashType>(ckt.pin(pinIdx).pinType()));
+    }
+    for (IndexType netIdx = 0; netIdx < ckt.numNets(); ++netIdx)
+    {
+        hash = HashUtil::combine(hash, HashUtil::hashString(ckt.net(netIdx).name()));
+        hash = HashUtil::combine(hash, ckt.netFlags()[netIdx]);
+    }
+    _fingerprints.at(cktIdx) = hash;
+    _hasFingerprint[cktIdx] = 1;
+    _numNodes[cktIdx] = ckt.numNodes();
+    _numPins[cktIdx] = ckt.numPins();
+    return hash;
+}
+
+HashType ImplCache::fingerprint(IndexType cktIdx) const
+{
+    AssertMsg(hasFingerprint(cktIdx), "ImplCache::%s: circuit %u is not fingerprinted \n", __FUNCTION__, cktIdx);
+    return _fingerprints[cktIdx];
+}
+
+std::string ImplCache::entryFile(IndexType cktIdx) const
+{
+    char key[17];
+    std::snprintf(key, sizeof(key), "%016" PRIx64, static_cast<std::uint64_t>(fingerprint(cktIdx)));
+    return _dir + key + ".impl";
+}
+
+bool ImplCache::contains(IndexType cktIdx) const
+{
+    return std::ifstream(entryFile(cktIdx), std::ios::binary).is_open();
+}
+
+bool ImplCache::restore(IndexType cktIdx, const std::string &resultDir)
+{
+    std::string filename = entryFile(cktIdx);
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open())
+    {
+        ++_numMisses;
+        return false;
+    }
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    try
+    {
+        BinaryReader in(data.data(), data.size());
+        char magic[sizeof(IMPL_CACHE_MAGIC)];
+        for (char &ch : magic)
+        {
+            ch = in.read<char>();
+        }
+        if (!std::equal(magic, magic + sizeof(magic), IMPL_CACHE_MAGIC)
+            || in.read<std::uint32_t>() != IMPL_CACHE_VERSION
+            || in.read<std::uint32_t>() != IMPL_CACHE_BYTE_ORDER
+            || in.read<HashType>() != fingerprint(cktIdx))
+        {
+            throw std::runtime_error("not an entry of this version");
+        }
+        bool isGdsFileInResult = in.read<Byte>() != 0;
+        std::string gdsFile = in.readString();
+        std::vector<std::pair<std::string, std::string>> files(in.read<IndexType>());
+        for (auto &file : files)
+        {
+            file.first = in.readString();
+            file.second = in.readString();
+        }
+        std::vector<SymbolId> symbolMap(in.read<IndexType>());
+        for (SymbolId &symbol : symbolMap)
+        {
+            symbol = SymbolTable::global().intern(in.readString());
+        }
+        in.setSymbolMap(std::move(symbolMap));
+        std::vector<CktGraph> addedCkts(in.read<IndexType>());
+        for (CktGraph &added : addedCkts)
+        {
+            added.load(in);
+            added.layout().load(in);
+            Span<const IndexType> subgraphs = added.nodeSubgraphIdx();
+            if (std::any_of(subgraphs.begin(), subgraphs.end(), [](IndexType graphIdx) { return graphIdx != INDEX_TYPE_MAX; }))
+            {
+                throw std::runtime_error("an added circuit has sub circuits");
+            }
+        }
+        // The files come first, so that a failed write leaves the circuit unchanged.
+        // If the implementation is rejected after them, implementing the circuit writes them again
+        for (const auto &file : files)
+        {
+            if (!writeFile(resultDir + file.first, file.second))
+            {
+                throw std::runtime_error("cannot write the result file " + resultDir + file.first);
+            }
+        }
+        CktGraph &ckt = _db.subCkt(cktIdx);
+        IndexType numNodes = ckt.numNodes();
+        // The added nodes point to their added circuits by index until the circuits are allocated
+        ckt.loadImpl(in, [&](IndexType ref)
+                {
+                    if (ref >= addedCkts.size())
+                    {
+                        throw std::runtime_error("invalid added circuit " + std::to_string(ref));
+                    }
+                    return ref;
+                });
+        std::vector<IndexType> addedIdx;
+        addedIdx.reserve(addedCkts.size());
+        for (CktGraph &added : addedCkts)
+        {
+            addedIdx.emplace_back(_db.allocateCkt());
+            _db.subCkt(addedIdx.back()) = std::move(added);
+        }
+        for (IndexType nodeIdx = numNodes; nodeIdx < ckt.numNodes(); ++nodeIdx)
+        {
+            IndexType ref = ckt.nodeSubgraphIdx()[nodeIdx];
+            if (ref != INDEX_TYPE_MAX)
+            {
+                ckt.node(nodeIdx).setSubgraphIdx(addedIdx[ref]);
+            }
+        }
+        if (isGdsFileInResult)
+        {
+            ckt.gdsData().setGdsFile(resultDir + gdsFile);
+        }
+    }
+    catch (const std::exception &e)
+    {
+        WRN("ImplCache::%s: ignore the entry %s of circuit %s: %s \n", __FUNCTION__, filename.c_str(), _db.subCkt(cktIdx).name().c_str(), e.what());
+        ++_numMisses;
+        return false;
+    }
+    ++_numHits;
+    return true;
+}
+
+bool ImplCache::store(IndexType cktIdx, const std::string &resultDir, const std::vector<std::string> &files) const
+{
+    const CktGraph &ckt = _db.subCkt(cktIdx);
+    std::vector<std::string> contents(files.size());
+    for (IndexType fileIdx = 0; fileIdx < files.size(); ++fileIdx)
+    {
+        if (!readFile(resultDir + files[fileIdx], contents[fileIdx]))
+        {
+            ERR("ImplCache::%s: cannot read the result file: %s \n", __FUNCTION__, (resultDir + files[fileIdx]).c_str());
+            return false;
+        }
+    }
+    // The circuits allocated for the added nodes since the cache was created, with their symbols numbered in the entry
+    std::vector<CktGraph> addedCkts;
+    std::unordered_map<IndexType, IndexType> addedRefs;
+    std::vector<SymbolId> symbols;
+    std::unordered_map<SymbolId, SymbolId> symbolIds;
+    auto localSymbol = [&](SymbolId symbol)
+    {
+        auto inserted = symbolIds.emplace(symbol, symbols.size());
+        if (inserted.second)
+        {
+            symbols.emplace_back(symbol);
+        }
+        return inserted.first->second;
+    };
+    for (IndexType nodeIdx = _numNodes[cktIdx]; nodeIdx < ckt.numNodes(); ++nodeIdx)
+    {
+        IndexType graphIdx = ckt.nodeSubgraphIdx()[nodeIdx];
+        if (graphIdx == INDEX_TYPE_MAX || addedRefs.count(graphIdx))
+        {
+            continue;
+        }
+        const CktGraph &added = _db.subCkt(graphIdx);
+        Span<const IndexType> subgraphs = added.nodeSubgraphIdx();
+        if (graphIdx < _structHashes.size()
+            || std::any_of(subgraphs.begin(), subgraphs.end(), [](IndexType subIdx) { return subIdx != INDEX_TYPE_MAX; }))
+        {
+            ERR("ImplCache::%s: circuit %s added a node of circuit %u, which is not a new circuit without sub circuits \n", __FUNCTION__,
+                ckt.name().c_str(), graphIdx);
+            return false;
+        }
+        addedRefs.emplace(graphIdx, addedCkts.size());
+        addedCkts.emplace_back(added);
+        addedCkts.back().remapSymbols(localSymbol);
+    }
+    // The gds file is kept relative to the result directory, so that a hit in another run points into the result directory of that run
+    const std::string &gdsFile = ckt.gdsData().gdsFile();
+    bool isGdsFileInResult = !resultDir.empty() && gdsFile.compare(0, resultDir.size(), resultDir) == 0;
+    // Several flows may share the cache directory, so write aside and rename
+    std::string filename = entryFile(cktIdx);
+    std::string tmpName = filename + ".tmp";
+    {
+        std::ofstream file(tmpName, std::ios::binary | std::ios::trunc);
+        if (!file.is_open())
+        {
+            ERR("ImplCache::%s: cannot open file: %s \n", __FUNCTION__, tmpName.c_str());
+            return false;
+        }
+        BinaryWriter out(file);
+        out.writeBytes(IMPL_CACHE_MAGIC, sizeof(IMPL_CACHE_MAGIC));
+        out.write<std::uint32_t>(IMPL_CACHE_VERSION);
+        out.write<std::uint32_t>(IMPL_CACHE_BYTE_ORDER);
+        out.write<HashType>(fingerprint(cktIdx));
+        out.write<Byte>(isGdsFileInResult);
+        out.writeString(isGdsFileInResult ? gdsFile.substr(resultDir.size()) : gdsFile);
+        out.write<IndexType>(files.size());
+        for (IndexType fileIdx = 0; fileIdx < files.size(); ++fileIdx)
+        {
+            out.writeString(files[fileIdx]);
+            out.writeString(contents[fileIdx]);
+        }
+        out.write<IndexType>(symbols.size());
+        for (SymbolId symbol : symbols)
+        {
+            out.writeString(SymbolTable::global().str(symbol));
+        }
+        out.write<IndexType>(addedCkts.size());
+        for (const CktGraph &added : addedCkts)
+        {
+            added.save(out);
+            added.saveLayout(out);
+        }
+        ckt.saveImpl(out, _numNodes[cktIdx], _numPins[cktIdx], [&](IndexType graphIdx) { return addedRefs.at(graphIdx); });
+        file.close();
+        if (!out.good() || file.fail())
+        {
+            ERR("ImplCache::%s: failed to write file: %s \n", __FUNCTION__, tmpName.c_str());
+            std::remove(tmpName.c_str());
+            return false;
+        }
+    }
+    if (std::rename(tmpName.c_str(), filename.c_str()) != 0)
+    {
+        ERR("ImplCache::%s: cannot replace file: %s \n", __FUNCTION__, filename.c_str());
+        std::remove(tmpName.c_str());
+        return false;
+    }
+    return true;
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,97 @@
+/**
+ * @file ImplCache.h
+ * @brief A persistent cache of the implemented circuits, keyed by fingerprints of their inputs
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_IMPL_CACHE_H_
+#define MAGICAL_FLOW_IMPL_CACHE_H_
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+class DesignDB;
+
+/// @class MAGICAL_FLOW::ImplCache
+/// @brief keep the implementations of the circuits in a directory across the runs of the flow.
+/// The fingerprint of a circuit covers its netlist, its device properties, the names of its nodes and nets,
+/// a salt for the inputs outside the design (the constraint files and the parameters) and the fingerprints of its sub circuits.
+/// An edit to a circuit therefore changes the fingerprints of it and its ancestors only, and the rest are restored from the cache.
+/// Each entry is one file named by the fingerprint, holding the layout, the placement of the nodes, the IO pins, the gds data
+/// and the result files of the circuit, which a hit writes into the result directory of the run. The nodes the implementation added
+/// to the circuit after it was fingerprinted, such as the IO pin nodes of the placer, are stored with their circuits and added again by a hit
+class ImplCache
+{
+    public:
+        /// @brief constructor. The structural hashes of the circuits are taken here, so the netlist edits after it are not seen
+        /// @param first: the design
+        /// @param second: the directory of the entries. It must exist
+        explicit ImplCache(DesignDB &db, const std::string &dir);
+        /*------------------------------*/
+        /* Fingerprints                 */
+        /*------------------------------*/
+        /// @brief compute the fingerprint of a circuit. Its sub circuits must be fingerprinted, with their own salts.
+        /// Different circuits may be fingerprinted concurrently once their sub circuits are. Call it before implementing the circuit,
+        /// as the nodes and pins after the ones here are taken as added by the implementation
+        /// @param first: the index of the circuit
+        /// @param second: the hash of the inputs of the circuit outside the design
+        /// @return the fingerprint
+        HashType computeFingerprint(IndexType cktIdx, HashType salt);
+        /// @brief whether a circuit is fingerprinted
+        /// @param the index of the circuit
+        /// @return whether computeFingerprint() was called on it
+        bool hasFingerprint(IndexType cktIdx) const { return _hasFingerprint.at(cktIdx) != 0; }
+        /// @brief get the fingerprint of a circuit
+        /// @param the index of the circuit
+        /// @return the fingerprint computed by computeFingerprint()
+        HashType fingerprint(IndexType cktIdx) const;
+        /*------------------------------*/
+        /* Entries                      */
+        /*------------------------------*/
+        /// @brief get the file of the entry of a circuit
+        /// @param the index of the fingerprinted circuit
+        /// @return the file name
+        std::string entryFile(IndexType cktIdx) const;
+        /// @brief whether the cache has the entry of a circuit
+        /// @param the index of the fingerprinted circuit
+        /// @return whether the entry file exists
+        bool contains(IndexType cktIdx) const;
+        /// @brief replace the implementation of a circuit by its entry and mark it implemented. The result files of the entry are
+        /// written into the result directory, and a gds file stored in the result directory is moved there with them.
+        /// The added nodes of the entry are added to the circuit, and new circuits are allocated for their subgraphs
+        /// @param first: the index of the fingerprinted circuit
+        /// @param second: the result directory of this run. A result file is written to resultDir + its name given to store()
+        /// @return false if the cache misses. A corrupted entry, or a result file that cannot be written, is a miss and the circuit is unchanged
+        bool restore(IndexType cktIdx, const std::string &resultDir = "");
+        /// @brief write the implementation of a circuit and its result files as its entry. The entry is replaced only after the new one is completely written
+        /// @param first: the index of the fingerprinted circuit
+        /// @param second: the result directory of this run
+        /// @param third: the names of the result files relative to the result directory. A file that cannot be read fails the store
+        /// @return whether the entry is written
+        bool store(IndexType cktIdx, const std::string &resultDir = "", const std::vector<std::string> &files = {}) const;
+        /// @brief get the number of restore() that hit
+        /// @return the number of hits
+        IndexType numHits() const { return _numHits; }
+        /// @brief get the number of restore() that missed
+        /// @return the number of misses
+        IndexType numMisses() const { return _numMisses; }
+    private:
+        DesignDB &_db; ///< The design
+        std::string _dir; ///< The directory of the entries
+        std::vector<HashType> _structHashes; ///< _structHashes[cktIdx] = the structural hash of the circuit when the cache was created
+        std::vector<HashType> _fingerprints; ///< _fingerprints[cktIdx] = the fingerprint of the circuit
+        std::vector<Byte> _hasFingerprint; ///< _hasFingerprint[cktIdx] = whether the circuit is fingerprinted
+        std::vector<IndexType> _numNodes; ///< _numNodes[cktIdx] = the number of nodes of the circuit when it was fingerprinted, before its implementation
+        std::vector<IndexType> _numPins; ///< _numPins[cktIdx] = the number of pins of the circuit when it was fingerprinted
+        std::atomic<IndexType> _numHits; ///< The number of hits
+        std::atomic<IndexType> _numMisses; ///< The number of misses
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_IMPL_CACHE_H_
@@ -0,0 +1,335 @@
+/**
+ * @file ImplScheduler.cpp
+ * @brief Run the implementation of the circuits of a DesignDB in parallel, children before parents
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/ImplScheduler.h"
+#include "db/DesignDB.h"
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+PROJECT_NAMESPACE_BEGIN
+
+IndexType ImplScheduler::addStage(const std::string &name, Callback callback, bool barrier)
+{
+    AssertMsg(_ckts.empty(), "ImplScheduler::%s: add the stages before build() \n", __FUNCTION__);
+    _stageNames.emplace_back(name);
+    _callbacks.emplace_back(std::move(callback));
+    _barriers.emplace_back(barrier ? 1 : 0);
+    return _stageNames.size() - 1;
+}
+
+void ImplScheduler::build(const std::vector<IndexType> &ckts)
+{
+    AssertMsg(numStages() > 0, "ImplScheduler::%s: no stage \n", __FUNCTION__);
+    _ckts = ckts;
+    _schedIdx.assign(_db.numCkts(), INDEX_TYPE_MAX);
+    for (IndexType pos = 0; pos < _ckts.size(); ++pos)
+    {
+        AssertMsg(_ckts[pos] < _db.numCkts() && _schedIdx[_ckts[pos]] == INDEX_TYPE_MAX,
+                  "ImplScheduler::%s: invalid or repeated circuit %u \n", __FUNCTION__, _ckts[pos]);
+        _schedIdx[_ckts[pos]] = pos;
+    }
+    // The distinct sub circuits of every scheduled circuit, and the scheduled parents of each
+    IndexType numCkts = _ckts.size();
+    _childStart.assign(1, 0);
+    _children.clear();
+    std::vector<IndexType> numParents(numCkts + 1, 0);
+    for (IndexType cktIdx : _ckts)
+    {
+        Span<const IndexType> subgraphs = _db.subCkt(cktIdx).nodeSubgraphIdx();
+        std::vector<IndexType> children(subgraphs.begin(), subgraphs.end());
+        std::sort(children.begin(), children.end());
+        children.erase(std::unique(children.begin(), children.end()), children.end());
+        if (!children.empty() && children.back() == INDEX_TYPE_MAX)
+        {
+            children.pop_back();
+        }
+        for (IndexType child : children)
+        {
+            if (_schedIdx[child] != INDEX_TYPE_MAX)
+            {
+                ++numParents[_schedIdx[child] + 1];
+            }
+        }
+        _children.insert(_children.end(), children.begin(), children.end());
+        _childStart.emplace_back(_children.size());
+    }
+    std::partial_sum(numParents.begin(), numParents.end(), numParents.begin());
+    _parentStart = numParents;
+    _parents.resize(_parentStart.back());
+    for (IndexType pos = 0; pos < numCkts; ++pos)
+    {
+        for (IndexType idx = _childStart[pos]; idx < _childStart[pos + 1]; ++idx)
+        {
+            IndexType childPos = _schedIdx[_children[idx]];
+            if (childPos != INDEX_TYPE_MAX)
+            {
+                _parents[numParents[childPos]++] = pos;
+            }
+        }
+    }
+    std::vector<double> ones(numCkts * numStages(), 1.0);
+    std::vector<double> chains = longestChains(ones);
+    _chainLength.assign(chains.begin(), chains.end());
+    reset();
+}
+
+std::vector<double> ImplScheduler::longestChains(const std::vector<double> &weights) const
+{
+    // Visit the stages backward, and the parents before the children in each stage
+    IndexType numCkts = _ckts.size();
+    std::vector<IndexType> topDown(numCkts);
+    std::iota(topDown.begin(), topDown.end(), 0);
+    std::stable_sort(topDown.begin(), topDown.end(), [&](IndexType lhs, IndexType rhs)
+            { return _db.cktLevel(_ckts[lhs]) > _db.cktLevel(_ckts[rhs]); });
+    std::vector<double> chains(numCkts * numStages(), 0.0);
+    double nextStageMax = 0.0;
+    for (IndexType stage = numStages(); stage > 0; --stage)
+    {
+        IndexType base = (stage - 1) * numCkts;
+        bool nextIsBarrier = stage < numStages() && _barriers[stage];
+        double stageMax = 0.0;
+        for (IndexType pos : topDown)
+        {
+            double after = 0.0;
+            if (stage < numStages())
+            {
+                after = nextIsBarrier ? nextStageMax : chains[base + numCkts + pos];
+            }
+            for (IndexType idx = _parentStart[pos]; idx < _parentStart[pos + 1]; ++idx)
+            {
+                after = std::max(after, chains[base + _parents[idx]]);
+            }
+            chains[base + pos] = weights[base + pos] + after;
+            stageMax = std::max(stageMax, chains[base + pos]);
+        }
+        nextStageMax = stageMax;
+    }
+    return chains;
+}
+
+void ImplScheduler::reset()
+{
+    IndexType numCkts = _ckts.size();
+    IndexType numAllTasks = numCkts * numStages();
+    _numDeps.assign(numAllTasks, 0);
+    for (IndexType stage = 0; stage < numStages(); ++stage)
+    {
+        for (IndexType pos = 0; pos < numCkts; ++pos)
+        {
+            IndexType numDeps = stage > 0 ? 1 : 0; // The previous stage of the circuit, or the whole previous stage
+            for (IndexType idx = _childStart[pos]; idx < _childStart[pos + 1]; ++idx)
+            {
+                numDeps += _schedIdx[_children[idx]] != INDEX_TYPE_MAX ? 1 : 0;
+            }
+            _numDeps[stage * numCkts + pos] = numDeps;
+        }
+    }
+    _stageRemaining.assign(numStages(), numCkts);
+    _states.assign(numAllTasks, ImplTaskState::WAITING);
+    _runtimes.assign(numAllTasks, 0.0);
+    _ready = decltype(_ready)();
+    for (IndexType task = 0; task < numAllTasks; ++task)
+    {
+        if (_numDeps[task] == 0)
+        {
+            release(task);
+        }
+    }
+    _numRunning = 0;
+    _stop = false;
+    _error = nullptr;
+}
+
+bool ImplScheduler::run(IndexType numThreads)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        reset();
+    }
+    // The workers read the circuits under the lock, so the callbacks allocate circuits under it too
+    _db.setCktTableMutex(&_mutex);
+    // The calling thread is one of the workers
+    std::vector<std::thread> workers;
+    for (IndexType idx = 1; idx < numThreads; ++idx)
+    {
+        workers.emplace_back(&ImplScheduler::work, this);
+    }
+    work();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+    _db.setCktTableMutex(nullptr);
+    if (_error)
+    {
+        std::rethrow_exception(_error);
+    }
+    return numTasks(ImplTaskState::DONE) == _states.size();
+}
+
+void ImplScheduler::work()
+{
+    IndexType numCkts = _ckts.size();
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+        // Nothing ready and nothing running means all done, or blocked by a failure
+        _cv.wait(lock, [&]() { return _stop || !_ready.empty() || _numRunning == 0; });
+        if (_stop || _ready.empty())
+        {
+            break;
+        }
+        IndexType task = _ready.top().second;
+        _ready.pop();
+        _states[task] = ImplTaskState::RUNNING;
+        ++_numRunning;
+        IndexType pos = task % numCkts;
+        IndexType stage = task / numCkts;
+        std::exception_ptr error;
+        try
+        {
+            // Read the layouts left in a checkpoint here, one at a time, before the parallel callbacks can read them.
+            // The callbacks may append circuits meanwhile, which DesignDB does under this lock
+            for (IndexType idx = _childStart[pos]; idx < _childStart[pos + 1]; ++idx)
+            {
+                CktGraph &child = _db.subCkt(_children[idx]);
+                if (!child.isLayoutLoaded())
+                {
+                    child.layout();
+                }
+            }
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+        lock.unlock();
+        bool success = false;
+        auto start = std::chrono::steady_clock::now();
+        if (!error)
+        {
+            try
+            {
+                success = _callbacks[stage](_ckts[pos]);
+            }
+            catch (...)
+            {
+                error = std::current_exception();
+            }
+        }
+        std::chrono::duration<double> runtime = std::chrono::steady_clock::now() - start;
+        lock.lock();
+        _runtimes[task] = runtime.count();
+        if (error && !_error)
+        {
+            _error = error;
+        }
+        --_numRunning;
+        finish(task, success && !error);
+        _cv.notify_all();
+    }
+    _cv.notify_all();
+}
+
+void ImplScheduler::finish(IndexType task, bool success)
+{
+    _states[task] = success ? ImplTaskState::DONE : ImplTaskState::FAILED;
+    if (!success)
+    {
+        _stop = true;
+        return;
+    }
+    IndexType numCkts = _ckts.size();
+    IndexType pos = task % numCkts;
+    IndexType stage = task / numCkts;
+    auto done = [&](IndexType next)
+    {
+        if (--_numDeps[next] == 0)
+        {
+            release(next);
+        }
+    };
+    --_stageRemaining[stage];
+    for (IndexType idx = _parentStart[pos]; idx < _parentStart[pos + 1]; ++idx)
+    {
+        done(stage * numCkts + _parents[idx]);
+    }
+    if (stage + 1 < numStages())
+    {
+        if (!_barriers[stage + 1])
+        {
+            done(task + numCkts);
+        }
+        else if (_stageRemaining[stage] == 0)
+        {
+            for (IndexType next = 0; next < numCkts; ++next)
+            {
+                done((stage + 1) * numCkts + next);
+            }
+        }
+    }
+}
+
+void ImplScheduler::release(IndexType task)
+{
+    _states[task] = ImplTaskState::READY;
+    _ready.emplace(_chainLength[task], task);
+}
+
+IndexType ImplScheduler::taskIdx(IndexType cktIdx, IndexType stage) const
+{
+    AssertMsg(cktIdx < _schedIdx.size() && _schedIdx[cktIdx] != INDEX_TYPE_MAX && stage < numStages(),
+              "ImplScheduler::%s: circuit %u stage %u is not scheduled \n", __FUNCTION__, cktIdx, stage);
+    return stage * _ckts.size() + _schedIdx[cktIdx];
+}
+
+ImplTaskState ImplScheduler::taskState(IndexType cktIdx, IndexType stage) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _states[taskIdx(cktIdx, stage)];
+}
+
+IndexType ImplScheduler::numTasks(ImplTaskState state) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return std::count(_states.begin(), _states.end(), state);
+}
+
+std::vector<std::pair<IndexType, IndexType>> ImplScheduler::runningTasks() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<std::pair<IndexType, IndexType>> running;
+    for (IndexType task = 0; task < _states.size(); ++task)
+    {
+        if (_states[task] == ImplTaskState::RUNNING)
+        {
+            running.emplace_back(_ckts[task % _ckts.size()], task / _ckts.size());
+        }
+    }
+    return running;
+}
+
+double ImplScheduler::taskRuntime(IndexType cktIdx, IndexType stage) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _runtimes[taskIdx(cktIdx, stage)];
+}
+
+double ImplScheduler::criticalPathRuntime() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<double> chains = longestChains(_runtimes);
+    return chains.empty() ? 0.0 : *std::max_element(chains.begin(), chains.end());
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,151 @@
+/**
+ * @file ImplScheduler.h
+ * @brief Run the implementation of the circuits of a DesignDB in parallel, children before parents
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_IMPL_SCHEDULER_H_
+#define MAGICAL_FLOW_IMPL_SCHEDULER_H_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+class DesignDB;
+
+/// @brief the state of one implementation task
+enum class ImplTaskState : Byte
+{
+    WAITING = 0, ///< Some task it depends on is not done
+    READY = 1, ///< Queued for a worker
+    RUNNING = 2, ///< The callback is running
+    DONE = 3, ///< The callback succeeded
+    FAILED = 4 ///< The callback returned false or threw
+};
+
+/// @class MAGICAL_FLOW::ImplScheduler
+/// @brief a task graph over the hierarchy of a DesignDB. Every scheduled circuit runs the callbacks of the stages in order,
+/// and a stage of a circuit starts only after the same stage of its scheduled sub circuits is done.
+/// A barrier stage also waits for the previous stage of all the circuits.
+/// The ready tasks are run on a pool of workers, the ones heading the longest chains of remaining tasks first.
+/// The callbacks of different circuits run concurrently, so a callback must only write to its own circuit, or allocate new circuits. See DesignDB::setCktTableMutex()
+class ImplScheduler
+{
+    public:
+        /// @brief the implementation of one stage of a circuit
+        /// @param the index of the circuit
+        /// @return false if the implementation failed
+        typedef std::function<bool(IndexType)> Callback;
+        /// @brief constructor
+        /// @param the design. Its hierarchy must be levelized with DesignDB::findRootCkt()
+        explicit ImplScheduler(DesignDB &db) : _db(db) {}
+        /*------------------------------*/
+        /* Setup                        */
+        /*------------------------------*/
+        /// @brief append a stage
+        /// @param first: the name of the stage
+        /// @param second: the callback
+        /// @param third: whether the stage waits for the previous stage of all the circuits
+        /// @return the index of the stage
+        IndexType addStage(const std::string &name, Callback callback, bool barrier = false);
+        /// @brief set the circuits to implement. The sub circuits not in the list are taken as implemented
+        /// @param the indices of the circuits
+        void build(const std::vector<IndexType> &ckts);
+        /*------------------------------*/
+        /* Run                          */
+        /*------------------------------*/
+        /// @brief run all the tasks. After a failure, no new task is started and the running ones are finished
+        /// @param the number of workers. 0 for the number of hardware threads
+        /// @return whether all the tasks are done. The first exception thrown by a callback is rethrown instead
+        bool run(IndexType numThreads = 0);
+        /*------------------------------*/
+        /* Queue state                  */
+        /*------------------------------*/
+        /// @brief get the number of stages
+        /// @return the number of stages
+        IndexType numStages() const { return _stageNames.size(); }
+        /// @brief get the name of a stage
+        /// @param the index of the stage
+        /// @return the name
+        const std::string & stageName(IndexType stage) const { return _stageNames.at(stage); }
+        /// @brief get the scheduled circuits
+        /// @return the indices of the circuits, in the order given to build()
+        const std::vector<IndexType> & ckts() const { return _ckts; }
+        /// @brief get the state of a task. Safe to call while running
+        /// @param first: the index of the circuit
+        /// @param second: the index of the stage
+        /// @return the state
+        ImplTaskState taskState(IndexType cktIdx, IndexType stage) const;
+        /// @brief get the number of tasks in a state. Safe to call while running
+        /// @param the state
+        /// @return the number of tasks
+        IndexType numTasks(ImplTaskState state) const;
+        /// @brief get the running tasks. Safe to call while running
+        /// @return the (circuit, stage) of the running tasks
+        std::vector<std::pair<IndexType, IndexType>> runningTasks() const;
+        /// @brief get the wall time of a finished task
+        /// @param first: the index of the circuit
+        /// @param second: the index of the stage
+        /// @return the runtime in seconds. 0 if the task is not finished
+        double taskRuntime(IndexType cktIdx, IndexType stage) const;
+        /// @brief get the runtime of the longest chain of dependent tasks in the last run, the lower bound of its wall time
+        /// @return the runtime in seconds
+        double criticalPathRuntime() const;
+    private:
+        /// @brief get the task of a stage of a circuit
+        IndexType taskIdx(IndexType cktIdx, IndexType stage) const;
+        /// @brief compute the longest chains of dependent tasks
+        /// @param weights[task] = the weight of the task
+        /// @return chains[task] = the total weight of the longest chain starting from the task
+        std::vector<double> longestChains(const std::vector<double> &weights) const;
+        /// @brief reset the states and queue the tasks without dependencies
+        void reset();
+        /// @brief the loop of a worker
+        void work();
+        /// @brief mark a task finished and release the tasks waiting for it. The lock must be held
+        void finish(IndexType task, bool success);
+        /// @brief queue a task whose dependencies are done. The lock must be held
+        void release(IndexType task);
+    private:
+        DesignDB &_db; ///< The design
+        std::vector<std::string> _stageNames; ///< The names of the stages
+        std::vector<Callback> _callbacks; ///< _callbacks[stage] = the implementation of the stage
+        std::vector<Byte> _barriers; ///< _barriers[stage] = whether the stage waits for the whole previous stage
+        std::vector<IndexType> _ckts; ///< The scheduled circuits
+        std::vector<IndexType> _schedIdx; ///< _schedIdx[cktIdx] = the position in _ckts. INDEX_TYPE_MAX if not scheduled
+        /*------------------------------*/
+        /* Task graph                   */
+        /*------------------------------*/
+        // Task t is stage t / _ckts.size() of circuit _ckts[t % _ckts.size()]
+        std::vector<IndexType> _parentStart; ///< The parents of schedule position p are _parents[_parentStart[p], _parentStart[p + 1])
+        std::vector<IndexType> _parents; ///< The schedule positions of the scheduled parents, once per parent circuit
+        std::vector<IndexType> _childStart; ///< The children of schedule position p are _children[_childStart[p], _childStart[p + 1])
+        std::vector<IndexType> _children; ///< The indices of all the sub circuits, once per sub circuit
+        std::vector<IndexType> _numDeps; ///< _numDeps[task] = the number of unfinished tasks it waits for
+        std::vector<IndexType> _chainLength; ///< _chainLength[task] = the number of tasks on the longest chain starting from it
+        std::vector<IndexType> _stageRemaining; ///< _stageRemaining[stage] = the number of unfinished tasks of the stage
+        std::vector<ImplTaskState> _states; ///< _states[task] = the state
+        std::vector<double> _runtimes; ///< _runtimes[task] = the wall time in seconds
+        std::priority_queue<std::pair<IndexType, IndexType>> _ready; ///< The ready tasks as (chain length, task)
+        /*------------------------------*/
+        /* Workers                      */
+        /*------------------------------*/
+        mutable std::mutex _mutex; ///< Guards the task states and the queue
+        std::condition_variable _cv; ///< Notified when tasks are queued or the run ends
+        IndexType _numRunning = 0; ///< The number of running tasks
+        bool _stop = false; ///< Whether a task failed
+        std::exception_ptr _error; ///< The first exception thrown by a callback
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_IMPL_SCHEDULER_H_
@@ -6,16 +6,19 @@
  */
 
 #include "db/Layout.h"
+#include "util/BinaryIO.h"
+#include "util/Hash.h"
+#include <algorithm>
  
 PROJECT_NAMESPACE_BEGIN
 
-void Layout::insertLayout(Layout & layout, LocType x_offset, LocType y_offset, bool flipVertFlag)
+void Layout::insertLayout(const Layout & layout, LocType x_offset, LocType y_offset, bool flipVertFlag)
 {
     for (IndexType layerIdx = 0; layerIdx < layout.numLayers(); layerIdx++)
     {
         for (IndexType recIdx = 0; recIdx < layout.numRects(layerIdx); recIdx++)
         {
-            RectLayout rect = layout.rect(layerIdx, recIdx);
+            const RectLayout &rect = layout.rect(layerIdx, recIdx);
             LocType xlo, xhi, ylo, yhi;
             if (flipVertFlag)
             {
@@ -36,6 +39,191 @@ void Layout::insertLayout(Layout & layout, LocType x_offset, LocType y_offset, b
     }
 }
 
+void Layout::flipVert()
+{
+    LocType axis = _boundary.xLo() + _boundary.xHi();
+    for (LayoutLayer &layer : _layers)
+    {
+        for (RectLayout &rect : layer.rectList())
+        {
+            LocType xLo = rect.rect().xLo();
+            rect.rect().setXLo(axis - rect.rect().xHi());
+            rect.rect().setXHi(axis - xLo);
+        }
+        for (TextLayout &text : layer.textList())
+        {
+            text.coord().setX(axis - text.coord().x());
+        }
+    }
+}
+
+HashType Layout::hash(bool flipVertFlag) const
+{
+    LocType axis = _boundary.xLo() + _boundary.xHi();
+    HashType hash = HashUtil::combine(static_cast<HashType>(_numLayers), static_cast<HashType>(_boundary.xLo()));
+    hash = HashUtil::combine(hash, static_cast<HashType>(_boundary.yLo()));
+    hash = HashUtil::combine(hash, static_cast<HashType>(_boundary.xHi()));
+    hash = HashUtil::combine(hash, static_cast<HashType>(_boundary.yHi()));
+    for (IndexType layerIdx = 0; layerIdx < _layers.size(); ++layerIdx)
+    {
+        const LayoutLayer &layer = _layers[layerIdx];
+        if (layer.textList().empty() && layer.rectList().empty())
+        {
+            continue;
+        }
+        hash = HashUtil::combine(hash, layerIdx);
+        for (const RectLayout &rect : layer.rectList())
+        {
+            const Box<LocType> &box = rect.rect();
+            hash = HashUtil::combine(hash, static_cast<HashType>(flipVertFlag ? axis - box.xHi() : box.xLo()));
+            hash = HashUtil::combine(hash, static_cast<HashType>(box.yLo()));
+            hash = HashUtil::combine(hash, static_cast<HashType>(flipVertFlag ? axis - box.xLo() : box.xHi()));
+            hash = HashUtil::combine(hash, static_cast<HashType>(box.yHi()));
+            hash = HashUtil::combine(hash, rect.datatype());
+        }
+        for (const TextLayout &text : layer.textList())
+        {
+            hash = HashUtil::combine(hash, HashUtil::hashString(text.text()));
+            hash = HashUtil::combine(hash, static_cast<HashType>(flipVertFlag ? axis - text.coord().x() : text.coord().x()));
+            hash = HashUtil::combine(hash, static_cast<HashType>(text.coord().y()));
+        }
+    }
+    return hash;
+}
+
+bool Layout::equals(const Layout &other, bool flipVertFlag) const
+{
+    if (_numLayers != other._numLayers || !(_boundary == other._boundary) || _layers.size() != other._layers.size())
+    {
+        return false;
+    }
+    LocType axis = other._boundary.xLo() + other._boundary.xHi();
+    for (IndexType layerIdx = 0; layerIdx < _layers.size(); ++layerIdx)
+    {
+        const LayoutLayer &layer = _layers[layerIdx];
+        const LayoutLayer &otherLayer = other._layers[layerIdx];
+        if (layer.rectList().size() != otherLayer.rectList().size() || layer.textList().size() != otherLayer.textList().size())
+        {
+            return false;
+        }
+        for (IndexType rectIdx = 0; rectIdx < layer.rectList().size(); ++rectIdx)
+        {
+            const RectLayout &rect = layer.rectList()[rectIdx];
+            const RectLayout &otherRect = otherLayer.rectList()[rectIdx];
+            Box<LocType> box = otherRect.rect();
+            if (flipVertFlag)
+            {
+                box.setXLo(axis - otherRect.rect().xHi());
+                box.setXHi(axis - otherRect.rect().xLo());
+            }
+            if (!(rect.rect() == box) || rect.datatype() != otherRect.datatype())
+            {
+                return false;
+            }
+        }
+        for (IndexType textIdx = 0; textIdx < layer.textList().size(); ++textIdx)
+        {
+            const TextLayout &text = layer.textList()[textIdx];
+            const TextLayout &otherText = otherLayer.textList()[textIdx];
+            LocType x = flipVertFlag ? axis - otherText.coord().x() : otherText.coord().x();
+            if (text.text() != otherText.text() || text.coord().x() != x || text.coord().y() != otherText.coord().y())
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void Layout::save(BinaryWriter &out) const
+{
+    out.write<IntType>(_numLayers);
+    out.write<LocType>(_boundary.xLo());
+    out.write<LocType>(_boundary.yLo());
+    out.write<LocType>(_boundary.xHi());
+    out.write<LocType>(_boundary.yHi());
+    IndexType numUsed = std::count_if(_layers.begin(), _layers.end(), [](const LayoutLayer &layer)
+            { return !layer.textList().empty() || !layer.rectList().empty(); });
+    out.write<IndexType>(numUsed);
+    for (IndexType layerIdx = 0; layerIdx < _layers.size(); ++layerIdx)
+    {
+        const LayoutLayer &layer = _layers[layerIdx];
+        if (layer.textList().empty() && layer.rectList().empty())
+        {
+            continue;
+        }
+        out.write<IndexType>(layerIdx);
+        out.write<IndexType>(layer.textList().size());
+        for (const TextLayout &text : layer.textList())
+        {
+            out.writeString(text.text());
+            out.write<LocType>(text.coord().x());
+            out.write<LocType>(text.coord().y());
+        }
+        out.write<IndexType>(layer.rectList().size());
+        for (const RectLayout &rect : layer.rectList())
+        {
+            // Field by field, so that the padding never reaches the file
+            out.write<LocType>(rect.rect().xLo());
+            out.write<LocType>(rect.rect().yLo());
+            out.write<LocType>(rect.rect().xHi());
+            out.write<LocType>(rect.rect().yHi());
+            out.write<IndexType>(rect.datatype());
+        }
+    }
+}
+
+void Layout::load(BinaryReader &in)
+{
+    IntType numLayers = in.read<IntType>();
+    if (numLayers < 0)
+    {
+        throw std::runtime_error("Layout::load: invalid number of layers");
+    }
+    this->init(numLayers);
+    LocType xLo = in.read<LocType>();
+    LocType yLo = in.read<LocType>();
+    LocType xHi = in.read<LocType>();
+    LocType yHi = in.read<LocType>();
+    IndexType numUsed = in.read<IndexType>();
+    for (IndexType idx = 0; idx < numUsed; ++idx)
+    {
+        IndexType layerIdx = in.read<IndexType>();
+        if (layerIdx >= _layers.size())
+        {
+            throw std::runtime_error("Layout::load: invalid layer " + std::to_string(layerIdx));
+        }
+        LayoutLayer &layer = _layers[layerIdx];
+        IndexType numTexts = in.read<IndexType>();
+        for (IndexType textIdx = 0; textIdx < numTexts; ++textIdx)
+        {
+            std::string text = in.readString();
+            LocType x = in.read<LocType>();
+            LocType y = in.read<LocType>();
+            layer.insertText(text, x, y);
+        }
+        IndexType numRects = in.read<IndexType>();
+        std::vector<RectLayout> &rects = layer.rectList();
+        rects.reserve(numRects);
+        for (IndexType rectIdx = 0; rectIdx < numRects; ++rectIdx)
+        {
+            LocType rxLo = in.read<LocType>();
+            LocType ryLo = in.read<LocType>();
+            LocType rxHi = in.read<LocType>();
+            LocType ryHi = in.read<LocType>();
+            IndexType datatype = in.read<IndexType>();
+            if (datatype >= RESERVED_DATATYPES_NUMBER && datatype != DRAWING_DATATYPE)
+            {
+                throw std::runtime_error("Layout::load: invalid datatype " + std::to_string(datatype));
+            }
+            rects.emplace_back(rxLo, ryLo, rxHi, ryHi);
+            rects.back().setDatatype(datatype);
+        }
+    }
+    // The boundary was saved as is. It may differ from the union of the shapes after setBoundary()
+    _boundary.set(xLo, yLo, xHi, yHi);
+}
+
 // void RectLayout::shift(LocType x_offset, LocType y_offset)
 // {
 //     _rect.setXLo(_rect.xLo() + x_offset);
@@ -10,10 +10,15 @@
 
 #include <utility> // std::forward
 #include <limits> // std::numeric_limits
+#include <stdexcept>
+#include <string>
 #include "global/global.h"
 
 PROJECT_NAMESPACE_BEGIN
 
+class BinaryWriter;
+class BinaryReader;
+
 class LayoutObject
 {
 #if 0
@@ -58,9 +63,11 @@ class TextLayout : public LayoutObject
         /// @brief get the text of this layout object
         /// @return the text of this layout object
         std::string & text() { return _text; }
+        const std::string & text() const { return _text; }
         /// @brief get the coordinate of the text object
         /// @return the reference to the text object
         XY<LocType> & coord() { return _coord; }
+        const XY<LocType> & coord() const { return _coord; }
         /*------------------------------*/ 
         /* Setters                      */
         /*------------------------------*/ 
@@ -81,17 +88,17 @@ class RectLayout : public LayoutObject
         explicit RectLayout() = default;
         /// @brief construtor
         /// @param a box object representing the rectangle geometry
-        explicit RectLayout(const Box<LocType> &rect) : _rect(rect), _datatype(0) {}
+        explicit RectLayout(const Box<LocType> &rect) : _rect(rect), _datatype(DRAWING_DATATYPE) {}
         /// @brief constructor
         /// @param the lower left coordinate
         /// @param the upper right coordinate
-        explicit RectLayout(const XY<LocType> &lo, const XY<LocType> &ur) : _rect(Box<LocType>(lo, ur)), _datatype(0) {}
+        explicit RectLayout(const XY<LocType> &lo, const XY<LocType> &ur) : _rect(Box<LocType>(lo, ur)), _datatype(DRAWING_DATATYPE) {}
         /// @brief constructor
         /// @param the x coordinate of the lower left point
         /// @param the y coordinate of the lower left point
         /// @param the x coordinate of the upper right point
         /// @param the y coordinate of the upper right pointLayout
-        explicit RectLayout(LocType xLo, LocType yLo, LocType xHi, LocType yHi) : _rect(Box<LocType>(xLo, yLo, xHi, yHi)), _datatype(0) {}
+        explicit RectLayout(LocType xLo, LocType yLo, LocType xHi, LocType yHi) : _rect(Box<LocType>(xLo, yLo, xHi, yHi)), _datatype(DRAWING_DATATYPE) {}
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
@@ -99,12 +106,22 @@ class RectLayout : public LayoutObject
         /// @return the rectangle shape of the object
         Box<LocType> & rect() { return _rect; }
         const Box<LocType> & rect() const { return _rect; }
-        IndexType datatype() { return _datatype; }
-        /// @brief set the datatype of the shape, default is 0
-        void setDatatype(IndexType datatype) { _datatype = datatype; }
+        /// @brief get the datatype of the shape
+        /// @return the GDSII datatype of the shape, or DRAWING_DATATYPE for the drawing datatype of the layer
+        IndexType datatype() const { return _datatype; }
+        /// @brief set the datatype of the shape, default is DRAWING_DATATYPE
+        /// @param the GDSII datatype, or DRAWING_DATATYPE
+        void setDatatype(IndexType datatype)
+        {
+            if (datatype >= RESERVED_DATATYPES_NUMBER && datatype != DRAWING_DATATYPE)
+            {
+                throw std::out_of_range("RectLayout::setDatatype: GDSII datatype " + std::to_string(datatype) + " is out of range");
+            }
+            _datatype = datatype;
+        }
     private:
         Box<LocType> _rect; ///< The shape of this rectangle
-        IndexType _datatype;
+        IndexType _datatype = DRAWING_DATATYPE; ///< The GDSII datatype of the shape. DRAWING_DATATYPE for the drawing datatype of the layer
 };
 
 /// @class MAGICAL_FLOW::LayoutLayer
@@ -189,6 +206,9 @@ class Layout
     public:
         /// @brief default constructor
         explicit Layout() { this->init(RESERVED_LAYERS_NUMBER); }
+        /// @brief constructor
+        /// @param the number of layers
+        explicit Layout(IndexType numLayers) { this->init(numLayers); }
         /// @brief clear the layout
         void clear() {  
             AssertMsg(_numLayers >= 0, "%s: ensure the number of layers are set \n", __FUNCTION__); _layers.clear(); _layers.resize(_numLayers); 
@@ -211,11 +231,13 @@ class Layout
         /// @param second: the index of the text in that layer
         /// @return the requested text layout object
         TextLayout & text(IndexType layerIdx, IndexType textIdx) { return _layers.at(layerIdx).text(textIdx); }
+        const TextLayout & text(IndexType layerIdx, IndexType textIdx) const { return _layers.at(layerIdx).textList().at(textIdx); }
         /// @brief get one rect layout object
         /// @param first: the index of layer
         /// @param second: the index of the text in that layer
         /// @return the requested rect layout object
         RectLayout & rect(IndexType layerIdx, IndexType rectIdx) { return _layers.at(layerIdx).rect(rectIdx); }
+        const RectLayout & rect(IndexType layerIdx, IndexType rectIdx) const { return _layers.at(layerIdx).rectList().at(rectIdx); }
         /// @brief get the number of layers
         /// @return the number of layers
         IndexType numLayers() const { return _numLayers; }
@@ -292,7 +314,7 @@ class Layout
         /// @param second: x_offset
         /// @param third: y_offset
         /// @param fourth: boolean if to flip vertically
-        void insertLayout(Layout & layout, LocType x_offset, LocType y_offset, bool flipVertFlag);
+        void insertLayout(const Layout & layout, LocType x_offset, LocType y_offset, bool flipVertFlag);
         /// @brief set the datatype of a rectangle
         /// @param first: layer index
         /// @param second: the rect index in the layer
@@ -301,6 +323,39 @@ class Layout
         /// @brief set the boundary box of layout
         /// @param boundary box
         void setBoundary(LocType xLo, LocType yLo, LocType xHi, LocType yHi) { _boundary.set(xLo, yLo, xHi, yHi); }
+        /// @brief mirror the shapes and texts about the vertical center line of the boundary, as insertLayout() does. The boundary is unchanged
+        void flipVert();
+        /*------------------------------*/ 
+        /* Comparison                   */
+        /*------------------------------*/ 
+        /// @brief hash the layers, the boundary and the objects in order
+        /// @param whether to hash the layout mirrored by flipVert() instead
+        /// @return the hash. Equal layouts have equal hashes
+        HashType hash(bool flipVertFlag = false) const;
+        /// @brief whether the layout has the same layers, boundary and objects in the same order as another one
+        /// @param first: the other layout
+        /// @param second: whether to compare with the other layout mirrored by flipVert() instead
+        /// @return whether the layouts are equal
+        bool equals(const Layout &other, bool flipVertFlag = false) const;
+        /*------------------------------*/ 
+        /* Memory                       */
+        /*------------------------------*/ 
+        /// @brief get the heap bytes of the layer table
+        /// @return the bytes of the capacity of the table
+        std::uint64_t tableBytes() const;
+        /// @brief get the heap bytes of the shapes and texts of one layer
+        /// @param the index of the layer
+        /// @return the bytes of the capacity, including the strings of the texts
+        std::uint64_t layerBytes(IndexType layerIdx) const;
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        /// @brief write the layout. Only the layers with shapes are written
+        /// @param the binary writer
+        void save(BinaryWriter &out) const;
+        /// @brief replace the layout by one written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in);
 
     private:
         std::vector<LayoutLayer> _layers; ///< _text[idx of layer] = vector of text objects
@@ -0,0 +1,283 @@
+/**
+ * @file MemoryReport.cpp
+ * @brief The memory held by the design database, by circuit and by kind
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/MemoryReport.h"
+#include "db/DesignDB.h"
+#include "util/MemoryUsage.h"
+#include <algorithm>
+#include <cstdio>
+#include <numeric>
+#include <unordered_set>
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace
+{
+    /// @brief print bytes in the largest unit that keeps them above 1
+    std::string formatBytes(std::uint64_t bytes)
+    {
+        const char *units[] = { "B", "KiB", "MiB", "GiB" };
+        double value = static_cast<double>(bytes);
+        IndexType unit = 0;
+        while (value >= 1024.0 && unit < 3)
+        {
+            value /= 1024.0;
+            ++unit;
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), unit == 0 ? "%.0f %s" : "%.2f %s", value, units[unit]);
+        return buffer;
+    }
+}
+
+/*------------------------------*/
+/* Components                   */
+/*------------------------------*/
+std::uint64_t Layout::tableBytes() const
+{
+    return MemUtil::vectorBytes(_layers);
+}
+
+std::uint64_t Layout::layerBytes(IndexType layerIdx) const
+{
+    const LayoutLayer &layer = _layers.at(layerIdx);
+    std::uint64_t bytes = MemUtil::vectorBytes(layer.rectList()) + MemUtil::vectorBytes(layer.textList());
+    for (const TextLayout &text : layer.textList())
+    {
+        bytes += MemUtil::stringBytes(text.text());
+    }
+    return bytes;
+}
+
+std::uint64_t SymbolTable::heapBytes() const
+{
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    std::uint64_t bytes = MemUtil::vectorBytes(_hashes) + MemUtil::vectorBytes(_slots);
+    for (IndexType chunk = 0; chunk < NUM_CHUNKS && _chunks[chunk]; ++chunk)
+    {
+        bytes += chunkSize(chunk) * sizeof(std::string);
+    }
+    for (SymbolId id = 0; id < _hashes.size(); ++id)
+    {
+        bytes += MemUtil::stringBytes(str(id));
+    }
+    return bytes;
+}
+
+std::uint64_t TechDB::heapBytes() const
+{
+    std::uint64_t bytes = MemUtil::vectorBytes(_dbLayerToPdkLayer) + MemUtil::vectorBytes(_dbLayerToPdkDatatype)
+        + MemUtil::vectorBytes(_datatypeToColumn) + MemUtil::vectorBytes(_layerDatatypeToDbLayer)
+        + MemUtil::unorderedMapBytes(_layerNameToDbLayer);
+    for (const auto &pair : _layerNameToDbLayer)
+    {
+        bytes += MemUtil::stringBytes(pair.first);
+    }
+    return bytes;
+}
+
+std::uint64_t LefTables::heapBytes() const
+{
+    std::uint64_t bytes = MemUtil::vectorBytes(layers) + MemUtil::vectorBytes(vias) + MemUtil::vectorBytes(macros);
+    for (const LefLayer &layer : layers)
+    {
+        bytes += MemUtil::stringBytes(layer.name) + MemUtil::stringBytes(layer.type) + MemUtil::stringBytes(layer.direction);
+    }
+    for (const LefVia &via : vias)
+    {
+        bytes += MemUtil::stringBytes(via.name) + MemUtil::vectorBytes(via.shapes);
+    }
+    for (const LefMacro &macro : macros)
+    {
+        bytes += MemUtil::stringBytes(macro.name) + MemUtil::stringBytes(macro.macroClass);
+        bytes += MemUtil::vectorBytes(macro.pins) + MemUtil::vectorBytes(macro.obs);
+        for (const LefPin &pin : macro.pins)
+        {
+            bytes += MemUtil::stringBytes(pin.name) + MemUtil::stringBytes(pin.direction) + MemUtil::stringBytes(pin.use);
+            bytes += MemUtil::vectorBytes(pin.shapes);
+        }
+    }
+    return bytes;
+}
+
+/*------------------------------*/
+/* CktGraph                     */
+/*------------------------------*/
+void CktGraph::memoryUsage(CktMemory &usage, std::vector<std::uint64_t> &layerBytes) const
+{
+    usage.nameId = _nameId;
+    usage.graph = sizeof(CktGraph);
+    // Nodes
+    usage.nodes = MemUtil::vectorBytes(_nodes.graphIdx) + MemUtil::vectorBytes(_nodes.offset) + MemUtil::vectorBytes(_nodes.orient)
+        + MemUtil::vectorBytes(_nodes.flipVertFlag) + MemUtil::vectorBytes(_nodes.cold);
+    for (const CktNodeArrays::Cold &node : _nodes.cold)
+    {
+        usage.nodes += MemUtil::smallVectorBytes(node.pinIdxArray);
+    }
+    // Pins
+    usage.pins = MemUtil::vectorBytes(_pinArray);
+    for (const Pin &pin : _pinArray)
+    {
+        usage.pins += pin.heapBytes();
+    }
+    // Nets
+    usage.nets = MemUtil::vectorBytes(_nets.flags) + MemUtil::vectorBytes(_nets.cold);
+    for (const NetArrays::Cold &net : _nets.cold)
+    {
+        usage.nets += MemUtil::vectorBytes(net.pinIdxArray) + MemUtil::vectorBytes(net.subIdxArray) + MemUtil::smallVectorBytes(net.ioInterfaces);
+    }
+    // Connectivity
+    usage.connectivity = MemUtil::vectorBytes(_psubIdxArray) + MemUtil::vectorBytes(_nwellIdxArray) + MemUtil::vectorBytes(_journal)
+        + _nodeNameIndex.heapBytes() + _netNameIndex.heapBytes()
+        + _netPinRows.heapBytes() + _netSubRows.heapBytes() + _nodePinRows.heapBytes();
+    // Layout. A layout in the checkpoint file holds no memory
+    usage.layout = _layout.tableBytes();
+    layerBytes.resize(std::max<std::size_t>(layerBytes.size(), _layout.numLayers()), 0);
+    for (IndexType layerIdx = 0; layerIdx < _layout.numLayers(); ++layerIdx)
+    {
+        std::uint64_t bytes = _layout.layerBytes(layerIdx);
+        layerBytes[layerIdx] += bytes;
+        usage.layout += bytes;
+    }
+    usage.strings = MemUtil::stringBytes(_gdsData.gdsFile());
+    usage.tech = _techDB.heapBytes();
+}
+
+/*------------------------------*/
+/* DesignDB                     */
+/*------------------------------*/
+MemoryReport DesignDB::memoryReport(IndexType topN) const
+{
+    MemoryReport report;
+    report.ckts.resize(this->numCkts());
+    std::vector<std::uint64_t> &layerBytes = report.layoutLayers;
+    std::unordered_set<const Layout *> counted;
+    std::unordered_set<const LefTables *> countedLef;
+    for (IndexType cktIdx = 0; cktIdx < this->numCkts(); ++cktIdx)
+    {
+        const CktGraph &ckt = _ckts[cktIdx];
+        CktMemory &usage = report.ckts[cktIdx];
+        usage.cktIdx = cktIdx;
+        ckt.memoryUsage(usage, layerBytes);
+        report.numUnloadedLayouts += ckt.isLayoutLoaded() ? 0 : 1;
+        // The LEF data is shared by the copies of the tech, like a shared layout
+        const LefTables *lef = ckt.techDB().sharedLef().get();
+        if (lef != nullptr && countedLef.insert(lef).second)
+        {
+            usage.tech += lef->heapBytes();
+        }
+        const Layout *shared = ckt.sharedLayout().get();
+        if (shared == nullptr)
+        {
+            continue;
+        }
+        if (!counted.insert(shared).second)
+        {
+            ++report.numSharedLayouts;
+            continue;
+        }
+        usage.layout += shared->tableBytes();
+        layerBytes.resize(std::max<std::size_t>(layerBytes.size(), shared->numLayers()), 0);
+        for (IndexType layerIdx = 0; layerIdx < shared->numLayers(); ++layerIdx)
+        {
+            std::uint64_t bytes = shared->layerBytes(layerIdx);
+            layerBytes[layerIdx] += bytes;
+            usage.layout += bytes;
+        }
+    }
+    // The layer tables are what is left of the layouts after the layers
+    std::uint64_t layoutTotal = 0;
+    for (const CktMemory &usage : report.ckts)
+    {
+        layoutTotal += usage.layout;
+    }
+    report.layoutTables = layoutTotal - std::accumulate(layerBytes.begin(), layerBytes.end(), std::uint64_t(0));
+    report.processSymbols = SymbolTable::global().heapBytes();
+    report.phyProps = _phyPropDB.heapBytes();
+    // The rest of the design
+    report.design = (_ckts.capacity() - _ckts.size()) * sizeof(CktGraph)
+        + MemUtil::vectorBytes(_rootCkts) + MemUtil::vectorBytes(_cktLevels) + MemUtil::vectorBytes(_levelStart)
+        + MemUtil::vectorBytes(_levelCkts) + MemUtil::vectorBytes(_structHashes) + MemUtil::vectorBytes(_structInputs)
+        + MemUtil::vectorBytes(_parents) + MemUtil::vectorBytes(_parentEdits)
+        + MemUtil::vectorBytes(_dirty) + _cktNameIndex.heapBytes()
+        + MemUtil::vectorBytes(power) + MemUtil::vectorBytes(ground);
+    for (const auto &parents : _parents)
+    {
+        report.design += MemUtil::vectorBytes(parents);
+    }
+    for (const std::string &name : power)
+    {
+        report.design += MemUtil::stringBytes(name);
+    }
+    for (const std::string &name : ground)
+    {
+        report.design += MemUtil::stringBytes(name);
+    }
+    // The heaviest circuits
+    std::vector<IndexType> order(this->numCkts());
+    std::iota(order.begin(), order.end(), 0);
+    IndexType numTop = std::min<IndexType>(topN, order.size());
+    std::partial_sort(order.begin(), order.begin() + numTop, order.end(), [&](IndexType lhs, IndexType rhs)
+            {
+                std::uint64_t lhsBytes = report.ckts[lhs].total();
+                std::uint64_t rhsBytes = report.ckts[rhs].total();
+                return lhsBytes != rhsBytes ? lhsBytes > rhsBytes : lhs < rhs;
+            });
+    report.heaviest.assign(order.begin(), order.begin() + numTop);
+    return report;
+}
+
+/*------------------------------*/
+/* MemoryReport                 */
+/*------------------------------*/
+std::uint64_t MemoryReport::cktTotal() const
+{
+    std::uint64_t bytes = 0;
+    for (const CktMemory &usage : ckts)
+    {
+        bytes += usage.total();
+    }
+    return bytes;
+}
+
+void MemoryReport::log() const
+{
+    CktMemory sum;
+    for (const CktMemory &usage : ckts)
+    {
+        sum.graph += usage.graph;
+        sum.nodes += usage.nodes;
+        sum.pins += usage.pins;
+        sum.nets += usage.nets;
+        sum.connectivity += usage.connectivity;
+        sum.layout += usage.layout;
+        sum.strings += usage.strings;
+        sum.tech += usage.tech;
+    }
+    INF("MemoryReport: %s in total, %u circuits \n", formatBytes(total()).c_str(), static_cast<IndexType>(ckts.size()));
+    INF("MemoryReport:   graphs %s, nodes %s, pins %s, nets %s, connectivity %s \n", formatBytes(sum.graph).c_str(),
+        formatBytes(sum.nodes).c_str(), formatBytes(sum.pins).c_str(), formatBytes(sum.nets).c_str(), formatBytes(sum.connectivity).c_str());
+    INF("MemoryReport:   layouts %s (layer tables %s, %u shared, %u not loaded), strings %s, tech copies %s \n", formatBytes(sum.layout).c_str(),
+        formatBytes(layoutTables).c_str(), numSharedLayouts, numUnloadedLayouts, formatBytes(sum.strings).c_str(), formatBytes(sum.tech).c_str());
+    INF("MemoryReport:   device properties %s, design %s \n", formatBytes(phyProps).c_str(), formatBytes(design).c_str());
+    INF("MemoryReport: %s in the process-wide symbol table, shared by every design \n", formatBytes(processSymbols).c_str());
+    for (IndexType layerIdx = 0; layerIdx < layoutLayers.size(); ++layerIdx)
+    {
+        if (layoutLayers[layerIdx] > 0)
+        {
+            INF("MemoryReport:   layer %u: %s \n", layerIdx, formatBytes(layoutLayers[layerIdx]).c_str());
+        }
+    }
+    for (IndexType rank = 0; rank < heaviest.size(); ++rank)
+    {
+        const CktMemory &usage = ckts[heaviest[rank]];
+        INF("MemoryReport:   #%u %s: %s (layout %s, tech %s) \n", rank + 1, SymbolTable::global().str(usage.nameId).c_str(), formatBytes(usage.total()).c_str(),
+            formatBytes(usage.layout).c_str(), formatBytes(usage.tech).c_str());
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,62 @@
+/**
+ * @file MemoryReport.h
+ * @brief The memory held by the design database, by circuit and by kind
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_MEMORY_REPORT_H_
+#define MAGICAL_FLOW_MEMORY_REPORT_H_
+
+#include <cstdint>
+#include <vector>
+#include "global/global.h"
+#include "db/SymbolTable.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::CktMemory
+/// @brief the bytes held by one circuit. The bytes are allocated capacity, not size
+struct CktMemory
+{
+    IndexType cktIdx = INDEX_TYPE_MAX; ///< The circuit
+    SymbolId nameId = EMPTY_SYMBOL; ///< The name of the circuit
+    std::uint64_t graph = 0; ///< The CktGraph object itself, including the inline members
+    std::uint64_t nodes = 0; ///< The node arrays and the pin arrays of the nodes
+    std::uint64_t pins = 0; ///< The pin array and the rectangle indices of the pins
+    std::uint64_t nets = 0; ///< The net arrays, the pin arrays of the nets and the IO pins
+    std::uint64_t connectivity = 0; ///< The packed connectivity, the name indexes, the substrate nets and the edit journal
+    std::uint64_t layout = 0; ///< The layout. A shared layout is counted once, for the first circuit sharing it
+    std::uint64_t strings = 0; ///< The strings owned by the circuit outside the layout and the symbol table
+    std::uint64_t tech = 0; ///< The copy of the TechDB. The shared LEF data is counted once, for the first circuit sharing it
+    /// @brief get the bytes of the circuit
+    /// @return the sum of all the kinds
+    std::uint64_t total() const { return graph + nodes + pins + nets + connectivity + layout + strings + tech; }
+};
+
+/// @class MAGICAL_FLOW::MemoryReport
+/// @brief the bytes held by the design database. See DesignDB::memoryReport()
+struct MemoryReport
+{
+    std::vector<CktMemory> ckts; ///< ckts[cktIdx] = the bytes of the circuit
+    std::vector<std::uint64_t> layoutLayers; ///< layoutLayers[layerIdx] = the bytes of the shapes and texts of the layer in all the layouts
+    std::uint64_t layoutTables = 0; ///< The layer tables of all the layouts, with or without shapes
+    std::uint64_t processSymbols = 0; ///< The process-wide symbol table holding the names. It is shared by every design, so it is not in total()
+    std::uint64_t phyProps = 0; ///< The PhyPropDB
+    std::uint64_t design = 0; ///< The rest of the DesignDB: the unused circuit slots, the hierarchy, the hashes and the name index
+    IndexType numSharedLayouts = 0; ///< The number of circuits sharing a layout counted for another circuit
+    IndexType numUnloadedLayouts = 0; ///< The number of layouts still in a checkpoint file, which hold no memory
+    std::vector<IndexType> heaviest; ///< The heaviest circuits, heaviest first
+    /// @brief get the bytes of the circuits
+    /// @return the sum of the circuit totals
+    std::uint64_t cktTotal() const;
+    /// @brief get the bytes of the design database
+    /// @return the sum of the circuits, the properties and the rest
+    std::uint64_t total() const { return cktTotal() + phyProps + design; }
+    /// @brief write the report to the log: the totals by kind, the non-empty layers and the heaviest circuits
+    void log() const;
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_MEMORY_REPORT_H_
@@ -0,0 +1,196 @@
+/**
+ * @file NameIndex.h
+ * @brief Hash index from interned names to object indices
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_NAME_INDEX_H_
+#define MAGICAL_FLOW_NAME_INDEX_H_
+
+#include "db/SymbolTable.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::NameIndex
+/// @brief An open addressing hash from symbol ids to the indices of the objects carrying them.
+/// The owner builds it lazily and rebuilds it when its count of edits changes. The owner bumps the count whenever
+/// an object is added, removed or renamed, so shrinking and growing back to the same size is caught as well.
+/// If several objects share a name, the one with the smallest index is found
+class NameIndex
+{
+    public:
+        /// @brief default constructor
+        explicit NameIndex() = default;
+        /// @brief whether the index needs to be rebuilt
+        /// @param first: the current number of objects
+        /// @param second: the number of edits of the objects so far, counted by the owner
+        /// @return true if the index is out of date
+        bool isStale(IndexType numObjs, IndexType epoch) const
+        {
+            return !_isBuilt || _numObjs != numObjs || _epoch != epoch;
+        }
+        /// @brief drop the index
+        void invalidate() { _isBuilt = false; }
+        /// @brief build the index
+        /// @param first: the number of objects
+        /// @param second: the number of edits of the objects so far
+        /// @param third: the function returns the symbol id of the object of an index
+        template<typename NameIdFunc>
+        void build(IndexType numObjs, IndexType epoch, NameIdFunc nameId)
+        {
+            IndexType capacity = 16;
+            while (capacity < numObjs * 2)
+            {
+                capacity *= 2;
+            }
+            _keys.assign(capacity, INDEX_TYPE_MAX);
+            _values.resize(capacity);
+            IndexType mask = capacity - 1;
+            bool hasDuplicates = false;
+            for (IndexType idx = 0; idx < numObjs; ++idx)
+            {
+                SymbolId key = nameId(idx);
+                IndexType slot = hash(key) & mask;
+                while (_keys[slot] != INDEX_TYPE_MAX && _keys[slot] != key)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                if (_keys[slot] == INDEX_TYPE_MAX)
+                {
+                    _keys[slot] = key;
+                    _values[slot] = idx;
+                }
+                else
+                {
+                    hasDuplicates = true;
+                }
+            }
+            _hasDuplicates = hasDuplicates;
+            _numObjs = numObjs;
+            _epoch = epoch;
+            _isBuilt = true;
+        }
+        /// @brief add the object appended after the last build without rebuilding. Drops the index if it is stale or too full
+        /// @param first: the symbol id of the new object
+        /// @param second: the index of the new object
+        /// @param third: the number of edits before the object was added
+        /// @param fourth: the number of edits after the object was added
+        void append(SymbolId key, IndexType idx, IndexType epochBefore, IndexType epochAfter)
+        {
+            if (isStale(idx, epochBefore) || (idx + 1) * 2 > _keys.size())
+            {
+                invalidate();
+                return;
+            }
+            IndexType mask = _keys.size() - 1;
+            IndexType slot = hash(key) & mask;
+            while (_keys[slot] != INDEX_TYPE_MAX && _keys[slot] != key)
+            {
+                slot = (slot + 1) & mask;
+            }
+            if (_keys[slot] == INDEX_TYPE_MAX)
+            {
+                _keys[slot] = key;
+                _values[slot] = idx;
+            }
+            else
+            {
+                _hasDuplicates = true;
+            }
+            _numObjs = idx + 1;
+            _epoch = epochAfter;
+        }
+        /// @brief remove an object whose index the last object takes, without rebuilding.
+        /// Drops the index if it is stale or some objects share a name, as another object may then be the one to find
+        /// @param first: the symbol id of the removed object
+        /// @param second: the index of the removed object
+        /// @param third: the symbol id of the last object
+        /// @param fourth: the index of the last object before the removal
+        /// @param fifth: the number of edits before the object was removed
+        /// @param sixth: the number of edits after the object was removed
+        void swapRemove(SymbolId key, IndexType idx, SymbolId lastKey, IndexType lastIdx, IndexType epochBefore, IndexType epochAfter)
+        {
+            if (isStale(lastIdx + 1, epochBefore) || _hasDuplicates)
+            {
+                invalidate();
+                return;
+            }
+            IndexType mask = _keys.size() - 1;
+            IndexType hole = slot(key);
+            // Shift the entries of the probe run back over the hole, unless the hole is before their home slot
+            IndexType next = (hole + 1) & mask;
+            while (_keys[next] != INDEX_TYPE_MAX)
+            {
+                IndexType home = hash(_keys[next]) & mask;
+                if (((next - home) & mask) >= ((next - hole) & mask))
+                {
+                    _keys[hole] = _keys[next];
+                    _values[hole] = _values[next];
+                    hole = next;
+                }
+                next = (next + 1) & mask;
+            }
+            _keys[hole] = INDEX_TYPE_MAX;
+            if (idx != lastIdx)
+            {
+                _values[slot(lastKey)] = idx;
+            }
+            _numObjs = lastIdx;
+            _epoch = epochAfter;
+        }
+        /// @brief find the object of a symbol
+        /// @param the symbol id
+        /// @return the index of the object. INDEX_TYPE_MAX if not found
+        IndexType find(SymbolId key) const
+        {
+            if (!_isBuilt || key == INDEX_TYPE_MAX)
+            {
+                return INDEX_TYPE_MAX;
+            }
+            IndexType mask = _keys.size() - 1;
+            IndexType slot = hash(key) & mask;
+            while (_keys[slot] != INDEX_TYPE_MAX)
+            {
+                if (_keys[slot] == key)
+                {
+                    return _values[slot];
+                }
+                slot = (slot + 1) & mask;
+            }
+            return INDEX_TYPE_MAX;
+        }
+        /// @brief get the heap bytes of the index
+        /// @return the bytes of the capacity of the slots
+        std::uint64_t heapBytes() const { return static_cast<std::uint64_t>(_keys.capacity()) * sizeof(SymbolId) + static_cast<std::uint64_t>(_values.capacity()) * sizeof(IndexType); }
+    private:
+        /// @brief hash a symbol id
+        /// @param the symbol id
+        /// @return the hash value
+        static IndexType hash(SymbolId key) { return key * 2654435761u; }
+        /// @brief find the slot of a symbol in the index
+        /// @param the symbol id. It must be in the index
+        /// @return the slot
+        IndexType slot(SymbolId key) const
+        {
+            IndexType mask = _keys.size() - 1;
+            IndexType slot = hash(key) & mask;
+            while (_keys[slot] != key)
+            {
+                AssertMsg(_keys[slot] != INDEX_TYPE_MAX, "NameIndex::slot: symbol %u is not in the index \n", key);
+                slot = (slot + 1) & mask;
+            }
+            return slot;
+        }
+    private:
+        std::vector<SymbolId> _keys; ///< The symbol ids in the slots. INDEX_TYPE_MAX is empty
+        std::vector<IndexType> _values; ///< The object indices in the slots
+        IndexType _numObjs = 0; ///< The number of objects when built
+        IndexType _epoch = 0; ///< The number of edits when built
+        bool _isBuilt = false; ///< Whether the index has been built
+        bool _hasDuplicates = false; ///< Whether some objects share a name, so that only the first of them is in the index
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_NAME_INDEX_H_
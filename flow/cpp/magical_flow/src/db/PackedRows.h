@@ -0,0 +1,109 @@
+/**
+ * @file PackedRows.h
+ * @brief The index arrays of a sequence of objects packed into one array
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_PACKED_ROWS_H_
+#define MAGICAL_FLOW_PACKED_ROWS_H_
+
+#include <vector>
+#include <algorithm>
+#include "util/Span.h"
+#include "util/MemoryUsage.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::PackedRows
+/// @brief The index arrays of a sequence of objects packed into one array, one row per object.
+/// A row is patched in place if it does not grow, and moved to the end of the array otherwise.
+/// The space it leaves behind is reclaimed by the next pack()
+class PackedRows
+{
+    public:
+        /// @brief default constructor, no rows
+        explicit PackedRows() = default;
+        /// @brief pack the index arrays of objects, one row per object
+        /// @param first: the objects, each of which has an index array
+        /// @param second: the getter for the index array of an object
+        template<typename ObjType, typename GetterType>
+        void pack(const std::vector<ObjType> &objs, GetterType getter)
+        {
+            _start.resize(objs.size());
+            _size.resize(objs.size());
+            IndexType numUsed = 0;
+            for (IndexType idx = 0; idx < objs.size(); ++idx)
+            {
+                _start[idx] = numUsed;
+                _size[idx] = getter(objs[idx]).size();
+                numUsed += _size[idx];
+            }
+            _packed.resize(numUsed);
+            for (IndexType idx = 0; idx < objs.size(); ++idx)
+            {
+                const auto &arr = getter(objs[idx]);
+                std::copy(arr.begin(), arr.end(), _packed.begin() + _start[idx]);
+            }
+            _numUsed = numUsed;
+        }
+        /// @brief get the number of rows
+        /// @return the number of rows
+        IndexType numRows() const { return _start.size(); }
+        /// @brief get a row
+        /// @param the index of the row
+        /// @return the view of the row
+        Span<const IndexType> row(IndexType idx) const { return Span<const IndexType>(_packed.data() + _start[idx], _size[idx]); }
+        /// @brief replace a row
+        /// @param first: the index of the row
+        /// @param second: the new index array of the row
+        template<typename ArrayType>
+        void setRow(IndexType idx, const ArrayType &arr)
+        {
+            IndexType size = arr.size();
+            if (size > _size[idx])
+            {
+                _start[idx] = _packed.size();
+                _packed.resize(_packed.size() + size);
+            }
+            std::copy(arr.begin(), arr.end(), _packed.begin() + _start[idx]);
+            _numUsed = _numUsed - _size[idx] + size;
+            _size[idx] = size;
+        }
+        /// @brief add a row after the last one
+        /// @param the index array of the row
+        template<typename ArrayType>
+        void appendRow(const ArrayType &arr)
+        {
+            _start.emplace_back(_packed.size());
+            _size.emplace_back(arr.size());
+            _packed.insert(_packed.end(), arr.begin(), arr.end());
+            _numUsed += arr.size();
+        }
+        /// @brief remove the last row
+        void popRow()
+        {
+            if (_start.back() + _size.back() == _packed.size())
+            {
+                _packed.resize(_start.back());
+            }
+            _numUsed -= _size.back();
+            _start.pop_back();
+            _size.pop_back();
+        }
+        /// @brief whether the space left behind by the patched rows outgrows the rows, so that it is time to pack() again
+        /// @return whether most of the packed array is unused
+        bool isSparse() const { return _packed.size() > 2 * _numUsed + 64; }
+        /// @brief get the heap bytes of the rows
+        /// @return the bytes of the capacities of the arrays
+        std::uint64_t heapBytes() const { return MemUtil::vectorBytes(_start) + MemUtil::vectorBytes(_size) + MemUtil::vectorBytes(_packed); }
+    private:
+        std::vector<IndexType> _start; ///< _start[idx] = the position of the row in _packed
+        std::vector<IndexType> _size; ///< _size[idx] = the length of the row
+        std::vector<IndexType> _packed; ///< The rows, with the space left by the moved and shrunk rows in between
+        IndexType _numUsed = 0; ///< The total length of the rows
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_PACKED_ROWS_H_
@@ -9,7 +9,12 @@
 #define MAGICAL_FLOW_PHYSICAL_PROP_H_
 
 #include "global/global.h"
+#include "db/SymbolTable.h"
+#include "util/Hash.h"
+#include "util/BinaryIO.h"
+#include "util/MemoryUsage.h"
 #include <string>
+#include <functional>
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -39,48 +44,106 @@ class MosProp
         /// @brief whether _width is set
         /// @return whether _width is set
         bool widthValid() const { return _width != -1; }
+        /// @brief get number of multiplier
+        /// @return multiplier
         IntType mult() const { return _mult; }
         /// @brief set number of multiplier
         /// @param multiplier
         void setMult(IntType mult) { _mult = mult; }
-        /// @brief whether _mult is set
-        /// @return whether _mult is set
+        /// @brief get the number of fingers
+        /// @return the number of fingers
         IntType numFingers() const { return _numFingers; }
         /// @brief set the number of fingers
         /// @param the number of fingers
         void setNumFingers(IntType numFingers) { _numFingers = numFingers; }
-        /// @brief whether _numFingers is set
-        /// @return whether _numFingers is set
-        std::string attr() const { return _attributes; }
-        /// @brief set _attribute string
-        /// @param the attribute string
-        void setAttr(std::string attributes) { _attributes = attributes; }
+        /// @brief get _attribute string
+        /// @return the attribute string
+        const std::string & attr() const { return SymbolTable::global().str(_attrId); }
+        /// @brief get the symbol of the attribute string
+        /// @return the symbol id of the attribute string
+        SymbolId attrId() const { return _attrId; }
         /// @brief set _attribute string
         /// @param the attribute string
-        std::string pinConType() const { return _pinConType; }
+        void setAttr(const std::string &attributes) { _attrId = SymbolTable::global().intern(attributes); }
         /// @brief get pinConType string
-        /// @param the type string: 'GS', 'DG', 'DS' for self connection
-        void setPinConType(std::string type) { _pinConType = type; }
+        /// @return the type string: 'GS', 'DG', 'DS' for self connection
+        std::string pinConType() const { return _pinConType; }
         /// @brief set pinConType string
         /// @param the type string: 'GS', 'DG', 'DS' for self connection
-        void appendBulkCon(IndexType pin) { _bulkCon.emplace_back(pin); }
+        void setPinConType(std::string type) { _pinConType = type; }
         /// @brief append to bulkCon 
         /// @param the pinType connected to bulk: 0:D, 1:G, 2:S 
         /// Currently only valid for PMOS
-        IndexType numBulkCon() { return _bulkCon.size(); }
-        /// @brief append to bulkCon 
-        /// @param the pinType connected to bulk: 0:D, 1:G, 2:S 
+        void appendBulkCon(IndexType pin) { _bulkCon.emplace_back(pin); }
+        /// @brief get the number of bulkCon
+        /// @return the number of pins connected to bulk
         /// Currently only valid for PMOS
-        IndexType bulkCon(IndexType id) { return _bulkCon.at(id); }
+        IndexType numBulkCon() const { return _bulkCon.size(); }
         /// @brief return the bulkCon at Index
         /// @param the Index
         /// Currently only valid for PMOS
+        IndexType bulkCon(IndexType id) const { return _bulkCon.at(id); }
+        /// @brief hash the properties that affect the layout
+        /// @return the hash of the properties
+        HashType hash() const
+        {
+            HashType hash = 0;
+            for (IntType val : { _length, _width, _mult, _numFingers })
+            {
+                hash = HashUtil::combine(hash, static_cast<HashType>(val));
+            }
+            hash = HashUtil::combine(hash, HashUtil::hashString(attr()));
+            hash = HashUtil::combine(hash, HashUtil::hashString(_pinConType));
+            for (IndexType pin : _bulkCon)
+            {
+                hash = HashUtil::combine(hash, pin);
+            }
+            return hash;
+        }
+        /// @brief compare the properties that affect the layout
+        /// @param the other property
+        /// @return whether the properties hashed by hash() are equal
+        bool equals(const MosProp &other) const
+        {
+            return _length == other._length && _width == other._width && _mult == other._mult && _numFingers == other._numFingers
+                && _attrId == other._attrId && _pinConType == other._pinConType && _bulkCon == other._bulkCon;
+        }
+        /// @brief get the heap bytes of the property
+        /// @return the bytes of the pin connection type and the bulk connections
+        std::uint64_t heapBytes() const { return MemUtil::stringBytes(_pinConType) + MemUtil::vectorBytes(_bulkCon); }
+        /// @brief write the properties
+        /// @param the binary writer
+        void save(BinaryWriter &out) const
+        {
+            for (IntType val : { _length, _width, _mult, _numFingers })
+            {
+                out.write<IntType>(val);
+            }
+            out.write<SymbolId>(_attrId);
+            out.writeString(_pinConType);
+            out.writeArray(_bulkCon);
+        }
+        /// @brief read the properties written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in)
+        {
+            for (IntType *val : { &_length, &_width, &_mult, &_numFingers })
+            {
+                *val = in.read<IntType>();
+            }
+            _attrId = in.readSymbol();
+            _pinConType = in.readString();
+            in.readArray(_bulkCon);
+        }
+        /// @brief translate the symbols read by load() into the running symbol table
+        /// @param the function maps a saved symbol to the running one
+        void remapSymbols(const std::function<SymbolId(SymbolId)> &symbol) { _attrId = symbol(_attrId); }
     protected:
         IntType _length = -1; ///< l. unit: e-12
         IntType _width = -1; ///< w. unit: e-12
         IntType _mult = 1; ///<mult. 
         IntType _numFingers = 1; ///<numFinger.
-        std::string _attributes=""; ///<attributes. This is reference of the device to match devgen.
+        SymbolId _attrId = EMPTY_SYMBOL; ///<attributes. This is reference of the device to match devgen.
         std::string _pinConType=""; ///<pinConType. Self connection type.
         std::vector<IndexType> _bulkCon; ///<bulkConnections.
 };
@@ -155,10 +218,59 @@ class ResProp
         void setSegSpace(IntType segSpace) { _segSpace = segSpace; } 
         /// @brief get _attribute string
         /// @param the attribute string
-        std::string attr() const { return _attributes; }
+        const std::string & attr() const { return SymbolTable::global().str(_attrId); }
+        /// @brief get the symbol of the attribute string
+        /// @return the symbol id of the attribute string
+        SymbolId attrId() const { return _attrId; }
         /// @brief set _attribute string
         /// @param the attribute string
-        void setAttr(std::string attributes) { _attributes = attributes; }
+        void setAttr(const std::string &attributes) { _attrId = SymbolTable::global().intern(attributes); }
+        /// @brief hash the properties that affect the layout
+        /// @return the hash of the properties
+        HashType hash() const
+        {
+            HashType hash = 0;
+            for (IntType val : { _lr, _wr, static_cast<IntType>(_series), static_cast<IntType>(_parallel), _segNum, _segSpace })
+            {
+                hash = HashUtil::combine(hash, static_cast<HashType>(val));
+            }
+            return HashUtil::combine(hash, HashUtil::hashString(attr()));
+        }
+        /// @brief compare the properties that affect the layout
+        /// @param the other property
+        /// @return whether the properties hashed by hash() are equal
+        bool equals(const ResProp &other) const
+        {
+            return _lr == other._lr && _wr == other._wr && _series == other._series && _parallel == other._parallel
+                && _segNum == other._segNum && _segSpace == other._segSpace && _attrId == other._attrId;
+        }
+        /// @brief write the properties
+        /// @param the binary writer
+        void save(BinaryWriter &out) const
+        {
+            for (IntType val : { _lr, _wr, _segNum, _segSpace })
+            {
+                out.write<IntType>(val);
+            }
+            out.write<Byte>(_series);
+            out.write<Byte>(_parallel);
+            out.write<SymbolId>(_attrId);
+        }
+        /// @brief read the properties written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in)
+        {
+            for (IntType *val : { &_lr, &_wr, &_segNum, &_segSpace })
+            {
+                *val = in.read<IntType>();
+            }
+            _series = in.read<Byte>() != 0;
+            _parallel = in.read<Byte>() != 0;
+            _attrId = in.readSymbol();
+        }
+        /// @brief translate the symbols read by load() into the running symbol table
+        /// @param the function maps a saved symbol to the running one
+        void remapSymbols(const std::function<SymbolId(SymbolId)> &symbol) { _attrId = symbol(_attrId); }
    protected:
         IntType _lr = -1; ///< length. unit: e-12
         IntType _wr = -1; ///< width. unit: e-12
@@ -166,7 +278,7 @@ class ResProp
         bool _parallel = false; ///< parallel
         IntType _segNum = 1; ///< number of segments
         IntType _segSpace = -1; ///< space between segments. unit: e-12
-        std::string _attributes = ""; ///< attribute string.
+        SymbolId _attrId = EMPTY_SYMBOL; ///< attribute string.
 };
 
 /// @class MAGICAL_FLOW::CapProp
@@ -245,10 +357,55 @@ class CapProp
         bool ftipValid() const { return _ftip != -1; }
         /// @brief get _attribute string
         /// @param the attribute string
-        std::string attr() const { return _attributes; }
+        const std::string & attr() const { return SymbolTable::global().str(_attrId); }
+        /// @brief get the symbol of the attribute string
+        /// @return the symbol id of the attribute string
+        SymbolId attrId() const { return _attrId; }
         /// @brief set _attribute string
         /// @param the attribute string
-        void setAttr(std::string attributes) { _attributes = attributes; }
+        void setAttr(const std::string &attributes) { _attrId = SymbolTable::global().intern(attributes); }
+        /// @brief hash the properties that affect the layout
+        /// @return the hash of the properties
+        HashType hash() const
+        {
+            HashType hash = 0;
+            for (IntType val : { _numFingers, _lr, _w, _spacing, _stm, _spm, _multi, _ftip })
+            {
+                hash = HashUtil::combine(hash, static_cast<HashType>(val));
+            }
+            return HashUtil::combine(hash, HashUtil::hashString(attr()));
+        }
+        /// @brief compare the properties that affect the layout
+        /// @param the other property
+        /// @return whether the properties hashed by hash() are equal
+        bool equals(const CapProp &other) const
+        {
+            return _numFingers == other._numFingers && _lr == other._lr && _w == other._w && _spacing == other._spacing
+                && _stm == other._stm && _spm == other._spm && _multi == other._multi && _ftip == other._ftip && _attrId == other._attrId;
+        }
+        /// @brief write the properties
+        /// @param the binary writer
+        void save(BinaryWriter &out) const
+        {
+            for (IntType val : { _numFingers, _lr, _w, _spacing, _stm, _spm, _multi, _ftip })
+            {
+                out.write<IntType>(val);
+            }
+            out.write<SymbolId>(_attrId);
+        }
+        /// @brief read the properties written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in)
+        {
+            for (IntType *val : { &_numFingers, &_lr, &_w, &_spacing, &_stm, &_spm, &_multi, &_ftip })
+            {
+                *val = in.read<IntType>();
+            }
+            _attrId = in.readSymbol();
+        }
+        /// @brief translate the symbols read by load() into the running symbol table
+        /// @param the function maps a saved symbol to the running one
+        void remapSymbols(const std::function<SymbolId(SymbolId)> &symbol) { _attrId = symbol(_attrId); }
     protected:
         IntType _numFingers = 1; ///< number of fingers.
         IntType _lr = -1; ///< lr. unit: e-12
@@ -258,7 +415,7 @@ class CapProp
         IntType _spm = -1; ///< spm
         IntType _multi = -1; ///< multi
         IntType _ftip = -1; ///< ftip. unit: e-12
-        std::string _attributes = ""; ///< attributes string.
+        SymbolId _attrId = EMPTY_SYMBOL; ///< attributes string.
 };
 
 
@@ -295,6 +452,114 @@ class PhyPropDB
         /// @brief allocate a new capacitore property
         /// @return the index
         IndexType allocateCap() { _capArray.emplace_back(CapProp()); return _capArray.size() - 1; }
+        /// @brief hash the property of a device
+        /// @param first: the implementation type of the device
+        /// @param second: the index of the property
+        /// @return the hash of the property. 0 if the type is not a device or the index is not set
+        HashType propHash(ImplType implType, IndexType implIdx) const
+        {
+            if (implIdx == INDEX_TYPE_MAX)
+            {
+                return 0;
+            }
+            switch (implType)
+            {
+                case ImplType::PCELL_Nch: return _nchArray.at(implIdx).hash();
+                case ImplType::PCELL_Pch: return _pchArray.at(implIdx).hash();
+                case ImplType::PCELL_Res: return _resArray.at(implIdx).hash();
+                case ImplType::PCELL_Cap: return _capArray.at(implIdx).hash();
+                default: return 0;
+            }
+        }
+        /// @brief compare the properties of two devices of the same type
+        /// @param first: the implementation type of the devices
+        /// @param second: the index of the property of one device
+        /// @param third: the index of the property of the other device
+        /// @return whether the properties hashed by propHash() are equal. Two unset indices are equal
+        bool propEquals(ImplType implType, IndexType lhsIdx, IndexType rhsIdx) const
+        {
+            if (lhsIdx == INDEX_TYPE_MAX || rhsIdx == INDEX_TYPE_MAX)
+            {
+                return lhsIdx == rhsIdx;
+            }
+            switch (implType)
+            {
+                case ImplType::PCELL_Nch: return _nchArray.at(lhsIdx).equals(_nchArray.at(rhsIdx));
+                case ImplType::PCELL_Pch: return _pchArray.at(lhsIdx).equals(_pchArray.at(rhsIdx));
+                case ImplType::PCELL_Res: return _resArray.at(lhsIdx).equals(_resArray.at(rhsIdx));
+                case ImplType::PCELL_Cap: return _capArray.at(lhsIdx).equals(_capArray.at(rhsIdx));
+                default: return true;
+            }
+        }
+        /// @brief get the heap bytes of the properties
+        /// @return the bytes of the capacity of the property arrays and the heap bytes of the properties
+        std::uint64_t heapBytes() const
+        {
+            std::uint64_t bytes = MemUtil::vectorBytes(_nchArray) + MemUtil::vectorBytes(_pchArray) + MemUtil::vectorBytes(_resArray) + MemUtil::vectorBytes(_capArray);
+            for (const NchProp &prop : _nchArray)
+            {
+                bytes += prop.heapBytes();
+            }
+            for (const PchProp &prop : _pchArray)
+            {
+                bytes += prop.heapBytes();
+            }
+            return bytes;
+        }
+        /// @brief write all the properties
+        /// @param the binary writer
+        void save(BinaryWriter &out) const
+        {
+            saveArray(out, _nchArray);
+            saveArray(out, _pchArray);
+            saveArray(out, _resArray);
+            saveArray(out, _capArray);
+        }
+        /// @brief replace all the properties by the ones written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in)
+        {
+            loadArray(in, _nchArray);
+            loadArray(in, _pchArray);
+            loadArray(in, _resArray);
+            loadArray(in, _capArray);
+        }
+        /// @brief translate the symbols read by load() into the running symbol table
+        /// @param the function maps a saved symbol to the running one
+        void remapSymbols(const std::function<SymbolId(SymbolId)> &symbol)
+        {
+            remapArray(_nchArray, symbol);
+            remapArray(_pchArray, symbol);
+            remapArray(_resArray, symbol);
+            remapArray(_capArray, symbol);
+        }
+    private:
+        template<typename PropType>
+        static void saveArray(BinaryWriter &out, const std::vector<PropType> &props)
+        {
+            out.write<IndexType>(props.size());
+            for (const PropType &prop : props)
+            {
+                prop.save(out);
+            }
+        }
+        template<typename PropType>
+        static void loadArray(BinaryReader &in, std::vector<PropType> &props)
+        {
+            props.assign(in.read<IndexType>(), PropType());
+            for (PropType &prop : props)
+            {
+                prop.load(in);
+            }
+        }
+        template<typename PropType>
+        static void remapArray(std::vector<PropType> &props, const std::function<SymbolId(SymbolId)> &symbol)
+        {
+            for (PropType &prop : props)
+            {
+                prop.remapSymbols(symbol);
+            }
+        }
     private:
         std::vector<NchProp> _nchArray; ///< for nch
         std::vector<PchProp> _pchArray; ///< for pch
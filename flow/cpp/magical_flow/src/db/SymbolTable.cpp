@@ -0,0 +1,111 @@
+/*
+ * @file SymbolTable.cpp
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#include "db/SymbolTable.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+SymbolTable::SymbolTable() : _size(0)
+{
+    _slots.resize(64, INDEX_TYPE_MAX);
+    intern(boost::string_view());
+}
+
+SymbolTable & SymbolTable::global()
+{
+    static SymbolTable table;
+    return table;
+}
+
+std::uint32_t SymbolTable::hash(boost::string_view name)
+{
+    // FNV-1a
+    std::uint32_t value = 2166136261u;
+    for (char c : name)
+    {
+        value ^= static_cast<std::uint8_t>(c);
+        value *= 16777619u;
+    }
+    return value;
+}
+
+IndexType SymbolTable::findSlot(boost::string_view name, std::uint32_t hashValue) const
+{
+    IndexType mask = _slots.size() - 1;
+    IndexType slot = hashValue & mask;
+    while (_slots[slot] != INDEX_TYPE_MAX)
+    {
+        SymbolId id = _slots[slot];
+        if (_hashes[id] == hashValue && str(id) == name)
+        {
+            return slot;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+SymbolId SymbolTable::find(boost::string_view name) const
+{
+    std::uint32_t hashValue = hash(name);
+    std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+    return _slots[findSlot(name, hashValue)];
+}
+
+SymbolId SymbolTable::intern(boost::string_view name)
+{
+    std::uint32_t hashValue = hash(name);
+    {
+        // Most names are already interned, so look them up without blocking the readers
+        std::shared_lock<std::shared_timed_mutex> lock(_mutex);
+        IndexType slot = findSlot(name, hashValue);
+        if (_slots[slot] != INDEX_TYPE_MAX)
+        {
+            return _slots[slot];
+        }
+    }
+    std::unique_lock<std::shared_timed_mutex> lock(_mutex);
+    // Another thread may have interned it in between
+    IndexType slot = findSlot(name, hashValue);
+    if (_slots[slot] != INDEX_TYPE_MAX)
+    {
+        return _slots[slot];
+    }
+    SymbolId id = _size.load(std::memory_order_relaxed);
+    IndexType chunk = chunkIdx(id);
+    if (!_chunks[chunk])
+    {
+        _chunks[chunk].reset(new std::string[chunkSize(chunk)]);
+    }
+    _chunks[chunk][id - chunkStart(chunk)].assign(name.data(), name.size());
+    _hashes.emplace_back(hashValue);
+    _slots[slot] = id;
+    // Publish the string to the readers of str()
+    _size.store(id + 1, std::memory_order_release);
+    // Keep the load factor under 1/2
+    if (_hashes.size() * 2 > _slots.size())
+    {
+        grow();
+    }
+    return id;
+}
+
+void SymbolTable::grow()
+{
+    _slots.assign(_slots.size() * 2, INDEX_TYPE_MAX);
+    IndexType mask = _slots.size() - 1;
+    for (SymbolId id = 0; id < _hashes.size(); ++id)
+    {
+        IndexType slot = _hashes[id] & mask;
+        while (_slots[slot] != INDEX_TYPE_MAX)
+        {
+            slot = (slot + 1) & mask;
+        }
+        _slots[slot] = id;
+    }
+}
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,112 @@
+/**
+ * @file SymbolTable.h
+ * @brief The interned names shared by the design database
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_SYMBOL_TABLE_H_
+#define MAGICAL_FLOW_SYMBOL_TABLE_H_
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <boost/utility/string_view.hpp>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief the id of an interned name
+using SymbolId = IndexType;
+/// @brief the id of the empty name. Objects are created with it
+constexpr SymbolId EMPTY_SYMBOL = 0;
+
+/// @class MAGICAL_FLOW::SymbolTable
+/// @brief Each distinct name is stored once and referred to by a 32-bit id.
+/// The strings are stored in chunks that never move, so the references returned by str() stay valid.
+/// The table is shared by all the designs of the process. str() and size() do not lock: a string is written before
+/// the size publishing it. The name lookups share a reader-writer lock with interning
+class SymbolTable
+{
+    public:
+        /// @brief constructor. The empty string is interned as EMPTY_SYMBOL
+        explicit SymbolTable();
+        /// @brief get the table shared by the whole design
+        /// @return the global symbol table
+        static SymbolTable & global();
+        /*------------------------------*/ 
+        /* Getters                      */
+        /*------------------------------*/ 
+        /// @brief get the string of a symbol
+        /// @param the symbol id
+        /// @return the string
+        const std::string & str(SymbolId id) const
+        {
+            if (id >= _size.load(std::memory_order_acquire))
+            {
+                throw std::out_of_range("SymbolTable::str: symbol id out of range");
+            }
+            IndexType chunk = chunkIdx(id);
+            return _chunks[chunk][id - chunkStart(chunk)];
+        }
+        /// @brief get the number of symbols
+        /// @return the number of symbols
+        IndexType size() const { return _size.load(std::memory_order_acquire); }
+        /// @brief find the symbol of a name without interning it
+        /// @param the name
+        /// @return the symbol id. INDEX_TYPE_MAX if the name was never interned
+        SymbolId find(boost::string_view name) const;
+        /// @brief hash a name
+        /// @param the name
+        /// @return the hash value
+        static std::uint32_t hash(boost::string_view name);
+        /// @brief get the heap bytes of the table
+        /// @return the bytes of the strings, the hashes and the slots. See MemUtil
+        std::uint64_t heapBytes() const;
+        /*------------------------------*/ 
+        /* Setters                      */
+        /*------------------------------*/ 
+        /// @brief intern a name
+        /// @param the name
+        /// @return the symbol id of the name
+        SymbolId intern(boost::string_view name);
+    private:
+        /// @brief find the slot of a name in the open addressing table. The caller holds the lock
+        /// @param first: the name
+        /// @param second: the hash of the name
+        /// @return the slot either holding the name or empty
+        IndexType findSlot(boost::string_view name, std::uint32_t hashValue) const;
+        /// @brief grow the open addressing table and reinsert all the symbols. The caller holds the lock
+        void grow();
+        /// @brief get the chunk of a symbol. Chunk c holds FIRST_CHUNK_SIZE << c strings
+        /// @param the symbol id
+        /// @return the index of the chunk
+        static IndexType chunkIdx(SymbolId id)
+        {
+            // The floor of log2(id / FIRST_CHUNK_SIZE + 1)
+            return 63 - __builtin_clzll(static_cast<std::uint64_t>(id) / FIRST_CHUNK_SIZE + 1);
+        }
+        /// @brief get the number of strings in a chunk
+        /// @param the index of the chunk
+        /// @return the number of strings
+        static std::uint64_t chunkSize(IndexType chunk) { return static_cast<std::uint64_t>(FIRST_CHUNK_SIZE) << chunk; }
+        /// @brief get the id of the first symbol in a chunk
+        /// @param the index of the chunk
+        /// @return the symbol id
+        static std::uint64_t chunkStart(IndexType chunk) { return chunkSize(chunk) - FIRST_CHUNK_SIZE; }
+    private:
+        static constexpr IndexType FIRST_CHUNK_SIZE = 64; ///< The number of strings in the first chunk. Each next chunk doubles
+        static constexpr IndexType NUM_CHUNKS = 27; ///< Enough chunks for every 32-bit symbol id
+        std::array<std::unique_ptr<std::string[]>, NUM_CHUNKS> _chunks; ///< The strings by symbol id. A chunk is allocated once and never moves
+        std::atomic<IndexType> _size; ///< The number of symbols. Stored after the string, so the lock-free readers see it written
+        std::vector<std::uint32_t> _hashes; ///< _hashes[symbol id] = the hash of the string
+        std::vector<SymbolId> _slots; ///< The open addressing table with linear probing. INDEX_TYPE_MAX is empty. The size is power of 2
+        mutable std::shared_timed_mutex _mutex; ///< Interning takes it exclusively, the name lookups share it
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_SYMBOL_TABLE_H_
@@ -1,5 +1,6 @@
 #include "TechDB.h"
 #include "parser/ParseSimpleTech.h"
+#include "parser/ParseLef.h"
 
 PROJECT_NAMESPACE_BEGIN
 
@@ -15,5 +16,14 @@ namespace PARSE
         }
         return true;
     }
+
+    bool parseLefFile(const std::string &file, TechDB &techDB)
+    {
+        if (!ParseLef(techDB).read(file))
+        {
+            return false;
+        }
+        return true;
+    }
 }
 PROJECT_NAMESPACE_END
@@ -9,10 +9,15 @@
 #define MAGICAL_FLOW_TECHDB_H_
 
 #include <unordered_map>
+#include <algorithm>
+#include <memory>
 #include "global/global.h"
 
 PROJECT_NAMESPACE_BEGIN
 
+class BinaryWriter;
+class BinaryReader;
+
 class TechUnit
 {
     public:
@@ -44,19 +49,88 @@ class TechUnit
         IntType _gdsHeader = 600; ///< GDSII format header. usually 600 see: http://boolean.klaasholwerda.nl/interface/bnf/gdsformat.html#recordheader
 };
 
+/// @brief a rectangle on a layer from LEF, in dbu
+struct LefShape
+{
+    LefShape() = default;
+    LefShape(IndexType dbLayer_, const Box<LocType> &rect_) : dbLayer(dbLayer_), rect(rect_) {}
+    IndexType dbLayer = INDEX_TYPE_MAX; ///< The index of layer in db. INDEX_TYPE_MAX if the layer is not in the tech
+    Box<LocType> rect; ///< The shape
+};
+
+/// @brief the LEF description of a layer. Lengths are in dbu
+struct LefLayer
+{
+    std::string name; ///< The name of the layer
+    std::string type; ///< MASTERSLICE, CUT, ROUTING...
+    std::string direction; ///< HORIZONTAL or VERTICAL for routing layers
+    LocType pitch = 0; ///< The routing pitch
+    LocType width = 0; ///< The default width
+    LocType spacing = 0; ///< The minimum spacing
+    RealType area = 0; ///< The minimum area in um^2
+    IndexType dbLayer = INDEX_TYPE_MAX; ///< The index of layer in db. INDEX_TYPE_MAX if the layer is not in the tech
+};
+
+/// @brief the LEF description of a fixed via
+struct LefVia
+{
+    std::string name; ///< The name of the via
+    bool isDefault = false; ///< Whether the via is a DEFAULT via
+    std::vector<LefShape> shapes; ///< The shapes on the layers of the via
+};
+
+/// @brief the LEF description of a macro pin
+struct LefPin
+{
+    std::string name; ///< The name of the pin
+    std::string direction; ///< INPUT, OUTPUT, INOUT...
+    std::string use; ///< SIGNAL, POWER, GROUND...
+    std::vector<LefShape> shapes; ///< The port shapes
+};
+
+/// @brief the LEF description of a macro
+struct LefMacro
+{
+    std::string name; ///< The name of the macro
+    std::string macroClass; ///< CORE, BLOCK...
+    XY<LocType> origin = XY<LocType>(0, 0); ///< The origin
+    LocType width = 0; ///< The width of the macro
+    LocType height = 0; ///< The height of the macro
+    std::vector<LefPin> pins; ///< The pins
+    std::vector<LefShape> obs; ///< The obstructions
+};
+
+/// @brief the LEF data of a tech. It is read once and shared by the copies of the tech, which never change it
+struct LefTables
+{
+    std::vector<LefLayer> layers; ///< The layers read from LEF
+    std::vector<LefVia> vias; ///< The fixed vias read from LEF
+    std::vector<LefMacro> macros; ///< The macros read from LEF
+    /// @brief get the heap bytes of the tables
+    /// @return the bytes of the arrays and the strings. See MemUtil
+    std::uint64_t heapBytes() const;
+};
+
 /// @class MAGICAL_FLOW::TechDB
 /// @brief The database for needed technology information
 class TechDB
 {
     public:
         /// @brief constructor
-        explicit TechDB() { _pdkLayerToDbLayer.resize(RESERVED_LAYERS_NUMBER, INDEX_TYPE_MAX); }
+        explicit TechDB()
+        {
+            _datatypeToColumn.resize(RESERVED_DATATYPES_NUMBER, 0);
+            _layerDatatypeToDbLayer.resize(RESERVED_LAYERS_NUMBER * _numDatatypeColumns, INDEX_TYPE_MAX);
+        }
         /*------------------------------*/ 
         /* Getters                      */
         /*------------------------------*/ 
         /// @brief get the units 
         /// @return the units 
         TechUnit & units() { return _units; }
+        /// @brief get the units
+        /// @return the units
+        const TechUnit & units() const { return _units; }
         /// @brief get the number of layers
         /// @return the number of layers
         IndexType numLayers() const { return _dbLayerToPdkLayer.size(); }
@@ -64,14 +138,94 @@ class TechDB
         /// @param the index of layer in db
         /// @return the layer ID in PDK
         IndexType dbLayerToPdk(IndexType dbLayerIdx) const { return _dbLayerToPdkLayer.at(dbLayerIdx); }
+        /// @brief convert the datatype of a shape on a db layer to the GDSII datatype to write
+        /// @param first: the index of layer in db
+        /// @param second: the datatype stored in the layout. DRAWING_DATATYPE for the drawing datatype of the layer
+        /// @return the datatype in PDK
+        IndexType dbLayerToPdkDatatype(IndexType dbLayerIdx, IndexType datatype) const
+        {
+            return datatype == DRAWING_DATATYPE ? _dbLayerToPdkDatatype.at(dbLayerIdx) : datatype;
+        }
         /// @brief convert pdk layer to db layer
         /// @param the pdk layer
         /// @return the db layer
-        IndexType pdkLayerToDb(IndexType pdkLayer) const { return _pdkLayerToDbLayer.at(pdkLayer); }
+        IndexType pdkLayerToDb(IndexType pdkLayer) const { return _layerDatatypeToDbLayer.at(pdkLayer * _numDatatypeColumns); }
+        /// @brief convert a pdk (layer, datatype) pair to db layer
+        /// @param first: the pdk layer
+        /// @param second: the GDSII datatype
+        /// @return the db layer. INDEX_TYPE_MAX if the pair is not in the tech
+        IndexType pdkLayerToDb(IndexType pdkLayer, IndexType datatype) const
+        {
+            // GDSII layers go up to 65535, beyond the layers a tech can define
+            if (pdkLayer >= RESERVED_LAYERS_NUMBER)
+            {
+                return INDEX_TYPE_MAX;
+            }
+            // Out of range datatypes are not named by the tech either
+            IndexType col = datatype < RESERVED_DATATYPES_NUMBER ? _datatypeToColumn[datatype] : 0;
+            return _layerDatatypeToDbLayer[pdkLayer * _numDatatypeColumns + col];
+        }
+        /// @brief convert a GDSII datatype read on a db layer to the datatype stored in the layout
+        /// @param first: the index of layer in db
+        /// @param second: the GDSII datatype
+        /// @return the datatype for the layout. The drawing datatype of the layer is stored as DRAWING_DATATYPE.
+        /// The datatype is kept as is on an unmapped layer (INDEX_TYPE_MAX)
+        IndexType pdkDatatypeToDb(IndexType dbLayerIdx, IndexType datatype) const
+        {
+            if (dbLayerIdx >= _dbLayerToPdkDatatype.size())
+            {
+                return datatype;
+            }
+            return datatype == _dbLayerToPdkDatatype[dbLayerIdx] ? DRAWING_DATATYPE : datatype;
+        }
         /// @brief convert layer name to db layer
         /// @param the name of the layer
         /// @return the corresponding layer index in the db
         IndexType layerNameToIdx(const std::string &name) const { return _layerNameToDbLayer.at(name); }
+        /// @brief find the db layer of a layer name
+        /// @param the name of the layer
+        /// @return the layer index in the db. INDEX_TYPE_MAX if not found
+        IndexType findLayer(const std::string &name) const
+        {
+            auto it = _layerNameToDbLayer.find(name);
+            return it == _layerNameToDbLayer.end() ? INDEX_TYPE_MAX : it->second;
+        }
+        /// @brief get the LEF data
+        /// @return the LEF tables. Empty if no LEF is read
+        const LefTables & lef() const { return _lef ? *_lef : emptyLef(); }
+        /// @brief get the LEF data shared by the copies of this tech
+        /// @return the shared LEF tables. nullptr if no LEF is read
+        const std::shared_ptr<const LefTables> & sharedLef() const { return _lef; }
+        /// @brief get the LEF layers
+        /// @return the LEF layers
+        const std::vector<LefLayer> & lefLayers() const { return lef().layers; }
+        /// @brief get the LEF vias
+        /// @return the LEF vias
+        const std::vector<LefVia> & lefVias() const { return lef().vias; }
+        /// @brief get the LEF macros
+        /// @return the LEF macros
+        const std::vector<LefMacro> & lefMacros() const { return lef().macros; }
+        /// @brief get the number of LEF layers
+        /// @return the number of LEF layers
+        IndexType numLefLayers() const { return lef().layers.size(); }
+        /// @brief get the number of LEF vias
+        /// @return the number of LEF vias
+        IndexType numLefVias() const { return lef().vias.size(); }
+        /// @brief get the number of LEF macros
+        /// @return the number of LEF macros
+        IndexType numLefMacros() const { return lef().macros.size(); }
+        /// @brief get a LEF layer
+        /// @param the index of the LEF layer
+        /// @return the LEF layer
+        const LefLayer & lefLayer(IndexType idx) const { return lef().layers.at(idx); }
+        /// @brief get a LEF via
+        /// @param the index of the LEF via
+        /// @return the LEF via
+        const LefVia & lefVia(IndexType idx) const { return lef().vias.at(idx); }
+        /// @brief get a LEF macro
+        /// @param the index of the LEF macro
+        /// @return the LEF macro
+        const LefMacro & lefMacro(IndexType idx) const { return lef().macros.at(idx); }
         /*------------------------------*/ 
         /* Setters                      */
         /*------------------------------*/ 
@@ -81,24 +235,94 @@ class TechDB
         /// @brief push back a new layer
         /// @param first: the tech layer ID
         /// @param second: the name of the layer
+        /// @param third: the drawing datatype of the layer. Shapes of other datatypes on the same tech layer are mapped to this layer as well
         /// @return the index of the layer
-        IndexType addNewLayer(IndexType techID, const std::string &name)
+        IndexType addNewLayer(IndexType techID, const std::string &name, IndexType datatype = 0)
         {
+            AssertMsg(techID < RESERVED_LAYERS_NUMBER, "TechDB::addNewLayer: tech layer %u is out of range \n", techID);
+            AssertMsg(datatype < RESERVED_DATATYPES_NUMBER, "TechDB::addNewLayer: datatype %u is out of range \n", datatype);
             if (!_dbLayerToPdkLayer.empty())
             {
-                AssertMsg(_dbLayerToPdkLayer.back() < techID, "TechDB::addNewLayer: the order of adding layers is wrong.");
+                AssertMsg(_dbLayerToPdkLayer.back() < techID 
+                        || (_dbLayerToPdkLayer.back() == techID && _dbLayerToPdkDatatype.back() < datatype),
+                        "TechDB::addNewLayer: the order of adding layers is wrong.");
             }
             IndexType index = _dbLayerToPdkLayer.size(); 
             _dbLayerToPdkLayer.emplace_back(techID);
-            _pdkLayerToDbLayer.at(techID) = index;
+            _dbLayerToPdkDatatype.emplace_back(datatype);
             _layerNameToDbLayer[name] = index;
+            // The first layer on a tech layer takes all the datatypes. The later ones only take their own
+            IndexType row = techID * _numDatatypeColumns;
+            if (_layerDatatypeToDbLayer[row] == INDEX_TYPE_MAX)
+            {
+                std::fill(_layerDatatypeToDbLayer.begin() + row, _layerDatatypeToDbLayer.begin() + row + _numDatatypeColumns, index);
+            }
+            if (datatype != 0)
+            {
+                IndexType col = this->datatypeColumn(datatype);
+                _layerDatatypeToDbLayer[techID * _numDatatypeColumns + col] = index;
+            }
             return index;
         }
+        /// @brief set the LEF data. The copies of the tech made from here on share it
+        /// @param the LEF tables
+        void setLef(std::shared_ptr<const LefTables> lef) { _lef = std::move(lef); }
+        /*------------------------------*/ 
+        /* Memory                       */
+        /*------------------------------*/ 
+        /// @brief get the heap bytes of the tech
+        /// @return the bytes of the layer tables. The shared LEF data is not included. See MemUtil
+        std::uint64_t heapBytes() const;
+        /*------------------------------*/ 
+        /* Checkpoint                   */
+        /*------------------------------*/ 
+        /// @brief write the units, the layer tables and the LEF data. See DesignDB::save()
+        /// @param the binary writer
+        void save(BinaryWriter &out) const;
+        /// @brief replace the tech by one written by save()
+        /// @param the binary reader
+        void load(BinaryReader &in);
+    private:
+        /// @brief get the LEF data of the techs without LEF
+        /// @return the empty LEF tables
+        static const LefTables & emptyLef()
+        {
+            static const LefTables empty;
+            return empty;
+        }
+        /// @brief get the column of a datatype in the dense (layer, datatype) table. Allocate a new column if the datatype has not been seen
+        /// @param the GDSII datatype
+        /// @return the column index
+        IndexType datatypeColumn(IndexType datatype)
+        {
+            if (datatype == 0 || _datatypeToColumn[datatype] != 0)
+            {
+                return _datatypeToColumn[datatype];
+            }
+            // Re-layout the table with one more column. The new column inherits the default column of each tech layer
+            IndexType numColumns = _numDatatypeColumns + 1;
+            std::vector<IndexType> table(RESERVED_LAYERS_NUMBER * numColumns);
+            for (IndexType techID = 0; techID < RESERVED_LAYERS_NUMBER; ++techID)
+            {
+                std::copy(_layerDatatypeToDbLayer.begin() + techID * _numDatatypeColumns,
+                          _layerDatatypeToDbLayer.begin() + (techID + 1) * _numDatatypeColumns,
+                          table.begin() + techID * numColumns);
+                table[techID * numColumns + _numDatatypeColumns] = _layerDatatypeToDbLayer[techID * _numDatatypeColumns];
+            }
+            _layerDatatypeToDbLayer.swap(table);
+            _datatypeToColumn[datatype] = static_cast<Byte>(_numDatatypeColumns);
+            _numDatatypeColumns = numColumns;
+            return _datatypeToColumn[datatype];
+        }
     private:
         TechUnit _units; ///< Units 
         std::vector<IndexType> _dbLayerToPdkLayer; ///< _dbLayerToLayerId[the index of layer in this project] = the layer ID in the PDK
-        std::vector<IndexType> _pdkLayerToDbLayer; ///< _pdkLayerToDbLayer[PDK layer ID] = the index of layer in this project. The size of the vector is const defined in "global/constant.h"
+        std::vector<IndexType> _dbLayerToPdkDatatype; ///< _dbLayerToPdkDatatype[the index of layer in this project] = the drawing datatype in the PDK
+        std::vector<Byte> _datatypeToColumn; ///< _datatypeToColumn[GDSII datatype] = column in _layerDatatypeToDbLayer. Datatypes not used by the tech share column 0
+        IndexType _numDatatypeColumns = 1; ///< The number of columns in _layerDatatypeToDbLayer
+        std::vector<IndexType> _layerDatatypeToDbLayer; ///< _layerDatatypeToDbLayer[PDK layer ID * _numDatatypeColumns + column] = the index of layer in this project. The number of rows is const defined in "global/constant.h"
         std::unordered_map<std::string, IndexType> _layerNameToDbLayer; ///< _layerNameToDbLayer["name of the layer"] = index of layer in db
+        std::shared_ptr<const LefTables> _lef; ///< The data read from LEF, shared by the copies of the tech. nullptr if no LEF is read
 };
 
 namespace PARSE
@@ -106,6 +330,11 @@ namespace PARSE
     /// @brief parser layer ID
     /// @param the input file name for layers(simple techfile)
     bool parseSimpleTechFile(const std::string &file, TechDB &techDB);
+    /// @brief parse the layers, vias and macros in a LEF file
+    /// @param first: the LEF file name
+    /// @param second: the technology database. Layers are matched to the existing db layers by name
+    /// @return whether the parsing is successful
+    bool parseLefFile(const std::string &file, TechDB &techDB);
 }
 PROJECT_NAMESPACE_END
 
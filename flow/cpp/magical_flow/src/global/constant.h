@@ -13,6 +13,8 @@
 PROJECT_NAMESPACE_BEGIN
 
 constexpr IndexType RESERVED_LAYERS_NUMBER = 500; ///< Reverse this number of layers for tech layer ID
+constexpr IndexType RESERVED_DATATYPES_NUMBER = 256; ///< GDSII datatypes are within [0, 255]
+constexpr IndexType DRAWING_DATATYPE = INDEX_TYPE_MAX; ///< The datatype of a shape on the drawing datatype of its layer, whatever the number in the PDK
 
 PROJECT_NAMESPACE_END
 
@@ -21,6 +21,7 @@ using IntType    = std::int32_t;
 using RealType   = double;
 using Byte       = std::uint8_t;
 using LocType    = std::int32_t; // Location/design unit // Location/design unit
+using HashType   = std::uint64_t; // Structural hashes and fingerprints
  // Location/design unit
 // Built-in type constants
 constexpr IndexType INDEX_TYPE_MAX  = UINT32_MAX;
@@ -70,6 +71,27 @@ enum class PinType
     NWELL
 };
 
+/// @class MAGICAL_FLOW::NetFlag
+/// @brief the bits of the net flags
+enum class NetFlag : Byte
+{
+    VDD = 1,
+    VSS = 2,
+    DIGITAL = 4,
+    ANALOG = 8,
+    IO = 16 ///< Kept in sync with the ioPos of the net
+};
+
+/// @class MAGICAL_FLOW::CktEditType
+/// @brief the type of an edit in the journal of a circuit graph
+enum class CktEditType : Byte
+{
+    ADD_NODE,
+    REMOVE_NODE,
+    RECONNECT_PIN,
+    EDIT_PROP
+};
+
 
 PROJECT_NAMESPACE_END
 
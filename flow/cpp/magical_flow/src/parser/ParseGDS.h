@@ -57,7 +57,13 @@ namespace ParseLayoutAction
         IndexType rect_id;
         std::vector<Box<LocType>> rects;
         std::vector<XY<LocType>> pts;
-        layer_id = techDB.pdkLayerToDb(layer_id);
+        layer_id = techDB.pdkLayerToDb(layer_id, datatype);
+        if (layer_id == INDEX_TYPE_MAX)
+        {
+            WRN("ParseGDS: skip a polygon on layer %d datatype %d not in the tech \n", object->layer(), object->datatype());
+            return;
+        }
+        datatype = techDB.pdkDatatypeToDb(layer_id, datatype);
         for (auto pt : *object)
         {
             pts.emplace_back(pt.x(), pt.y());
@@ -66,7 +72,7 @@ namespace ParseLayoutAction
         for (auto rect : rects)
         {
             rect_id = layer.insertRect(layer_id, rect);
-            if(datatype != 0)
+            if(datatype != DRAWING_DATATYPE)
                 layer.setRectDatatype(layer_id, rect_id, datatype);
         }
         // LocType x_min = std::numeric_limits<LocType>::max();
@@ -0,0 +1,370 @@
+#include "ParseLef.h"
+#include <cmath>
+#include <algorithm>
+
+PROJECT_NAMESPACE_BEGIN
+
+bool ParseLef::read(const std::string &filename)
+{
+    MappedTextFile file;
+    if (!file.open(filename)) 
+    {
+        ERR("LEF parser::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
+        return false;
+    }
+    // Added to the LEF data read before. The tech is only changed if the whole file is read
+    _lef = _techDB.lef();
+    TextTokenizer tokenizer(file.content(), true);
+    boost::string_view token;
+    boost::string_view name;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            if (tokenizer.next(token) && token == "LIBRARY")
+            {
+                break;
+            }
+        }
+        else if (token == "LAYER" || token == "VIA" || token == "MACRO")
+        {
+            if (!tokenizer.next(name))
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Missing %s name \n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
+                return false;
+            }
+            bool success = token == "LAYER" ? parseLayer(tokenizer, name)
+                         : token == "VIA" ? parseVia(tokenizer, name)
+                         : parseMacro(tokenizer, name);
+            if (!success)
+            {
+                return false;
+            }
+        }
+        else if (token == "VIARULE" || token == "SITE" || token == "NONDEFAULTRULE")
+        {
+            if (!tokenizer.next(name) || !skipBlock(tokenizer, name))
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Unterminated %s \n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
+                return false;
+            }
+        }
+        else if (token == "UNITS" || token == "PROPERTYDEFINITIONS")
+        {
+            // The coordinates are converted with the dbu in the tech db, not the DATABASE MICRONS of LEF
+            if (!skipBlock(tokenizer, token))
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Unterminated %s \n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
+                return false;
+            }
+        }
+        else
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    _techDB.setLef(std::make_shared<const LefTables>(std::move(_lef)));
+    return true;
+}
+
+bool ParseLef::parseLayer(TextTokenizer &tokenizer, boost::string_view name)
+{
+    LefLayer layer;
+    layer.name = name.to_string();
+    layer.dbLayer = _techDB.findLayer(layer.name);
+    boost::string_view token;
+    RealType value = 0;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            if (!tokenizer.next(token) || token != name)
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Expect END %s \n", __FUNCTION__, tokenizer.lineNumber(), layer.name.c_str());
+                return false;
+            }
+            _lef.layers.emplace_back(std::move(layer));
+            return true;
+        }
+        else if (token == "TYPE" && tokenizer.next(token) && token != ";")
+        {
+            layer.type = token.to_string();
+        }
+        else if (token == "DIRECTION" && tokenizer.next(token) && token != ";")
+        {
+            layer.direction = token.to_string();
+        }
+        else if (token == "PITCH" && readReal(tokenizer, token, value))
+        {
+            layer.pitch = toDbu(value);
+        }
+        else if (token == "WIDTH" && readReal(tokenizer, token, value))
+        {
+            layer.width = toDbu(value);
+        }
+        else if (token == "AREA" && readReal(tokenizer, token, value))
+        {
+            layer.area = value;
+        }
+        else if (token == "SPACING" && readReal(tokenizer, token, value))
+        {
+            // Keep the first one as the minimum spacing
+            if (layer.spacing == 0)
+            {
+                layer.spacing = toDbu(value);
+            }
+        }
+        // The value read may be the ';' already
+        if (token != ";")
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    ERR("LEF parser::%s: syntax error. No END %s? \n", __FUNCTION__, layer.name.c_str());
+    return false;
+}
+
+bool ParseLef::parseVia(TextTokenizer &tokenizer, boost::string_view name)
+{
+    LefVia via;
+    via.name = name.to_string();
+    boost::string_view token;
+    if (tokenizer.nextInLine(token))
+    {
+        via.isDefault = token == "DEFAULT";
+    }
+    IndexType dbLayer = INDEX_TYPE_MAX;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            if (!tokenizer.next(token) || token != name)
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Expect END %s \n", __FUNCTION__, tokenizer.lineNumber(), via.name.c_str());
+                return false;
+            }
+            _lef.vias.emplace_back(std::move(via));
+            return true;
+        }
+        else if (token == "LAYER")
+        {
+            dbLayer = tokenizer.next(token) && token != ";" ? _techDB.findLayer(token.to_string()) : INDEX_TYPE_MAX;
+            if (token != ";")
+            {
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "RECT")
+        {
+            if (!parseRect(tokenizer, dbLayer, via.shapes))
+            {
+                return false;
+            }
+        }
+        else if (token != ";")
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    ERR("LEF parser::%s: syntax error. No END %s? \n", __FUNCTION__, via.name.c_str());
+    return false;
+}
+
+bool ParseLef::parseMacro(TextTokenizer &tokenizer, boost::string_view name)
+{
+    LefMacro macro;
+    macro.name = name.to_string();
+    boost::string_view token;
+    RealType x = 0, y = 0;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            if (!tokenizer.next(token) || token != name)
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Expect END %s \n", __FUNCTION__, tokenizer.lineNumber(), macro.name.c_str());
+                return false;
+            }
+            _lef.macros.emplace_back(std::move(macro));
+            return true;
+        }
+        else if (token == "CLASS")
+        {
+            if (tokenizer.next(token) && token != ";")
+            {
+                macro.macroClass = token.to_string();
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "ORIGIN")
+        {
+            if (readReal(tokenizer, token, x) && readReal(tokenizer, token, y))
+            {
+                macro.origin = XY<LocType>(toDbu(x), toDbu(y));
+            }
+            if (token != ";")
+            {
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "SIZE")
+        {
+            // SIZE width BY height ;
+            if (readReal(tokenizer, token, x) && tokenizer.next(token) && token == "BY" && readReal(tokenizer, token, y))
+            {
+                macro.width = toDbu(x);
+                macro.height = toDbu(y);
+            }
+            if (token != ";")
+            {
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "PIN")
+        {
+            if (!tokenizer.next(token))
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Missing PIN name \n", __FUNCTION__, tokenizer.lineNumber());
+                return false;
+            }
+            macro.pins.emplace_back();
+            macro.pins.back().name = token.to_string();
+            if (!parsePin(tokenizer, macro.pins.back()))
+            {
+                return false;
+            }
+        }
+        else if (token == "OBS")
+        {
+            if (!parseShapes(tokenizer, macro.obs))
+            {
+                return false;
+            }
+        }
+        else if (token != ";")
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    ERR("LEF parser::%s: syntax error. No END %s? \n", __FUNCTION__, macro.name.c_str());
+    return false;
+}
+
+bool ParseLef::parsePin(TextTokenizer &tokenizer, LefPin &pin)
+{
+    boost::string_view token;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            if (!tokenizer.next(token) || token != pin.name)
+            {
+                ERR("LEF parser::%s: syntax error at line %u. Expect END %s \n", __FUNCTION__, tokenizer.lineNumber(), pin.name.c_str());
+                return false;
+            }
+            return true;
+        }
+        else if (token == "DIRECTION" || token == "USE")
+        {
+            std::string &value = token == "DIRECTION" ? pin.direction : pin.use;
+            if (tokenizer.next(token) && token != ";")
+            {
+                value = token.to_string();
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "PORT")
+        {
+            if (!parseShapes(tokenizer, pin.shapes))
+            {
+                return false;
+            }
+        }
+        else if (token != ";")
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    ERR("LEF parser::%s: syntax error. No END %s? \n", __FUNCTION__, pin.name.c_str());
+    return false;
+}
+
+bool ParseLef::parseShapes(TextTokenizer &tokenizer, std::vector<LefShape> &shapes)
+{
+    boost::string_view token;
+    IndexType dbLayer = INDEX_TYPE_MAX;
+    while (tokenizer.next(token))
+    {
+        if (token == "END")
+        {
+            return true;
+        }
+        else if (token == "LAYER")
+        {
+            dbLayer = tokenizer.next(token) && token != ";" ? _techDB.findLayer(token.to_string()) : INDEX_TYPE_MAX;
+            if (token != ";")
+            {
+                tokenizer.skipStatement();
+            }
+        }
+        else if (token == "RECT")
+        {
+            if (!parseRect(tokenizer, dbLayer, shapes))
+            {
+                return false;
+            }
+        }
+        else if (token != ";")
+        {
+            tokenizer.skipStatement();
+        }
+    }
+    ERR("LEF parser::%s: syntax error. No END? \n", __FUNCTION__);
+    return false;
+}
+
+bool ParseLef::parseRect(TextTokenizer &tokenizer, IndexType dbLayer, std::vector<LefShape> &shapes)
+{
+    boost::string_view token;
+    RealType coords[4] = { 0, 0, 0, 0 };
+    for (IndexType idx = 0; idx < 4; ++idx)
+    {
+        bool isRead = tokenizer.next(token);
+        if (isRead && idx == 0 && token == "MASK")
+        {
+            // RECT MASK maskNum pt pt ;
+            isRead = tokenizer.next(token) && tokenizer.next(token);
+        }
+        if (!isRead || !TokenUtil::toReal(token, coords[idx]))
+        {
+            ERR("LEF parser::%s: syntax error at line %u. Invalid RECT \n", __FUNCTION__, tokenizer.lineNumber());
+            return false;
+        }
+    }
+    shapes.emplace_back(dbLayer, Box<LocType>(toDbu(std::min(coords[0], coords[2])), toDbu(std::min(coords[1], coords[3])),
+                                              toDbu(std::max(coords[0], coords[2])), toDbu(std::max(coords[1], coords[3]))));
+    tokenizer.skipStatement();
+    return true;
+}
+
+bool ParseLef::skipBlock(TextTokenizer &tokenizer, boost::string_view name)
+{
+    boost::string_view token;
+    bool afterEnd = false;
+    while (tokenizer.next(token))
+    {
+        if (afterEnd && token == name)
+        {
+            return true;
+        }
+        afterEnd = token == "END";
+    }
+    return false;
+}
+
+bool ParseLef::readReal(TextTokenizer &tokenizer, boost::string_view &token, RealType &value)
+{
+    return tokenizer.next(token) && TokenUtil::toReal(token, value);
+}
+
+PROJECT_NAMESPACE_END
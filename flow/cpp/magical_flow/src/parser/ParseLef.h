@@ -0,0 +1,85 @@
+/**
+ * @file ParseLef.h
+ * @brief Parsing the layers, vias and macros in LEF files
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_PARSE_LEF_H_
+#define MAGICAL_FLOW_PARSE_LEF_H_
+
+#include "global/global.h"
+#include "db/TechDB.h"
+#include "parser/TextTokenizer.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class PROJECT_NAMESPACE::ParseLef
+/// @brief parser for LEF files. Only the layers, fixed vias and macros are read.
+/// LEF layers are matched to the db layers by name, so the tech layers should be read first.
+/// The coordinates are converted to the dbu in the TechDB. The tech is left unchanged if the file fails to parse
+class ParseLef
+{
+    public:
+        /// @brief constructor
+        /// @param technology database to fill
+        explicit ParseLef(TechDB &techDB) : _techDB(techDB) {}
+        /// @brief read a LEF file
+        /// @param the file name of the LEF file
+        /// @return whether the parsing is successful
+        bool read(const std::string &filename);
+    private:
+        /// @brief parse a LAYER block
+        /// @param first: the tokenizer
+        /// @param second: the name of the layer
+        /// @return whether the parsing is successful
+        bool parseLayer(TextTokenizer &tokenizer, boost::string_view name);
+        /// @brief parse a VIA block
+        /// @param first: the tokenizer
+        /// @param second: the name of the via
+        /// @return whether the parsing is successful
+        bool parseVia(TextTokenizer &tokenizer, boost::string_view name);
+        /// @brief parse a MACRO block
+        /// @param first: the tokenizer
+        /// @param second: the name of the macro
+        /// @return whether the parsing is successful
+        bool parseMacro(TextTokenizer &tokenizer, boost::string_view name);
+        /// @brief parse a PIN block in a macro
+        /// @param first: the tokenizer
+        /// @param second: the pin to fill
+        /// @return whether the parsing is successful
+        bool parsePin(TextTokenizer &tokenizer, LefPin &pin);
+        /// @brief parse the LAYER and RECT statements until a bare END, as in PORT and OBS
+        /// @param first: the tokenizer
+        /// @param second: the shapes to fill
+        /// @return whether the parsing is successful
+        bool parseShapes(TextTokenizer &tokenizer, std::vector<LefShape> &shapes);
+        /// @brief parse a RECT statement after the RECT keyword
+        /// @param first: the tokenizer
+        /// @param second: the db layer of the rectangle
+        /// @param third: the shapes to add to
+        /// @return whether the parsing is successful
+        bool parseRect(TextTokenizer &tokenizer, IndexType dbLayer, std::vector<LefShape> &shapes);
+        /// @brief skip a block until "END name"
+        /// @param first: the tokenizer
+        /// @param second: the name of the block
+        /// @return whether the end of the block is found
+        bool skipBlock(TextTokenizer &tokenizer, boost::string_view name);
+        /// @brief read a real number token
+        /// @param first: the tokenizer
+        /// @param second: the token read. The caller checks it for the ';' before skipping the rest of the statement
+        /// @param third: the result
+        /// @return whether the next token is a real number
+        bool readReal(TextTokenizer &tokenizer, boost::string_view &token, RealType &value);
+        /// @brief convert micron to dbu
+        /// @param the length in micron
+        /// @return the length in dbu
+        LocType toDbu(RealType um) const { return static_cast<LocType>(std::lround(um * _techDB.units().dbu())); }
+    private:
+        TechDB &_techDB; ///< Reference to the technology database
+        LefTables _lef; ///< The LEF data read so far, set to the tech at the end
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_PARSE_LEF_H_
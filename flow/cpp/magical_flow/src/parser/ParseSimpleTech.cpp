@@ -4,99 +4,57 @@ PROJECT_NAMESPACE_BEGIN
 
 bool ParseSimpleTech::read(const std::string &filename)
 {
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
-    {
-        ERR("ParserTechSimple::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
-        Assert(false);
-        return false;
-    }
-    // Read in the file
-    std::string line;
-    while (std::getline(inf, line))
-    {
-        // Split the line into words
-        std::vector<std::string> words;
-        std::istringstream iss(line);
-        std::string layerName;
-        IndexType gdsLayer = INDEX_TYPE_MAX;
-        iss >> layerName;
-        iss >> gdsLayer;
-        // Add to the database
-        _techDB.addNewLayer(gdsLayer, layerName);
-    }
-    return true;
-}
-
-bool ParseSimpleTech::parse(const std::string &filename)
-{
-    std::ifstream inf(filename.c_str());
-    if (!inf.is_open()) 
+    MappedTextFile file;
+    if (!file.open(filename)) 
     {
         ERR("Simple tech parser::%s: cannot open file: %s \n", __FUNCTION__ , filename.c_str());
         Assert(false);
         return false;
     }
-    std::string lineStr;
-    while (std::getline(inf, lineStr))
+    TextTokenizer tokenizer(file.content());
+    boost::string_view token;
+    while (tokenizer.next(token))
     {
-        std::stringstream ss(lineStr);
-        std::string token;
-        ss >> token;
         if (token == "DBU")
         {
             RealType dbu = 1000;
-            ss >> dbu;
-            auto &units = _techDB.units();
-            units.setDbu(static_cast<IntType>(dbu));
+            if (tokenizer.nextInLine(token) && TokenUtil::toReal(token, dbu))
+            {
+                _techDB.units().setDbu(static_cast<IntType>(dbu));
+            }
+            else
+            {
+                ERR("Simple tech parser::%s: syntax error at line %u. Invalid DBU \n", __FUNCTION__, tokenizer.lineNumber());
+                return false;
+            }
         }
         else if (token == "MANUFACTURINGGRID")
         {
-            RealType mgrid = 0.0001;
-            ss >> mgrid;
+            // Not used
         }
         else if (token == "LAYER")
         {
-            ss >> token;
-            if (token == "MASTERSLICE")
+            if (!tokenizer.nextInLine(token) || (token != "MASTERSLICE" && token != "ROUTING" && token != "CUT"))
             {
-                if (!parseMastersliceLayer(inf))
-                {
-                    return false;
-                }
-            }
-            else if (token == "ROUTING")
-            {
-                if (!parseRoutingLayer(inf))
-                {
-                    return false;
-                }
-            }
-            else if (token == "CUT")
-            {
-                if (!parseCutLayer(inf))
-                {
-                    return false;
-                }
+                ERR("Simple tech parser::%s: syntax error at line %u. Token %s\n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
+                return false;
             }
-            else
+            tokenizer.skipLine();
+            if (!parseLayer(tokenizer))
             {
-                ERR("Simple tech parse::%s: syntax error. Token %s\n", __FUNCTION__, token.c_str());
                 return false;
             }
+            continue;
         }
         else if (token == "VIA")
         {
-            if (!parseVia(inf))
-            {
-                return false;
-            }
+            // Vias are not used
         }
-        else
+        else if (!parseLayerLine(tokenizer, token))
         {
-            ERR("Simple tech parse::%s: syntax error. Token %s\n", __FUNCTION__, token.c_str());
             return false;
         }
+        tokenizer.skipLine();
     }
     if (!this->finish())
     {
@@ -105,157 +63,86 @@ bool ParseSimpleTech::parse(const std::string &filename)
     return true;
 }
 
-bool ParseSimpleTech::parseMastersliceLayer(std::ifstream &inf)
+bool ParseSimpleTech::parseLayerLine(TextTokenizer &tokenizer, boost::string_view name)
 {
-    std::string name;
-    IntType techLayer = 0;
-
-    std::string lineStr;
-    while (std::getline(inf, lineStr))
+    boost::string_view token;
+    IndexType techLayer = 0;
+    IndexType datatype = 0;
+    if (!tokenizer.nextInLine(token) || !TokenUtil::toIndex(token, techLayer))
     {
-        std::stringstream ss(lineStr);
-        std::string token;
-        ss >> token;
-        if (token == "ENDLAYER")
-        {
-            // Wrap up everything and return
-            _techLayers.emplace_back(name, techLayer);
-            return true;
-        }
-        else if (token == "NAME")
-        {
-            ss >> name;
-        }
-        else if (token == "TECHLAYER")
-        {
-            ss >> techLayer;
-        }
-        else
-        {
-            ERR("Simple tech parse::%s: syntax error. Token %s \n", __FUNCTION__, token.c_str());
-            return false;
-        }
+        ERR("Simple tech parser::%s: syntax error at line %u. Token %s \n", __FUNCTION__, tokenizer.lineNumber(), name.to_string().c_str());
+        return false;
     }
-    ERR("Simple tech parse::%s: syntax error. No ENDLAYER? \n", __FUNCTION__);
-    return false;
+    if (tokenizer.nextInLine(token) && !TokenUtil::toIndex(token, datatype))
+    {
+        ERR("Simple tech parser::%s: syntax error at line %u. Invalid datatype %s \n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
+        return false;
+    }
+    _techLayers.emplace_back(name.to_string(), techLayer, datatype);
+    return true;
 }
 
-bool ParseSimpleTech::parseRoutingLayer(std::ifstream &inf)
+bool ParseSimpleTech::parseLayer(TextTokenizer &tokenizer)
 {
-    IntType techLayer = 0;
-    std::string name = "";
-    bool hasDirection = false;
-    std::string direction = "";
-    RealType spacing = 0.0;
-    bool hasWidth = false;
-    RealType width = 0.0;
-
-    std::string lineStr;
-    while (std::getline(inf, lineStr))
+    boost::string_view name;
+    IndexType techLayer = 0;
+    IndexType datatype = 0;
+    boost::string_view token;
+    while (tokenizer.next(token))
     {
-        std::stringstream ss(lineStr);
-        std::string token;
-        RealType floatToken;
-        ss >> token;
         if (token == "ENDLAYER")
         {
-            _techLayers.emplace_back(name, techLayer);
+            // Wrap up everything and return
+            tokenizer.skipLine();
+            _techLayers.emplace_back(name.to_string(), techLayer, datatype);
             return true;
         }
         else if (token == "NAME")
         {
-            ss >> token;
-            name = token;
-        }
-        else if (token == "DIRECTION")
-        {
-            ss >> token;
-            hasDirection = true;
-            direction = token;
-        }
-        else if (token == "SPACING")
-        {
-            ss >> floatToken;
-            spacing = floatToken;
-        }
-        else if (token == "WIDTH")
-        {
-            ss >> floatToken;
-            hasWidth = true;
-            width = floatToken;
+            tokenizer.nextInLine(name);
         }
         else if (token == "TECHLAYER")
         {
-            ss >> techLayer;
-        }
-        else
-        {
-            ERR("Simple tech parse::%s: syntax error. Token %s \n", __FUNCTION__, token.c_str());
-            return false;
-        }
-    }
-    ERR("Simple tech parse::%s: syntax error. No ENDLAYER? \n", __FUNCTION__);
-    return false;
-}
-
-bool ParseSimpleTech::parseCutLayer(std::ifstream &inf)
-{
-    IntType techLayer = 0;
-    std::string name = "";
-    RealType spacing = 0.0;
-    std::string lineStr;
-    while (std::getline(inf, lineStr))
-    {
-        std::stringstream ss(lineStr);
-        std::string token;
-        RealType floatToken;
-        ss >> token;
-        if (token == "ENDLAYER")
-        {
-            _techLayers.emplace_back(name, techLayer);
-            return true;
-        }
-        else if (token == "NAME")
-        {
-            ss >> token;
-            name = token;
+            if (!tokenizer.nextInLine(token) || !TokenUtil::toIndex(token, techLayer))
+            {
+                ERR("Simple tech parser::%s: syntax error at line %u. Invalid TECHLAYER \n", __FUNCTION__, tokenizer.lineNumber());
+                return false;
+            }
         }
-        else if (token == "SPACING")
+        else if (token == "DATATYPE")
         {
-            // Use one spacing to overwrite all the spacing requirements
-            ss >> floatToken;
-            spacing = floatToken;
+            if (!tokenizer.nextInLine(token) || !TokenUtil::toIndex(token, datatype))
+            {
+                ERR("Simple tech parser::%s: syntax error at line %u. Invalid DATATYPE \n", __FUNCTION__, tokenizer.lineNumber());
+                return false;
+            }
         }
-        else if (token == "TECHLAYER")
+        else if (token == "DIRECTION" || token == "SPACING" || token == "WIDTH")
         {
-            ss >> techLayer;
+            // Design rules are not used
         }
         else
         {
-            ERR("Simple tech parse::%s: syntax error. Token %s \n", __FUNCTION__, token.c_str());
+            ERR("Simple tech parser::%s: syntax error at line %u. Token %s \n", __FUNCTION__, tokenizer.lineNumber(), token.to_string().c_str());
             return false;
         }
+        tokenizer.skipLine();
     }
-    ERR("Simple tech parse::%s: syntax error. No ENDLAYER? \n", __FUNCTION__);
+    ERR("Simple tech parser::%s: syntax error. No ENDLAYER? \n", __FUNCTION__);
     return false;
 }
 
-bool ParseSimpleTech::parseVia(std::ifstream &inf)
-{
-    return true;
-}
-
 bool ParseSimpleTech::finish()
 {
     // Tech layers
     auto sortLayer = [&] (const TechLayer &lhs, const TechLayer &rhs)
     {
-        return lhs.techLayer < rhs.techLayer;
+        return lhs.techLayer < rhs.techLayer || (lhs.techLayer == rhs.techLayer && lhs.datatype < rhs.datatype);
     };
-    std::sort(_techLayers.begin(), _techLayers.end(), sortLayer); // Sort by acesending layer id
+    std::sort(_techLayers.begin(), _techLayers.end(), sortLayer); // Sort by acesending (layer id, datatype)
     for (IndexType idx = 0; idx < _techLayers.size(); ++idx)
     {
-        IndexType returnIdx = _techDB.addNewLayer(_techLayers.at(idx).techLayer, _techLayers.at(idx).name);
+        IndexType returnIdx = _techDB.addNewLayer(_techLayers.at(idx).techLayer, _techLayers.at(idx).name, _techLayers.at(idx).datatype);
         Assert(returnIdx == idx);
     }
     return true;
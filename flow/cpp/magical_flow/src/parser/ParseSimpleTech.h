@@ -10,53 +10,50 @@
 
 #include "global/global.h"
 #include "db/TechDB.h"
+#include "parser/TextTokenizer.h"
 
 PROJECT_NAMESPACE_BEGIN
 
 struct TechLayer
 {
     TechLayer() = default;
-    TechLayer(const std::string &name_, IndexType techLayer_) : name(name_), techLayer(techLayer_) {}
+    TechLayer(const std::string &name_, IndexType techLayer_, IndexType datatype_ = 0) : name(name_), techLayer(techLayer_), datatype(datatype_) {}
     std::string name;
     IndexType techLayer;
+    IndexType datatype = 0; ///< The drawing datatype of the layer
 };
 
 /// @class PROJECT_NAMESPACE::ParseSimpleTech
-/// @brief parser for simple tech files
+/// @brief parser for simple tech files.
+/// Two formats are accepted, and they can be mixed in one file:
+/// 1. "NAME LAYER_ID [DATATYPE]" per line
+/// 2. The structured format with DBU, LAYER ... ENDLAYER blocks
 class ParseSimpleTech
 {
     public:
         /// @brief constructor
         /// @param first: technology database reference for the routing flow
-        /// @param second: macro databse reference for the routing flow
         explicit ParseSimpleTech(TechDB &techDB) : _techDB(techDB) {}
         /// @brief read a simple tech file
         /// @param the file name of the simple tech file
         /// @return whether the parsing is successful
-        bool parse(const std::string &filename);
-        /// @brief read a simple tech file, no idea what parse reads
+        bool parse(const std::string &filename) { return read(filename); }
+        /// @brief read a simple tech file
         /// @param the file name of the simple tech file
         /// @return whether the parsing is successful
         bool read(const std::string &filename);
     private:
         /// @brief finish up the parsing
         bool finish();
-        /// @brief parse information for a masterslice layer
-        /// @param the input file stream
-        /// @return if parsing is successful
-        bool parseMastersliceLayer(std::ifstream &inf);
-        /// @brief parse information for a routing layer
-        /// @param the input file stream
-        /// @return if the parsing is successful
-        bool parseRoutingLayer(std::ifstream &inf);
-        /// @brief parse information for a cut layer
-        /// @param the input file stream
+        /// @brief parse information for a layer block, from the line after "LAYER TYPE" to ENDLAYER
+        /// @param the tokenizer of the file
         /// @return if the parsing is successful
-        bool parseCutLayer(std::ifstream &inf);
-        /// @brief parse information for a via macro
-        /// @param the input file stream
+        bool parseLayer(TextTokenizer &tokenizer);
+        /// @brief parse a "NAME LAYER_ID [DATATYPE]" line
+        /// @param first: the tokenizer of the file
+        /// @param second: the name of the layer, which is the first token of the line
         /// @return if the parsing is successful
-        bool parseVia(std::ifstream &inf);
+        bool parseLayerLine(TextTokenizer &tokenizer, boost::string_view name);
     private:
         TechDB &_techDB; ///< Reference to the technology database
         std::vector<TechLayer> _techLayers; ///< For recording the techlayer IDs
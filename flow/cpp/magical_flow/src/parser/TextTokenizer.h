@@ -0,0 +1,269 @@
+/**
+ * @file TextTokenizer.h
+ * @brief Memory mapped file and whitespace tokenizer shared by the text parsers
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef MAGICAL_FLOW_TEXT_TOKENIZER_H_
+#define MAGICAL_FLOW_TEXT_TOKENIZER_H_
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <boost/utility/string_view.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include "global/global.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::MappedTextFile
+/// @brief A read-only text file mapped into memory
+class MappedTextFile
+{
+    public:
+        /// @brief default constructor
+        explicit MappedTextFile() = default;
+        /// @brief map a file into memory
+        /// @param the file name
+        /// @return whether the file is successfully opened. An empty file is opened with empty content
+        bool open(const std::string &filename)
+        {
+            try
+            {
+                _file.open(filename);
+            }
+            catch (const std::exception &e)
+            {
+                // Zero-length files cannot be mapped
+                std::ifstream inf(filename.c_str());
+                return inf.is_open() && inf.peek() == std::ifstream::traits_type::eof();
+            }
+            return _file.is_open();
+        }
+        /// @brief get the content of the file
+        /// @return the view of the whole file
+        boost::string_view content() const
+        {
+            if (!_file.is_open())
+            {
+                return boost::string_view();
+            }
+            return boost::string_view(_file.data(), _file.size());
+        }
+    private:
+        boost::iostreams::mapped_file_source _file; ///< The mapped file
+};
+
+/// @class MAGICAL_FLOW::TextTokenizer
+/// @brief Split a text buffer into whitespace-separated tokens without copying them.
+/// Tokens are views into the buffer, so the buffer must outlive them.
+/// Comments start with '#' and run to the end of the line. Quoted strings are single tokens.
+/// Optionally ';' is always a token of its own, as in LEF.
+class TextTokenizer
+{
+    public:
+        /// @brief constructor
+        /// @param first: the text to tokenize
+        /// @param second: whether ';' is split as a separate token
+        explicit TextTokenizer(boost::string_view text, bool splitSemicolon = false)
+            : _cur(text.data()), _end(text.data() + text.size()), _splitSemicolon(splitSemicolon) {}
+        /// @brief get the next token, crossing lines
+        /// @param the token
+        /// @return false if reaching the end of the text
+        bool next(boost::string_view &token)
+        {
+            while (true)
+            {
+                skipBlank();
+                if (_cur == _end)
+                {
+                    return false;
+                }
+                if (*_cur == '\n')
+                {
+                    ++_cur;
+                    ++_lineNum;
+                    continue;
+                }
+                return readToken(token);
+            }
+        }
+        /// @brief get the next token in the current line
+        /// @param the token
+        /// @return false if reaching the end of the line. The newline is not consumed
+        bool nextInLine(boost::string_view &token)
+        {
+            skipBlank();
+            if (_cur == _end || *_cur == '\n')
+            {
+                return false;
+            }
+            return readToken(token);
+        }
+        /// @brief skip the rest of the current line, including the newline
+        void skipLine()
+        {
+            const char *nl = static_cast<const char *>(std::memchr(_cur, '\n', _end - _cur));
+            if (nl == nullptr)
+            {
+                _cur = _end;
+                return;
+            }
+            _cur = nl + 1;
+            ++_lineNum;
+        }
+        /// @brief skip tokens until the end of the statement, including the ';'
+        /// @return false if reaching the end of the text
+        bool skipStatement()
+        {
+            boost::string_view token;
+            while (next(token))
+            {
+                if (token == ";")
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+        /// @brief get the current line number, starting from 1
+        /// @return the current line number
+        IndexType lineNumber() const { return _lineNum; }
+    private:
+        /// @brief skip spaces, tabs, carriage returns and comments, stopping at newlines
+        void skipBlank()
+        {
+            while (_cur != _end)
+            {
+                char c = *_cur;
+                if (c == ' ' || c == '\t' || c == '\r')
+                {
+                    ++_cur;
+                }
+                else if (c == '#')
+                {
+                    const char *nl = static_cast<const char *>(std::memchr(_cur, '\n', _end - _cur));
+                    _cur = nl == nullptr ? _end : nl;
+                }
+                else
+                {
+                    return;
+                }
+            }
+        }
+        /// @brief read a token starting at a non-blank character
+        /// @param the token
+        /// @return true
+        bool readToken(boost::string_view &token)
+        {
+            const char *begin = _cur;
+            if (*_cur == '"')
+            {
+                const char *close = static_cast<const char *>(std::memchr(_cur + 1, '"', _end - _cur - 1));
+                _cur = close == nullptr ? _end : close + 1;
+                token = boost::string_view(begin, _cur - begin);
+                return true;
+            }
+            if (_splitSemicolon && *_cur == ';')
+            {
+                ++_cur;
+                token = boost::string_view(begin, 1);
+                return true;
+            }
+            while (_cur != _end)
+            {
+                char c = *_cur;
+                if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || (_splitSemicolon && c == ';'))
+                {
+                    break;
+                }
+                ++_cur;
+            }
+            token = boost::string_view(begin, _cur - begin);
+            return true;
+        }
+    private:
+        const char *_cur = nullptr; ///< The current position
+        const char *_end = nullptr; ///< The end of the text
+        bool _splitSemicolon = false; ///< Whether ';' is a token by itself
+        IndexType _lineNum = 1; ///< The current line number
+};
+
+namespace TokenUtil
+{
+    /// @brief convert a token to an unsigned integer
+    /// @param first: the token
+    /// @param second: the result
+    /// @return whether the whole token is a valid number that fits in IndexType
+    inline bool toIndex(boost::string_view token, IndexType &value)
+    {
+        if (token.empty())
+        {
+            return false;
+        }
+        IndexType result = 0;
+        for (char c : token)
+        {
+            if (c < '0' || c > '9')
+            {
+                return false;
+            }
+            IndexType digit = static_cast<IndexType>(c - '0');
+            if (result > (std::numeric_limits<IndexType>::max() - digit) / 10)
+            {
+                return false;
+            }
+            result = result * 10 + digit;
+        }
+        value = result;
+        return true;
+    }
+    /// @brief convert a token to a signed integer
+    /// @param first: the token
+    /// @param second: the result
+    /// @return whether the whole token is a valid number that fits in IntType
+    inline bool toInt(boost::string_view token, IntType &value)
+    {
+        bool negative = !token.empty() && token.front() == '-';
+        if (negative || (!token.empty() && token.front() == '+'))
+        {
+            token.remove_prefix(1);
+        }
+        IndexType magnitude = 0;
+        if (!toIndex(token, magnitude) || magnitude > static_cast<IndexType>(INT_TYPE_MAX) + (negative ? 1 : 0))
+        {
+            return false;
+        }
+        value = static_cast<IntType>(negative ? -static_cast<std::int64_t>(magnitude) : static_cast<std::int64_t>(magnitude));
+        return true;
+    }
+    /// @brief convert a token to a real number
+    /// @param first: the token
+    /// @param second: the result
+    /// @return whether the whole token is a valid number
+    inline bool toReal(boost::string_view token, RealType &value)
+    {
+        // The token is not null-terminated, so copy it to a small buffer on the stack
+        char buffer[64];
+        if (token.empty() || token.size() >= sizeof(buffer))
+        {
+            return false;
+        }
+        std::memcpy(buffer, token.data(), token.size());
+        buffer[token.size()] = '\0';
+        char *end = nullptr;
+        RealType result = std::strtod(buffer, &end);
+        if (end != buffer + token.size())
+        {
+            return false;
+        }
+        value = result;
+        return true;
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //MAGICAL_FLOW_TEXT_TOKENIZER_H_
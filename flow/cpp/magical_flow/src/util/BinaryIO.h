@@ -0,0 +1,180 @@
+/**
+ * @file BinaryIO.h
+ * @brief Writer and reader of the plain binary records in the checkpoint files
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_BINARY_IO_H_
+#define ZKUTIL_BINARY_IO_H_
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+#include "util/Box.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::BinaryWriter
+/// @brief Write trivially copyable values, strings and arrays to a stream in the native byte order.
+/// The arrays and strings are prefixed by their sizes
+class BinaryWriter
+{
+    public:
+        /// @brief constructor
+        /// @param the stream to write. It must be opened in binary mode
+        explicit BinaryWriter(std::ostream &out) : _out(out) {}
+        /// @brief write a value
+        /// @param the value
+        template<typename T>
+        void write(const T &val)
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "BinaryWriter: only trivially copyable values are written directly");
+            _out.write(reinterpret_cast<const char *>(&val), sizeof(T));
+        }
+        /// @brief write raw bytes
+        /// @param first: the bytes
+        /// @param second: the number of bytes
+        void writeBytes(const char *data, std::size_t size) { _out.write(data, size); }
+        /// @brief write a string
+        /// @param the string
+        void writeString(const std::string &str)
+        {
+            write<std::uint32_t>(str.size());
+            _out.write(str.data(), str.size());
+        }
+        /// @brief write an array of trivially copyable values
+        /// @param the array. Anything with data() and size()
+        template<typename ArrayType>
+        void writeArray(const ArrayType &arr)
+        {
+            typedef typename std::decay<decltype(*arr.data())>::type ValueType;
+            static_assert(std::is_trivially_copyable<ValueType>::value, "BinaryWriter: only arrays of trivially copyable values are written directly");
+            write<std::uint32_t>(arr.size());
+            _out.write(reinterpret_cast<const char *>(arr.data()), sizeof(ValueType) * arr.size());
+        }
+        /// @brief write a box as its four coordinates
+        /// @param the box
+        template<typename T>
+        void writeBox(const Box<T> &box)
+        {
+            write<T>(box.xLo());
+            write<T>(box.yLo());
+            write<T>(box.xHi());
+            write<T>(box.yHi());
+        }
+        /// @brief get the position in the stream
+        /// @return the number of bytes from the beginning of the stream
+        std::uint64_t pos() { return static_cast<std::uint64_t>(_out.tellp()); }
+        /// @brief whether all the writes succeeded
+        /// @return false if the stream failed
+        bool good() const { return _out.good(); }
+    private:
+        std::ostream &_out; ///< The output stream
+};
+
+/// @class MAGICAL_FLOW::BinaryReader
+/// @brief Read the records of BinaryWriter from a buffer. Reading past the end throws std::runtime_error.
+/// The symbols are translated to the running symbol table through a map set by the owner
+class BinaryReader
+{
+    public:
+        /// @brief constructor
+        /// @param first: the beginning of the buffer
+        /// @param second: the size of the buffer
+        explicit BinaryReader(const char *data, std::size_t size) : _begin(data), _cur(data), _end(data + size) {}
+        /// @brief read a value
+        /// @return the value
+        template<typename T>
+        T read()
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "BinaryReader: only trivially copyable values are read directly");
+            T val;
+            std::memcpy(&val, take(sizeof(T)), sizeof(T));
+            return val;
+        }
+        /// @brief read a string
+        /// @return the string
+        std::string readString()
+        {
+            std::uint32_t size = read<std::uint32_t>();
+            return std::string(take(size), size);
+        }
+        /// @brief read an array of trivially copyable values
+        /// @param the array to fill. Anything with resize(), data() and size()
+        template<typename ArrayType>
+        void readArray(ArrayType &arr)
+        {
+            typedef typename std::decay<decltype(*arr.data())>::type ValueType;
+            std::uint32_t size = read<std::uint32_t>();
+            const char *src = take(sizeof(ValueType) * size);
+            arr.resize(size);
+            if (size > 0)
+            {
+                std::memcpy(static_cast<void *>(arr.data()), src, sizeof(ValueType) * size);
+            }
+        }
+        /// @brief read a box written by BinaryWriter::writeBox()
+        /// @return the box
+        template<typename T>
+        Box<T> readBox()
+        {
+            T xLo = read<T>();
+            T yLo = read<T>();
+            T xHi = read<T>();
+            T yHi = read<T>();
+            return Box<T>(xLo, yLo, xHi, yHi);
+        }
+        /// @brief read a symbol written as its id in the saved symbol table
+        /// @return the symbol in the running symbol table
+        IndexType readSymbol()
+        {
+            std::uint32_t id = read<std::uint32_t>();
+            if (id >= _symbolMap.size())
+            {
+                throw std::runtime_error("BinaryReader: invalid symbol " + std::to_string(id));
+            }
+            return _symbolMap[id];
+        }
+        /// @brief set the translation of the saved symbols
+        /// @param symbolMap[saved id] = the symbol in the running table
+        void setSymbolMap(std::vector<IndexType> symbolMap) { _symbolMap = std::move(symbolMap); }
+        /// @brief skip bytes
+        /// @param the number of bytes
+        void skip(std::size_t size) { take(size); }
+        /// @brief get the position in the buffer
+        /// @return the number of bytes read
+        std::size_t pos() const { return _cur - _begin; }
+        /// @brief get the number of bytes left
+        /// @return the number of bytes after the position
+        std::size_t remaining() const { return _end - _cur; }
+    private:
+        /// @brief consume bytes
+        /// @param the number of bytes
+        /// @return the beginning of the consumed bytes
+        const char * take(std::size_t size)
+        {
+            if (size > remaining())
+            {
+                throw std::runtime_error("BinaryReader: unexpected end of data");
+            }
+            const char *data = _cur;
+            _cur += size;
+            return data;
+        }
+    private:
+        const char *_begin; ///< The beginning of the buffer
+        const char *_cur; ///< The next byte to read
+        const char *_end; ///< The end of the buffer
+        std::vector<IndexType> _symbolMap; ///< _symbolMap[saved id] = the symbol in the running table
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_BINARY_IO_H_
@@ -0,0 +1,84 @@
+/**
+ * @file Hash.h
+ * @brief Deterministic 64-bit hashing helpers
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_HASH_H_
+#define ZKUTIL_HASH_H_
+
+#include <fstream>
+#include <string>
+#include "global/namespace.h"
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The hashes do not depend on the standard library or the process, so they can be compared across runs
+namespace HashUtil
+{
+    /// @brief mix a 64-bit value so that nearby inputs spread over all the bits (splitmix64 finalizer)
+    /// @param the value
+    /// @return the mixed value
+    inline HashType mix(HashType x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+    /// @brief combine a value into a running hash. The order of the combined values matters
+    /// @param first: the running hash
+    /// @param second: the value to combine
+    /// @return the new running hash
+    inline HashType combine(HashType seed, HashType value)
+    {
+        return mix(seed ^ (mix(value) + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+    /// @brief hash bytes (FNV-1a)
+    /// @param first: the bytes
+    /// @param second: the number of bytes
+    /// @param third: the hash of the bytes before them, to hash a sequence of chunks
+    /// @return the hash of the bytes
+    inline HashType hashBytes(const char *data, std::size_t size, HashType hash = 0xcbf29ce484222325ULL)
+    {
+        for (std::size_t idx = 0; idx < size; ++idx)
+        {
+            hash ^= static_cast<unsigned char>(data[idx]);
+            hash *= 0x100000001b3ULL;
+        }
+        return hash;
+    }
+    /// @brief hash a string (FNV-1a)
+    /// @param the string
+    /// @return the hash of the string
+    inline HashType hashString(const std::string &str)
+    {
+        return hashBytes(str.data(), str.size());
+    }
+    /// @brief hash the contents of a file
+    /// @param the file name
+    /// @return the hash of the contents. 0 if the file cannot be read
+    inline HashType hashFile(const std::string &filename)
+    {
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open())
+        {
+            return 0;
+        }
+        HashType hash = 0xcbf29ce484222325ULL;
+        char buffer[1 << 16];
+        while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0)
+        {
+            hash = hashBytes(buffer, file.gcount(), hash);
+        }
+        return mix(hash);
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_HASH_H_
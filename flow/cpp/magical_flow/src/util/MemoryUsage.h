@@ -0,0 +1,67 @@
+/**
+ * @file MemoryUsage.h
+ * @brief Helpers to count the heap memory held by containers
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_MEMORY_USAGE_H_
+#define ZKUTIL_MEMORY_USAGE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+#include "util/SmallVector.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @brief The bytes are the allocated capacity, not the size. The elements themselves are counted by the caller when they own heap memory
+namespace MemUtil
+{
+    /// @brief get the heap bytes of a vector
+    /// @param the vector
+    /// @return the bytes of the capacity
+    template<typename T>
+    inline std::uint64_t vectorBytes(const std::vector<T> &vec)
+    {
+        return static_cast<std::uint64_t>(vec.capacity()) * sizeof(T);
+    }
+
+    /// @brief get the heap bytes of a small vector
+    /// @param the small vector
+    /// @return the bytes of the capacity. 0 while the elements are inline
+    template<typename T, IndexType N>
+    inline std::uint64_t smallVectorBytes(const SmallVector<T, N> &vec)
+    {
+        return vec.isHeap() ? static_cast<std::uint64_t>(vec.capacity()) * sizeof(T) : 0;
+    }
+
+    /// @brief get the heap bytes of a string
+    /// @param the string
+    /// @return the bytes of the capacity and the terminator. 0 if the string is short enough to be stored in place
+    inline std::uint64_t stringBytes(const std::string &str)
+    {
+        const char *begin = reinterpret_cast<const char *>(&str);
+        bool isInPlace = str.data() >= begin && str.data() < begin + sizeof(std::string);
+        return isInPlace ? 0 : static_cast<std::uint64_t>(str.capacity()) + 1;
+    }
+
+    /// @brief get the heap bytes of an unordered map, with one node per element and one pointer per bucket as in libstdc++
+    /// @param the map
+    /// @return the bytes of the nodes and the buckets. The heap memory owned by the keys and values is not included
+    template<typename K, typename V, typename H, typename E, typename A>
+    inline std::uint64_t unorderedMapBytes(const std::unordered_map<K, V, H, E, A> &map)
+    {
+        // A node holds the next pointer, the element and the cached hash
+        std::uint64_t nodeBytes = sizeof(void *) + sizeof(std::pair<const K, V>) + sizeof(std::size_t);
+        return map.size() * nodeBytes + map.bucket_count() * sizeof(void *);
+    }
+}
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_MEMORY_USAGE_H_
@@ -0,0 +1,272 @@
+/**
+ * @file SmallVector.h
+ * @brief A vector that keeps its first elements inline
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_SMALL_VECTOR_H_
+#define ZKUTIL_SMALL_VECTOR_H_
+
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::SmallVector
+/// @brief A vector with room for N elements inside the object. It only allocates when it grows beyond N.
+/// The inline room shares the space of the heap pointer, so a SmallVector<IndexType, 4> is as large as a std::vector.
+/// Moving a vector with inline elements moves the elements, so pointers into it do not survive a move
+template<typename T, IndexType N>
+class SmallVector
+{
+    static_assert(N > 0, "SmallVector: the inline capacity must be positive");
+    public:
+        typedef T               value_type;
+        typedef T *             iterator;
+        typedef const T *       const_iterator;
+        typedef T &             reference;
+        typedef const T &       const_reference;
+        typedef IndexType       size_type;
+
+        /// @brief default constructor, an empty vector
+        SmallVector() = default;
+        /// @brief constructor
+        /// @param the number of default elements
+        explicit SmallVector(IndexType size) { resize(size); }
+        /// @brief constructor
+        /// @param the elements
+        SmallVector(std::initializer_list<T> init) { assign(init.begin(), init.end()); }
+        /// @brief copy constructor
+        SmallVector(const SmallVector &other) { assign(other.begin(), other.end()); }
+        /// @brief move constructor
+        SmallVector(SmallVector &&other) noexcept { moveFrom(other); }
+        /// @brief destructor
+        ~SmallVector() { clear(); release(); }
+        /// @brief copy assignment
+        SmallVector & operator=(const SmallVector &other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+        /// @brief move assignment
+        SmallVector & operator=(SmallVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                release();
+                moveFrom(other);
+            }
+            return *this;
+        }
+        /*------------------------------*/
+        /* Getters                      */
+        /*------------------------------*/
+        /// @brief get the number of elements
+        /// @return the number of elements
+        IndexType size() const { return _size; }
+        /// @brief whether the vector is empty
+        /// @return true if there is no element
+        bool empty() const { return _size == 0; }
+        /// @brief get the number of elements that fit without allocating
+        /// @return the capacity
+        IndexType capacity() const { return _capacity; }
+        /// @brief whether the elements are on the heap
+        /// @return true if the vector has grown beyond the inline capacity
+        bool isHeap() const { return _capacity > N; }
+        /// @brief get the pointer to the first element
+        T * data() { return isHeap() ? _heap : inlineData(); }
+        /// @brief get the pointer to the first element
+        const T * data() const { return isHeap() ? _heap : inlineData(); }
+        T & operator[](IndexType idx) { return data()[idx]; }
+        const T & operator[](IndexType idx) const { return data()[idx]; }
+        /// @brief get an element with range check
+        /// @param the index of the element
+        /// @return the element
+        T & at(IndexType idx) { checkRange(idx); return data()[idx]; }
+        const T & at(IndexType idx) const { checkRange(idx); return data()[idx]; }
+        T & front() { return data()[0]; }
+        const T & front() const { return data()[0]; }
+        T & back() { return data()[_size - 1]; }
+        const T & back() const { return data()[_size - 1]; }
+        iterator begin() { return data(); }
+        iterator end() { return data() + _size; }
+        const_iterator begin() const { return data(); }
+        const_iterator end() const { return data() + _size; }
+        /*------------------------------*/
+        /* Vector operation             */
+        /*------------------------------*/
+        /// @brief make room for a number of elements
+        /// @param the number of elements
+        void reserve(IndexType capacity)
+        {
+            if (capacity <= _capacity)
+            {
+                return;
+            }
+            T *heap = static_cast<T *>(::operator new(sizeof(T) * capacity));
+            T *old = data();
+            for (IndexType idx = 0; idx < _size; ++idx)
+            {
+                new (heap + idx) T(std::move(old[idx]));
+                old[idx].~T();
+            }
+            release();
+            _heap = heap;
+            _capacity = capacity;
+        }
+        /// @brief append an element
+        /// @param the element
+        void push_back(const T &val) { emplace_back(val); }
+        /// @brief append an element
+        /// @param the element
+        void push_back(T &&val) { emplace_back(std::move(val)); }
+        /// @brief construct an element at the end
+        /// @param the arguments of the constructor
+        /// @return the new element
+        template<typename... Args>
+        T & emplace_back(Args&&... args)
+        {
+            if (_size == _capacity)
+            {
+                // Construct first in case the arguments refer to an element
+                T val(std::forward<Args>(args)...);
+                reserve(_capacity * 2);
+                return *new (data() + _size++) T(std::move(val));
+            }
+            return *new (data() + _size++) T(std::forward<Args>(args)...);
+        }
+        /// @brief remove the last element
+        void pop_back() { data()[--_size].~T(); }
+        /// @brief change the number of elements. New elements are default
+        /// @param the number of elements
+        void resize(IndexType size) { resize(size, T()); }
+        /// @brief change the number of elements
+        /// @param first: the number of elements
+        /// @param second: the value of the new elements
+        void resize(IndexType size, const T &val)
+        {
+            while (_size > size)
+            {
+                pop_back();
+            }
+            reserve(size);
+            while (_size < size)
+            {
+                new (data() + _size++) T(val);
+            }
+        }
+        /// @brief remove all the elements. The capacity is kept
+        void clear()
+        {
+            while (_size > 0)
+            {
+                pop_back();
+            }
+        }
+        /// @brief remove an element
+        /// @param the position of the element
+        /// @return the position after the removed element
+        iterator erase(const_iterator pos)
+        {
+            iterator it = begin() + (pos - begin());
+            std::move(it + 1, end(), it);
+            pop_back();
+            return it;
+        }
+        /// @brief replace the elements with a range
+        /// @param first: the begin of the range
+        /// @param second: the end of the range
+        template<typename InputIt>
+        void assign(InputIt first, InputIt last)
+        {
+            clear();
+            reserve(static_cast<IndexType>(std::distance(first, last)));
+            for (; first != last; ++first)
+            {
+                new (data() + _size++) T(*first);
+            }
+        }
+        /// @brief convert to a std::vector
+        /// @return the copy of the elements
+        std::vector<T> toVector() const { return std::vector<T>(begin(), end()); }
+    private:
+        T * inlineData() { return reinterpret_cast<T *>(&_inline); }
+        const T * inlineData() const { return reinterpret_cast<const T *>(&_inline); }
+        void checkRange(IndexType idx) const
+        {
+            if (idx >= _size)
+            {
+                throw std::out_of_range("SmallVector: index out of range");
+            }
+        }
+        /// @brief free the heap storage and go back to the inline room. The elements must be destroyed
+        void release()
+        {
+            if (isHeap())
+            {
+                ::operator delete(_heap);
+            }
+            _capacity = N;
+        }
+        /// @brief take the elements of a vector, leaving it empty. This vector must be empty and inline
+        void moveFrom(SmallVector &other)
+        {
+            if (other.isHeap())
+            {
+                _heap = other._heap;
+                _size = other._size;
+                _capacity = other._capacity;
+                other._size = 0;
+                other._capacity = N;
+                return;
+            }
+            for (IndexType idx = 0; idx < other._size; ++idx)
+            {
+                new (inlineData() + idx) T(std::move(other.inlineData()[idx]));
+            }
+            _size = other._size;
+            other.clear();
+        }
+    private:
+        IndexType _size = 0; ///< The number of elements
+        IndexType _capacity = N; ///< The number of elements that fit. Beyond N the elements are on the heap
+        union
+        {
+            T *_heap; ///< The elements when on the heap
+            typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _inline; ///< The elements when inline
+        };
+};
+
+template<typename T, IndexType N>
+inline bool operator==(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename T, IndexType N>
+inline bool operator!=(const SmallVector<T, N> &lhs, const SmallVector<T, N> &rhs) { return !(lhs == rhs); }
+
+template<typename T, IndexType N>
+inline bool operator==(const SmallVector<T, N> &lhs, const std::vector<T> &rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template<typename T, IndexType N>
+inline bool operator==(const std::vector<T> &lhs, const SmallVector<T, N> &rhs) { return rhs == lhs; }
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_SMALL_VECTOR_H_
@@ -0,0 +1,80 @@
+/**
+ * @file Span.h
+ * @brief A non-owning view of a contiguous array
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_SPAN_H_
+#define ZKUTIL_SPAN_H_
+
+#include <vector>
+#include <cstdint>
+#include "global/namespace.h"
+#include "global/type.h"
+#include "util/Assert.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::Span
+/// @brief A pointer and a size over contiguous elements owned by someone else.
+/// The span is invalidated when the owner reallocates
+template<typename T>
+class Span
+{
+    public:
+        typedef T           value_type;
+        typedef T *         iterator;
+        typedef T *         const_iterator;
+
+        /// @brief default constructor, an empty span
+        Span() = default;
+        /// @brief constructor
+        /// @param first: the pointer to the first element
+        /// @param second: the number of elements
+        Span(T *data, IndexType size) : _data(data), _size(size) {}
+        /// @brief construct from a vector
+        /// @param the vector
+        template<typename U>
+        Span(std::vector<U> &vec) : _data(vec.data()), _size(static_cast<IndexType>(vec.size())) {}
+        /// @brief construct from a const vector
+        /// @param the vector
+        template<typename U>
+        Span(const std::vector<U> &vec) : _data(vec.data()), _size(static_cast<IndexType>(vec.size())) {}
+
+        /// @brief get the number of elements
+        /// @return the number of elements
+        IndexType size() const { return _size; }
+        /// @brief whether the span is empty
+        /// @return true if the span is empty
+        bool empty() const { return _size == 0; }
+        /// @brief get the pointer to the first element
+        /// @return the pointer to the first element
+        T * data() const { return _data; }
+        /// @brief get an element without range check
+        /// @param the index of the element
+        /// @return the element
+        T & operator[](IndexType idx) const { return _data[idx]; }
+        /// @brief get an element with range check
+        /// @param the index of the element
+        /// @return the element
+        T & at(IndexType idx) const { AssertMsg(idx < _size, "Span: index %u out of range %u \n", idx, _size); return _data[idx]; }
+        /// @brief get the first element
+        /// @return the first element
+        T & front() const { return _data[0]; }
+        /// @brief get the last element
+        /// @return the last element
+        T & back() const { return _data[_size - 1]; }
+        /// @brief begin iterator
+        iterator begin() const { return _data; }
+        /// @brief end iterator
+        iterator end() const { return _data + _size; }
+
+    private:
+        T *_data = nullptr; ///< The first element
+        IndexType _size = 0; ///< The number of elements
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_SPAN_H_
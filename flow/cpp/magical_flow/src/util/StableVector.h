@@ -0,0 +1,218 @@
+/**
+ * @file StableVector.h
+ * @brief A vector whose elements never move
+ * @author agent
+ * @date 10/19/2026
+ */
+
+#ifndef ZKUTIL_STABLE_VECTOR_H_
+#define ZKUTIL_STABLE_VECTOR_H_
+
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+#include "global/namespace.h"
+#include "global/type.h"
+
+PROJECT_NAMESPACE_BEGIN
+
+/// @class MAGICAL_FLOW::StableVector
+/// @brief A vector stored in fixed-size chunks. Appending allocates a new chunk when the last one is full and never moves
+/// the existing elements, so references to them stay valid until the elements are removed.
+/// Nothing is reserved upfront: the memory is at most one chunk more than the elements
+template<typename T, IndexType ChunkSize = 64>
+class StableVector
+{
+    static_assert(ChunkSize > 0, "StableVector: the chunk size must be positive");
+    template<typename Owner, typename Value>
+    class Iterator
+    {
+        public:
+            typedef std::random_access_iterator_tag iterator_category;
+            typedef Value                           value_type;
+            typedef std::ptrdiff_t                  difference_type;
+            typedef Value *                         pointer;
+            typedef Value &                         reference;
+
+            Iterator(Owner *owner, IndexType idx) : _owner(owner), _idx(idx) {}
+            Value & operator*() const { return (*_owner)[_idx]; }
+            Value * operator->() const { return &(*_owner)[_idx]; }
+            Value & operator[](difference_type n) const { return (*_owner)[_idx + n]; }
+            Iterator & operator++() { ++_idx; return *this; }
+            Iterator operator++(int) { Iterator it = *this; ++_idx; return it; }
+            Iterator & operator--() { --_idx; return *this; }
+            Iterator operator--(int) { Iterator it = *this; --_idx; return it; }
+            Iterator & operator+=(difference_type n) { _idx += n; return *this; }
+            Iterator & operator-=(difference_type n) { _idx -= n; return *this; }
+            Iterator operator+(difference_type n) const { return Iterator(_owner, _idx + n); }
+            Iterator operator-(difference_type n) const { return Iterator(_owner, _idx - n); }
+            difference_type operator-(const Iterator &rhs) const { return static_cast<difference_type>(_idx) - rhs._idx; }
+            bool operator==(const Iterator &rhs) const { return _idx == rhs._idx; }
+            bool operator!=(const Iterator &rhs) const { return _idx != rhs._idx; }
+            bool operator<(const Iterator &rhs) const { return _idx < rhs._idx; }
+        private:
+            Owner *_owner;
+            IndexType _idx;
+    };
+    public:
+        typedef T                                               value_type;
+        typedef Iterator<StableVector, T>                       iterator;
+        typedef Iterator<const StableVector, const T>           const_iterator;
+
+        /// @brief default constructor, an empty vector without any chunk
+        StableVector() = default;
+        /// @brief copy constructor
+        StableVector(const StableVector &other)
+        {
+            for (const T &val : other)
+            {
+                emplace_back(val);
+            }
+        }
+        /// @brief move constructor. The chunks are taken over, so the references stay valid
+        StableVector(StableVector &&other) noexcept : _chunks(std::move(other._chunks)), _size(other._size) { other._size = 0; }
+        /// @brief destructor
+        ~StableVector() { clear(); }
+        /// @brief copy assignment
+        StableVector & operator=(const StableVector &other)
+        {
+            if (this != &other)
+            {
+                StableVector copy(other);
+                swap(copy);
+            }
+            return *this;
+        }
+        /// @brief move assignment
+        StableVector & operator=(StableVector &&other) noexcept
+        {
+            if (this != &other)
+            {
+                clear();
+                swap(other);
+            }
+            return *this;
+        }
+        /// @brief swap the contents with another vector
+        void swap(StableVector &other) noexcept
+        {
+            _chunks.swap(other._chunks);
+            std::swap(_size, other._size);
+        }
+        /*------------------------------*/
+        /* Getters                      */
+        /*------------------------------*/
+        /// @brief get the number of elements
+        /// @return the number of elements
+        IndexType size() const { return _size; }
+        /// @brief whether the vector is empty
+        /// @return true if there is no element
+        bool empty() const { return _size == 0; }
+        /// @brief get the number of elements that fit in the allocated chunks
+        /// @return the capacity
+        IndexType capacity() const { return _chunks.size() * ChunkSize; }
+        T & operator[](IndexType idx) { return *slot(idx); }
+        const T & operator[](IndexType idx) const { return *slot(idx); }
+        /// @brief get an element with range check
+        /// @param the index of the element
+        /// @return the element
+        T & at(IndexType idx) { checkRange(idx); return (*this)[idx]; }
+        const T & at(IndexType idx) const { checkRange(idx); return (*this)[idx]; }
+        T & front() { return (*this)[0]; }
+        const T & front() const { return (*this)[0]; }
+        T & back() { return (*this)[_size - 1]; }
+        const T & back() const { return (*this)[_size - 1]; }
+        iterator begin() { return iterator(this, 0); }
+        iterator end() { return iterator(this, _size); }
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, _size); }
+        /*------------------------------*/
+        /* Vector operation             */
+        /*------------------------------*/
+        /// @brief construct an element at the end
+        /// @param the arguments of the constructor
+        /// @return the new element
+        template<typename... Args>
+        T & emplace_back(Args&&... args)
+        {
+            bool newChunk = _size == capacity();
+            if (newChunk)
+            {
+                _chunks.emplace_back(static_cast<T *>(::operator new(sizeof(T) * ChunkSize)));
+            }
+            try
+            {
+                new (slot(_size)) T(std::forward<Args>(args)...);
+            }
+            catch (...)
+            {
+                if (newChunk)
+                {
+                    _chunks.pop_back();
+                }
+                throw;
+            }
+            return *slot(_size++);
+        }
+        /// @brief append an element
+        /// @param the element
+        void push_back(const T &val) { emplace_back(val); }
+        /// @brief append an element
+        /// @param the element
+        void push_back(T &&val) { emplace_back(std::move(val)); }
+        /// @brief remove the last element. The chunk is released when it becomes empty
+        void pop_back()
+        {
+            --_size;
+            (*this)[_size].~T();
+            if (_size % ChunkSize == 0)
+            {
+                _chunks.pop_back();
+            }
+        }
+        /// @brief change the number of elements. New elements are default constructed
+        /// @param the number of elements
+        void resize(IndexType size)
+        {
+            while (_size > size)
+            {
+                pop_back();
+            }
+            while (_size < size)
+            {
+                emplace_back();
+            }
+        }
+        /// @brief remove all the elements and release the chunks
+        void clear()
+        {
+            while (_size > 0)
+            {
+                pop_back();
+            }
+        }
+    private:
+        /// @brief frees a chunk without destroying the elements. They are destroyed one by one in pop_back()
+        struct ChunkDeleter
+        {
+            void operator()(T *chunk) const { ::operator delete(chunk); }
+        };
+        T * slot(IndexType idx) const { return _chunks[idx / ChunkSize].get() + idx % ChunkSize; }
+        void checkRange(IndexType idx) const
+        {
+            if (idx >= _size)
+            {
+                throw std::out_of_range("StableVector: index out of range");
+            }
+        }
+    private:
+        std::vector<std::unique_ptr<T, ChunkDeleter>> _chunks; ///< The chunks of ChunkSize elements. Only the last one is partly filled
+        IndexType _size = 0; ///< The number of elements
+};
+
+PROJECT_NAMESPACE_END
+
+#endif //ZKUTIL_STABLE_VECTOR_H_
@@ -10,6 +10,7 @@
 
 #include "db/DesignDB.h"
 #include "db/TechDB.h"
+#include "db/ArtifactStore.h"
 #include "util/GdsHelper.h"
 
 PROJECT_NAMESPACE_BEGIN
@@ -27,6 +28,9 @@ class GdsWriter
         /// @param first: the index of circuit graph        电路图索引
         /// @param second: the output file name         输出文件名
         void writeGdsLayout(IndexType cktIdx, const std::string &filename);
+        /// @brief write the files through an artifact store
+        /// @param the store. nullptr to write the files directly
+        void setArtifactStore(ArtifactStore *store) { _store = store; }
     private:
         /// @brief add CktGraph to the gds DB       将CktGraph添加到gds数据库 
         /// @param the index of CktGraph        CktGraph索引
@@ -36,7 +40,7 @@ class GdsWriter
         /// @param rectangle
         /// @param db layer
         /// @param datatype
-        void addRect2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const Box<LocType> &rect, IndexType dbLayer, IntType datatype);
+        void addRect2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const Box<LocType> &rect, IndexType dbLayer, IndexType datatype);
         /// @brief add text to the cell     向单元格添加文本
         /// @param reference to the cell    引用单元格
         /// @param coordinate of the text   文本坐标
@@ -46,7 +50,7 @@ class GdsWriter
         /// @brief add a cellreference to a gdscell     为晶体管单元添加单元引用
         /// @param the reference to the gdscell     对晶体管单元的引用
         /// @param the CktNode want to add      添加电流节点
-        void addCellRef2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, CktNode &node);
+        void addCellRef2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const CktNode &node);
         /// @brief add text to the cell     向单元格添加文本
         /// @brief convert XY type to point_type        将XY类型转换为point_type
         point_type convertXY(const XY<LocType> &pt)
@@ -57,6 +61,7 @@ class GdsWriter
         ::GdsParser::GdsDB::GdsDB _gdsDB; ///< The database for the GDS     GDS的数据库     
         DesignDB &_designDB; ///< The design database       设计数据库
         TechDB &_techDB; ///< The technology database       技术数据库
+        ArtifactStore *_store = nullptr; ///< The artifact store of the written files. nullptr if not used
 };
 
 inline void GdsWriter::writeGdsLayout(IndexType cktIdx, const string &filename)
@@ -71,8 +76,18 @@ inline void GdsWriter::writeGdsLayout(IndexType cktIdx, const string &filename)
     this->addCktGraph(cktIdx);
 
     // Write out        
+    // With a store, the file may be a link to a stored object. Write aside and let the store take it
+    std::string written = _store ? filename + ".tmp" : filename;
     ::GdsParser::GdsDB::GdsWriter gw (_gdsDB);
-    gw(filename.c_str());
+    gw(written.c_str());
+    if (_store && !_store->commit(_designDB.subCkt(cktIdx).name(), written, filename))
+    {
+        // The store leaves the written file on failure. Keep it as the output without the store
+        if (std::rename(written.c_str(), filename.c_str()) != 0)
+        {
+            ERR("Flow::GdsWriter:: cannot rename %s to %s \n", written.c_str(), filename.c_str());
+        }
+    }
     INF("Flow::GdsWriter:: Write circuit %s layout to %s \n", _designDB.subCkt(cktIdx).name().c_str(), filename.c_str());
 }
 
@@ -90,23 +105,31 @@ inline void GdsWriter::addCktGraph(IndexType cktGraphIdx)
     auto &gdsCell = _gdsDB.addCell(cktGraph.name()); // GdsCell     晶体管单元
     
     // Add layout       添加布局
-    auto cktLayout = cktGraph.layout(); // Layout
-    for (IndexType layerIdx = 0; layerIdx < cktLayout.numLayers(); ++layerIdx)
+    // Read a shared layout in place, so that writing does not copy it
+    const Layout *cktLayout = &cktGraph.layoutSource(); // Layout
+    Layout mirrored(0);
+    if (cktGraph.layoutSourceFlipVert())
     {
-        for (IndexType rectIdx = 0; rectIdx < cktLayout.numRects(layerIdx); ++rectIdx)
+        mirrored = *cktLayout;
+        mirrored.flipVert();
+        cktLayout = &mirrored;
+    }
+    for (IndexType layerIdx = 0; layerIdx < cktLayout->numLayers(); ++layerIdx)
+    {
+        for (IndexType rectIdx = 0; rectIdx < cktLayout->numRects(layerIdx); ++rectIdx)
         {
-            this->addRect2Cell(gdsCell, cktLayout.rect(layerIdx, rectIdx).rect(), layerIdx, cktLayout.rect(layerIdx, rectIdx).datatype()); // FIXME For >M6 layer, need to use datatype=40
+            this->addRect2Cell(gdsCell, cktLayout->rect(layerIdx, rectIdx).rect(), layerIdx, cktLayout->rect(layerIdx, rectIdx).datatype());
         }
-        for (IndexType textIdx = 0; textIdx < cktLayout.numTexts(layerIdx); ++textIdx)
+        for (IndexType textIdx = 0; textIdx < cktLayout->numTexts(layerIdx); ++textIdx)
         {
-            this->addText2Cell(gdsCell, cktLayout.text(layerIdx, textIdx).coord(), layerIdx, cktLayout.text(layerIdx, textIdx).text());
+            this->addText2Cell(gdsCell, cktLayout->text(layerIdx, textIdx).coord(), layerIdx, cktLayout->text(layerIdx, textIdx).text());
         }
     }
 
     // Add cell reference       添加单元格引用
     for (IndexType nodeIdx = 0; nodeIdx < cktGraph.numNodes(); ++nodeIdx)
     {
-        auto & node = cktGraph.node(nodeIdx);
+        auto node = cktGraph.node(nodeIdx);
         if (node.isLeaf())
         {
             continue;
@@ -117,9 +140,10 @@ inline void GdsWriter::addCktGraph(IndexType cktGraphIdx)
     }
 }
 
-inline void GdsWriter::addRect2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const Box<LocType> &rect, IndexType dbLayer, IntType datatype)
+inline void GdsWriter::addRect2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const Box<LocType> &rect, IndexType dbLayer, IndexType datatype)
 {
     IntType pdkLayer = static_cast<IntType>(_techDB.dbLayerToPdk(dbLayer));
+    IntType pdkDatatype = static_cast<IntType>(_techDB.dbLayerToPdkDatatype(dbLayer, datatype));
     std::vector<point_type> pts;
     pts.emplace_back(this->convertXY(XY<LocType>(rect.xLo(), rect.yLo())));
     pts.emplace_back(this->convertXY(XY<LocType>(rect.xLo(), rect.yHi())));
@@ -128,7 +152,7 @@ inline void GdsWriter::addRect2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const
     pts.emplace_back(this->convertXY(XY<LocType>(rect.xLo(), rect.yLo())));
 
     // Add to the cells     添加到单元
-    gdsCell.addPolygon(pdkLayer, datatype, pts);
+    gdsCell.addPolygon(pdkLayer, pdkDatatype, pts);
 
 }
 
@@ -139,7 +163,7 @@ inline void GdsWriter::addText2Cell(::GdsParser::GdsDB::GdsCell &gdsCell, const
     gdsCell.addText(pdkLayer, std::numeric_limits<int>::max(), 0, str, convertXY(coord), std::numeric_limits<int>::max(), 5, 0, 0.2, 0);
 }
 
-inline void GdsWriter::addCellRef2Cell(GdsParser::GdsDB::GdsCell &gdsCell, CktNode &node)
+inline void GdsWriter::addCellRef2Cell(GdsParser::GdsDB::GdsCell &gdsCell, const CktNode &node)
 {
     double angle = 0; 
     bool flip = false;          // flip 翻转
@@ -180,6 +204,18 @@ namespace WRITER
     {
         GdsWriter(designDB, techDB).writeGdsLayout(cktIdx, filename);
     }
+    /// @brief write the layout for circuit to GDSII through an artifact store
+    /// @param first: circuit graph index
+    /// @param second: output file name
+    /// @param third: design database
+    /// @param fourth: technology database
+    /// @param fifth: the artifact store
+    inline void writeGdsLayout(IndexType cktIdx, const std::string &filename, DesignDB &designDB, TechDB &techDB, ArtifactStore &store)
+    {
+        GdsWriter writer(designDB, techDB);
+        writer.setArtifactStore(&store);
+        writer.writeGdsLayout(cktIdx, filename);
+    }
 }
 PROJECT_NAMESPACE_END
 #endif //MAGICAL_FLOW_GDS_WRITER_H_
@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+#include "csflow/CSFlow.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class CSFlowTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                /*
+                 * ckt 0: pch, ckt 1: nch. Device pins are (d, g, s)
+                 * ckt 2: two parallel pch P0, P1 from vdd to out, and two nch branches from out to gnd:
+                 * N0 (out -> mid) in series with N1 (mid -> gnd), and N2 (out -> gnd)
+                 * Net 0: vdd, net 1: out, net 2: mid, net 3: gnd, net 4: in
+                 */
+                for (IndexType cktIdx = 0; cktIdx < 3; ++cktIdx)
+                {
+                    _db.allocateCkt();
+                }
+                for (IndexType cktIdx = 0; cktIdx < 2; ++cktIdx)
+                {
+                    CktGraph &dev = _db.subCkt(cktIdx);
+                    dev.build(std::vector<IndexType>(3, INDEX_TYPE_MAX), std::vector<IndexType>{ 0, 1, 2 },
+                              std::vector<IndexType>{ 0, 1, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+                    dev.setNetNames({ "D", "G", "S" });
+                    dev.setImplType(cktIdx == 0 ? ImplType::PCELL_Pch : ImplType::PCELL_Nch);
+                }
+                std::vector<IntType> netFlags(5, 0);
+                netFlags[0] = static_cast<IntType>(NetFlag::VDD);
+                netFlags[3] = static_cast<IntType>(NetFlag::VSS);
+                CktGraph &ckt = _db.subCkt(2);
+                ckt.build(std::vector<IndexType>{ 0, 0, 1, 1, 1 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3, 3, 4, 4, 4 },
+                          std::vector<IndexType>{ 1, 4, 0, 1, 4, 0, 1, 4, 2, 1, 4, 3, 2, 4, 3 }, Span<const IntType>(), netFlags);
+                ckt.setNodeNames({ "P0", "P1", "N0", "N2", "N1" }, {});
+                for (IndexType pinIdx = 0; pinIdx < ckt.numPins(); ++pinIdx)
+                {
+                    ckt.pin(pinIdx).setIntNetIdx(pinIdx % 3);
+                }
+            }
+            DesignDB _db; ///< The db under test
+    };
+
+    // Test every path from a VDD pch source to a VSS nch source is found, by source and then by sink
+    TEST_F(CSFlowTest, currentFlowTest)
+    {
+        CSFlow csflow(_db);
+        csflow.computeCurrentFlow(_db.subCkt(2));
+        ASSERT_EQ(csflow.numCurrentPaths(), 4u);
+        std::vector<std::vector<std::string>> cellPaths = csflow.currentCellPaths();
+        // The sink of N2 comes before the sink of N1, although the search reaches N1 first
+        EXPECT_EQ(cellPaths[0], (std::vector<std::string>{ "P0", "P0", "N2", "N2" }));
+        EXPECT_EQ(cellPaths[1], (std::vector<std::string>{ "P0", "P0", "N0", "N0", "N1", "N1" }));
+        EXPECT_EQ(cellPaths[2], (std::vector<std::string>{ "P1", "P1", "N2", "N2" }));
+        EXPECT_EQ(cellPaths[3], (std::vector<std::string>{ "P1", "P1", "N0", "N0", "N1", "N1" }));
+        EXPECT_EQ(csflow.currentPinPath(1), (std::vector<std::string>{ "S", "D", "D", "S", "D", "S" }));
+        // The paths are stored as indices
+        Span<const IndexType> pins = csflow.currentPathPins(0);
+        EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), (std::vector<IndexType>{ 2, 0, 9, 11 }));
+        Span<const IndexType> nodes = csflow.currentPathNodes(3);
+        EXPECT_EQ(std::vector<IndexType>(nodes.begin(), nodes.end()), (std::vector<IndexType>{ 1, 1, 2, 2, 4, 4 }));
+        EXPECT_EQ(csflow.currentPathStart().size(), 5u);
+        EXPECT_EQ(csflow.currentPathPinIdx().size(), 20u);
+        // Computing another circuit replaces the paths
+        csflow.computeCurrentFlow(_db.subCkt(2));
+        EXPECT_EQ(csflow.numCurrentPaths(), 4u);
+    }
+
+    // Test the signal flows from the input gates to the output drains, through a feedback loop
+    TEST_F(CSFlowTest, signalFlowTest)
+    {
+        /*
+         * ckt 3: a resistor. ckt 4: a common source stage M0 with a diode load M1, driving M2,
+         * and a resistor R0 feeding the output back to the first stage
+         * Net 0: vdd, net 1: gnd, net 2: in, net 3: x, net 4: out
+         */
+        for (IndexType cktIdx = 3; cktIdx < 5; ++cktIdx)
+        {
+            _db.allocateCkt();
+        }
+        CktGraph &res = _db.subCkt(3);
+        res.build(std::vector<IndexType>(2, INDEX_TYPE_MAX), std::vector<IndexType>{ 0, 1 },
+                  std::vector<IndexType>{ 0, 1 }, Span<const IntType>(), std::vector<IntType>(2, 0));
+        res.setNetNames({ "PLUS", "MINUS" });
+        res.setImplType(ImplType::PCELL_Res);
+        std::vector<IntType> netFlags(5, 0);
+        netFlags[0] = static_cast<IntType>(NetFlag::VDD);
+        netFlags[1] = static_cast<IntType>(NetFlag::VSS);
+        CktGraph &ckt = _db.subCkt(4);
+        ckt.build(std::vector<IndexType>{ 1, 0, 0, 3 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1, 2, 2, 2, 3, 3 },
+                  std::vector<IndexType>{ 3, 2, 1, 3, 3, 0, 4, 3, 0, 4, 3 }, Span<const IntType>(), netFlags);
+        ckt.setNodeNames({ "M0", "M1", "M2", "R0" }, {});
+        for (IndexType pinIdx = 0; pinIdx < ckt.numPins(); ++pinIdx)
+        {
+            ckt.pin(pinIdx).setIntNetIdx(pinIdx < 9 ? pinIdx % 3 : pinIdx - 9);
+        }
+        ckt.net(2).setIoPos(0);
+        ckt.net(4).setIoPos(1);
+
+        CSFlow csflow(_db);
+        csflow.computeSignalFlow(ckt);
+        ASSERT_EQ(csflow.numSignalPaths(), 1u);
+        EXPECT_EQ(csflow.signalCellPath(0), (std::vector<std::string>{ "M0", "M0", "M2", "M2" }));
+        EXPECT_EQ(csflow.signalPinPath(0), (std::vector<std::string>{ "G", "D", "G", "D" }));
+        Span<const IndexType> pins = csflow.signalPathPins(0);
+        EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), (std::vector<IndexType>{ 1, 0, 7, 6 }));
+        EXPECT_EQ(csflow.signalNetLevel(2), 0u);
+        EXPECT_EQ(csflow.signalNetLevel(3), 1u);
+        EXPECT_EQ(csflow.signalNetLevel(4), 2u);
+        EXPECT_EQ(csflow.signalNetLevel(0), INDEX_TYPE_MAX);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "db/ArtifactStore.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class ArtifactStoreTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                _dir = ::testing::TempDir() + "magical_artifacts_" + std::to_string(::getpid()) + "/";
+                ::mkdir(_dir.c_str(), 0755);
+                ::mkdir((_dir + "result").c_str(), 0755);
+            }
+            void TearDown() override
+            {
+                std::system(("rm -rf " + _dir).c_str());
+            }
+            /// @brief write a file in place
+            void write(const std::string &filename, const std::string &data)
+            {
+                std::ofstream(filename, std::ios::binary | std::ios::trunc) << data;
+            }
+            /// @brief read a file
+            std::string read(const std::string &filename)
+            {
+                std::ifstream file(filename, std::ios::binary);
+                return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            }
+            /// @brief get the inode of a file
+            ino_t inode(const std::string &filename)
+            {
+                struct stat st;
+                return ::stat(filename.c_str(), &st) == 0 ? st.st_ino : 0;
+            }
+            std::string _dir; ///< The directory of the test
+    };
+
+    // Test identical files share one object and the index maps (circuit, stage) to it
+    TEST_F(ArtifactStoreTest, dedupTest)
+    {
+        ArtifactStore store(_dir + "store");
+        std::string result = _dir + "result/";
+        write(result + "amp.sym", "M0 M1\n");
+        ASSERT_TRUE(store.commit("amp", result + "amp.sym"));
+        write(result + "ota.sym", "M0 M1\n");
+        ASSERT_TRUE(store.commit("ota", result + "ota.sym"));
+        EXPECT_TRUE(store.put("ota", "M2 M3\n", result + "ota.symnet"));
+        EXPECT_EQ(store.numStored(), 2u);
+        EXPECT_EQ(store.numDeduped(), 1u);
+        EXPECT_EQ(store.bytesDeduped(), 6u);
+        EXPECT_EQ(read(result + "ota.sym"), "M0 M1\n");
+        EXPECT_TRUE(store.contains("ota", ".symnet"));
+        EXPECT_FALSE(store.contains("amp", ".symnet"));
+        EXPECT_EQ(store.numArtifacts(), 3u);
+
+        // A file written aside
+        write(result + "amp.place.gds.tmp", "gds");
+        ASSERT_TRUE(store.commit("amp", result + "amp.place.gds.tmp", result + "amp.place.gds"));
+        EXPECT_EQ(read(result + "amp.place.gds"), "gds");
+        EXPECT_EQ(inode(result + "amp.place.gds.tmp"), 0u);
+        EXPECT_EQ(ArtifactStore::stageOf("amp", result + "amp.place.gds"), ".place.gds");
+        write(result + "ota.place.gds", "gds");
+        ASSERT_TRUE(store.commit("ota", result + "ota.place.gds"));
+        EXPECT_EQ(inode(result + "amp.place.gds"), inode(result + "ota.place.gds"));
+        EXPECT_EQ(inode(result + "amp.place.gds"), inode(store.objectFile("amp", ".place.gds")));
+    }
+
+    // Test the constraint files users edit are writable copies, so that an edit does not change the stored object
+    TEST_F(ArtifactStoreTest, editableTest)
+    {
+        ArtifactStore store(_dir + "store");
+        std::string result = _dir + "result/";
+        write(result + "amp.sym", "M0 M1\n");
+        ASSERT_TRUE(store.commit("amp", result + "amp.sym"));
+        EXPECT_TRUE(store.put("amp", "M2 M3\n", result + "amp.symnet"));
+        std::string object = store.objectFile("amp", ".sym");
+        EXPECT_NE(inode(result + "amp.sym"), inode(object));
+        EXPECT_EQ(::access((result + "amp.sym").c_str(), W_OK), 0);
+        EXPECT_EQ(::access((result + "amp.symnet").c_str(), W_OK), 0);
+        write(result + "amp.sym", "M0 M2\n");
+        EXPECT_EQ(read(object), "M0 M1\n");
+        ASSERT_TRUE(store.checkout("amp", ".sym", result + "ota.sym"));
+        EXPECT_NE(inode(result + "ota.sym"), inode(object));
+        EXPECT_EQ(read(result + "ota.sym"), "M0 M1\n");
+    }
+
+    // Test a failed commit leaves the written file and the result file as they are
+    TEST_F(ArtifactStoreTest, failureTest)
+    {
+        ArtifactStore store(_dir + "store");
+        std::string result = _dir + "result/";
+        write(result + "amp.place.gds.tmp", "gds");
+        EXPECT_FALSE(store.commit("amp", result + "amp.place.gds.tmp", _dir + "missing/amp.place.gds"));
+        EXPECT_EQ(read(result + "amp.place.gds.tmp"), "gds");
+        EXPECT_FALSE(store.contains("amp", ".place.gds"));
+        // The same object linked again
+        write(result + "amp.route.gds", "gds");
+        ASSERT_TRUE(store.commit("amp", result + "amp.route.gds"));
+        ASSERT_TRUE(store.commit("amp", result + "amp.route.gds"));
+        EXPECT_EQ(read(result + "amp.route.gds"), "gds");
+        EXPECT_EQ(inode(result + "amp.route.gds.link"), 0u);
+    }
+
+    // Test a rewritten file does not change the stored object, and the index persists
+    TEST_F(ArtifactStoreTest, rewriteTest)
+    {
+        std::string result = _dir + "result/";
+        {
+            ArtifactStore store(_dir + "store");
+            write(result + "amp.sym", "old\n");
+            ASSERT_TRUE(store.commit("amp", result + "amp.sym"));
+            std::string object = store.objectFile("amp", ".sym");
+            store.release(result + "amp.sym");
+            write(result + "amp.sym", "new\n");
+            EXPECT_EQ(read(object), "old\n");
+            ASSERT_TRUE(store.commit("amp", result + "amp.sym"));
+            EXPECT_NE(store.objectFile("amp", ".sym"), object);
+        }
+        ArtifactStore reopened(_dir + "store");
+        EXPECT_EQ(reopened.numArtifacts(), 1u);
+        ASSERT_TRUE(reopened.checkout("amp", ".sym", result + "copy.sym"));
+        EXPECT_EQ(read(result + "copy.sym"), "new\n");
+        EXPECT_FALSE(reopened.checkout("ota", ".sym", result + "ota.sym"));
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,376 @@
+#include <gtest/gtest.h>
+#include "db/CktGraph.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class CktGraphTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                initInverter();
+            }
+            /// @brief connect a pin to a node and a net
+            void connect(IndexType nodeIdx, IndexType netIdx);
+            /// @brief init a graph of two 3-pin nodes sharing the first two nets
+            void initInverter();
+            CktGraph _ckt; ///< The graph under test
+    };
+
+    inline void CktGraphTest::connect(IndexType nodeIdx, IndexType netIdx)
+    {
+        IndexType pinIdx = _ckt.allocatePin();
+        _ckt.pin(pinIdx).setNodeIdx(nodeIdx);
+        _ckt.pin(pinIdx).setNetIdx(netIdx);
+        _ckt.node(nodeIdx).appendPinIdx(pinIdx);
+        _ckt.net(netIdx).appendPinIdx(pinIdx);
+    }
+
+    inline void CktGraphTest::initInverter()
+    {
+        /*
+         * net 0: out, net 1: in, net 2: vdd, net 3: vss
+         * node 0: (out, in, vdd)
+         * node 1: (out, in, vss)
+         */
+        for (IndexType idx = 0; idx < 4; ++idx)
+        {
+            _ckt.allocateNet();
+        }
+        _ckt.allocateNode();
+        _ckt.allocateNode();
+        connect(0, 0);
+        connect(0, 1);
+        connect(0, 2);
+        connect(1, 0);
+        connect(1, 1);
+        connect(1, 3);
+        _ckt.net(2).appendSubIdx(2);
+    }
+
+    // Test the packed connectivity matches the objects
+    TEST_F(CktGraphTest, finalizeTest)
+    {
+        EXPECT_FALSE(_ckt.isFinalized());
+        _ckt.finalize();
+        EXPECT_TRUE(_ckt.isFinalized());
+        for (IndexType netIdx = 0; netIdx < _ckt.numNets(); ++netIdx)
+        {
+            auto pins = _ckt.netPins(netIdx);
+            EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), _ckt.netArrays().cold[netIdx].pinIdxArray);
+        }
+        for (IndexType nodeIdx = 0; nodeIdx < _ckt.numNodes(); ++nodeIdx)
+        {
+            auto pins = _ckt.nodePins(nodeIdx);
+            EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), _ckt.nodeArrays().cold[nodeIdx].pinIdxArray);
+        }
+        EXPECT_EQ(_ckt.netSubs(2).size(), 1u);
+        EXPECT_EQ(_ckt.netSubs(3).size(), 0u);
+        EXPECT_EQ(_ckt.pinNet(5), 3u);
+        EXPECT_EQ(_ckt.pinNode(5), 1u);
+    }
+
+    // Test allocating drops the packed connectivity
+    TEST_F(CktGraphTest, invalidateTest)
+    {
+        _ckt.finalize();
+        IndexType netIdx = _ckt.allocateNet();
+        EXPECT_FALSE(_ckt.isFinalized());
+        EXPECT_EQ(_ckt.netPins(netIdx).size(), 0u);
+        connect(1, netIdx);
+        EXPECT_EQ(_ckt.netPins(netIdx).size(), 1u);
+        _ckt.finalize();
+        EXPECT_EQ(_ckt.netPins(netIdx).front(), 6u);
+        EXPECT_EQ(_ckt.nodePins(1).size(), 4u);
+    }
+
+    // Test editing the pins through the node and net views drops the packed connectivity
+    TEST_F(CktGraphTest, viewEditTest)
+    {
+        _ckt.finalize();
+        IndexType pinIdx = _ckt.allocatePin();
+        _ckt.finalize();
+        _ckt.pin(pinIdx).setNodeIdx(1);
+        _ckt.pin(pinIdx).setNetIdx(0);
+        EXPECT_EQ(_ckt.pinNet(pinIdx), 0u);
+        EXPECT_EQ(_ckt.pinNode(pinIdx), 1u);
+        _ckt.node(1).appendPinIdx(pinIdx);
+        EXPECT_FALSE(_ckt.isFinalized());
+        EXPECT_EQ(_ckt.nodePins(1).back(), pinIdx);
+        _ckt.finalize();
+        _ckt.net(0).appendPinIdx(pinIdx);
+        EXPECT_FALSE(_ckt.isFinalized());
+        EXPECT_EQ(_ckt.netPins(0).back(), pinIdx);
+        _ckt.finalize();
+        EXPECT_TRUE(_ckt.isFinalized());
+        EXPECT_EQ(_ckt.netPins(0).back(), pinIdx);
+        // Reading the pins through the views keeps the packed arrays
+        CktNode node = _ckt.node(1);
+        Net net = _ckt.net(0);
+        EXPECT_EQ(node.pinIdxArray().back(), pinIdx);
+        EXPECT_EQ(net.pinIdxArray().back(), pinIdx);
+        EXPECT_EQ(net.subIdxArray().size(), net.numSubs());
+        EXPECT_TRUE(_ckt.isFinalized());
+    }
+
+    // Test the name lookup follows renames and new objects
+    TEST_F(CktGraphTest, findTest)
+    {
+        _ckt.net(0).setName("out");
+        _ckt.net(1).setName("in");
+        _ckt.node(0).setName("MP0");
+        _ckt.node(1).setName("MN0");
+        EXPECT_EQ(_ckt.findNet("out"), 0u);
+        EXPECT_EQ(_ckt.findNet("in"), 1u);
+        EXPECT_EQ(_ckt.findNode("MN0"), 1u);
+        EXPECT_EQ(_ckt.findNode("out"), INDEX_TYPE_MAX);
+        EXPECT_EQ(_ckt.findNet("no_such_net"), INDEX_TYPE_MAX);
+        _ckt.net(1).setName("inp");
+        EXPECT_EQ(_ckt.findNet("in"), INDEX_TYPE_MAX);
+        EXPECT_EQ(_ckt.findNet("inp"), 1u);
+        IndexType netIdx = _ckt.allocateNet();
+        _ckt.net(netIdx).setName("vbias");
+        EXPECT_EQ(_ckt.findNet("vbias"), netIdx);
+        // Shrinking and growing back to the same number of nodes drops the index
+        _ckt.resizeNodeArray(1);
+        _ckt.allocateNode();
+        EXPECT_EQ(_ckt.findNode("MN0"), INDEX_TYPE_MAX);
+        EXPECT_EQ(_ckt.findNode("MP0"), 0u);
+    }
+
+    // Test the node and net views write through to the hot arrays
+    TEST_F(CktGraphTest, hotArraysTest)
+    {
+        CktNode node = _ckt.node(1);
+        Net net = _ckt.net(2);
+        for (IndexType idx = 0; idx < 100; ++idx)
+        {
+            _ckt.allocateNode();
+            _ckt.allocateNet();
+        }
+        // The views stay valid after the arrays grow
+        node.setOffset(3, 4);
+        node.setFlipVertFlag(true);
+        node.setSubgraphIdx(7);
+        net.markVddFlag();
+        EXPECT_EQ(_ckt.nodeOffsets()[1].x(), 3);
+        EXPECT_EQ(_ckt.nodeOffsets()[1].y(), 4);
+        EXPECT_EQ(_ckt.nodeFlipVertFlags()[1], 1);
+        EXPECT_EQ(_ckt.nodeSubgraphIdx()[1], 7u);
+        EXPECT_EQ(_ckt.netFlags()[2], static_cast<Byte>(NetFlag::VDD));
+        _ckt.nodeOffsets()[0].setXY(5, 6);
+        EXPECT_EQ(_ckt.node(0).offset().x(), 5);
+        EXPECT_TRUE(_ckt.node(_ckt.numNodes() - 1).isLeaf());
+        net.markDigitalFlag();
+        net.markAnalogFlag();
+        EXPECT_TRUE(_ckt.net(2).isVdd());
+        EXPECT_TRUE(_ckt.net(2).isAnalog());
+        EXPECT_FALSE(_ckt.net(2).isDigital());
+        EXPECT_THROW(_ckt.node(_ckt.numNodes()), std::out_of_range);
+    }
+
+    // Test the bulk flag queries agree with the per-net getters
+    TEST_F(CktGraphTest, netFlagQueryTest)
+    {
+        const Byte power = static_cast<Byte>(NetFlag::VDD) | static_cast<Byte>(NetFlag::VSS);
+        const Byte io = static_cast<Byte>(NetFlag::IO);
+        _ckt.net(0).setIoPos(0);
+        _ckt.net(2).setIoPos(1);
+        _ckt.net(2).markVddFlag();
+        _ckt.net(3).markVssFlag();
+        EXPECT_TRUE(_ckt.net(0).isIo());
+        EXPECT_FALSE(_ckt.net(1).isIo());
+        EXPECT_EQ(_ckt.netsWithFlags(io, power), std::vector<IndexType>({ 0 }));
+        EXPECT_EQ(_ckt.netsWithFlags(io), std::vector<IndexType>({ 0, 2 }));
+        EXPECT_EQ(_ckt.netsWithFlags(static_cast<Byte>(NetFlag::VDD)), std::vector<IndexType>({ 2 }));
+        EXPECT_EQ(_ckt.netsWithFlags(0, power), std::vector<IndexType>({ 0, 1 }));
+        EXPECT_EQ(_ckt.netsWithFlags(0).size(), _ckt.numNets());
+        for (IndexType netIdx = 0; netIdx < _ckt.numNets(); ++netIdx)
+        {
+            bool isIoSignal = _ckt.net(netIdx).isIo() && !_ckt.net(netIdx).isPower();
+            EXPECT_EQ(isIoSignal, netIdx == 0);
+        }
+        _ckt.net(0).setIoPos(INDEX_TYPE_MAX);
+        EXPECT_FALSE(_ckt.net(0).isIo());
+        EXPECT_EQ(_ckt.netsWithFlags(io), std::vector<IndexType>({ 2 }));
+    }
+
+    // Test the bulk construction matches the graph built object by object
+    TEST_F(CktGraphTest, buildTest)
+    {
+        // Instances of sub circuits, so the n-well pin is in both arrays of its net like the vdd pin of the fixture
+        std::vector<IndexType> nodeGraphIdx = { 4, 5 };
+        std::vector<IndexType> pinNodeIdx = { 0, 0, 0, 1, 1, 1 };
+        std::vector<IndexType> pinNetIdx = { 0, 1, 2, 0, 1, 3 };
+        std::vector<IntType> pinTypes = { 0, 0, static_cast<IntType>(PinType::NWELL), 0, 0, 0 };
+        std::vector<IntType> netFlags = { 0, 0, static_cast<IntType>(NetFlag::VDD), static_cast<IntType>(NetFlag::VSS) };
+        CktGraph ckt;
+        ckt.build(nodeGraphIdx, pinNodeIdx, pinNetIdx, pinTypes, netFlags);
+        EXPECT_TRUE(ckt.isFinalized());
+        ASSERT_EQ(ckt.numNodes(), _ckt.numNodes());
+        ASSERT_EQ(ckt.numPins(), _ckt.numPins());
+        ASSERT_EQ(ckt.numNets(), _ckt.numNets());
+        for (IndexType netIdx = 0; netIdx < ckt.numNets(); ++netIdx)
+        {
+            EXPECT_EQ(ckt.net(netIdx).pinIdxArray(), _ckt.net(netIdx).pinIdxArray());
+            EXPECT_EQ(ckt.net(netIdx).subIdxArray(), _ckt.net(netIdx).subIdxArray());
+        }
+        for (IndexType nodeIdx = 0; nodeIdx < ckt.numNodes(); ++nodeIdx)
+        {
+            EXPECT_EQ(ckt.node(nodeIdx).pinIdxArray(), _ckt.node(nodeIdx).pinIdxArray());
+        }
+        EXPECT_EQ(ckt.node(0).subgraphIdx(), 4u);
+        EXPECT_EQ(ckt.node(1).subgraphIdx(), 5u);
+        EXPECT_EQ(ckt.pin(2).pinType(), PinType::NWELL);
+        EXPECT_TRUE(ckt.net(2).isVdd());
+        EXPECT_TRUE(ckt.net(3).isVss());
+        EXPECT_FALSE(ckt.net(0).isPower());
+        ckt.setNetNames({ "out", "in", "vdd", "vss" });
+        ckt.setNodeNames({ "MP0", "MN0" }, { "pch", "nch" });
+        EXPECT_EQ(ckt.findNet("vss"), 3u);
+        EXPECT_EQ(ckt.node(1).refName(), "nch");
+        // The substrate pin of a leaf node is only in the substrate pins, as in a device circuit
+        nodeGraphIdx[0] = INDEX_TYPE_MAX;
+        ckt.build(nodeGraphIdx, pinNodeIdx, pinNetIdx, pinTypes, netFlags);
+        EXPECT_EQ(ckt.net(2).numPins(), 0u);
+        EXPECT_EQ(ckt.net(2).subIdxArray(), (std::vector<IndexType>{ 2 }));
+    }
+
+    // Test the edits keep the objects and name lookup consistent and are journaled
+    TEST_F(CktGraphTest, ecoTest)
+    {
+        _ckt.node(0).setName("MP0");
+        _ckt.node(1).setName("MN0");
+        EXPECT_EQ(_ckt.findNode("MN0"), 1u);
+        IndexType nodeIdx = _ckt.addNode("MN1", 3, { 0, 1, INDEX_TYPE_MAX });
+        EXPECT_EQ(nodeIdx, 2u);
+        EXPECT_EQ(_ckt.findNode("MN1"), 2u);
+        EXPECT_EQ(_ckt.node(2).numPins(), 3u);
+        EXPECT_EQ(_ckt.net(0).numPins(), 3u);
+        // Move the output of MN0 to vss
+        _ckt.reconnectPin(3, 3);
+        EXPECT_EQ(_ckt.net(0).numPins(), 2u);
+        EXPECT_EQ(_ckt.net(3).numPins(), 2u);
+        EXPECT_EQ(_ckt.pinNet(3), 3u);
+        _ckt.removeNode(0);
+        EXPECT_EQ(_ckt.numNodes(), 2u);
+        EXPECT_EQ(_ckt.findNode("MP0"), INDEX_TYPE_MAX);
+        EXPECT_EQ(_ckt.findNode("MN1"), 0u);
+        EXPECT_EQ(_ckt.node(0).subgraphIdx(), 3u);
+        EXPECT_EQ(_ckt.pin(_ckt.node(0).pinIdx(0)).nodeIdx(), 0u);
+        EXPECT_EQ(_ckt.net(2).numPins(), 0u);
+        EXPECT_EQ(_ckt.net(2).subIdxArray().size(), 0u);
+        // The pins of MP0 are removed and the last pins of MN1 take their indices
+        ASSERT_EQ(_ckt.numPins(), 6u);
+        EXPECT_EQ(_ckt.node(0).pinIdxArray(), (std::vector<IndexType>{ 0, 1, 2 }));
+        EXPECT_EQ(_ckt.net(0).pinIdxArray(), (std::vector<IndexType>{ 0 }));
+        EXPECT_EQ(_ckt.pinNet(1), 1u);
+        EXPECT_EQ(_ckt.pinNet(2), INDEX_TYPE_MAX);
+        _ckt.finalize();
+        EXPECT_EQ(_ckt.netPins(1).size(), 2u);
+        ASSERT_EQ(_ckt.journal().size(), 3u);
+        EXPECT_EQ(_ckt.journal()[0].type, CktEditType::ADD_NODE);
+        EXPECT_EQ(_ckt.journal()[1].from, 0u);
+        EXPECT_EQ(_ckt.journal()[1].to, 3u);
+        EXPECT_EQ(_ckt.journal()[2].type, CktEditType::REMOVE_NODE);
+        EXPECT_EQ(_ckt.journal()[2].to, 2u);
+        // A substrate pin of a leaf node is only in the substrate pins of its net, and one of an instance is in both, as the parser puts them
+        ASSERT_TRUE(_ckt.node(_ckt.pin(5).nodeIdx()).isLeaf());
+        _ckt.pin(5).setPinType(PinType::PSUB);
+        _ckt.reconnectPin(5, 2);
+        EXPECT_EQ(_ckt.net(2).numPins(), 0u);
+        EXPECT_EQ(_ckt.net(2).subIdxArray(), (std::vector<IndexType>{ 5 }));
+        EXPECT_EQ(_ckt.net(3).pinIdxArray(), (std::vector<IndexType>{ 3 }));
+        ASSERT_EQ(_ckt.pin(0).nodeIdx(), 0u);
+        _ckt.pin(0).setPinType(PinType::PSUB);
+        _ckt.reconnectPin(0, 2);
+        EXPECT_EQ(_ckt.net(2).pinIdxArray(), (std::vector<IndexType>{ 0 }));
+        EXPECT_EQ(_ckt.net(2).subIdxArray(), (std::vector<IndexType>{ 5, 0 }));
+        _ckt.removeNode(0);
+        EXPECT_EQ(_ckt.net(2).numPins(), 0u);
+    }
+
+    // Test the edits patch the packed connectivity and the node name index instead of dropping them
+    TEST_F(CktGraphTest, ecoPatchTest)
+    {
+        auto expectPacked = [&]()
+        {
+            ASSERT_TRUE(_ckt.isFinalized());
+            for (IndexType netIdx = 0; netIdx < _ckt.numNets(); ++netIdx)
+            {
+                auto pins = _ckt.netPins(netIdx);
+                auto subs = _ckt.netSubs(netIdx);
+                EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), _ckt.netArrays().cold[netIdx].pinIdxArray);
+                EXPECT_EQ(std::vector<IndexType>(subs.begin(), subs.end()), _ckt.netArrays().cold[netIdx].subIdxArray);
+            }
+            for (IndexType nodeIdx = 0; nodeIdx < _ckt.numNodes(); ++nodeIdx)
+            {
+                auto pins = _ckt.nodePins(nodeIdx);
+                EXPECT_EQ(std::vector<IndexType>(pins.begin(), pins.end()), std::vector<IndexType>(_ckt.nodeArrays().cold[nodeIdx].pinIdxArray.begin(), _ckt.nodeArrays().cold[nodeIdx].pinIdxArray.end()));
+            }
+        };
+        _ckt.node(0).setName("MP0");
+        _ckt.node(1).setName("MN0");
+        _ckt.finalize();
+        EXPECT_EQ(_ckt.findNode("MN0"), 1u);
+        for (IndexType idx = 0; idx < 40; ++idx)
+        {
+            _ckt.addNode("X" + std::to_string(idx), idx % 2 ? 1 : INDEX_TYPE_MAX, { idx % 4, (idx + 1) % 4, INDEX_TYPE_MAX });
+        }
+        expectPacked();
+        for (IndexType pinIdx = 0; pinIdx < _ckt.numPins(); pinIdx += 3)
+        {
+            _ckt.reconnectPin(pinIdx, (_ckt.pinNet(pinIdx) + 1) % 4);
+        }
+        expectPacked();
+        _ckt.pin(7).setPinType(PinType::PSUB);
+        _ckt.reconnectPin(7, 2);
+        expectPacked();
+        EXPECT_EQ(_ckt.findNode("X39"), 41u);
+        for (IndexType idx = 0; idx < 30; ++idx)
+        {
+            _ckt.removeNode((idx * 7) % _ckt.numNodes());
+        }
+        expectPacked();
+        EXPECT_EQ(_ckt.numNodes(), 12u);
+        // The name index follows the removals without a rebuild
+        for (IndexType nodeIdx = 0; nodeIdx < _ckt.numNodes(); ++nodeIdx)
+        {
+            EXPECT_EQ(_ckt.findNode(_ckt.node(nodeIdx).name()), nodeIdx);
+        }
+        EXPECT_EQ(_ckt.findNode("MP0"), INDEX_TYPE_MAX);
+        _ckt.finalize();
+        expectPacked();
+    }
+
+    // Test the inline pin arrays spill to the heap and survive copies and moves
+    TEST_F(CktGraphTest, smallVectorTest)
+    {
+        EXPECT_FALSE(_ckt.node(0).pinIdxArray().isHeap());
+        for (IndexType idx = 0; idx < 3; ++idx)
+        {
+            connect(0, 3);
+        }
+        EXPECT_TRUE(_ckt.node(0).pinIdxArray().isHeap());
+        EXPECT_EQ(_ckt.node(0).pinIdxArray(), (std::vector<IndexType>{ 0, 1, 2, 6, 7, 8 }));
+        EXPECT_EQ(_ckt.net(0).numIoPins(), 1u);
+        CktGraph copy(_ckt);
+        CktGraph moved(std::move(_ckt));
+        EXPECT_EQ(copy.node(0).pinIdxArray(), moved.node(0).pinIdxArray());
+        EXPECT_EQ(copy.node(1).pinIdxArray(), moved.node(1).pinIdxArray());
+        copy.node(1).appendPinIdx(9);
+        EXPECT_EQ(copy.node(1).pinIdxArray(), (std::vector<IndexType>{ 3, 4, 5, 9 }));
+        EXPECT_EQ(moved.node(1).numPins(), 3u);
+        copy.pin(0).addLayoutRectIdx(5);
+        copy.pin(0).addLayoutRectIdx(6);
+        copy.pin(0).addLayoutRectIdx(7);
+        EXPECT_EQ(copy.pin(0).layoutRectIdx(2), 7u);
+        EXPECT_THROW(copy.pin(0).layoutRectIdx(3), std::out_of_range);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
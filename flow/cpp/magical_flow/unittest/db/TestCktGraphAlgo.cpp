@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "db/CktGraphAlgo.h"
+#include "db/CktGraphBGL.h"
+#include <boost/graph/graph_concepts.hpp>
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class CktGraphAlgoTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                /*
+                 * node 0: (net 0, net 1)
+                 * node 1: (net 1, net 2)
+                 * node 2: (net 3, unconnected)
+                 * net 4 is floating
+                 */
+                std::vector<IndexType> nodeGraphIdx(3, INDEX_TYPE_MAX);
+                std::vector<IndexType> pinNodeIdx = { 0, 0, 1, 1, 2, 2 };
+                std::vector<IndexType> pinNetIdx = { 0, 1, 1, 2, 3, INDEX_TYPE_MAX };
+                std::vector<IntType> netFlags(5, 0);
+                _ckt.build(nodeGraphIdx, pinNodeIdx, pinNetIdx, Span<const IntType>(), netFlags);
+            }
+            CktGraph _ckt; ///< The graph under test
+    };
+
+    // Test the adaptor models the BGL concepts the algorithms need
+    TEST_F(CktGraphAlgoTest, conceptTest)
+    {
+        BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<CktBipartiteGraph>));
+        BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<CktBipartiteGraph>));
+        CktBipartiteGraph g(_ckt);
+        EXPECT_EQ(num_vertices(g), 8u);
+        EXPECT_EQ(out_degree(g.nodeVertex(2), g), 1u);
+        EXPECT_EQ(out_degree(g.netVertex(1), g), 2u);
+        auto edges = out_edges(g.netVertex(1), g);
+        EXPECT_EQ(source(*edges.first, g), g.netVertex(1));
+        EXPECT_EQ(target(*edges.first, g), g.nodeVertex(0));
+    }
+
+    // Test the connected components
+    TEST_F(CktGraphAlgoTest, componentTest)
+    {
+        std::vector<IndexType> component;
+        EXPECT_EQ(CktGraphAlgo::connectedComponents(_ckt, component), 3u);
+        EXPECT_EQ(component[0], component[1]);
+        EXPECT_EQ(component[0], component[3 + 2]);
+        EXPECT_EQ(component[2], component[3 + 3]);
+        EXPECT_NE(component[0], component[2]);
+        EXPECT_NE(component[3 + 4], component[0]);
+        EXPECT_NE(component[3 + 4], component[2]);
+    }
+
+    // Test the BFS distances and eccentricity
+    TEST_F(CktGraphAlgoTest, distanceTest)
+    {
+        auto dist = CktGraphAlgo::bfsDistances(_ckt, 3 + 0);
+        EXPECT_EQ(dist[3 + 0], 0u);
+        EXPECT_EQ(dist[0], 1u);
+        EXPECT_EQ(dist[3 + 1], 2u);
+        EXPECT_EQ(dist[1], 3u);
+        EXPECT_EQ(dist[3 + 2], 4u);
+        EXPECT_EQ(dist[2], INDEX_TYPE_MAX);
+        EXPECT_EQ(CktGraphAlgo::eccentricity(_ckt, 3 + 0), 4u);
+        EXPECT_EQ(CktGraphAlgo::eccentricity(_ckt, 3 + 1), 2u);
+        EXPECT_EQ(CktGraphAlgo::eccentricity(_ckt, 3 + 4), 0u);
+        EXPECT_THROW(CktGraphAlgo::bfsDistances(_ckt, 3 + 5), std::out_of_range);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 #include "db/DesignDB.h"
+#include <cstdio>
+#include <fstream>
 
 
 PROJECT_NAMESPACE_BEGIN
@@ -62,6 +64,624 @@ namespace unittest
         _db.findRootCkt();
         EXPECT_EQ(_db.rootCktIdx(), static_cast<IndexType>(6));
     }
+
+    // Test the levels, the topological order and the multiple roots
+    TEST_F(DesignDBTest, levelTest)
+    {
+        initSimpleHierarchy();
+        ASSERT_TRUE(_db.findRootCkt());
+        ASSERT_EQ(_db.numLevels(), 5u);
+        auto ckts = _db.levelCkts(1);
+        EXPECT_EQ(std::vector<IndexType>(ckts.begin(), ckts.end()), (std::vector<IndexType>{ 3, 4 }));
+        EXPECT_EQ(_db.cktLevel(5), 3u);
+        EXPECT_EQ(_db.cktLevel(0), 0u);
+        EXPECT_EQ(_db.topoOrder(), (std::vector<IndexType>{ 6, 5, 2, 3, 4, 0, 1 }));
+        EXPECT_EQ(_db.subtreeCkts(4), (std::vector<IndexType>{ 0, 1, 4 }));
+        EXPECT_EQ(_db.subtreeCkts(2), (std::vector<IndexType>{ 1, 3, 2 }));
+        EXPECT_EQ(_db.rootCkts(), (std::vector<IndexType>{ 6 }));
+        // A second, lower root
+        IndexType other = _db.allocateCkt();
+        _db.subCkt(other).node(_db.subCkt(other).allocateNode()).setSubgraphIdx(1);
+        ASSERT_TRUE(_db.findRootCkt());
+        EXPECT_EQ(_db.rootCkts(), (std::vector<IndexType>{ 6, 7 }));
+        EXPECT_EQ(_db.rootCktIdx(), 6u);
+        EXPECT_EQ(_db.cktLevel(7), 1u);
+        // A cycle
+        _db.subCkt(1).node(_db.subCkt(1).allocateNode()).setSubgraphIdx(6);
+        EXPECT_FALSE(_db.findRootCkt());
+    }
+
+    // Test the circuit lookup by name
+    TEST_F(DesignDBTest, findCktTest)
+    {
+        initSimpleHierarchy();
+        for (IndexType idx = 0; idx < _db.numCkts(); ++idx)
+        {
+            _db.subCkt(idx).setName("ckt" + std::to_string(idx));
+        }
+        EXPECT_EQ(_db.findCkt("ckt6"), 6u);
+        EXPECT_EQ(_db.findCkt("ckt0"), 0u);
+        EXPECT_EQ(_db.findCkt("ckt7"), INDEX_TYPE_MAX);
+        // Dropping a circuit and adding another one keeps the count but not the name
+        _db.resizeSubCkts(6);
+        _db.allocateCkt();
+        EXPECT_EQ(_db.findCkt("ckt6"), INDEX_TYPE_MAX);
+        _db.subCkt(6).setName("ckt7");
+        EXPECT_EQ(_db.findCkt("ckt7"), 6u);
+        // A copy counts its renames in the design too
+        IndexType copyIdx = _db.copyCkt(6, "ckt8");
+        EXPECT_EQ(_db.findCkt("ckt8"), copyIdx);
+        _db.subCkt(copyIdx).setName("ckt9");
+        EXPECT_EQ(_db.findCkt("ckt9"), copyIdx);
+        EXPECT_EQ(_db.findCkt("ckt8"), INDEX_TYPE_MAX);
+    }
+
+    // Test the structural hash ignores the names and the order of the nets, but not the devices
+    TEST_F(DesignDBTest, structHashTest)
+    {
+        /*
+         * 0, 1: nch devices of the same size. 2: a wider nch
+         * 3: (0, 1) as a current mirror. 4: the same with other names and net order. 5: (0, 2)
+         */
+        for (IndexType idx = 0; idx < 6; ++idx)
+        {
+            _db.allocateCkt();
+            _db.subCkt(idx).setName("ckt" + std::to_string(idx));
+        }
+        for (IndexType cktIdx = 0; cktIdx < 3; ++cktIdx)
+        {
+            CktGraph &dev = _db.subCkt(cktIdx);
+            dev.build(std::vector<IndexType>(3, INDEX_TYPE_MAX), std::vector<IndexType>{ 0, 1, 2 },
+                      std::vector<IndexType>{ 0, 1, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+            for (IndexType netIdx = 0; netIdx < 3; ++netIdx)
+            {
+                dev.net(netIdx).setIoPos(netIdx);
+            }
+            IndexType nchIdx = _db.phyPropDB().allocateNch();
+            _db.phyPropDB().nch(nchIdx).setWidth(cktIdx == 2 ? 2000 : 1000);
+            _db.phyPropDB().nch(nchIdx).setLength(100);
+            dev.setImplType(ImplType::PCELL_Nch);
+            dev.setImplIdx(nchIdx);
+        }
+        // Net 0: in, net 1: out, net 2: gnd. Device pins are (d, g, s)
+        _db.subCkt(3).build(std::vector<IndexType>{ 0, 1 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1 },
+                            std::vector<IndexType>{ 0, 0, 2, 1, 0, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+        // Net 0: gnd, net 1: out, net 2: in
+        _db.subCkt(4).build(std::vector<IndexType>{ 1, 0 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1 },
+                            std::vector<IndexType>{ 1, 2, 0, 2, 2, 0 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+        _db.subCkt(5).build(std::vector<IndexType>{ 0, 2 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1 },
+                            std::vector<IndexType>{ 0, 0, 2, 1, 0, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+        EXPECT_EQ(_db.structHash(0), _db.structHash(1));
+        EXPECT_NE(_db.structHash(0), _db.structHash(2));
+        EXPECT_EQ(_db.structHash(3), _db.structHash(4));
+        EXPECT_NE(_db.structHash(3), _db.structHash(5));
+        EXPECT_EQ(_db.structEquivClasses(), (std::vector<IndexType>{ 0, 0, 2, 3, 3, 5 }));
+        // The edits are picked up without recomputing. Resizing a device changes its parents too
+        _db.phyPropDB().nch(2).setWidth(1000);
+        EXPECT_EQ(_db.structHash(0), _db.structHash(2));
+        EXPECT_EQ(_db.structHash(3), _db.structHash(5));
+        // Swapping the drain and source of one device changes the port-ordered connectivity
+        _db.subCkt(4).pin(0).setNetIdx(0);
+        _db.subCkt(4).pin(2).setNetIdx(1);
+        EXPECT_NE(_db.structHash(3), _db.structHash(4));
+        EXPECT_EQ(_db.structEquivClasses(), (std::vector<IndexType>{ 0, 0, 0, 3, 4, 3 }));
+    }
+
+    // Test the identical devices are merged and the nodes follow their masters
+    TEST_F(DesignDBTest, dedupDevicesTest)
+    {
+        /*
+         * 0 -> (1, 2, 4), 1 -> (3, 5)
+         * 2, 3, 5: identical nch. 4: a longer nch
+         */
+        for (IndexType idx = 0; idx < 6; ++idx)
+        {
+            _db.allocateCkt();
+            _db.subCkt(idx).setName("ckt" + std::to_string(idx));
+        }
+        for (IndexType cktIdx = 2; cktIdx < 6; ++cktIdx)
+        {
+            CktGraph &dev = _db.subCkt(cktIdx);
+            dev.build(std::vector<IndexType>(2, INDEX_TYPE_MAX), std::vector<IndexType>{ 0, 1 },
+                      std::vector<IndexType>{ 0, 1 }, Span<const IntType>(), std::vector<IntType>(2, 0));
+            IndexType nchIdx = _db.phyPropDB().allocateNch();
+            _db.phyPropDB().nch(nchIdx).setLength(cktIdx == 4 ? 200 : 100);
+            dev.setImplType(ImplType::PCELL_Nch);
+            dev.setImplIdx(nchIdx);
+        }
+        for (IndexType graphIdx : { 1, 2, 4 })
+        {
+            _db.subCkt(0).node(_db.subCkt(0).allocateNode()).setSubgraphIdx(graphIdx);
+        }
+        for (IndexType graphIdx : { 3, 5 })
+        {
+            _db.subCkt(1).node(_db.subCkt(1).allocateNode()).setSubgraphIdx(graphIdx);
+        }
+        _db.subCkt(1).node(1).setFlipVertFlag(true);
+        // The candidates of equal hash are compared property by property
+        EXPECT_TRUE(_db.phyPropDB().propEquals(ImplType::PCELL_Nch, 0, 1));
+        EXPECT_FALSE(_db.phyPropDB().propEquals(ImplType::PCELL_Nch, 0, 2));
+        _db.findRootCkt();
+        EXPECT_EQ(_db.dedupDevices(), 2u);
+        ASSERT_EQ(_db.numCkts(), 4u);
+        EXPECT_EQ(_db.rootCktIdx(), 0u);
+        EXPECT_EQ(_db.findCkt("ckt4"), 3u);
+        EXPECT_EQ(_db.findCkt("ckt3"), INDEX_TYPE_MAX);
+        EXPECT_EQ(_db.subCkt(0).node(1).subgraphIdx(), 2u);
+        EXPECT_EQ(_db.subCkt(0).node(2).subgraphIdx(), 3u);
+        EXPECT_EQ(_db.subCkt(1).node(0).subgraphIdx(), 2u);
+        EXPECT_EQ(_db.subCkt(1).node(1).subgraphIdx(), 2u);
+        EXPECT_FALSE(_db.subCkt(1).node(0).flipVertFlag());
+        EXPECT_TRUE(_db.subCkt(1).node(1).flipVertFlag());
+        EXPECT_EQ(_db.dedupDevices(), 2u);
+        EXPECT_EQ(_db.numCkts(), 4u);
+        // A copy of a master stays a separate circuit until it is merged again. It is not implemented
+        _db.subCkt(2).setIsImpl(true);
+        _db.subCkt(2).layout().insertRect(1, 0, 0, 4, 4);
+        EXPECT_EQ(_db.copyCkt(2, "ckt2_flip"), 4u);
+        EXPECT_FALSE(_db.subCkt(4).isImpl());
+        EXPECT_EQ(_db.subCkt(4).layout().numRects(1), 0u);
+        EXPECT_EQ(_db.subCkt(2).layout().numRects(1), 1u);
+        EXPECT_EQ(_db.findCkt("ckt2_flip"), 4u);
+        EXPECT_EQ(_db.subCkt(4).implIdx(), _db.subCkt(2).implIdx());
+        EXPECT_EQ(_db.structHash(4), _db.structHash(2));
+        EXPECT_EQ(_db.subCkt(2).name(), "ckt2");
+        // The flipped copy is made once and kept by index, in the checkpoint too
+        EXPECT_EQ(_db.flippedCopy(2), INDEX_TYPE_MAX);
+        IndexType copyIdx = _db.flippedCopyOf(2, "ckt2_mirror");
+        EXPECT_EQ(copyIdx, 5u);
+        EXPECT_EQ(_db.flippedCopyOf(2, "ckt2_mirror"), copyIdx);
+        EXPECT_EQ(_db.flippedCopy(2), copyIdx);
+        EXPECT_EQ(_db.flippedOriginal(copyIdx), 2u);
+        EXPECT_EQ(_db.flippedOriginal(2), INDEX_TYPE_MAX);
+        EXPECT_EQ(_db.flippedOriginal(4), INDEX_TYPE_MAX);
+        std::string filename = ::testing::TempDir() + "magical_flipped.ckpt";
+        ASSERT_TRUE(_db.save(filename));
+        DesignDB loaded;
+        ASSERT_TRUE(loaded.load(filename));
+        EXPECT_EQ(loaded.flippedCopy(2), copyIdx);
+        EXPECT_EQ(loaded.flippedOriginal(copyIdx), 2u);
+        std::remove(filename.c_str());
+        // Merging the copies back forgets them
+        EXPECT_EQ(_db.dedupDevices(), 2u);
+        EXPECT_EQ(_db.numCkts(), 4u);
+        EXPECT_EQ(_db.flippedCopy(2), INDEX_TYPE_MAX);
+        _db.flippedCopyOf(2, "ckt2_mirror");
+        _db.resizeSubCkts(4);
+        EXPECT_EQ(_db.flippedCopy(2), INDEX_TYPE_MAX);
+    }
+
+    // Test the edits dirty the ancestors and the updated hashes match a full recompute
+    TEST_F(DesignDBTest, ecoTest)
+    {
+        initSimpleHierarchy();
+        for (IndexType cktIdx = 0; cktIdx < _db.numCkts(); ++cktIdx)
+        {
+            _db.subCkt(cktIdx).allocateNet();
+            _db.subCkt(cktIdx).clearJournal();
+        }
+        _db.computeStructHashes();
+        EXPECT_EQ(_db.propagateEdits(), 0u);
+        // 3->1 becomes 3->0
+        _db.subCkt(3).removeNode(0);
+        _db.subCkt(3).addNode("X0", 0, { 0 });
+        EXPECT_EQ(_db.propagateEdits(), 4u);
+        EXPECT_EQ(_db.dirtyCkts(), (std::vector<IndexType>{ 2, 3, 5, 6 }));
+        EXPECT_FALSE(_db.isDirty(4));
+        _db.updateDirty();
+        EXPECT_FALSE(_db.isDirty(3));
+        EXPECT_TRUE(_db.subCkt(3).isFinalized());
+        std::vector<HashType> hashes;
+        for (IndexType cktIdx = 0; cktIdx < _db.numCkts(); ++cktIdx)
+        {
+            hashes.emplace_back(_db.structHash(cktIdx));
+        }
+        _db.computeStructHashes();
+        for (IndexType cktIdx = 0; cktIdx < _db.numCkts(); ++cktIdx)
+        {
+            EXPECT_EQ(hashes[cktIdx], _db.structHash(cktIdx));
+        }
+        // The parents follow the edits: 1 is now only under 4
+        _db.subCkt(1).markPropEdited();
+        EXPECT_EQ(_db.propagateEdits(), 3u);
+        EXPECT_EQ(_db.dirtyCkts(), (std::vector<IndexType>{ 1, 4, 6 }));        _db.updateDirty();
+        // A node moved to another subgraph through its view edits the circuit without a journal entry: 4->1 becomes 4->0
+        _db.subCkt(4).node(1).setSubgraphIdx(0);
+        EXPECT_EQ(_db.propagateEdits(), 2u);
+        EXPECT_EQ(_db.dirtyCkts(), (std::vector<IndexType>{ 4, 6 }));
+        _db.updateDirty();
+        EXPECT_EQ(_db.propagateEdits(), 0u);
+        // 1 is not instantiated any more
+        _db.subCkt(1).markPropEdited();
+        EXPECT_EQ(_db.propagateEdits(), 1u);
+    }
+
+    // Test the circuits keep their addresses as more are allocated, and the storage grows by chunks
+    TEST_F(DesignDBTest, stableCktsTest)
+    {
+        initSimpleHierarchy();
+        _db.findRootCkt();
+        CktGraph &root = _db.subCkt(_db.rootCktIdx());
+        const CktGraph *first = &_db.subCkt(0);
+        IndexType numCkts = _db.numCkts();
+        EXPECT_LT(_db.ckts().capacity(), 100u);
+        for (IndexType idx = 0; idx < 20000; ++idx)
+        {
+            _db.subCkt(_db.allocateCkt()).setName("extra" + std::to_string(idx));
+        }
+        EXPECT_EQ(_db.numCkts(), numCkts + 20000);
+        EXPECT_EQ(&_db.subCkt(0), first);
+        EXPECT_EQ(&_db.subCkt(_db.rootCktIdx()), &root);
+        EXPECT_EQ(_db.findCkt("extra19999"), numCkts + 19999);
+        EXPECT_EQ(_db.subCkt(numCkts + 123).name(), "extra123");
+        IndexType numSeen = 0;
+        for (const CktGraph &ckt : _db.ckts())
+        {
+            EXPECT_EQ(&ckt, &_db.subCkt(numSeen));
+            ++numSeen;
+        }
+        EXPECT_EQ(numSeen, _db.numCkts());
+        _db.resizeSubCkts(numCkts);
+        EXPECT_EQ(&_db.subCkt(0), first);
+        EXPECT_LT(_db.ckts().capacity(), 100u);
+        EXPECT_THROW(_db.subCkt(numCkts), std::out_of_range);
+    }
+
+    // Test a checkpoint restores the circuits, the properties, the layouts and the implementation state
+    TEST_F(DesignDBTest, checkpointTest)
+    {
+        initSimpleHierarchy();
+        CktGraph &dev = _db.subCkt(0);
+        dev.setName("nch_dev");
+        dev.build(std::vector<IndexType>{ INDEX_TYPE_MAX }, std::vector<IndexType>{ 0, 0, 0 },
+                  std::vector<IndexType>{ 0, 1, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+        dev.setNetNames({ "d", "g", "s" });
+        dev.net(1).setIoPos(0);
+        dev.net(1).setIoShape(1, 2, 3, 4);
+        dev.node(0).setOffset(7, -8);
+        dev.setImplType(ImplType::PCELL_Nch);
+        dev.setImplIdx(_db.phyPropDB().allocateNch());
+        _db.phyPropDB().nch(0).setWidth(400);
+        _db.phyPropDB().nch(0).setAttr("nch_lvt");
+        _db.phyPropDB().nch(0).appendBulkCon(2);
+        CktGraph &top = _db.subCkt(6);
+        top.setName("top");
+        top.layout().insertRect(3, 0, 0, 10, 20);
+        top.layout().setRectDatatype(3, 0, 2);
+        top.layout().insertText(5, "VDD", 1, 2);
+        top.setIsImpl(true);
+        TechDB tech;
+        tech.units().setDbu(2000);
+        tech.addNewLayer(17, "M1");
+        tech.addNewLayer(17, "M1_PIN", 251);
+        LefVia via;
+        via.name = "VIA12";
+        via.shapes.emplace_back(0, Box<LocType>(-1, -1, 1, 1));
+        auto lef = std::make_shared<LefTables>();
+        lef->vias.emplace_back(std::move(via));
+        tech.setLef(lef);
+        top.setTechDB(tech);
+        _db.finalize();
+        std::string filename = ::testing::TempDir() + "magical_design.ckpt";
+        ASSERT_TRUE(_db.save(filename));
+
+        DesignDB loaded;
+        ASSERT_TRUE(loaded.load(filename));
+        ASSERT_EQ(loaded.numCkts(), 7u);
+        EXPECT_EQ(loaded.rootCktIdx(), 6u);
+        EXPECT_EQ(loaded.findCkt("nch_dev"), 0u);
+        loaded.subCkt(0).setName("nch_dev0");
+        EXPECT_EQ(loaded.findCkt("nch_dev0"), 0u);
+        loaded.subCkt(0).setName("nch_dev");
+        EXPECT_EQ(loaded.subtreeCkts(4), (std::vector<IndexType>{ 0, 1, 4 }));
+        CktGraph &loadedDev = loaded.subCkt(0);
+        EXPECT_TRUE(loadedDev.isFinalized());
+        EXPECT_EQ(loadedDev.numPins(), 3u);
+        EXPECT_EQ(loadedDev.pinNet(2), 2u);
+        EXPECT_EQ(loadedDev.findNet("g"), 1u);
+        EXPECT_TRUE(loadedDev.net(1).isIo());
+        EXPECT_EQ(loadedDev.net(1).ioShape(), Box<LocType>(1, 2, 3, 4));
+        EXPECT_EQ(loadedDev.node(0).offset(), XY<LocType>(7, -8));
+        EXPECT_EQ(loadedDev.implType(), ImplType::PCELL_Nch);
+        EXPECT_EQ(loaded.phyPropDB().nch(loadedDev.implIdx()).width(), 400);
+        EXPECT_EQ(loaded.phyPropDB().nch(0).attr(), "nch_lvt");
+        EXPECT_EQ(loaded.phyPropDB().nch(0).bulkCon(0), 2u);
+        EXPECT_EQ(loaded.structHash(0), _db.structHash(0));
+        // The layouts are read on demand
+        CktGraph &loadedTop = loaded.subCkt(6);
+        EXPECT_TRUE(loadedTop.isImpl());
+        EXPECT_FALSE(loadedTop.isLayoutLoaded());
+        ASSERT_EQ(loadedTop.layout().numRects(3), 1u);
+        EXPECT_TRUE(loadedTop.isLayoutLoaded());
+        EXPECT_EQ(loadedTop.layout().rect(3, 0).rect(), Box<LocType>(0, 0, 10, 20));
+        EXPECT_EQ(loadedTop.layout().rect(3, 0).datatype(), 2u);
+        EXPECT_EQ(loadedTop.layout().text(5, 0).text(), "VDD");
+        EXPECT_EQ(loadedTop.layout().boundary(), top.layout().boundary());
+        // The tech is restored and the circuits without one keep the default
+        const TechDB &loadedTech = loadedTop.techDB();
+        EXPECT_EQ(loadedTech.numLayers(), 2u);
+        EXPECT_EQ(loadedTech.layerNameToIdx("M1_PIN"), 1u);
+        EXPECT_EQ(loadedTech.pdkLayerToDb(17, 251), 1u);
+        EXPECT_EQ(loadedTech.pdkLayerToDb(17, 3), 0u);
+        EXPECT_EQ(loadedTech.dbLayerToPdkDatatype(1, DRAWING_DATATYPE), 251u);
+        // The copies of the tech share the LEF data
+        EXPECT_EQ(top.techDB().sharedLef(), tech.sharedLef());
+        ASSERT_EQ(loadedTech.lefVias().size(), 1u);
+        EXPECT_EQ(loadedTech.lefVias()[0].shapes[0].rect, Box<LocType>(-1, -1, 1, 1));
+        EXPECT_EQ(loadedDev.techDB().numLayers(), 0u);
+        EXPECT_EQ(loadedTech.units().dbu(), 2000);
+
+        // Saving over the mapped checkpoint copies the layouts not read yet
+        loadedTop.layout().insertRect(3, 5, 5, 6, 6);
+        ASSERT_TRUE(loaded.save(filename));
+        ASSERT_TRUE(_db.load(filename, false));
+        EXPECT_TRUE(_db.subCkt(6).isLayoutLoaded());
+        EXPECT_EQ(_db.subCkt(6).layout().numRects(3), 2u);
+        EXPECT_EQ(_db.subCkt(0).layout().numRects(3), 0u);
+
+        // A truncated file is rejected and the design is kept
+        {
+            std::ofstream truncated(filename, std::ios::binary | std::ios::trunc);
+            truncated << "MAGICKPT";
+        }
+        EXPECT_FALSE(_db.load(filename));
+        EXPECT_EQ(_db.numCkts(), 7u);
+
+        // The names of a rejected file are not interned
+        ASSERT_TRUE(_db.save(filename));
+        std::string header;
+        {
+            std::ifstream saved(filename, std::ios::binary);
+            header.resize(16);
+            saved.read(&header[0], header.size());
+        }
+        {
+            std::ofstream truncated(filename, std::ios::binary | std::ios::trunc);
+            truncated.write(header.data(), header.size());
+            BinaryWriter out(truncated);
+            out.write<IndexType>(2);
+            out.writeString("");
+            out.writeString("never_interned_net");
+        }
+        EXPECT_FALSE(_db.load(filename));
+        EXPECT_EQ(SymbolTable::global().find("never_interned_net"), INDEX_TYPE_MAX);
+
+        // An invalid subgraph and a cycle are rejected before the design is replaced
+        _db.subCkt(0).node(0).setSubgraphIdx(7);
+        ASSERT_TRUE(_db.save(filename));
+        EXPECT_FALSE(loaded.load(filename));
+        _db.subCkt(0).node(0).setSubgraphIdx(6);
+        ASSERT_TRUE(_db.save(filename));
+        EXPECT_FALSE(loaded.load(filename));
+        EXPECT_EQ(loaded.numCkts(), 7u);
+        EXPECT_EQ(loaded.rootCktIdx(), 6u);
+        EXPECT_EQ(loaded.subtreeCkts(4), (std::vector<IndexType>{ 0, 1, 4 }));
+        std::remove(filename.c_str());
+    }
+
+    // Test a checkpoint taken between the placement and the routing resumes the circuit as before its placement
+    TEST_F(DesignDBTest, checkpointMidImplTest)
+    {
+        initSimpleHierarchy();
+        _db.subCkt(0).setIsImpl(true);
+        _db.subCkt(1).setIsImpl(true);
+        CktGraph &ckt = _db.subCkt(4);
+        IndexType netIdx = ckt.allocateNet();
+        IndexType pinIdx = ckt.allocatePin();
+        ckt.pin(pinIdx).setNodeIdx(0);
+        ckt.pin(pinIdx).setNetIdx(netIdx);
+        ckt.node(0).appendPinIdx(pinIdx);
+        ckt.net(netIdx).appendPinIdx(pinIdx);
+        // Place: the placer adds an IO pin node on a circuit of its own, and places the nodes
+        auto place = [&]()
+        {
+            CktGraph &placed = _db.subCkt(4);
+            placed.beginImpl();
+            IndexType ioNodeIdx = placed.allocateNode();
+            IndexType ioPinIdx = placed.allocatePin();
+            placed.pin(ioPinIdx).setNodeIdx(ioNodeIdx);
+            placed.pin(ioPinIdx).setNetIdx(netIdx);
+            placed.node(ioNodeIdx).appendPinIdx(ioPinIdx);
+            placed.net(netIdx).appendPinIdx(ioPinIdx);
+            IndexType ioCktIdx = _db.allocateCkt();
+            _db.subCkt(ioCktIdx).setIsImpl(true);
+            placed.node(ioNodeIdx).setSubgraphIdx(ioCktIdx);
+            placed.net(netIdx).addIoPin(0, 0, 2, 2, 1);
+            placed.node(1).setOffset(10, 0);
+            placed.layout().insertRect(1, 0, 0, 12, 4);
+        };
+        place();
+        EXPECT_TRUE(ckt.isImplInProgress());
+        std::string filename = ::testing::TempDir() + "magical_mid_impl.ckpt";
+        ASSERT_TRUE(_db.save(filename));
+        // The design keeps the placement for the routing
+        EXPECT_EQ(ckt.numNodes(), 3u);
+        EXPECT_EQ(ckt.net(netIdx).numIoPins(), 1u);
+        EXPECT_EQ(ckt.layout().numRects(1), 1u);
+
+        DesignDB resumed;
+        ASSERT_TRUE(resumed.load(filename));
+        CktGraph &saved = resumed.subCkt(4);
+        EXPECT_FALSE(saved.isImpl());
+        EXPECT_FALSE(saved.isImplInProgress());
+        EXPECT_EQ(saved.numNodes(), 2u);
+        EXPECT_EQ(saved.numPins(), 1u);
+        EXPECT_EQ(saved.net(netIdx).pinIdxArray(), (std::vector<IndexType>{ pinIdx }));
+        EXPECT_EQ(saved.node(0).pinIdxArray(), (std::vector<IndexType>{ pinIdx }));
+        EXPECT_EQ(saved.net(netIdx).numIoPins(), 1u);
+        EXPECT_EQ(saved.net(netIdx).ioLayer(), INDEX_TYPE_MAX);
+        EXPECT_EQ(saved.node(1).offset(), XY<LocType>(0, 0));
+        EXPECT_EQ(saved.layout().numRects(1), 0u);
+        EXPECT_TRUE(resumed.subCkt(0).isImpl());
+
+        // The resumed placement adds its IO pin once
+        _db = std::move(resumed);
+        place();
+        EXPECT_EQ(_db.subCkt(4).numNodes(), 3u);
+        EXPECT_EQ(_db.subCkt(4).numPins(), 2u);
+        EXPECT_EQ(_db.subCkt(4).net(netIdx).numPins(), 2u);
+        EXPECT_EQ(_db.subCkt(4).net(netIdx).numIoPins(), 1u);
+        _db.subCkt(4).setIsImpl(true);
+        EXPECT_FALSE(_db.subCkt(4).isImplInProgress());
+        // Once routed, the circuit is saved as implemented
+        ASSERT_TRUE(_db.save(filename));
+        ASSERT_TRUE(resumed.load(filename));
+        EXPECT_TRUE(resumed.subCkt(4).isImpl());
+        EXPECT_EQ(resumed.subCkt(4).numNodes(), 3u);
+        EXPECT_EQ(resumed.subCkt(4).layout().numRects(1), 1u);
+        std::remove(filename.c_str());
+    }
+
+    // Test identical and mirrored layouts are shared and copied on the first edit
+    TEST_F(DesignDBTest, shareLayoutTest)
+    {
+        for (IndexType idx = 0; idx < 4; ++idx)
+        {
+            _db.allocateCkt();
+            Layout &layout = _db.subCkt(idx).layout();
+            layout.insertRect(1, 0, 0, 10, 20);
+            layout.insertRect(2, 2, 0, 4, 5);
+            layout.insertText(2, "G", 3, 1);
+            layout.setBoundary(0, 0, 10, 20);
+        }
+        // 1 is identical to 0, 2 is mirrored and 3 differs
+        _db.subCkt(2).layout().flipVert();
+        _db.subCkt(3).layout().insertRect(1, 0, 0, 1, 1);
+        Layout mirrored = _db.subCkt(0).layout();
+        mirrored.flipVert();
+        EXPECT_EQ(mirrored.rect(2, 0).rect(), Box<LocType>(6, 0, 8, 5));
+        EXPECT_EQ(mirrored.text(2, 0).coord(), XY<LocType>(7, 1));
+        EXPECT_TRUE(mirrored.equals(_db.subCkt(0).layout(), true));
+        EXPECT_EQ(mirrored.hash(), _db.subCkt(0).layout().hash(true));
+
+        EXPECT_EQ(_db.shareIdenticalLayouts(), 2u);
+        CktGraph &master = _db.subCkt(0);
+        CktGraph &copy = _db.subCkt(1);
+        CktGraph &flipped = _db.subCkt(2);
+        EXPECT_TRUE(master.isLayoutShared());
+        EXPECT_TRUE(copy.isLayoutShared());
+        EXPECT_TRUE(flipped.isLayoutShared());
+        EXPECT_FALSE(_db.subCkt(3).isLayoutShared());
+        EXPECT_EQ(&copy.layoutSource(), &master.layoutSource());
+        EXPECT_EQ(&flipped.layoutSource(), &master.layoutSource());
+        EXPECT_TRUE(flipped.layoutSourceFlipVert());
+        EXPECT_EQ(flipped.layoutBoundary(), Box<LocType>(0, 0, 10, 20));
+
+        // Reading through the sharing circuit applies the mirror without copying
+        Layout parent;
+        flipped.insertLayoutInto(parent, 100, 0, false);
+        EXPECT_EQ(parent.rect(2, 0).rect(), Box<LocType>(106, 0, 108, 5));
+        EXPECT_TRUE(flipped.isLayoutShared());
+
+        // Editing copies the layout. The others keep the shared one
+        flipped.layout().insertRect(3, 0, 0, 1, 1);
+        EXPECT_FALSE(flipped.isLayoutShared());
+        EXPECT_FALSE(flipped.layout().equals(mirrored));
+        EXPECT_EQ(flipped.layout().rect(2, 0).rect(), Box<LocType>(6, 0, 8, 5));
+        EXPECT_EQ(master.layoutSource().numRects(3), 0u);
+        EXPECT_EQ(copy.layout().numRects(3), 0u);
+        EXPECT_FALSE(copy.isLayoutShared());
+        // The last one takes the shared layout
+        EXPECT_EQ(master.layout().numRects(1), 1u);
+        EXPECT_FALSE(master.isLayoutShared());
+    }
+
+    // Test the layouts are shared one circuit at a time as they are produced, and saved and loaded shared
+    TEST_F(DesignDBTest, shareIdenticalLayoutTest)
+    {
+        for (IndexType idx = 0; idx < 3; ++idx)
+        {
+            _db.allocateCkt();
+            Layout &layout = _db.subCkt(idx).layout();
+            layout.insertRect(1, 0, 0, 10, 20);
+            layout.insertRect(2, 2, 0, 4, 5);
+            layout.setBoundary(0, 0, 10, 20);
+        }
+        _db.subCkt(1).layout().flipVert();
+        // The first one is offered, the mirrored one shares it, and offering a circuit again changes nothing
+        EXPECT_FALSE(_db.shareIdenticalLayout(0));
+        EXPECT_FALSE(_db.subCkt(0).isLayoutShared());
+        EXPECT_TRUE(_db.shareIdenticalLayout(1));
+        EXPECT_TRUE(_db.subCkt(1).layoutSourceFlipVert());
+        EXPECT_FALSE(_db.shareIdenticalLayout(0));
+        EXPECT_TRUE(_db.shareIdenticalLayout(1));
+        // A layout not offered yet is not shared
+        EXPECT_FALSE(_db.subCkt(2).isLayoutShared());
+        EXPECT_TRUE(_db.shareIdenticalLayout(2));
+        EXPECT_EQ(&_db.subCkt(2).layoutSource(), &_db.subCkt(0).layoutSource());
+        EXPECT_FALSE(_db.subCkt(2).layoutSourceFlipVert());
+
+        // The shared layout is written once and loaded shared
+        std::string filename = ::testing::TempDir() + "magical_shared.ckpt";
+        ASSERT_TRUE(_db.save(filename));
+        std::uint64_t sharedSize = std::ifstream(filename, std::ios::binary | std::ios::ate).tellg();
+        // Taking the layout to edit copies it, and the copy is written on its own
+        _db.subCkt(2).layout();
+        EXPECT_FALSE(_db.subCkt(2).isLayoutShared());
+        ASSERT_TRUE(_db.save(filename));
+        std::uint64_t unsharedSize = std::ifstream(filename, std::ios::binary | std::ios::ate).tellg();
+        EXPECT_GT(unsharedSize, sharedSize);
+        EXPECT_EQ(_db.shareIdenticalLayouts(), 1u);
+        ASSERT_TRUE(_db.save(filename));
+        DesignDB loaded;
+        ASSERT_TRUE(loaded.load(filename));
+        for (IndexType idx : { 1, 2 })
+        {
+            EXPECT_TRUE(loaded.subCkt(idx).isLayoutShared());
+            EXPECT_EQ(&loaded.subCkt(idx).layoutSource(), &loaded.subCkt(0).layoutSource());
+        }
+        EXPECT_TRUE(loaded.subCkt(1).layoutSourceFlipVert());
+        EXPECT_FALSE(loaded.subCkt(2).layoutSourceFlipVert());
+        EXPECT_TRUE(loaded.subCkt(1).layout().equals(_db.subCkt(1).layout()));
+        EXPECT_EQ(loaded.subCkt(1).layout().rect(2, 0).rect(), Box<LocType>(6, 0, 8, 5));
+        std::remove(filename.c_str());
+    }
+
+    // Test the memory report counts the capacity, a shared layout once, and ranks the circuits
+    TEST_F(DesignDBTest, memoryReportTest)
+    {
+        initSimpleHierarchy();
+        CktGraph &top = _db.subCkt(6);
+        top.setName("top");
+        top.pinArray().reserve(100);
+        for (IndexType idx = 0; idx < 100; ++idx)
+        {
+            top.layout().insertRect(3, 0, 0, idx, idx);
+        }
+        top.layout().insertText(5, std::string(64, 'x'), 0, 0);
+        _db.subCkt(1).layout().insertRect(7, 0, 0, 1, 1);
+        _db.subCkt(2).layout().insertRect(7, 0, 0, 1, 1);
+
+        MemoryReport report = _db.memoryReport(2);
+        ASSERT_EQ(report.ckts.size(), 7u);
+        const CktMemory &usage = report.ckts[6];
+        EXPECT_EQ(usage.graph, sizeof(CktGraph));
+        EXPECT_EQ(usage.pins, 100 * sizeof(Pin));
+        std::uint64_t layer3 = top.layout().layerBytes(3);
+        EXPECT_GE(layer3, 100 * sizeof(RectLayout));
+        EXPECT_EQ(top.layout().layerBytes(5), sizeof(TextLayout) + 65);
+        EXPECT_EQ(report.layoutLayers[3], layer3);
+        EXPECT_EQ(usage.layout, top.layout().tableBytes() + layer3 + top.layout().layerBytes(5));
+        ASSERT_EQ(report.heaviest.size(), 2u);
+        EXPECT_EQ(report.heaviest[0], 6u);
+        for (IndexType cktIdx = 0; cktIdx < 6; ++cktIdx)
+        {
+            EXPECT_LE(report.ckts[cktIdx].total(), report.ckts[report.heaviest[1]].total());
+        }
+        // The symbol table is shared by every design and is not charged to this one
+        EXPECT_EQ(report.processSymbols, SymbolTable::global().heapBytes());
+        EXPECT_GT(report.processSymbols, 0u);
+        EXPECT_EQ(report.total(), report.cktTotal() + report.phyProps + report.design);
+
+        // A shared layout is counted once
+        std::uint64_t before = report.ckts[1].layout + report.ckts[2].layout;
+        _db.shareIdenticalLayouts();
+        MemoryReport shared = _db.memoryReport();
+        EXPECT_EQ(shared.numSharedLayouts, 4u);
+        EXPECT_LT(shared.ckts[1].layout + shared.ckts[2].layout, before);
+        EXPECT_EQ(shared.layoutLayers[7], report.layoutLayers[7] / 2);
+        EXPECT_EQ(shared.ckts[6].layout, usage.layout);
+    }
 } // End of the unittest namespace
 
 PROJECT_NAMESPACE_END
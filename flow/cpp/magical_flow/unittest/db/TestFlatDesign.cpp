@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include "db/DesignDB.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class FlatDesignTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                /*
+                 * 0: nch, 1: pch, with pins (d, g, s)
+                 * 2: cell with nets (in, out, gnd, mid) and M0 = nch(out, in, gnd), M1 = nch(mid, in, gnd), M2 = pch(out, mid, gnd)
+                 * 3: top with nets (a, b, c, gnd) and X0 = cell(a, b, gnd), X1 = cell(b, c, gnd)
+                 */
+                for (IndexType idx = 0; idx < 4; ++idx)
+                {
+                    _db.allocateCkt();
+                }
+                for (IndexType cktIdx = 0; cktIdx < 2; ++cktIdx)
+                {
+                    CktGraph &dev = _db.subCkt(cktIdx);
+                    dev.build(std::vector<IndexType>{ INDEX_TYPE_MAX }, std::vector<IndexType>{ 0, 0, 0 },
+                              std::vector<IndexType>{ 0, 1, 2 }, Span<const IntType>(), std::vector<IntType>(3, 0));
+                    dev.setImplType(cktIdx == 0 ? ImplType::PCELL_Nch : ImplType::PCELL_Pch);
+                }
+                CktGraph &cell = _db.subCkt(2);
+                cell.build(std::vector<IndexType>{ 0, 0, 1 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1, 2, 2, 2 },
+                           std::vector<IndexType>{ 1, 0, 2, 3, 0, 2, 1, 3, 2 }, Span<const IntType>(), std::vector<IntType>(4, 0));
+                cell.setNodeNames({ "M0", "M1", "M2" }, {});
+                for (IndexType pinIdx = 0; pinIdx < cell.numPins(); ++pinIdx)
+                {
+                    cell.pin(pinIdx).setIntNetIdx(pinIdx % 3);
+                }
+                CktGraph &top = _db.subCkt(3);
+                top.build(std::vector<IndexType>{ 2, 2 }, std::vector<IndexType>{ 0, 0, 0, 1, 1, 1 },
+                          std::vector<IndexType>{ 0, 1, 3, 1, 2, 3 }, Span<const IntType>(), std::vector<IntType>(4, 0));
+                top.setNodeNames({ "X0", "X1" }, {});
+                for (IndexType pinIdx = 0; pinIdx < top.numPins(); ++pinIdx)
+                {
+                    top.pin(pinIdx).setIntNetIdx(pinIdx % 3);
+                }
+                _db.findRootCkt();
+            }
+            DesignDB _db; ///< The db under test
+    };
+
+    // Test the instance paths are in preorder and named from the node names
+    TEST_F(FlatDesignTest, pathTest)
+    {
+        FlatDesign flat = _db.flatten();
+        ASSERT_EQ(flat.numPaths(), 9u);
+        EXPECT_EQ(flat.pathParent(0), INDEX_TYPE_MAX);
+        EXPECT_EQ(flat.pathCkt(0), 3u);
+        EXPECT_EQ(flat.pathName(0), "");
+        EXPECT_EQ(flat.pathName(1), "X0");
+        EXPECT_EQ(flat.pathName(7), "X1/M1");
+        EXPECT_EQ(flat.pathName(8, "."), "X1.M2");
+        EXPECT_EQ(flat.pathParent(7), 5u);
+        EXPECT_EQ(flat.pathNode(7), 1u);
+        EXPECT_EQ(flat.pathCkt(5), 2u);
+    }
+
+    // Test the devices and the nets merged across the levels
+    TEST_F(FlatDesignTest, deviceNetTest)
+    {
+        FlatDesign flat = _db.flatten();
+        ASSERT_EQ(flat.numDevices(), 6u);
+        EXPECT_EQ(flat.deviceMasters(), (std::vector<IndexType>{ 0, 0, 1, 0, 0, 1 }));
+        EXPECT_EQ(flat.devicePath(3), 6u);
+        // a, b, c, gnd and the mid net of each cell
+        ASSERT_EQ(flat.numNets(), 6u);
+        IndexType a = flat.flatNet(0, 0);
+        IndexType b = flat.flatNet(0, 1);
+        IndexType c = flat.flatNet(0, 2);
+        IndexType gnd = flat.flatNet(0, 3);
+        EXPECT_EQ(flat.flatNet(1, 0), a);
+        EXPECT_EQ(flat.flatNet(1, 1), b);
+        EXPECT_EQ(flat.flatNet(5, 0), b);
+        EXPECT_EQ(flat.flatNet(5, 1), c);
+        EXPECT_EQ(flat.flatNet(5, 2), gnd);
+        IndexType mid0 = flat.flatNet(1, 3);
+        IndexType mid1 = flat.flatNet(5, 3);
+        EXPECT_NE(mid0, mid1);
+        // The flat nets are named by their highest nets
+        EXPECT_EQ(flat.netPath(b), 0u);
+        EXPECT_EQ(flat.netIdx(b), 1u);
+        EXPECT_EQ(flat.netPath(mid1), 5u);
+        EXPECT_EQ(flat.netIdx(mid1), 3u);
+        // X0/M0 = nch(b, a, gnd), X1/M2 = pch(c, mid1, gnd)
+        auto nets = flat.deviceNets(0);
+        EXPECT_EQ(std::vector<IndexType>(nets.begin(), nets.end()), (std::vector<IndexType>{ b, a, gnd }));
+        nets = flat.deviceNets(5);
+        EXPECT_EQ(std::vector<IndexType>(nets.begin(), nets.end()), (std::vector<IndexType>{ c, mid1, gnd }));
+        EXPECT_THROW(flat.deviceNets(6), std::out_of_range);
+        EXPECT_THROW(flat.flatNet(1, 4), std::out_of_range);
+        EXPECT_THROW(flat.build(_db, _db.numCkts()), std::out_of_range);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,279 @@
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include "db/DesignDB.h"
+#include "db/ImplCache.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class ImplCacheTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                build(_db);
+            }
+            /// @brief build the design
+            void build(DesignDB &db)
+            {
+                /*
+                 * top(2) -> amp(1) x2 -> nch(0)
+                 */
+                for (IndexType idx = 0; idx < 3; ++idx)
+                {
+                    db.allocateCkt();
+                }
+                CktGraph &dev = db.subCkt(0);
+                dev.setName("nch");
+                dev.build(std::vector<IndexType>{ INDEX_TYPE_MAX }, std::vector<IndexType>{ 0, 0 },
+                          std::vector<IndexType>{ 0, 1 }, Span<const IntType>(), std::vector<IntType>(2, 0));
+                dev.setNetNames({ "d", "s" });
+                dev.setImplType(ImplType::PCELL_Nch);
+                dev.setImplIdx(db.phyPropDB().allocateNch());
+                db.phyPropDB().nch(0).setWidth(400);
+                CktGraph &amp = db.subCkt(1);
+                amp.setName("amp");
+                amp.build(std::vector<IndexType>{ 0 }, std::vector<IndexType>{ 0, 0 },
+                          std::vector<IndexType>{ 0, 1 }, Span<const IntType>(), std::vector<IntType>(2, 0));
+                amp.setNetNames({ "out", "vss" });
+                amp.node(0).setName("M0");
+                CktGraph &top = db.subCkt(2);
+                top.setName("top");
+                top.build(std::vector<IndexType>{ 1, 1 }, std::vector<IndexType>{ 0, 0, 1, 1 },
+                          std::vector<IndexType>{ 0, 1, 0, 1 }, Span<const IntType>(), std::vector<IntType>(2, 0));
+                top.setNetNames({ "x", "gnd" });
+                top.node(0).setName("X0");
+                top.node(1).setName("X1");
+                db.findRootCkt();
+            }
+            void TearDown() override
+            {
+                for (const std::string &filename : _files)
+                {
+                    std::remove(filename.c_str());
+                }
+            }
+            /// @brief fingerprint all the circuits bottom-up
+            void fingerprintAll(ImplCache &cache, HashType topSalt = 0)
+            {
+                for (IndexType cktIdx : { 0, 1, 2 })
+                {
+                    cache.computeFingerprint(cktIdx, cktIdx == 2 ? topSalt : 0);
+                }
+            }
+            DesignDB _db; ///< The db under test
+            std::vector<std::string> _files; ///< The entries to remove
+    };
+
+    // Test an entry restores the implementation of an identical circuit
+    TEST_F(ImplCacheTest, storeRestoreTest)
+    {
+        ImplCache cache(_db, ::testing::TempDir());
+        fingerprintAll(cache);
+        CktGraph &amp = _db.subCkt(1);
+        amp.node(0).setOffset(10, 20);
+        amp.node(0).setFlipVertFlag(true);
+        amp.net(0).setIoShape(1, 2, 3, 4);
+        amp.net(0).setIoLayer(2);
+        amp.net(0).addIoPin(5, 6, 7, 8, 3);
+        amp.gdsData().setBBox(0, 0, 100, 50);
+        amp.layout().insertRect(1, 0, 0, 100, 50);
+        amp.layout().insertText(2, "out", 1, 2);
+        _files.push_back(cache.entryFile(1));
+        EXPECT_FALSE(cache.contains(1));
+        ASSERT_TRUE(cache.store(1));
+        EXPECT_TRUE(cache.contains(1));
+
+        // The same design built again, as in the next run of the flow
+        DesignDB next;
+        build(next);
+        ImplCache other(next, ::testing::TempDir());
+        fingerprintAll(other);
+        EXPECT_EQ(other.fingerprint(1), cache.fingerprint(1));
+        ASSERT_TRUE(other.restore(1));
+        EXPECT_EQ(other.numHits(), 1u);
+        CktGraph &amp2 = next.subCkt(1);
+        EXPECT_TRUE(amp2.isImpl());
+        EXPECT_EQ(amp2.node(0).offset(), XY<LocType>(10, 20));
+        EXPECT_TRUE(amp2.node(0).flipVertFlag());
+        ASSERT_EQ(amp2.net(0).numIoPins(), 2u);
+        EXPECT_EQ(amp2.net(0).ioShape(), Box<LocType>(1, 2, 3, 4));
+        EXPECT_EQ(amp2.net(0).ioPinMetalLayer(1), 3u);
+        EXPECT_EQ(amp2.gdsData().bbox(), Box<LocType>(0, 0, 100, 50));
+        ASSERT_EQ(amp2.layout().numRects(1), 1u);
+        EXPECT_EQ(amp2.layout().text(2, 0).text(), "out");
+        // Nothing is stored for the top
+        EXPECT_FALSE(other.restore(2));
+        EXPECT_EQ(other.numMisses(), 1u);
+        EXPECT_FALSE(next.subCkt(2).isImpl());
+    }
+
+    // Test the IO pin nodes the placer adds after fingerprinting are stored with their circuits and added again by a hit
+    TEST_F(ImplCacheTest, addedNodesTest)
+    {
+        ImplCache cache(_db, ::testing::TempDir());
+        fingerprintAll(cache);
+        // As Placer.addIoPinToNet() does
+        auto addIoPin = [](DesignDB &db, IndexType netIdx, LocType x)
+        {
+            CktGraph &amp = db.subCkt(1);
+            IndexType nodeIdx = amp.allocateNode();
+            IndexType pinIdx = amp.allocatePin();
+            amp.net(netIdx).appendPinIdx(pinIdx);
+            amp.net(netIdx).addIoPin(x, 0, x + 10, 10, 2);
+            IndexType iopinIdx = db.allocateCkt();
+            CktGraph &iopin = db.subCkt(iopinIdx);
+            iopin.setIsImpl(true);
+            iopin.allocateNet();
+            iopin.net(0).addIoPin(0, 0, 10, 10, 2);
+            iopin.layout().insertRect(2, 0, 0, 10, 10);
+            iopin.layout().setBoundary(0, 0, 10, 10);
+            amp.node(nodeIdx).setSubgraphIdx(iopinIdx);
+            amp.node(nodeIdx).appendPinIdx(pinIdx);
+            amp.pin(pinIdx).setIntNetIdx(0);
+            amp.pin(pinIdx).setNodeIdx(nodeIdx);
+            amp.pin(pinIdx).setNetIdx(netIdx);
+        };
+        addIoPin(_db, 0, 100);
+        addIoPin(_db, 1, 200);
+        _db.subCkt(1).node(2).setOffset(200, 0);
+        _db.subCkt(1).layout().insertRect(1, 0, 0, 210, 10);
+        _files.push_back(cache.entryFile(1));
+        ASSERT_TRUE(cache.store(1));
+
+        DesignDB next;
+        build(next);
+        // Another circuit allocated meanwhile, so the circuits are added at other indices
+        next.allocateCkt();
+        ImplCache other(next, ::testing::TempDir());
+        fingerprintAll(other);
+        ASSERT_TRUE(other.restore(1));
+        ASSERT_EQ(next.numCkts(), 6u);
+        CktGraph &amp = next.subCkt(1);
+        ASSERT_EQ(amp.numNodes(), 3u);
+        ASSERT_EQ(amp.numPins(), 4u);
+        EXPECT_EQ(amp.nodeSubgraphIdx()[1], 4u);
+        EXPECT_EQ(amp.nodeSubgraphIdx()[2], 5u);
+        EXPECT_EQ(amp.node(2).offset(), XY<LocType>(200, 0));
+        EXPECT_EQ(amp.pinNode(3), 2u);
+        EXPECT_EQ(amp.pinNet(3), 1u);
+        EXPECT_EQ(amp.pin(3).intNetIdx(), 0u);
+        EXPECT_EQ(std::vector<IndexType>(amp.nodePins(2).begin(), amp.nodePins(2).end()), std::vector<IndexType>{ 3 });
+        EXPECT_EQ(std::vector<IndexType>(amp.netPins(1).begin(), amp.netPins(1).end()), (std::vector<IndexType>{ 1, 3 }));
+        ASSERT_EQ(amp.net(0).numIoPins(), 1u);
+        EXPECT_EQ(amp.layout().numRects(1), 1u);
+        CktGraph &iopin = next.subCkt(5);
+        EXPECT_TRUE(iopin.isImpl());
+        ASSERT_EQ(iopin.numNets(), 1u);
+        EXPECT_EQ(iopin.net(0).ioPinShape(0), Box<LocType>(0, 0, 10, 10));
+        EXPECT_EQ(iopin.layout().numRects(2), 1u);
+        EXPECT_EQ(iopin.layout().boundary(), Box<LocType>(0, 0, 10, 10));
+        next.findRootCkt();
+        EXPECT_EQ(next.subtreeCkts(1), (std::vector<IndexType>{ 0, 4, 5, 1 }));
+    }
+
+    // Test a hit writes the result files into the result directory of the run
+    TEST_F(ImplCacheTest, resultFilesTest)
+    {
+        std::string firstDir = ::testing::TempDir() + "magical_first_";
+        std::string nextDir = ::testing::TempDir() + "magical_next_";
+        ImplCache cache(_db, ::testing::TempDir());
+        fingerprintAll(cache);
+        _db.subCkt(1).gdsData().setGdsFile(firstDir + "amp.route.gds");
+        {
+            std::ofstream route(firstDir + "amp.route.gds", std::ios::binary);
+            route << std::string("GDS\0route", 9);
+            std::ofstream ioPin(firstDir + "amp.ioPin");
+            ioPin << "out 1 2";
+        }
+        _files.insert(_files.end(), { cache.entryFile(1), firstDir + "amp.route.gds", firstDir + "amp.ioPin",
+                                      nextDir + "amp.route.gds", nextDir + "amp.ioPin" });
+        EXPECT_FALSE(cache.store(1, firstDir, { "amp.route.gds", "amp.missing" }));
+        ASSERT_TRUE(cache.store(1, firstDir, { "amp.route.gds", "amp.ioPin" }));
+
+        DesignDB next;
+        build(next);
+        ImplCache other(next, ::testing::TempDir());
+        fingerprintAll(other);
+        ASSERT_TRUE(other.restore(1, nextDir));
+        EXPECT_EQ(next.subCkt(1).gdsData().gdsFile(), nextDir + "amp.route.gds");
+        std::ifstream route(nextDir + "amp.route.gds", std::ios::binary);
+        EXPECT_EQ(std::string((std::istreambuf_iterator<char>(route)), std::istreambuf_iterator<char>()), std::string("GDS\0route", 9));
+        std::ifstream ioPin(nextDir + "amp.ioPin");
+        std::string line;
+        std::getline(ioPin, line);
+        EXPECT_EQ(line, "out 1 2");
+
+        // A result file that cannot be written is a miss
+        DesignDB unwritable;
+        build(unwritable);
+        ImplCache third(unwritable, ::testing::TempDir());
+        fingerprintAll(third);
+        EXPECT_FALSE(third.restore(1, ::testing::TempDir() + "magical_missing_dir/"));
+        EXPECT_FALSE(unwritable.subCkt(1).isImpl());
+    }
+
+    // Test an edit changes the fingerprints of the circuit and its ancestors only
+    TEST_F(ImplCacheTest, fingerprintTest)
+    {
+        ImplCache cache(_db, ::testing::TempDir());
+        fingerprintAll(cache);
+        std::vector<HashType> before = { cache.fingerprint(0), cache.fingerprint(1), cache.fingerprint(2) };
+        EXPECT_NE(before[0], before[1]);
+        EXPECT_EQ(cache.computeFingerprint(2, 0), before[2]);
+        EXPECT_NE(cache.computeFingerprint(2, 1), before[2]);
+
+        // Rename a net of amp
+        _db.subCkt(1).net(0).setName("vout");
+        ImplCache renamed(_db, ::testing::TempDir());
+        fingerprintAll(renamed);
+        EXPECT_EQ(renamed.fingerprint(0), before[0]);
+        EXPECT_NE(renamed.fingerprint(1), before[1]);
+        EXPECT_NE(renamed.fingerprint(2), before[2]);
+
+        // Resize the device
+        _db.subCkt(1).net(0).setName("out");
+        _db.phyPropDB().nch(0).setWidth(800);
+        ImplCache resized(_db, ::testing::TempDir());
+        fingerprintAll(resized);
+        EXPECT_NE(resized.fingerprint(0), before[0]);
+        EXPECT_NE(resized.fingerprint(1), before[1]);
+        EXPECT_NE(resized.fingerprint(2), before[2]);
+
+        // The salt of a sub circuit reaches its ancestors
+        ImplCache salted(_db, ::testing::TempDir());
+        salted.computeFingerprint(0, 1);
+        salted.computeFingerprint(1, 0);
+        salted.computeFingerprint(2, 0);
+        EXPECT_NE(salted.fingerprint(1), resized.fingerprint(1));
+        EXPECT_NE(salted.fingerprint(2), resized.fingerprint(2));
+    }
+
+    // Test a corrupted entry is a miss and leaves the circuit unchanged
+    TEST_F(ImplCacheTest, corruptedTest)
+    {
+        ImplCache cache(_db, ::testing::TempDir());
+        fingerprintAll(cache);
+        _db.subCkt(1).layout().insertRect(1, 0, 0, 100, 50);
+        _files.push_back(cache.entryFile(1));
+        ASSERT_TRUE(cache.store(1));
+        {
+            std::ifstream in(cache.entryFile(1), std::ios::binary);
+            std::string data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            std::ofstream out(cache.entryFile(1), std::ios::binary | std::ios::trunc);
+            out.write(data.data(), data.size() / 2);
+        }
+        _db.subCkt(1).node(0).setOffset(3, 3);
+        EXPECT_FALSE(cache.restore(1));
+        EXPECT_EQ(cache.numMisses(), 1u);
+        EXPECT_EQ(_db.subCkt(1).node(0).offset(), XY<LocType>(3, 3));
+        EXPECT_FALSE(_db.subCkt(1).isImpl());
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include "db/DesignDB.h"
+#include "db/ImplScheduler.h"
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+
+    class ImplSchedulerTest : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                /*
+                 * 6->5, 6->4, 5->2, 5->0, 4->0, 4->1, 2->3, 3->1
+                 * 0 is a device, taken as implemented
+                 */
+                for (IndexType idx = 0; idx < 7; ++idx)
+                {
+                    _db.allocateCkt();
+                }
+                std::vector<std::pair<IndexType, IndexType>> edges = { {5, 2}, {5, 0}, {4, 0}, {4, 1}, {2, 3}, {3, 1}, {6, 5}, {6, 4} };
+                for (const auto &edge : edges)
+                {
+                    IndexType nodeIdx = _db.subCkt(edge.first).allocateNode();
+                    _db.subCkt(edge.first).node(nodeIdx).setSubgraphIdx(edge.second);
+                }
+                _db.findRootCkt();
+            }
+            /// @brief a callback recording the tasks in their finishing order
+            ImplScheduler::Callback record(IndexType stage)
+            {
+                return [this, stage](IndexType cktIdx)
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+                    _log.emplace_back(cktIdx, stage);
+                    return true;
+                };
+            }
+            /// @brief get the position of a task in the log
+            IndexType logPos(IndexType cktIdx, IndexType stage) const
+            {
+                return std::find(_log.begin(), _log.end(), std::make_pair(cktIdx, stage)) - _log.begin();
+            }
+            DesignDB _db; ///< The db under test
+            std::mutex _mutex; ///< Guards the log
+            std::vector<std::pair<IndexType, IndexType>> _log; ///< The (circuit, stage) of the finished tasks
+    };
+
+    // Test every stage runs after the same stage of the sub circuits and the previous stage of the circuit
+    TEST_F(ImplSchedulerTest, orderTest)
+    {
+        ImplScheduler scheduler(_db);
+        scheduler.addStage("place", record(0));
+        scheduler.addStage("route", record(1));
+        scheduler.build({ 1, 2, 3, 4, 5, 6 });
+        EXPECT_EQ(scheduler.numTasks(ImplTaskState::READY), 1u);
+        EXPECT_EQ(scheduler.taskState(1, 0), ImplTaskState::READY);
+        EXPECT_EQ(scheduler.taskState(6, 1), ImplTaskState::WAITING);
+        ASSERT_TRUE(scheduler.run(4));
+        ASSERT_EQ(_log.size(), 12u);
+        EXPECT_EQ(scheduler.numTasks(ImplTaskState::DONE), 12u);
+        EXPECT_TRUE(scheduler.runningTasks().empty());
+        std::vector<std::pair<IndexType, IndexType>> edges = { {5, 2}, {4, 1}, {2, 3}, {3, 1}, {6, 5}, {6, 4} };
+        for (IndexType stage = 0; stage < 2; ++stage)
+        {
+            for (const auto &edge : edges)
+            {
+                EXPECT_LT(logPos(edge.second, stage), logPos(edge.first, stage));
+            }
+        }
+        for (IndexType cktIdx = 1; cktIdx < 7; ++cktIdx)
+        {
+            EXPECT_LT(logPos(cktIdx, 0), logPos(cktIdx, 1));
+        }
+        EXPECT_GE(scheduler.criticalPathRuntime(), scheduler.taskRuntime(6, 1));
+    }
+
+    // Test a barrier stage waits for the previous stage of all the circuits
+    TEST_F(ImplSchedulerTest, barrierTest)
+    {
+        ImplScheduler scheduler(_db);
+        scheduler.addStage("place", record(0));
+        scheduler.addStage("route", record(1), true);
+        scheduler.build({ 1, 2, 3, 4, 5, 6 });
+        ASSERT_TRUE(scheduler.run(3));
+        for (IndexType idx = 0; idx < _log.size(); ++idx)
+        {
+            EXPECT_EQ(_log[idx].second, idx < 6 ? 0u : 1u);
+        }
+        EXPECT_LT(logPos(1, 1), logPos(4, 1));
+    }
+
+    // Test the independent circuits run at the same time
+    TEST_F(ImplSchedulerTest, parallelTest)
+    {
+        std::atomic<IndexType> numRunning(0);
+        std::atomic<IndexType> maxRunning(0);
+        ImplScheduler scheduler(_db);
+        scheduler.addStage("place", [&](IndexType)
+        {
+            IndexType running = ++numRunning;
+            IndexType seen = maxRunning.load();
+            while (running > seen && !maxRunning.compare_exchange_weak(seen, running)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(50));
+            --numRunning;
+            return true;
+        });
+        // 3 and 4 only need 1, 2 needs 3
+        scheduler.build({ 1, 2, 3, 4 });
+        ASSERT_TRUE(scheduler.run(2));
+        EXPECT_EQ(maxRunning.load(), 2u);
+        EXPECT_GE(scheduler.taskRuntime(3, 0), 0.04);
+    }
+
+    // Test the callbacks allocate circuits while the workers look up the sub circuits
+    TEST_F(ImplSchedulerTest, allocateTest)
+    {
+        ImplScheduler scheduler(_db);
+        std::vector<IndexType> allocated;
+        scheduler.addStage("place", [&](IndexType cktIdx)
+        {
+            // Past a chunk of the circuit table, so that it grows
+            for (IndexType idx = 0; idx < 70; ++idx)
+            {
+                IndexType newIdx = _db.allocateCkt();
+                std::lock_guard<std::mutex> lock(_mutex);
+                allocated.emplace_back(newIdx);
+            }
+            return _db.subCkt(cktIdx).numNodes() < 3;
+        });
+        scheduler.addStage("route", record(1), true);
+        scheduler.build({ 1, 2, 3, 4, 5, 6 });
+        ASSERT_TRUE(scheduler.run(4));
+        EXPECT_EQ(_db.numCkts(), 7u + 6 * 70);
+        std::sort(allocated.begin(), allocated.end());
+        EXPECT_EQ(std::unique(allocated.begin(), allocated.end()) - allocated.begin(), 6 * 70);
+        EXPECT_EQ(_log.size(), 6u);
+        // The design is unlocked after the run
+        EXPECT_EQ(_db.allocateCkt(), 7u + 6 * 70);
+    }
+
+    // Test a failure stops the parents and an exception reaches the caller
+    TEST_F(ImplSchedulerTest, failureTest)
+    {
+        ImplScheduler scheduler(_db);
+        scheduler.addStage("place", [](IndexType cktIdx) { return cktIdx != 3; });
+        scheduler.build({ 1, 2, 3, 4, 5, 6 });
+        EXPECT_FALSE(scheduler.run(2));
+        EXPECT_EQ(scheduler.taskState(3, 0), ImplTaskState::FAILED);
+        EXPECT_EQ(scheduler.taskState(2, 0), ImplTaskState::WAITING);
+        EXPECT_EQ(scheduler.taskState(6, 0), ImplTaskState::WAITING);
+
+        ImplScheduler throwing(_db);
+        throwing.addStage("place", [](IndexType cktIdx) -> bool
+        {
+            if (cktIdx == 4)
+            {
+                throw std::runtime_error("placement failed");
+            }
+            return true;
+        });
+        throwing.build({ 1, 4, 6 });
+        EXPECT_THROW(throwing.run(1), std::runtime_error);
+        EXPECT_EQ(throwing.taskState(4, 0), ImplTaskState::FAILED);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include "db/CktGraph.h"
+#include <thread>
+
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+    // Test interning and looking up the names
+    TEST(SymbolTableTest, internTest)
+    {
+        SymbolTable table;
+        EXPECT_EQ(table.size(), 1u);
+        EXPECT_EQ(table.find(""), EMPTY_SYMBOL);
+        EXPECT_EQ(table.find("M1"), INDEX_TYPE_MAX);
+        std::vector<SymbolId> ids;
+        for (IndexType idx = 0; idx < 1000; ++idx)
+        {
+            ids.emplace_back(table.intern("net" + std::to_string(idx)));
+        }
+        const std::string &first = table.str(ids.front());
+        for (IndexType idx = 0; idx < 1000; ++idx)
+        {
+            std::string name = "net" + std::to_string(idx);
+            EXPECT_EQ(table.intern(name), ids[idx]);
+            EXPECT_EQ(table.find(name), ids[idx]);
+            EXPECT_EQ(table.str(ids[idx]), name);
+        }
+        EXPECT_EQ(table.size(), 1001u);
+        // The references stay valid after growing
+        EXPECT_EQ(first, "net0");
+    }
+
+    // Test the objects share the symbols
+    TEST(SymbolTableTest, objectNameTest)
+    {
+        CktGraph ckt;
+        CktNode node = ckt.node(ckt.allocateNode());
+        Net net = ckt.net(ckt.allocateNet());
+        EXPECT_EQ(node.name(), "");
+        node.setName("M1");
+        net.setName("M1");
+        EXPECT_EQ(node.nameId(), net.nameId());
+        EXPECT_EQ(node.name(), "M1");
+        // The renames are counted by the graph
+        CktGraph other;
+        other.node(other.allocateNode()).setName("M3");
+        IndexType edits = ckt.nodeArrays().edits;
+        IndexType otherEdits = other.nodeArrays().edits;
+        node.setName("M1");
+        EXPECT_EQ(ckt.nodeArrays().edits, edits);
+        node.setName("M2");
+        EXPECT_EQ(ckt.nodeArrays().edits, edits + 1);
+        EXPECT_EQ(other.nodeArrays().edits, otherEdits);
+        EXPECT_EQ(ckt.findNode("M2"), 0u);
+        EXPECT_EQ(ckt.findNode("M1"), INDEX_TYPE_MAX);
+        EXPECT_EQ(net.name(), "M1");
+    }
+
+    // Test interning the same names from several threads
+    TEST(SymbolTableTest, concurrentInternTest)
+    {
+        SymbolTable table;
+        std::vector<std::vector<SymbolId>> ids(4);
+        std::vector<std::thread> threads;
+        for (IndexType threadIdx = 0; threadIdx < ids.size(); ++threadIdx)
+        {
+            threads.emplace_back([&table, &ids, threadIdx]()
+            {
+                for (IndexType idx = 0; idx < 2000; ++idx)
+                {
+                    ids[threadIdx].emplace_back(table.intern("net" + std::to_string(idx)));
+                }
+            });
+        }
+        for (std::thread &thread : threads)
+        {
+            thread.join();
+        }
+        EXPECT_EQ(table.size(), 2001u);
+        for (IndexType threadIdx = 1; threadIdx < ids.size(); ++threadIdx)
+        {
+            EXPECT_EQ(ids[threadIdx], ids[0]);
+        }
+        EXPECT_EQ(table.str(ids[0][7]), "net7");
+    }
+    // Test reading the strings without the lock while another thread interns
+    TEST(SymbolTableTest, concurrentReadTest)
+    {
+        SymbolTable table;
+        std::thread writer([&table]()
+        {
+            for (IndexType idx = 0; idx < 5000; ++idx)
+            {
+                table.intern("net" + std::to_string(idx));
+            }
+        });
+        IndexType numMismatches = 0;
+        IndexType size = 1;
+        while (size < 5001)
+        {
+            size = table.size();
+            for (SymbolId id = 1; id < size; id += 97)
+            {
+                numMismatches += table.str(id) != "net" + std::to_string(id - 1) ? 1 : 0;
+            }
+        }
+        writer.join();
+        EXPECT_EQ(numMismatches, 0u);
+        EXPECT_EQ(table.str(5000), "net4999");
+        EXPECT_THROW(table.str(5001), std::out_of_range);
+    }
+} // End of the unittest namespace
+
+PROJECT_NAMESPACE_END
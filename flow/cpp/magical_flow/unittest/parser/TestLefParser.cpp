@@ -0,0 +1,138 @@
+#include <gtest/gtest.h>
+#include "db/TechDB.h"
+#include "parser/TextTokenizer.h"
+#include <cstdio>
+#include <fstream>
+
+extern std::string UNITTEST_TOP_DIR;
+
+PROJECT_NAMESPACE_BEGIN
+
+namespace unittest
+{
+    /// @brief test LEF parser
+    class TestLefParser : public::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                testFile = UNITTEST_TOP_DIR + "./layer.lef";
+                techDB.units().setDbu(2000);
+                techDB.addNewLayer(21, "M1");
+                techDB.addNewLayer(22, "M2");
+            }
+        public:
+            std::string testFile; ///< The LEF file
+            TechDB techDB; ///< The tech db to fill
+    };
+    TEST_F(TestLefParser, layer)
+    {
+        EXPECT_TRUE(PROJECT_NAMESPACE::PARSE::parseLefFile(testFile, techDB));
+        ASSERT_EQ(techDB.numLefLayers(), 3);
+        const auto &m1 = techDB.lefLayer(0);
+        EXPECT_EQ(m1.name, "M1");
+        EXPECT_EQ(m1.type, "ROUTING");
+        EXPECT_EQ(m1.direction, "HORIZONTAL");
+        EXPECT_EQ(m1.pitch, 260);
+        EXPECT_EQ(m1.width, 140);
+        EXPECT_EQ(m1.spacing, 160);
+        EXPECT_EQ(m1.dbLayer, 0);
+        EXPECT_EQ(techDB.lefLayer(1).name, "VIA1");
+        EXPECT_EQ(techDB.lefLayer(1).type, "CUT");
+        EXPECT_EQ(techDB.lefLayer(1).dbLayer, INDEX_TYPE_MAX);
+        EXPECT_EQ(techDB.lefLayer(2).direction, "VERTICAL");
+        EXPECT_EQ(techDB.lefLayer(2).dbLayer, 1);
+    }
+    TEST_F(TestLefParser, via)
+    {
+        EXPECT_TRUE(PROJECT_NAMESPACE::PARSE::parseLefFile(testFile, techDB));
+        ASSERT_EQ(techDB.numLefVias(), 1);
+        const auto &via = techDB.lefVia(0);
+        EXPECT_EQ(via.name, "VIA12_1C");
+        EXPECT_TRUE(via.isDefault);
+        ASSERT_EQ(via.shapes.size(), 3);
+        EXPECT_EQ(via.shapes[0].dbLayer, 0);
+        EXPECT_EQ(via.shapes[0].rect, Box<LocType>(-130, -70, 130, 70));
+        EXPECT_EQ(via.shapes[1].dbLayer, INDEX_TYPE_MAX);
+        EXPECT_EQ(via.shapes[2].dbLayer, 1);
+        EXPECT_EQ(via.shapes[2].rect, Box<LocType>(-70, -130, 70, 130));
+    }
+    TEST_F(TestLefParser, macro)
+    {
+        EXPECT_TRUE(PROJECT_NAMESPACE::PARSE::parseLefFile(testFile, techDB));
+        ASSERT_EQ(techDB.numLefMacros(), 1);
+        const auto &macro = techDB.lefMacro(0);
+        EXPECT_EQ(macro.name, "INV");
+        EXPECT_EQ(macro.macroClass, "CORE");
+        EXPECT_EQ(macro.width, 800);
+        EXPECT_EQ(macro.height, 3420);
+        ASSERT_EQ(macro.pins.size(), 2);
+        EXPECT_EQ(macro.pins[0].name, "A");
+        EXPECT_EQ(macro.pins[0].direction, "INPUT");
+        ASSERT_EQ(macro.pins[0].shapes.size(), 1);
+        EXPECT_EQ(macro.pins[0].shapes[0].rect, Box<LocType>(200, 1000, 400, 1200));
+        EXPECT_EQ(macro.pins[1].use, "POWER");
+        ASSERT_EQ(macro.obs.size(), 1);
+        EXPECT_EQ(macro.obs[0].dbLayer, 1);
+    }
+    TEST_F(TestLefParser, truncatedRect)
+    {
+        // The file ends in the middle of a RECT
+        std::string filename = testFile + ".truncated";
+        {
+            std::ofstream out(filename);
+            out << "VIA VIA12_1C DEFAULT\n  LAYER M1 ;\n    RECT -0.065 -0.035";
+        }
+        EXPECT_FALSE(PROJECT_NAMESPACE::PARSE::parseLefFile(filename, techDB));
+        EXPECT_EQ(techDB.numLefVias(), 0);
+        std::remove(filename.c_str());
+    }
+    TEST_F(TestLefParser, missingValue)
+    {
+        // A statement without its value ends at its own ';'
+        std::string filename = testFile + ".missing";
+        {
+            std::ofstream out(filename);
+            out << "LAYER M1\n  TYPE ROUTING ;\n  PITCH ;\n  WIDTH 0.1 ;\nEND M1\n"
+                << "MACRO INV\n  SIZE 0.4 ;\n  CLASS CORE ;\n  PIN A\n    DIRECTION ;\n    USE SIGNAL ;\n  END A\nEND INV\n";
+        }
+        EXPECT_TRUE(PROJECT_NAMESPACE::PARSE::parseLefFile(filename, techDB));
+        ASSERT_EQ(techDB.numLefLayers(), 1);
+        EXPECT_EQ(techDB.lefLayer(0).pitch, 0);
+        EXPECT_EQ(techDB.lefLayer(0).width, 200);
+        ASSERT_EQ(techDB.numLefMacros(), 1);
+        EXPECT_EQ(techDB.lefMacro(0).macroClass, "CORE");
+        EXPECT_EQ(techDB.lefMacro(0).pins[0].direction, "");
+        EXPECT_EQ(techDB.lefMacro(0).pins[0].use, "SIGNAL");
+        std::remove(filename.c_str());
+        EXPECT_FALSE(PROJECT_NAMESPACE::PARSE::parseLefFile(filename, techDB));
+    }
+    TEST_F(TestLefParser, truncatedPin)
+    {
+        // The file ends before the name of a PIN
+        std::string filename = testFile + ".truncated";
+        {
+            std::ofstream out(filename);
+            out << "MACRO INV\n  CLASS CORE ;\n  PIN";
+        }
+        EXPECT_FALSE(PROJECT_NAMESPACE::PARSE::parseLefFile(filename, techDB));
+        EXPECT_EQ(techDB.numLefMacros(), 0);
+        std::remove(filename.c_str());
+    }
+    TEST(TextTokenizerTest, numberRange)
+    {
+        IndexType index = 0;
+        EXPECT_TRUE(TokenUtil::toIndex("4294967295", index));
+        EXPECT_EQ(index, INDEX_TYPE_MAX);
+        EXPECT_FALSE(TokenUtil::toIndex("4294967296", index));
+        EXPECT_FALSE(TokenUtil::toIndex("99999999999", index));
+        IntType value = 0;
+        EXPECT_TRUE(TokenUtil::toInt("-2147483648", value));
+        EXPECT_EQ(value, INT_TYPE_MIN);
+        EXPECT_FALSE(TokenUtil::toInt("2147483648", value));
+        EXPECT_TRUE(TokenUtil::toInt("+12", value));
+        EXPECT_EQ(value, 12);
+    }
+}
+
+PROJECT_NAMESPACE_END
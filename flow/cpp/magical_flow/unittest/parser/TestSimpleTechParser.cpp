@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "db/Layout.h"
 #include "db/TechDB.h"
 #include "parser/ParseSimpleTech.h"
 
@@ -68,6 +69,44 @@ namespace unittest
         EXPECT_EQ(techDB.pdkLayerToDb(25), 10);
         EXPECT_EQ(techDB.layerNameToIdx("M5"), 10);
     }
+
+    /// @brief test the (layer, datatype) mapping of TechDB
+    TEST(TechDBTest, datatype)
+    {
+        TechDB techDB;
+        techDB.addNewLayer(1, "PO");
+        techDB.addNewLayer(31, "M7", 40);
+        techDB.addNewLayer(31, "M7_PIN", 41);
+        techDB.addNewLayer(32, "M8", 40);
+        // Datatypes not defined fall back to the first layer on the tech layer
+        EXPECT_EQ(techDB.pdkLayerToDb(1, 0), 0);
+        EXPECT_EQ(techDB.pdkLayerToDb(1, 40), 0);
+        EXPECT_EQ(techDB.pdkLayerToDb(31), 1);
+        EXPECT_EQ(techDB.pdkLayerToDb(31, 0), 1);
+        EXPECT_EQ(techDB.pdkLayerToDb(31, 40), 1);
+        EXPECT_EQ(techDB.pdkLayerToDb(31, 41), 2);
+        EXPECT_EQ(techDB.pdkLayerToDb(32, 41), 3);
+        EXPECT_EQ(techDB.pdkLayerToDb(33, 40), INDEX_TYPE_MAX);
+        EXPECT_EQ(techDB.pdkLayerToDb(31, 1000), 1);
+        EXPECT_EQ(techDB.pdkLayerToDb(RESERVED_LAYERS_NUMBER, 0), INDEX_TYPE_MAX);
+        EXPECT_EQ(techDB.pdkLayerToDb(65535, 40), INDEX_TYPE_MAX);
+        // The drawing datatype is stored as DRAWING_DATATYPE in the layout. A real datatype 0 is kept as is
+        EXPECT_EQ(techDB.pdkDatatypeToDb(1, 40), DRAWING_DATATYPE);
+        EXPECT_EQ(techDB.pdkDatatypeToDb(1, 0), 0u);
+        EXPECT_EQ(techDB.pdkDatatypeToDb(1, 1), 1u);
+        EXPECT_EQ(techDB.pdkDatatypeToDb(INDEX_TYPE_MAX, 7), 7u);
+        EXPECT_EQ(techDB.dbLayerToPdkDatatype(1, DRAWING_DATATYPE), 40u);
+        EXPECT_EQ(techDB.dbLayerToPdkDatatype(1, 0), 0u);
+        EXPECT_EQ(techDB.dbLayerToPdkDatatype(3, DRAWING_DATATYPE), 40u);
+        EXPECT_EQ(techDB.dbLayerToPdkDatatype(3, 1), 1u);
+        EXPECT_EQ(techDB.dbLayerToPdkDatatype(0, DRAWING_DATATYPE), 0u);
+        // A rectangle is on the drawing datatype by default and rejects the datatypes GDSII cannot hold
+        RectLayout rect(0, 0, 1, 1);
+        EXPECT_EQ(rect.datatype(), DRAWING_DATATYPE);
+        rect.setDatatype(0);
+        EXPECT_EQ(rect.datatype(), 0u);
+        EXPECT_THROW(rect.setDatatype(RESERVED_DATATYPES_NUMBER), std::out_of_range);
+    }
 }
 
 
@@ -0,0 +1,65 @@
+##
+# @file Artifacts.py
+# @author agent
+# @date 10/19/2026
+# @brief Write the result files through the artifact store
+#
+
+import magicalFlow
+from contextlib import contextmanager
+
+class Artifacts(object):
+    """
+    @brief the result files of the circuits. When params.artifactStore is set, the identical files of all the circuits and runs
+    are stored once and hard linked into resultDir. A linked file must be released before it is written again in place.
+    The constraint files users edit (.sym, .symnet and .sigpath) are written as copies instead
+    """
+    def __init__(self, params):
+        self.store = None
+        if params.artifactStore:
+            self.store = magicalFlow.ArtifactStore(params.artifactStore)
+
+    def release(self, filename):
+        """
+        @brief remove a result file before a tool writes it, so that the stored object does not change
+        @param the result file
+        """
+        if self.store is not None:
+            self.store.release(filename)
+
+    def commit(self, cktName, filename):
+        """
+        @brief take a written result file into the store
+        @param first: the name of the circuit
+        @param second: the result file, named by the circuit name and the stage suffix
+        """
+        if self.store is not None:
+            self.store.commit(cktName, filename)
+
+    @contextmanager
+    def writing(self, cktName, filename):
+        """
+        @brief release a result file, let the caller write it, and commit it
+        @param first: the name of the circuit
+        @param second: the result file
+        """
+        self.release(filename)
+        yield filename
+        self.commit(cktName, filename)
+
+    def writeGdsLayout(self, cktIdx, filename, dDB, tDB):
+        """
+        @brief write the layout of a circuit to GDSII through the store
+        """
+        if self.store is None:
+            magicalFlow.writeGdsLayout(cktIdx, filename, dDB, tDB)
+        else:
+            magicalFlow.writeGdsLayout(cktIdx, filename, dDB, tDB, self.store)
+
+    def report(self):
+        """
+        @brief print the deduplication of the store
+        """
+        if self.store is not None:
+            print("artifact store: ", self.store.numStored(), "new objects ", self.store.numDeduped(), "deduplicated files ",
+                  self.store.bytesDeduped(), "bytes saved")
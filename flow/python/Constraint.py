@@ -101,7 +101,11 @@ class Constraint(object):
                 constGen.addInstPin(idx, netIdx, pinTypeArray[pin_idx])            
                 # 调用constGen的addInstPin()方法，添加instNode的一个引脚约束，idx为实例索引，netIdx为网索引，pinTypeArray[pin_idx]为引脚类型
             assert nodeIdx == idx                                                  # insdtNode的节点索引nodeIdx与上面添加的实例索引idx相等，用于检查
+        for ext in ['.sym', '.symnet']:
+            self.mDB.artifacts.release(dirName + ckt.name + ext)
         constGen.dumpResult(dirName + ckt.name)                                    # 调用constGen的dumpResult()方法生成约束文件   
+        for ext in ['.sym', '.symnet']:
+            self.mDB.artifacts.commit(ckt.name, dirName + ckt.name + ext)
 
     def primarySymFile(self, cktIdx, dirName):              # cktIdx为电路索引，dirName为输出目录 
         """
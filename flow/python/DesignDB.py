@@ -6,6 +6,7 @@
 #
 
 import magicalFlow
+import numpy as np
 import pyparsing as _p
 
 
@@ -583,28 +584,29 @@ class Netlist_parser(object):
         self.db.subCkt(ckt_idx).name = ckt.name
         assert(ckt_idx == len(self.ckt_list) - 1)
 
-        for net_idx in range(len(ckt.nets)):
-            db_net_idx = self.db.subCkt(ckt_idx).allocateNet()
-            self.db.subCkt(ckt_idx).net(db_net_idx).name = ckt.net_name[net_idx]
-            assert(db_net_idx == net_idx)
+        # Build the nodes, pins and nets with one call instead of allocating them one by one
+        # The subgraphIdx, intNetIdx and pin types need to be set elsewhere
+        num_nets = len(ckt.nets)
+        pin_node_idx = []
+        pin_net_idx = []
+        for inst_idx in range(len(ckt.instances)):
+            for net_name in ckt.instances[inst_idx].pins: # the same "pin" in inst.pins is the index of net it connecting to
+                pin_node_idx.append(inst_idx)
+                pin_net_idx.append(ckt.nets[net_name].idx)
+        db_ckt = self.db.subCkt(ckt_idx)
+        db_ckt.build(np.full(len(ckt.instances), magicalFlow.INDEX_TYPE_MAX, dtype=np.uint32),
+                     np.array(pin_node_idx, dtype=np.uint32),
+                     np.array(pin_net_idx, dtype=np.uint32),
+                     np.zeros(0, dtype=np.int32),
+                     np.zeros(num_nets, dtype=np.int32))
+        db_ckt.setNetNames([ckt.net_name[net_idx] for net_idx in range(num_nets)])
+        db_ckt.setNodeNames([inst.name for inst in ckt.instances], [inst.reference for inst in ckt.instances])
+
+        for net_idx in range(num_nets):
             if ckt.nets[ckt.net_name[net_idx]].is_io:
-                self.db.subCkt(ckt_idx).net(db_net_idx).ioPos = net_idx
+                db_ckt.net(net_idx).ioPos = net_idx
                 inst_pin_map.append(net_idx) # [index of io_net/pin in ckt] = index of net in db 
 
-        for inst_idx in range(len(ckt.instances)):
-            inst = ckt.instances[inst_idx]
-            db_node_idx = self.db.subCkt(ckt_idx).allocateNode()
-            self.db.subCkt(ckt_idx).node(db_node_idx).refName = inst.reference
-            self.db.subCkt(ckt_idx).node(db_node_idx).name = inst.name
-            assert(db_node_idx == inst_idx)
-            for net_name in inst.pins: # the same "pin" in inst.pins is the index of net it connecting to
-                net_idx = ckt.nets[net_name].idx
-                db_pin_idx = self.db.subCkt(ckt_idx).allocatePin()
-                self.db.subCkt(ckt_idx).pin(db_pin_idx).nodeIdx = db_node_idx
-                self.db.subCkt(ckt_idx).pin(db_pin_idx).netIdx = net_idx # the intNetIdx need to be set elsewhere
-                self.db.subCkt(ckt_idx).net(net_idx).appendPinIdx(db_pin_idx)
-                self.db.subCkt(ckt_idx).node(db_node_idx).appendPinIdx(db_pin_idx) # The subgraphIdx need to be set elsewhere
-
         self.inst_pin_maps.append(inst_pin_map)
 
 
@@ -37,7 +37,8 @@ class Device_generator(object):
         Need to setGDS() and setPinBB
         Should be removed in later versions
         """
-        gdspy.write_gds(self.outGDS, [self.cell], unit=1.0e-6, precision=1.0e-9)
+        with self.mDB.artifacts.writing(self.cirname, self.outGDS):
+            gdspy.write_gds(self.outGDS, [self.cell], unit=1.0e-6, precision=1.0e-9)
         #of = open(self.outPinBB, 'w')
         #BB = basic.BB(self.cell)
         #of.write("%d %d %d %d\n" % (BB[0], BB[1], BB[2], BB[3]))
@@ -51,7 +52,8 @@ class Device_generator(object):
         Need to setGDS()
         Should write to layoutDB in future.
         """
-        gdspy.write_gds(self.outGDS, [self.cell], unit=1.0e-6, precision=1.0e-9)
+        with self.mDB.artifacts.writing(self.cirname, self.outGDS):
+            gdspy.write_gds(self.outGDS, [self.cell], unit=1.0e-6, precision=1.0e-9)
         ckt = self.dDB.subCkt(cktIdx)
         gdsData = ckt.GdsData()
         BB = basic.basic.BB(self.cell, flipCell)
@@ -136,6 +138,7 @@ class Device_generator(object):
             return False
         if flipCell:
             self.cell.flip_vert()
+        self.cirname = cirname
         self.setGDS(dirname+cirname+'.gds')
         #self.setPinBB(dirname+cirname+'.pin')
         self.writeOut()
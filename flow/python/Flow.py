@@ -11,7 +11,10 @@ import Constraint
 import PnR
 import StdCell
 import subprocess
+import threading
 import time
+import os
+import Worker
 
 ##============================= flow工艺流程 ==========================##
 class Flow(object):
@@ -20,8 +23,12 @@ class Flow(object):
         self.dDB = db.designDB.db                               # 初始化dDB 作为designDB(C++)数据库的引用
         self.constraint = Constraint.Constraint(self.mDB)       # 初始化constraint作为Constraint对象的引用
         self.params = self.mDB.params                           # 初始化params 作为mDB的params参数对象的引用
-        self.pnrs = []                                          # 初始化pnrs列表
+        self.pnrs = dict()                                      # 初始化pnrs字典 cktIdx -> PnR
         self.runtime = 0                                        # 初始化运行时间
+        self.cache = None                                       # 电路实现缓存  The cache of the implemented circuits
+        self.cachedCkts = set()                                 # 从缓存恢复的电路  The circuits restored from the cache
+        self.flippedLock = threading.Lock()                     # 保护翻转副本的生成  Generate each flipped copy once
+        self.stateLock = threading.Lock()                       # 保护pnrs, runtime和cachedCkts  The stages of the circuits run concurrently
 
     def run(self):                                              # run()主要执行流程
         """
@@ -29,15 +36,177 @@ class Flow(object):
         @return if successful
         """
         self.resultName = self.mDB.params.resultDir             # 获取结果目录名resultName
+        if self.params.resume and self.params.checkpoint and os.path.isfile(self.params.checkpoint):
+            # Continue the run that wrote the checkpoint. The circuits routed in it are kept
+            if not self.dDB.load(self.params.checkpoint):
+                return False
+            print("Flow: resumed from ", self.params.checkpoint)
+            self.dDB.shareIdenticalLayouts()                    # Offer the layouts of the resumed circuits to the ones implemented from here on
         topCktIdx = self.mDB.topCktIdx()                        # 获取顶层电路索引topcktIdx
         start = time.time()                                     # 记录开始时间
-        self.implCktLayout(topCktIdx)                           # 调用implCktLayout()实现顶层电路的布局
+        if self.params.implCache:
+            # Reuse the circuits implemented by the earlier runs. Only the changed circuits and their ancestors miss
+            if not os.path.isdir(self.params.implCache):
+                os.makedirs(self.params.implCache)
+            self.cache = magicalFlow.ImplCache(self.dDB, self.params.implCache)
+            self.paramsHash = self.hashParams()
+            # The circuits implemented before, as by a resumed run, are not scheduled. Fingerprint them children first as restoreCkt() does,
+            # so that their parents see the same fingerprints as in the run that implemented them
+            for cktIdx in self.dDB.subtreeCkts(topCktIdx):
+                if self.dDB.subCkt(cktIdx).isImpl:
+                    self.cache.computeFingerprint(cktIdx, self.cktSalt(cktIdx))
+        # Implement the circuits under the top that are not implemented yet on a worker pool, children before parents.
+        # The device circuits are generated as tasks of their own, so that the parents sharing them do not race
+        ckts = [cktIdx for cktIdx in self.dDB.subtreeCkts(topCktIdx) if not self.dDB.subCkt(cktIdx).isImpl]
+        self.scheduler = magicalFlow.ImplScheduler(self.dDB)
+        self.scheduler.addStage("place", self.placeCkt)
+        # The placement of a parent reads the placed layouts of the sub circuits, so the routing waits for all the placements
+        self.scheduler.addStage("route", self.routeCkt, True)
+        self.scheduler.build(ckts)
+        # The worker processes solving the placements and routings start before the scheduler threads
+        Worker.start(self.params.numThreads)
+        success = False
+        try:
+            success = self.scheduler.run(self.params.numThreads)
+        finally:
+            Worker.stop()
+            if not success and self.params.checkpoint:
+                # Keep the circuits routed before the failure for a resumed run. The tasks are all finished here,
+                # while routeCkt() checkpoints only the serial runs
+                self.dDB.save(self.params.checkpoint)
+        if not success:
+            return False
+        self.dDB.findRootCkt()                                  # The flipped instances moved to the copies of the devices
+        if self.params.memoryReport > 0:
+            self.dDB.memoryReport(self.params.memoryReport).log()
         end = time.time()                                       # 记录结束时间
-        print("runtime ", end - start)                          # 输出运行时间
-        for pnr in self.pnrs:                                   # 对pnrs列表中的每一个PnR对象调用routeOnly()进行布线
-            pnr.routeOnly()
+        print("runtime ", end - start, "critical path ", self.scheduler.criticalPathRuntime())     # 输出运行时间
+        self.mDB.artifacts.report()
+        if self.cache is not None:
+            print("implementation cache: ", self.cache.numHits(), "hits ", self.cache.numMisses(), "misses")
+        if self.params.checkpoint:
+            self.dDB.save(self.params.checkpoint)
+        return True
+
+    def placeCkt(self, cktIdx):
+        """
+        @brief the placement stage of a circuit for the scheduler
+        @param the index of the circuit
+        """
+        ckt = self.dDB.subCkt(cktIdx)
+        ckt.beginImpl()                                         # A checkpoint saved before the routing drops the IO pins the placement adds
+        symDict = self.genConstraint(cktIdx)
+        if self.cache is not None and self.restoreCkt(cktIdx, symDict):
+            self.dDB.shareIdenticalLayout(cktIdx)
+            return True
+        if magicalFlow.isImplTypeDevice(ckt.implType):
+            # The identical devices share one circuit after dedupDevices(). Generate it once here. The flipped instances use copies. See setup()
+            devGen = Device_generator.Device_generator(self.mDB)
+            devGen.generateDevice(cktIdx, self.resultName+'/gds/', False)    #FIXME: directly add to the database
+            devGen.readGDS(cktIdx, self.resultName+'/gds/')
+            ckt.isImpl = True
+            self.dDB.shareIdenticalLayout(cktIdx)
+            return True
+        self.implCktLayout(cktIdx, symDict)                     # 调用implCktLayout()实现电路的布局
+        return True
+
+    def routeCkt(self, cktIdx):
+        """
+        @brief the routing stage of a circuit for the scheduler
+        @param the index of the circuit
+        """
+        with self.stateLock:
+            pnr = self.pnrs.get(cktIdx)
+            cached = cktIdx in self.cachedCkts
+        if pnr is not None:
+            pnr.routeOnly()                                     # 对PnR对象调用routeOnly()进行布线
+        if self.cache is not None and not cached:
+            self.cache.store(cktIdx, self.resultName, self.resultFiles(cktIdx))     # 保存到缓存
+        # The layout is final here. Keep one copy of the identical or mirrored layouts from here on, as the parents only read it
+        self.dDB.shareIdenticalLayout(cktIdx)
+        if self.params.checkpoint and self.params.numThreads == 1:
+            self.dDB.save(self.params.checkpoint)               # Checkpoint the circuits implemented so far. Only when no other circuit is being implemented
+        return True
+
+    def isFlippedDevice(self, cktIdx):
+        """
+        @brief whether a device circuit is the flipped copy of another made by setup()
+        @param the index of the circuit
+        """
+        return self.dDB.flippedOriginal(cktIdx) != magicalFlow.INDEX_TYPE_MAX
+
+    def hashParams(self):
+        """
+        @brief hash the parameters that affect the implementation of every circuit
+        @return the hash
+        """
+        # The netlist is in the design, and the output locations do not change the layouts
+        skip = set(['spectre_netlist', 'hspice_netlist', 'resultDir', 'checkpoint', 'resume', 'numThreads', 'implCache', 'artifactStore', 'memoryReport'])
+        params = sorted((key, val) for key, val in vars(self.params).items() if key not in skip)
+        paramsHash = magicalFlow.hashString(repr(params))
+        for filename in [self.params.simple_tech_file, self.params.techfile, self.params.lef]:
+            paramsHash = magicalFlow.combineHash(paramsHash, magicalFlow.hashFile(filename))
+        return paramsHash
+
+    def cktSalt(self, cktIdx):
+        """
+        @brief hash the inputs of a circuit outside the design: the parameters, and the constraint files of a circuit placed by PnR
+        @param the index of the circuit
+        @return the salt of its fingerprint
+        """
+        ckt = self.dDB.subCkt(cktIdx)
+        salt = self.paramsHash
+        if not magicalFlow.isImplTypeDevice(ckt.implType) and not self.isCktStdCells(cktIdx):
+            for ext in ['.sym', '.symnet', '.sigpath']:
+                salt = magicalFlow.combineHash(salt, magicalFlow.hashFile(self.resultName + ckt.name + ext))
+        return salt
+
+    def genConstraint(self, cktIdx):
+        """
+        @brief generate the constraints of a circuit placed by PnR. They are generated once and may be edited by the user afterwards
+        @param the index of the circuit
+        @return the symmetric pairs of the nodes. None for the devices and the standard cells
+        """
+        ckt = self.dDB.subCkt(cktIdx)
+        if magicalFlow.isImplTypeDevice(ckt.implType) or self.isCktStdCells(cktIdx):
+            return None
+        # S3DET keeps the graph of the circuit it works on, so every task uses a Constraint of its own
+        return Constraint.Constraint(self.mDB).genConstraint(cktIdx, self.resultName)
+
+    def restoreCkt(self, cktIdx, symDict):
+        """
+        @brief fingerprint a circuit and restore it from the cache. Its sub circuits must be fingerprinted
+        @param first: the index of the circuit
+        @param second: the constraints from genConstraint(), which the fingerprint covers
+        @return whether the cache hits
+        """
+        ckt = self.dDB.subCkt(cktIdx)
+        self.cache.computeFingerprint(cktIdx, self.cktSalt(cktIdx))
+        if not self.cache.restore(cktIdx, self.resultName):
+            return False
+        if symDict is not None:
+            # The restored layout has the symmetric instances flipped. Move them to the flipped devices as a placement would
+            self.setup(cktIdx, symDict)
+        # The result files are written again, and go into the store like the written ones
+        for filename in self.resultFiles(cktIdx):
+            self.mDB.artifacts.commit(ckt.name, self.resultName + filename)
+        with self.stateLock:
+            self.cachedCkts.add(cktIdx)
+        print("Flow: restored ", ckt.name, " from ", self.cache.entryFile(cktIdx))
         return True
 
+    def resultFiles(self, cktIdx):
+        """
+        @brief the result files of a circuit kept in its cache entry, relative to resultDir
+        @param the index of the circuit
+        """
+        ckt = self.dDB.subCkt(cktIdx)
+        if magicalFlow.isImplTypeDevice(ckt.implType):
+            return ['/gds/' + ckt.name + '.gds']                # See placeCkt()
+        if self.isCktStdCells(cktIdx):
+            return []                                           # Read from the inputs
+        return [ckt.name + '.route.gds', ckt.name + '.ioPin']
+
     def generateConstraints(self):                                                      # 生成除设备和标准单元之外的电路布局约束
         for cktIdx in range(self.dDB.numCkts()):                                        # 遍历所有的电路CktIdx
             ckt = self.dDB.subCkt(cktIdx) #magicalFlow.CktGraph
@@ -55,24 +224,31 @@ class Flow(object):
             return False
 
 
-    def setup(self, cktIdx):                                                            # 用于设置
+    def setup(self, cktIdx, symDict):                                                   # 用于设置
         ckt = self.dDB.subCkt(cktIdx)                                                   
+        # Flip cell if is in the "right" half device of symmetry
+        flipNodes = set(ckt.findNode(name) for name in symDict.values())          # 通过名字索引找到symDict中的对称单元
         for nodeIdx in range(ckt.numNodes()):                                           # 遍历所有的节点cktnode
-            flipCell = False
             cktNode = ckt.node(nodeIdx)
-            # Flip cell if is in the "right" half device of symmetry
-            if cktNode.name in self.symDict.values():                                   # 如果cktNode在symDict中，说明是对称单元，flipCell设为True
-                flipCell = True
+            flipCell = nodeIdx in flipNodes                                             # 如果cktNode在symDict中，说明是对称单元，flipCell设为True
             if cktNode.isLeaf():                                                        # 如果cktNode是叶节点，跳过此次循环直接进入下个循环
                 continue
             subCktIdx = self.dDB.subCkt(cktIdx).node(nodeIdx).graphIdx                  # 不是叶节点，获取cktNode的子电路索引subCktIdx
             devGen = Device_generator.Device_generator(self.mDB)                        # 实例化一个Device_generator设备生成器对象devGen，在初始化时提供MagicalDB对象作为参数，以支持后续设备布局生成操作
             if magicalFlow.isImplTypeDevice(self.dDB.subCkt(subCktIdx).implType):       # 如果subCktIdx是设备
+                # The identical devices share one circuit after dedupDevices(), generated unflipped by placeCkt(). A flipped instance moves
+                # to a copy of its device, made and generated flipped the first time. The parents sharing the copy may run concurrently.
+                # A resumed node may be on the copy already
                 if flipCell:                                                            # 且flipCell为True，调用Device_generator生成对称设备布局
-                    devGen.generateDevice(subCktIdx, self.resultName+'/gds/', True)     #FIXME: directly add to the database
-                else:                                                                   # 否则生成标准设备布局，并读取GDS
-                    devGen.generateDevice(subCktIdx, self.resultName+'/gds/', False)    
-                devGen.readGDS(subCktIdx, self.resultName+'/gds/')
+                    with self.flippedLock:
+                        if not self.isFlippedDevice(subCktIdx):
+                            subCktIdx = self.dDB.flippedCopyOf(subCktIdx, self.dDB.subCkt(subCktIdx).name + '_flip')
+                            cktNode.graphIdx = subCktIdx
+                        if not self.dDB.subCkt(subCktIdx).isImpl:
+                            devGen.generateDevice(subCktIdx, self.resultName+'/gds/', True)     #FIXME: directly add to the database
+                            devGen.readGDS(subCktIdx, self.resultName+'/gds/')
+                            self.dDB.subCkt(subCktIdx).isImpl = True
+                            self.dDB.shareIdenticalLayout(subCktIdx)
             else:                                                                       # 如果subCktIdx不是设备
                 if flipCell:
                     cktNode.flipVertFlag = True                                         # 如果flipCell为True，设置cktNode的flipVertFlag为True
@@ -85,38 +261,23 @@ class Flow(object):
     """
 
 
-    def implCktLayout(self, cktIdx):
+    def implCktLayout(self, cktIdx, symDict):
         """
-        @brief implement the circuit layout                                             # 用于电路的布局
+        @brief implement the circuit layout. The sub circuits must be implemented. The devices are generated by placeCkt()   # 用于电路的布局
+        @param first: the index of the circuit
+        @param second: the constraints from genConstraint()
         """
-        dDB = self.mDB.designDB.db #c++ database                                        # 这里的dDB是C++数据库
-        ckt = dDB.subCkt(cktIdx) #magicalFlow.CktGraph                                  # 电路拓扑结构ckt引用
-        # If the ckt is a device, generation will be added in setup()                   # 如果ckt是设备，则通过Device_generator生成设备布局，并return
-        if magicalFlow.isImplTypeDevice(ckt.implType):
-            Device_generator.Device_generator(self.mDB).generateDevice(cktIdx, self.resultName+'/gds/') #FIXME: directly add to the database
-            return
         # If the ckt is a standard cell                                                 # 如果ckt是标准单元，则通过StdCell对象进行设置，并return
         # This version only support DFCNQD2BWP and NR2D8BWP, hard-encoded
         # TODO: This should be parsed from the json file
         if self.isCktStdCells(cktIdx):
             StdCell.StdCell(self.mDB).setup(cktIdx, self.resultName)
             return
-        # If the ckt is actually a circuit instead of a device
-        for nodeIdx in range(ckt.numNodes()):                                           # 遍历ckt所有的节点，numNodes()获得节点数量
-            cktNode = ckt.node(nodeIdx) # magicalFlow.CktNode                           # 获取节点cktNode的引用，node()方法传入节点索引nodeIdx获取相应节点
-            if cktNode.isLeaf(): # Do not go deeper for leaf node                       # 如果cktNode是叶节点，这两行跳过，继续下一个节点处理
-                continue
-            subCkt = dDB.subCkt(cktNode.graphIdx)
-            if (subCkt.isImpl): # Do not duplicately implement the layout               # 这两行获取cktNode的子电路subCkt引用，并检查是否已经布局，如果是则跳过后面操作，继续下个节点
-                continue
-            self.implCktLayout(cktNode.graphIdx) # Recursively implement all the children   # 这行递归调用自身方法来实现子电路subCkt的布局，实现层级布局
-            ckt = dDB.subCkt(cktIdx) # just to make sure the reference is not messed up     # 这行重新获取ckt的引用，以防在递归调用中引用被改变
         # After all the children being implemented. P&R at this circuit
-        ckt = dDB.subCkt(cktIdx) #magicalFlow.CktGraph                                  # 这行重新获取ckt的引用，以防在递归调用中引用被改变
-        self.symDict = self.constraint.genConstraint(cktIdx, self.resultName)           # 生成布局约束symDict，并调用setup()方法进行设置
-        self.setup(cktIdx)
+        self.setup(cktIdx, symDict)                                                     # 布局约束symDict由placeCkt()生成，调用setup()方法进行设置
         pnr = PnR.PnR(self.mDB)                                                         # 创建PnR对象pnr
         pnr.placeOnly(cktIdx, self.resultName)                                          # 调用placeOnly()方法进行布局
-        self.runtime += pnr.runtime                                                     # 累加pnr运行时间
-        self.pnrs.append(pnr)                                                           # 将其添加到pnrs列表
+        with self.stateLock:
+            self.runtime += pnr.runtime                                                 # 累加pnr运行时间
+            self.pnrs[cktIdx] = pnr                                                     # 将其添加到pnrs字典
         #PnR.PnR(self.mDB).implLayout(cktIdx, self.resultName)
@@ -6,6 +6,7 @@
 #
 
 import DesignDB
+import Artifacts
 import magicalFlow
 
 class MagicalDB(object): 
@@ -14,11 +15,20 @@ class MagicalDB(object):
         self.params = params                        # 保存了传入的params参数对象
         self.digitalNetNames = ["clk"]              # 初始化digitalNetNames列表来存储数字信号网名
         self.techDB = magicalFlow.TechDB()          # 初始化TechDB对象techDB
+        self.artifacts = Artifacts.Artifacts(params)    # 结果文件 The result files, written through the artifact store if set
 
     def parse(self):
+        """
+        @brief parse the design and merge its identical devices
+        dedupDevices() renumbers the circuits after the first merged device, and the circuit, node and net objects taken before are invalid.
+        It runs here before any circuit index is handed out: take the indices, such as topCktIdx(), only after parse() returns
+        """
         self.parse_input_netlist(self.params)                       # 调用parse_input_netlist()解析输入的网表文件(从params对象获取)
         self.parse_simple_techfile(self.params.simple_tech_file)    # 调用parse_simple_techfile()解析简单工艺文件(从params对象获取)
+        self.parse_lef(self.params.lef)                             # 读取LEF的层, 通孔和宏单元  After the layers, as the LEF layers are matched to them by name
         self.designDB.db.findRootCkt()                              # 调用designDB.db.findRootCkt()查找层次结构的根电路,DFS             After the parsing, find the root circuit of the hierarchy
+        self.designDB.db.dedupDevices()                             # Share one circuit among the identical devices so that each is generated once
+        self.designDB.db.finalize()                                 # Pack the connectivity of the circuits for the graph algorithms
         self.postProcessing()                                       # 调用postProcessing()进行后处理
         return True
 
@@ -30,6 +40,16 @@ class MagicalDB(object):
     def parse_simple_techfile(self, params):                        
         magicalFlow.parseSimpleTechFile( params, self.techDB)       # 调用magicalFlow.parse_simple_techfile()解析简单工艺文件，传入techDB对象和params参数
 
+    def parse_lef(self, lef):
+        """
+        @brief read the layers, vias and macros of the LEF into the tech. The circuits share them through their copies of the tech
+        @param the LEF file. Nothing is read if it is empty
+        """
+        if not lef:
+            return
+        if not magicalFlow.parseLefFile(lef, self.techDB):
+            print("MagicalDB: cannot read the LEF file ", lef, ", the tech is left without LEF data")
+
     def parse_input_netlist(self, params):                          # 用于解析输入的网表文件。它会根据params对象中的网表文件对应解析
         if (params.hspice_netlist is not None):                      
             self.read_hspice_netlist(params.resultDir+params.hspice_netlist)
@@ -54,7 +74,8 @@ class MagicalDB(object):
             ckt = self.designDB.db.subCkt(cktIdx)
             if ckt.implType == magicalFlow.ImplTypeUNSET:                               # 如果ckt的implType是magicalFlow.ImplTypeUNSET
                 csflow.computeCurrentFlow(ckt)                                          # 调用csflow.computeCurrentFlow(ckt)计算该电路的电流
-                with open(self.params.resultDir + ckt.name + '.sigpath','w') as f:      # 打开结果目录的ckt.name + '.sigpath'文件
+                sigpathFile = self.params.resultDir + ckt.name + '.sigpath'
+                with self.artifacts.writing(ckt.name, sigpathFile), open(sigpathFile,'w') as f:      # 打开结果目录的ckt.name + '.sigpath'文件
                     pinNamePaths = csflow.currentPinPaths();                            # 确认管脚名路径
                     cellNamePaths = csflow.currentCellPaths();                          # 确认单元名路径
                     assert len(pinNamePaths) == len(cellNamePaths)                      # 确认管脚名路径和单元名路径长度相等
@@ -82,12 +103,14 @@ class MagicalDB(object):
             # Using external naming-based labeling
             vddNetNames = self.params.vddNetNames               # 获取VddNetNames列表
             vssNetNames = self.params.vssNetNames               # 获取VssNetNames列表
-            for netIdx in range(ckt.numNets()):
-                net = ckt.net(netIdx)                           # 遍历所有的Nets
-                if net.name in vddNetNames:                     # 如果net的名字在VddNetNames中，调用net.markVddFlag()标记为VDD网
-                    net.markVddFlag()
-                if net.name in vssNetNames:                     # 如果net的名字在VssNetNames中，调用net.markVssFlag()标记为VSS网
-                    net.markVssFlag()
+            for vddNetName in vddNetNames:
+                netIdx = ckt.findNet(vddNetName)                # Look up the nets by name instead of scanning all the nets
+                if netIdx != magicalFlow.INDEX_TYPE_MAX:        # 如果net的名字在VddNetNames中，调用net.markVddFlag()标记为VDD网
+                    ckt.net(netIdx).markVddFlag()
+            for vssNetName in vssNetNames:
+                netIdx = ckt.findNet(vssNetName)
+                if netIdx != magicalFlow.INDEX_TYPE_MAX:        # 如果net的名字在VssNetNames中，调用net.markVssFlag()标记为VSS网
+                    ckt.net(netIdx).markVssFlag()
     ##======================== 上面方法使用了psubnet、nwell连接以及网名来标记VDD和VSS功率网 ==========================##
     
 
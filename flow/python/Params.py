@@ -29,6 +29,13 @@ class Params:
         
         ##======================这部分代码定义了很多表格，用来给不同情况下的导线宽度和VIA切口数量赋值===============================##
         self.resultDir = None               # 存储了结果目录
+        self.checkpoint = None              # 每个电路实现后保存的DesignDB检查点文件  The DesignDB checkpoint saved after each circuit is implemented
+        self.resume = False                 # 从检查点继续  Load the checkpoint, if it exists, and implement only the circuits not implemented in it
+        self.artifactStore = None           # 结果文件的内容寻址存储目录  The store keeping one copy of the identical result files. None to write resultDir directly
+        self.implCache = None               # 电路实现缓存目录  The directory caching the implemented circuits across the runs. None to implement all
+        self.numThreads = 1                 # 并行实现电路的线程数  The number of circuits implemented at the same time. 0 for all the cores. Above 1 the placer and router solve in worker processes. 1 by default until a parallel run is measured faster
+        self.signalFlow = False             # 从网表生成信号路径  Derive the signal paths from the netlist for the circuits without a .sigpath file
+        self.memoryReport = 0               # 流程结束后输出内存报告  Log the memory of the DesignDB after the flow, with this many of the largest circuits. 0 for no report
         self.powerLayer = 6                 # 存储了芯片的功率层
         self.psubLayer = self.powerLayer    # 存储了衬底接触层      same as power pin
         self.smallModuleAreaThreshold = 60  # 存储了小模块的面积阈值，单位是um^2
@@ -105,6 +112,13 @@ simple_tech_file [required]                         | input simple techfile
         if 'techfile' in data : self.techfile = data['techfile']                            # 保存了工艺文件
         if 'vddNetNames' in data : self.vddNetNames = data['vddNetNames']                   # 保存了电源网名
         if 'vssNetNames' in data : self.vssNetNames = data['vssNetNames']                   # 保存了接地网名
+        if 'checkpoint' in data : self.checkpoint = data['checkpoint']                      # DesignDB检查点文件
+        if 'resume' in data : self.resume = data['resume']                                  # 从检查点继续
+        if 'artifactStore' in data : self.artifactStore = data['artifactStore']             # 结果文件存储目录
+        if 'implCache' in data : self.implCache = data['implCache']                         # 电路实现缓存目录
+        if 'numThreads' in data : self.numThreads = data['numThreads']                      # 并行实现电路的线程数
+        if 'signalFlow' in data : self.signalFlow = data['signalFlow']                      # 从网表生成信号路径
+        if 'memoryReport' in data : self.memoryReport = data['memoryReport']                # 流程结束后输出内存报告
 
     def dump(self, filename):
         """
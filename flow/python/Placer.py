@@ -7,8 +7,42 @@ import device_generation.basic as basic
 import gdspy
 import device_generation.glovar as glovar
 import time
+import Worker
 
 
+class SolvedPlacement(object):
+    """
+    @brief the placement read out of a solved IdeaPlaceEx, with the same getters. A worker process sends it back. See solvePlacement()
+    """
+    def __init__(self, placer, numCells, ioNets):
+        self.cellLocs = [(placer.xCellLoc(cellIdx), placer.yCellLoc(cellIdx)) for cellIdx in range(numCells)]
+        self.cellNames = [placer.cellName(cellIdx) for cellIdx in range(numCells)]
+        self.ioPins = dict((netIdx, (placer.iopinX(netIdx), placer.iopinY(netIdx), placer.isIoPinVertical(netIdx))) for netIdx in ioNets)
+    def xCellLoc(self, cellIdx):
+        return self.cellLocs[cellIdx][0]
+    def yCellLoc(self, cellIdx):
+        return self.cellLocs[cellIdx][1]
+    def cellName(self, cellIdx):
+        return self.cellNames[cellIdx]
+    def iopinX(self, netIdx):
+        return self.ioPins[netIdx][0]
+    def iopinY(self, netIdx):
+        return self.ioPins[netIdx][1]
+    def isIoPinVertical(self, netIdx):
+        return self.ioPins[netIdx][2]
+
+def solvePlacement(calls, gridStep, numCells, ioNets):
+    """
+    @brief make an IdeaPlaceEx with the recorded calls and solve it. Run by a worker process, see Worker.run()
+    @param first: the calls recorded by Worker.Recorder
+    @param second: the grid step
+    @param third: the number of cells
+    @param fourth: the nets whose IO pins are read out
+    @return the symmetry axis and the SolvedPlacement
+    """
+    placer = Worker.replay(IdeaPlaceExPy.IdeaPlaceEx(), calls)
+    return placer.solve(gridStep), SolvedPlacement(placer, numCells, ioNets)
+
 ##========================= 布局 ============================##
 class Placer(object):
     
@@ -21,6 +55,8 @@ class Placer(object):
         self.cktIdx = cktIdx
         self.ckt = self.dDB.subCkt(cktIdx)                                      # 初始化debug、cktIdx和ckt属性，ckt用于访问电路信息
         self.placer = IdeaPlaceExPy.IdeaPlaceEx()                               # 初始化placer属性，指向布局放置的placer对象
+        if Worker.isParallel():
+            self.placer = Worker.Recorder(self.placer)                          # The input is recorded for the worker process that solves it
         self.dirname = dirname
         self.numCktNodes = self.ckt.numNodes() # without io pins
         self.gridStep = gridStep 
@@ -48,7 +84,14 @@ class Placer(object):
         self.dumpInput()                                                        # 调用dumpInput()为placer提供输出
         self.placer.numThreads(1) #FIXME                                        # 调用placer.numThreads()设置线程数为1
         start = time.time()
-        self.symAxis = self.placer.solve(self.gridStep)                         # 调用placer.solve()执行布局
+        if not Worker.isParallel():
+            self.symAxis = self.placer.solve(self.gridStep)                     # 调用placer.solve()执行布局
+        else:
+            # Solve in a worker process, so that the other circuits run meanwhile. The outputs are read from the placement it sends back
+            ioNets = []
+            if self.useIoPin:
+                ioNets = [int(netIdx) for netIdx in self.ioSignalNets()]
+            self.symAxis, self.placer = Worker.run(solvePlacement, self.placer.calls, self.gridStep, self.numCktNodes, ioNets)
         end = time.time()
         self.runtime = end-start
         print("placement finished: ", self.ckt.name, "runtime", end-start)      # 打印运行时间
@@ -74,6 +117,20 @@ class Placer(object):
         filename = self.dirname + self.ckt.name + '.sigpath' #FIXME: use in memeory interface
         if os.path.isfile(filename):
             self.placer.readSigpathFile(filename)
+        elif self.params.signalFlow:
+            self.computeAndAddSignalFlow()
+    def computeAndAddSignalFlow(self):
+        """
+        @brief derive the signal paths from the input nets to the output nets and add them to the placer
+        """
+        csflow = magicalFlow.CSFlow(self.dDB)
+        csflow.computeSignalFlow(self.ckt)
+        pinNamePaths = csflow.signalPinPaths()
+        cellNamePaths = csflow.signalCellPaths()
+        for i in range(len(pinNamePaths)):
+            pathIdx = self.placer.allocateSignalPath()
+            for j in range(len(pinNamePaths[i])):
+                self.placer.addPinToSignalPath(pathIdx, cellNamePaths[i][j], pinNamePaths[i][j])
     def computeAndAddPowerCurrentFlow(self):
         #if self.isTopLevel:
         #    return
@@ -120,16 +177,19 @@ class Placer(object):
         self.placer.openVirtualPinAssignment()
         self.placer.setIoPinBoundaryExtension(12 * 1 * self.gridStep)
         self.placer.setIoPinInterval(5 * 2 * self.gridStep)
-        for netIdx in range(self.ckt.numNets()):
-            net = self.ckt.net(netIdx)
-            if (net.isIo() and (not net.isPower()) and self.useIoPin):
-                self.placer.markIoNet(netIdx)
-            #if net.isVdd() and not self.isTopLevel:
-            if net.isVdd():
-                self.placer.markAsVddNet(netIdx)
-            if net.isVss():
-            #if net.isVss() and not self.isTopLevel:
-                self.placer.markAsVssNet(netIdx)
+        if self.useIoPin:
+            for netIdx in self.ioSignalNets():
+                self.placer.markIoNet(int(netIdx))
+        #if not self.isTopLevel:
+        for netIdx in self.ckt.netsWithFlags(int(magicalFlow.NetFlag.VDD)):
+            self.placer.markAsVddNet(int(netIdx))
+        for netIdx in self.ckt.netsWithFlags(int(magicalFlow.NetFlag.VSS)):
+            self.placer.markAsVssNet(int(netIdx))
+    def ioSignalNets(self):
+        """
+        @brief the indices of the IO nets that are not power, in increasing order
+        """
+        return self.ckt.netsWithFlags(int(magicalFlow.NetFlag.IO), int(magicalFlow.NetFlag.VDD) | int(magicalFlow.NetFlag.VSS))
     def processPlacementOutput(self):
         #  Set Placement origin
         self.setPlaceOrigin()
@@ -142,31 +202,30 @@ class Placer(object):
         self.iopinOffsety = []
         if self.useIoPin == False:
             return
-        for netIdx in range(self.ckt.numNets()):
-            net = self.ckt.net(netIdx)
-            if (net.isIo() and (not net.isPower())):
-                ioPinX = self.placer.iopinX(netIdx) - self.origin[0]
-                ioPinY = self.placer.iopinY(netIdx) - self.origin[1]
-                self.iopinOffsetx.append(ioPinX)
-                self.iopinOffsety.append(ioPinY)
-                #FIXME
-                size_scale = 1;
-                if (self.placer.isIoPinVertical(netIdx)):
-                    metals = [
-                            [- 65, -self.gridStep * (1 + size_scale)  - 70 - 30, 65, self.gridStep * (1+size_scale)  + 70 + 30]
-                            ]
-                    metalPkdLayers = [31]
-                    metalIoLayers = [1]
-                else:
-                    metals = [
-                            [-self.gridStep * (1+size_scale)  - 70 - 30, - 65 , self.gridStep  * (1 + size_scale) + 70 + 30, 65]
-                            ]
-                    metalPkdLayers = [31]
-                    metalIoLayers = [1]
-                cuts = []
-                cutsPdkLayers = []
-                # add a new pin to the net
-                self.addIoPinToNet(netIdx, ioPinX, ioPinY, metals, metalPkdLayers, cuts, cutsPdkLayers)
+        for netIdx in self.ioSignalNets():
+            netIdx = int(netIdx)
+            ioPinX = self.placer.iopinX(netIdx) - self.origin[0]
+            ioPinY = self.placer.iopinY(netIdx) - self.origin[1]
+            self.iopinOffsetx.append(ioPinX)
+            self.iopinOffsety.append(ioPinY)
+            #FIXME
+            size_scale = 1;
+            if (self.placer.isIoPinVertical(netIdx)):
+                metals = [
+                        [- 65, -self.gridStep * (1 + size_scale)  - 70 - 30, 65, self.gridStep * (1+size_scale)  + 70 + 30]
+                        ]
+                metalPkdLayers = [31]
+                metalIoLayers = [1]
+            else:
+                metals = [
+                        [-self.gridStep * (1+size_scale)  - 70 - 30, - 65 , self.gridStep  * (1 + size_scale) + 70 + 30, 65]
+                        ]
+                metalPkdLayers = [31]
+                metalIoLayers = [1]
+            cuts = []
+            cutsPdkLayers = []
+            # add a new pin to the net
+            self.addIoPinToNet(netIdx, ioPinX, ioPinY, metals, metalPkdLayers, cuts, cutsPdkLayers)
         self.ckt = self.dDB.subCkt(self.cktIdx)
     def upscaleBBox(self, gridStep, ckt, origin):
         """
@@ -194,12 +253,12 @@ class Placer(object):
             subCkt = self.dDB.subCkt(cktNode.graphIdx)
             x_offset = cktNode.offset().x
             y_offset = cktNode.offset().y
-            self.ckt.layout().insertLayout(subCkt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
+            subCkt.insertLayoutInto(self.ckt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
         # write guardring using gdspy
         for grCell in self.guardRingGrCells:
             self.addPycell(self.ckt.layout(), grCell)
         # Output placement result
-        magicalFlow.writeGdsLayout(self.cktIdx, self.dirname + self.ckt.name + '.place.gds', self.dDB, self.tDB)
+        self.mDB.artifacts.writeGdsLayout(self.cktIdx, self.dirname + self.ckt.name + '.place.gds', self.dDB, self.tDB)
 
     def resetPlacer(self):
         """
@@ -221,10 +280,10 @@ class Placer(object):
             y_offset = self.placer.yCellLoc(nodeIdx) - self.origin[1]
             print("node ", cktNode.name, x_offset, y_offset)
             cktNode.setOffset(x_offset, y_offset)
-            self.ckt.layout().insertLayout(subCkt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
+            subCkt.insertLayoutInto(self.ckt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
             print(cktNode.name, self.placer.cellName(nodeIdx), x_offset, y_offset, "PLACEMENT")
             if self.debug:
-                boundary = subCkt.layout().boundary()
+                boundary = subCkt.layoutBoundary()
                 rect = gdspy.Rectangle((boundary.xLo+x_offset,boundary.yLo+y_offset), (boundary.xHi+x_offset,boundary.yHi+y_offset))
                 text = gdspy.Text(cktNode.name,50,((boundary.xLo+boundary.xHi)/2+x_offset,(boundary.yLo+boundary.yHi)/2+y_offset),layer=100)
                 self.tempCell.add(rect)
@@ -238,7 +297,7 @@ class Placer(object):
                 x_offset = self.iopinOffsetx[nodeIdx - self.numCktNodes]
                 y_offset = self.iopinOffsety[nodeIdx - self.numCktNodes]
                 cktNode.setOffset(x_offset, y_offset)
-                self.ckt.layout().insertLayout(subCkt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
+                subCkt.insertLayoutInto(self.ckt.layout(), x_offset, y_offset, cktNode.flipVertFlag)
         # write guardring using gdspy
         if self.cktNeedSub(self.cktIdx) and self.implRealLayout:
             print("Adding GuardRing to Cell")
@@ -260,12 +319,13 @@ class Placer(object):
                 cktNode = self.ckt.node(nodeIdx)
                 subCkt = self.dDB.subCkt(cktNode.graphIdx)
                 cktNode.setOffset(0, 0)
-                self.ckt.layout().insertLayout(subCkt.layout(), 0, 0, cktNode.flipVertFlag)
+                subCkt.insertLayoutInto(self.ckt.layout(), 0, 0, cktNode.flipVertFlag)
         # Output placement result
-        magicalFlow.writeGdsLayout(self.cktIdx, self.dirname + self.ckt.name + '.place.gds', self.dDB, self.tDB)
+        self.mDB.artifacts.writeGdsLayout(self.cktIdx, self.dirname + self.ckt.name + '.place.gds', self.dDB, self.tDB)
         self.origin = [0,0]
         if self.debug:
-            gdspy.write_gds(self.dirname+self.ckt.name+'.floorplan.gds', [self.tempCell], unit=1.0e-9, precision=1.0e-9)
+            with self.mDB.artifacts.writing(self.ckt.name, self.dirname+self.ckt.name+'.floorplan.gds') as floorplanFile:
+                gdspy.write_gds(floorplanFile, [self.tempCell], unit=1.0e-9, precision=1.0e-9)
 
     def hardcodeConvertPdkLayerToIoLayer(self, pdkLayer):
         #print("WARNING: using hard-coded IO layer conversion")
@@ -362,6 +422,10 @@ class Placer(object):
         otherDbLayers = []
         for pdkLayer in otherPdkLayers:
             otherDbLayers.append(self.tDB.pdkLayerToDb(pdkLayer))
+        if useDatatype:
+            # The layout stores the drawing datatype of the layer apart from the PDK numbers. See addPycell()
+            routableDatatype = [self.tDB.pdkDatatypeToDb(routableDbLayers[mIdx], routableDatatype[mIdx]) for mIdx in range(len(routableShapes))]
+            otherDataType = [self.tDB.pdkDatatypeToDb(otherDbLayers[cIdx], otherDataType[cIdx]) for cIdx in range(len(otherShapes))]
         net = self.ckt.net(netIdx)
 
         # add a new pin to the net
@@ -402,7 +466,7 @@ class Placer(object):
             dbLayer = otherDbLayers[cIdx]
             rectIdx = iopinGraph.layout().insertRect(dbLayer, other[0], other[1], other[2], other[3])
             if useDatatype:
-                rectIdx = iopinGraph.layout().setRectDatatype(dbLayer, rectIdx, otherDataType[cIdx])
+                iopinGraph.layout().setRectDatatype(dbLayer, rectIdx, otherDataType[cIdx])
             if addtocurrentlayout:
                 rectIdx = self.ckt.layout().insertRect(dbLayer, other[0] + offsetX,  other[1] + offsetY,  other[2] + offsetX,  other[3] + offsetY)
                 if useDatatype:
@@ -547,7 +611,7 @@ class Placer(object):
         for nodeIdx in range(self.ckt.numNodes()):
             cktNode = self.ckt.node(nodeIdx)
             subCkt = self.dDB.subCkt(cktNode.graphIdx)
-            bBox = subCkt.layout().boundary()
+            bBox = subCkt.layoutBoundary()
             self.placer.addCellShape(nodeIdx, 0, bBox.xLo, bBox.yLo, bBox.xHi, bBox.yHi)
             if self.debug:
                 outFile.write("%d %d %d %d\n" % (bBox.xLo, bBox.yLo, bBox.xHi, bBox.yHi))
@@ -610,8 +674,7 @@ class Placer(object):
                 xHi = int(round(poly[2][0]*200))*5
                 yHi = int(round(poly[2][1]*200))*5
                 rectIdx = layout.insertRect(layerIdx, xLo, yLo, xHi, yHi)
-                if datatype != 0:
-                    layout.setRectDatatype(layerIdx, rectIdx, datatype)
+                layout.setRectDatatype(layerIdx, rectIdx, self.tDB.pdkDatatypeToDb(layerIdx, datatype))
 
     def subShape(self, subPin):
         shape = subPin.normalize_shape()
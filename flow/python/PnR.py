@@ -11,9 +11,34 @@ import sys
 import os
 import Router
 import Placer
+import Worker
 import gdspy
 from device_generation.glovar import tsmc40_glovar as glovar
 
+def solveRoute(router, placeFile, routeFile, ioPinFile):
+    """
+    @brief route and write the routed layout and the IO pins if the routing passes
+    @param first: the router with its input
+    @param second: the placed layout
+    @param third: the routed layout to write
+    @param fourth: the IO pin file to write
+    @return whether the routing passes
+    """
+    routerPass = router.solve(False)
+    router.evaluate()
+    if routerPass:
+        router.writeLayoutGds(placeFile, routeFile, True)
+        router.writeDumb(placeFile, ioPinFile)
+    return routerPass
+
+def solveRouteCalls(calls, placeFile, routeFile, ioPinFile):
+    """
+    @brief make an anaroute with the recorded calls and route it. Run by a worker process, see Worker.run()
+    @param first: the calls recorded by Worker.Recorder
+    @return whether the routing passes. See solveRoute() for the rest
+    """
+    return solveRoute(Worker.replay(anaroutePy.AnaroutePy(), calls), placeFile, routeFile, ioPinFile)
+
 class PnR(object):
     def __init__(self, magicalDB):
         self.mDB = magicalDB
@@ -58,7 +83,6 @@ class PnR(object):
         self.dirname = dirname
         self.runPlace(cktIdx, dirname)
         self.checkSmallModule(cktIdx)
-        self.dDB.subCkt(cktIdx).isImpl = True
         print("PnR: placement finished ", self.dDB.subCkt(cktIdx).name)
 
     def routeOnly(self):
@@ -69,6 +93,7 @@ class PnR(object):
 
         self.p.updatePlacementResult()
         self.runRoute(self.cktIdx, self.dirname)
+        self.dDB.subCkt(self.cktIdx).isImpl = True
         print("PnR: routing finished ", self.dDB.subCkt(self.cktIdx).name)
             
     def runPlace(self, cktIdx, dirname):
@@ -95,6 +120,8 @@ class PnR(object):
             self.routerNets.append(netIdx)
         self.findOrigin(cktIdx)
         router = anaroutePy.AnaroutePy()
+        if Worker.isParallel():
+            router = Worker.Recorder(router)                                    # The input is recorded for the worker process that solves it
         router.setCircuitName(ckt.name)
         placeFile = dirname + ckt.name + '.place.gds'
         if self.debug:
@@ -111,17 +138,22 @@ class PnR(object):
         print("routing grid off set", 2*(self.origin[0]), 2*(self.origin[1]))
         #router.parseSymNet(dirname+ckt.name+'.symnet')
         if self.isTopLevel:
-            for netIdx in self.routerNets:
-                net = ckt.net(netIdx)
-                if net.isIo():
-                    router.addIOPort(net.name)
-        routerPass = router.solve(False)
-        router.evaluate()
+            for netIdx in ckt.netsWithFlags(int(magicalFlow.NetFlag.IO)):
+                router.addIOPort(ckt.net(int(netIdx)).name)
+        routeFile = dirname+ckt.name+'.route.gds'
+        ioPinFile = dirname+ckt.name+'.ioPin'
+        self.mDB.artifacts.release(routeFile)
+        self.mDB.artifacts.release(ioPinFile)
+        if not Worker.isParallel():
+            routerPass = solveRoute(router, placeFile, routeFile, ioPinFile)
+        else:
+            # Route in a worker process, so that the other circuits run meanwhile. It only writes the files
+            routerPass = Worker.run(solveRouteCalls, router.calls, placeFile, routeFile, ioPinFile)
         if not routerPass:
             print("Routing failed! ckt ", ckt.name)
             assert(routerPass)
-        router.writeLayoutGds(placeFile, dirname+ckt.name+'.route.gds', True)
-        router.writeDumb(placeFile, dirname+ckt.name+'.ioPin') 
+        self.mDB.artifacts.commit(ckt.name, routeFile)
+        self.mDB.artifacts.commit(ckt.name, ioPinFile)
         # Read results to flow
         ckt.setTechDB(self.tDB)
         ckt.parseGDS(dirname+ckt.name+'.route.gds')
@@ -176,7 +208,7 @@ class PnR(object):
             for iopinidx in range(conCkt.net(conNet).numIoPins()):
                 conLayer = conCkt.net(conNet).ioPinMetalLayer(iopinidx) - 1
                 ioshape = conCkt.net(conNet).ioPinShape(iopinidx)
-                conShape = self.adjustIoShape(ioshape, ckt.node(conNode).offset(), conCkt.layout().boundary(), ckt.node(conNode).flipVertFlag)
+                conShape = self.adjustIoShape(ioshape, ckt.node(conNode).offset(), conCkt.layoutBoundary(), ckt.node(conNode).flipVertFlag)
                 # GDS and LEF unit mismatch, multiply by 2
                 assert conShape[0] <= conShape[2]
                 assert conShape[1] <= conShape[3]
@@ -205,17 +237,16 @@ class PnR(object):
         @brief this function write out the .iopin file for router. Primaily for debugging
         """
         ckt = self.dDB.subCkt(cktIdx)
-        with open(fileName, 'w') as of:
-            for netIdx in self.routerNets:
-                net = ckt.net(netIdx)
-                if net.isIo():
-                    of.write("%s\n"% net.name)
+        with self.mDB.artifacts.writing(ckt.name, fileName), open(fileName, 'w') as of:
+            for netIdx in ckt.netsWithFlags(int(magicalFlow.NetFlag.IO)):
+                of.write("%s\n"% ckt.net(int(netIdx)).name)
     def routeParsePin(self, router, cktIdx, fileName):
         router.init()
         ckt = self.dDB.subCkt(cktIdx)
         pinName = dict()
         pinNameIdx = 0
         if self.debug:
+            self.mDB.artifacts.release(fileName)
             outFile = open(fileName, 'w')
             outFile.write('gridStep %d\n' % (self.gridStep))
             outFile.write('Offset %d %d\n' % (self.origin[0],self.origin[1]))
@@ -255,7 +286,7 @@ class PnR(object):
                 for iopinidx in range(conCkt.net(conNet).numIoPins()):
                     conLayer = conCkt.net(conNet).ioPinMetalLayer(iopinidx) - 1
                     ioshape = conCkt.net(conNet).ioPinShape(iopinidx)
-                    conShape = self.adjustIoShape(ioshape, ckt.node(conNode).offset(), conCkt.layout().boundary(), ckt.node(conNode).flipVertFlag)
+                    conShape = self.adjustIoShape(ioshape, ckt.node(conNode).offset(), conCkt.layoutBoundary(), ckt.node(conNode).flipVertFlag)
                     # GDS and LEF unit mismatch, multiply by 2
                     assert conShape[0] <= conShape[2]
                     assert conShape[1] <= conShape[3]
@@ -286,10 +317,11 @@ class PnR(object):
         if self.debug:
             string = "NET_SPEC:\n" 
             specFile.write(string)   
+        netFlags = ckt.netFlags()
         for netIdx in self.routerNets: 
             net = ckt.net(netIdx)  
             grPinCount, isPsub, isNwell = self.netPinCount(ckt, net)    
-            width, cuts, rows, cols = self.determineNetWidthVia(cktIdx, netIdx)
+            width, cuts, rows, cols = self.determineNetWidthVia(cktIdx, netIdx, netFlags[netIdx])
             width = self.dbuToRouterDbu(width)
             routerNetIdx = router.addNet(net.name, width, cuts, net.isPower() and not self.isSmallModule, rows, cols)  
             print("addNet netname", net.name, "width", width, "cuts", cuts, "isPower", net.isPower() and not self.isSmallModule, "rows", rows, "cols", cols)
@@ -303,6 +335,10 @@ class PnR(object):
             if isPsub:
                 print("addPin2Net pubs ver", pinName[netIdx]['sub'], routerNetIdx)
                 router.addPin2Net(pinName[netIdx]['sub'], netIdx)                
+        if self.debug:
+            outFile.close()
+            specFile.close()
+            self.mDB.artifacts.commit(ckt.name, fileName)
 
     def updateOriginPin(self, shape):
         xCenter = (shape[0] + shape[2]) / 2
@@ -392,11 +428,14 @@ class PnR(object):
             self.isSmallModule = True
         else:
             self.isSmallModule = False
-    def determineNetWidthVia(self, cktIdx, netIdx):
+    def determineNetWidthVia(self, cktIdx, netIdx, flags):
+        """
+        @param flags: the NetFlag bits of the net, from CktGraph.netFlags()
+        """
         net = self.dDB.subCkt(cktIdx).net(netIdx)
         wTable = self.params.signalAnalogWireWidthTable
         vTable = self.params.signalAnalogViaCutsTable
-        if net.isPower():
+        if int(flags) & (int(magicalFlow.NetFlag.VDD) | int(magicalFlow.NetFlag.VSS)):
             wTable = self.params.powerWireWidthTable
             vTable = self.params.powerViaCutsTable
             if self.isSmallModule:
@@ -404,7 +443,7 @@ class PnR(object):
                 vTable = self.params.signalAnalogViaCutsTable
             if (self.dDB.subCkt(cktIdx).name == "DIGITAL_TOP_flat"):
                 wTable = self.params.dpowerWireWidthTable
-        if net.isDigital():
+        if int(flags) & int(magicalFlow.NetFlag.DIGITAL):
             wTable = self.params.signalDigitalWireWidthTable
             vTable = self.params.signalDigitalViaCutsTable
         length = self.calcNetLength(cktIdx, netIdx)
@@ -47,8 +47,10 @@ class S3DET(object):
             cktB = self.dDB.subCkt(nodeB.graphIdx)
             #boxA = (cktA.gdsData().bbox().xLen(), cktA.gdsData().bbox().yLen())
             #boxB = (cktB.gdsData().bbox().xLen(), cktB.gdsData().bbox().yLen())
-            boxA = (cktA.layout().boundary().xLen(), cktA.layout().boundary().yLen())
-            boxB = (cktB.layout().boundary().xLen(), cktB.layout().boundary().yLen())
+            boundaryA = cktA.layoutBoundary()
+            boundaryB = cktB.layoutBoundary()
+            boxA = (boundaryA.xLen(), boundaryA.yLen())
+            boxB = (boundaryB.xLen(), boundaryB.yLen())
             subgraphA = self.subgraph(cktIdx, nodeIdxA)
             subgraphB = self.subgraph(cktIdx, nodeIdxB)
             # Boundary box size check and circuit graph isomorphic check
@@ -88,6 +90,7 @@ class S3DET(object):
                 else:
                     continue
         filename = dirName + ckt.name + ".sym"
+        self.mDB.artifacts.release(filename)
         symFile = open(filename, "w")
         for idxA in symPair:
             idxB = symPair[idxA]
@@ -105,8 +108,9 @@ class S3DET(object):
             name = ckt.node(idx).name
             symFile.write("%s\n" % name)
         symNet = self.symNet(cktIdx, symPair, selfSym)
-        filename = dirName + ckt.name + ".symnet"
-        netFile = open(filename, "w")
+        netFilename = dirName + ckt.name + ".symnet"
+        self.mDB.artifacts.release(netFilename)
+        netFile = open(netFilename, "w")
         for idxA in symNet:
             idxB = symNet[idxA]
             if idxA == idxB:
@@ -118,6 +122,8 @@ class S3DET(object):
                 netFile.write("%s %s\n" % (nameA, nameB))
         symFile.close()
         netFile.close()
+        self.mDB.artifacts.commit(ckt.name, filename)
+        self.mDB.artifacts.commit(ckt.name, netFilename)
 
     def selfSym(self, symPair, hierGraph):
         selfSym = set()
@@ -0,0 +1,80 @@
+##
+# @file Worker.py
+# @author agent
+# @date 10/19/2026
+# @brief Solve the placements and the routings in a pool of worker processes
+#
+
+import multiprocessing
+import os
+
+# The pool of the run, or None to solve in this process
+_pool = None
+
+def start(numProcesses):
+    """
+    @brief start the worker processes. They come from a fork server, a fresh process, so call it before any thread is started.
+    The placer and router bindings hold the GIL while they solve, so the parallel flow solves in the workers
+    and waits for them without the GIL
+    @param the number of processes. 0 for the number of CPUs. With 1 nothing is started and the solvers run in this process
+    """
+    global _pool
+    if numProcesses == 0:
+        numProcesses = os.cpu_count() or 1
+    if numProcesses > 1 and _pool is None:
+        _pool = multiprocessing.get_context('forkserver').Pool(numProcesses)
+
+def stop():
+    """
+    @brief stop the worker processes started by start()
+    """
+    global _pool
+    if _pool is not None:
+        _pool.close()
+        _pool.join()
+        _pool = None
+
+def isParallel():
+    """
+    @brief whether the solvers run in the worker processes
+    """
+    return _pool is not None
+
+def run(func, *args):
+    """
+    @brief call func(*args) in a worker process and wait for its result, or here if no worker is started
+    @param first: a module-level function. The arguments and the result must be picklable
+    @param second: the arguments
+    @return the result of func(*args)
+    """
+    if _pool is None:
+        return func(*args)
+    return _pool.apply(func, args)
+
+class Recorder(object):
+    """
+    @brief forward the calls to a solver and record them, so that a worker process makes the same solver with replay().
+    The arguments of the calls must be picklable
+    """
+    def __init__(self, solver):
+        self.solver = solver
+        self.calls = []
+    def __getattr__(self, name):
+        attr = getattr(self.solver, name)
+        if not callable(attr):
+            return attr
+        def call(*args):
+            self.calls.append((name, args))
+            return attr(*args)
+        return call
+
+def replay(solver, calls):
+    """
+    @brief make the calls recorded by a Recorder on another solver
+    @param first: the solver, made like the recorded one
+    @param second: the calls of Recorder
+    @return the solver
+    """
+    for name, args in calls:
+        getattr(solver, name)(*args)
+    return solver